@@ -0,0 +1,278 @@
+// Command line front end of CefBatchRenderer: renders pages to images or PDFs.
+//
+//   cefview_batch_render [options] <url-or-file>...
+//   cefview_batch_render [options] --list pages.txt
+//
+// The executable is also its own CEF sub-process.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <global/CefContext.h>
+#include <client/CefViewAppDelegateInterface.h>
+#include <client/CefViewClient.h>
+#include <utils/PathUtil.h>
+#include <view/CefBatchRenderer.h>
+
+#include "include/base/cef_bind.h"
+#include "include/base/cef_callback.h"
+#include "include/cef_task.h"
+#include "include/wrapper/cef_closure_task.h"
+
+using namespace cefview;
+
+namespace {
+
+struct Arguments {
+    CefBatchRenderer::Options options;
+    std::vector<std::string> sources;
+    std::string outputDir = ".";
+};
+
+// Switches for a browser process that never shows a window.
+class BatchAppDelegate : public CefViewAppDelegateInterface {
+public:
+    void onBeforeCommandLineProcessing(const CefString& processType, CefRefPtr<CefCommandLine> commandLine) override {
+        if (!processType.empty()) {
+            return;
+        }
+        // Software compositing paints straight into OnPaint's buffers, with
+        // no GPU read-back per frame
+        commandLine->AppendSwitch("disable-gpu");
+        commandLine->AppendSwitch("disable-gpu-compositing");
+        commandLine->AppendSwitch("hide-scrollbars");
+        commandLine->AppendSwitch("mute-audio");
+    }
+};
+
+void PrintUsage() {
+    fprintf(stderr,
+            "Usage: cefview_batch_render [options] <url-or-file>...\n"
+            "  --list FILE           Read sources from FILE, one per line ('#' comments)\n"
+            "  --out DIR             Output directory (default .)\n"
+            "  --format FORMAT       png, jpeg, bmp or pdf (default png)\n"
+            "  --quality N           JPEG quality, 1-100 (default 90)\n"
+            "  --paper SIZE          PDF paper: letter, a4 or legal (default letter)\n"
+            "  --landscape           PDF in landscape orientation\n"
+            "  --print-background    PDF with background colors and images\n"
+            "  --width N --height N  Viewport in CSS pixels (default 1280x800)\n"
+            "  --scale-factor F      Device scale factor (default 1)\n"
+            "  --full-page           Capture the whole document height (images)\n"
+            "  --max-height N        Full-page limit in pixels (default 16384)\n"
+            "  --output-scale F      Output size relative to the frame, (0, 1] (default 1)\n"
+            "  --idle-ms N           Quiet period after loading, > 0 (default 500)\n"
+            "  --timeout-ms N        Per page timeout, > 0 (default 30000)\n"
+            "  --browsers N          Concurrent browsers (default: cores, max 8)\n"
+            "  --encode-threads N    Encoder threads (default: cores)\n");
+}
+
+bool ReadList(const std::string& path, std::vector<std::string>& sources) {
+    std::ifstream file(path);
+    if (!file) {
+        fprintf(stderr, "Cannot read %s\n", path.c_str());
+        return false;
+    }
+    std::string line;
+    while (std::getline(file, line)) {
+        const size_t begin = line.find_first_not_of(" \t\r");
+        const size_t end = line.find_last_not_of(" \t\r");
+        if (begin == std::string::npos || line[begin] == '#') {
+            continue;
+        }
+        sources.push_back(line.substr(begin, end - begin + 1));
+    }
+    return true;
+}
+
+bool ParseArguments(int argc, char* argv[], Arguments& args) {
+    CefBatchRenderer::Options& options = args.options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        auto value = [&]() { return std::string(argv[++i]); };
+
+        if (arg == "--full-page") {
+            options.fullPage = true;
+        } else if (arg == "--landscape") {
+            options.pdfSettings.landscape = true;
+        } else if (arg == "--print-background") {
+            options.pdfSettings.print_background = true;
+        } else if (arg == "--help" || arg == "-h") {
+            return false;
+        } else if (arg.compare(0, 2, "--") != 0) {
+            args.sources.push_back(arg);
+        } else if (!hasValue) {
+            fprintf(stderr, "Missing value for %s\n", arg.c_str());
+            return false;
+        } else if (arg == "--list") {
+            if (!ReadList(value(), args.sources)) {
+                return false;
+            }
+        } else if (arg == "--out") {
+            args.outputDir = value();
+        } else if (arg == "--format") {
+            const std::string format = value();
+            if (format == "png") {
+                options.format = ImageEncoder::Format::kPng;
+            } else if (format == "jpeg" || format == "jpg") {
+                options.format = ImageEncoder::Format::kJpeg;
+            } else if (format == "bmp") {
+                options.format = ImageEncoder::Format::kBmp;
+            } else if (format == "pdf") {
+                options.output = CefBatchRenderer::Output::kPdf;
+            } else {
+                fprintf(stderr, "Unknown format %s\n", format.c_str());
+                return false;
+            }
+        } else if (arg == "--paper") {
+            // Inches; zero width and height is CEF's default, US letter
+            const std::string paper = value();
+            if (paper == "letter") {
+                options.pdfSettings.paper_width = 0;
+                options.pdfSettings.paper_height = 0;
+            } else if (paper == "a4") {
+                options.pdfSettings.paper_width = 8.27;
+                options.pdfSettings.paper_height = 11.69;
+            } else if (paper == "legal") {
+                options.pdfSettings.paper_width = 8.5;
+                options.pdfSettings.paper_height = 14.0;
+            } else {
+                fprintf(stderr, "Unknown paper %s\n", paper.c_str());
+                return false;
+            }
+        } else if (arg == "--quality") {
+            options.quality = atoi(value().c_str());
+        } else if (arg == "--width") {
+            options.width = atoi(value().c_str());
+        } else if (arg == "--height") {
+            options.height = atoi(value().c_str());
+        } else if (arg == "--scale-factor") {
+            options.deviceScaleFactor = static_cast<float>(atof(value().c_str()));
+        } else if (arg == "--max-height") {
+            options.maxPageHeight = atoi(value().c_str());
+        } else if (arg == "--output-scale") {
+            options.scale = static_cast<float>(atof(value().c_str()));
+        } else if (arg == "--idle-ms") {
+            options.idleMs = atoi(value().c_str());
+        } else if (arg == "--timeout-ms") {
+            options.timeoutMs = atoi(value().c_str());
+        } else if (arg == "--browsers") {
+            options.concurrency = atoi(value().c_str());
+        } else if (arg == "--encode-threads") {
+            options.encodeThreads = atoi(value().c_str());
+        } else {
+            fprintf(stderr, "Unknown option %s\n", arg.c_str());
+            return false;
+        }
+    }
+
+    if (args.sources.empty()) {
+        fprintf(stderr, "No pages to render\n");
+        return false;
+    }
+    if (options.width <= 0 || options.height <= 0 || options.deviceScaleFactor <= 0.0f || options.scale <= 0.0f ||
+        options.scale > 1.0f || options.quality < 1 || options.quality > 100) {
+        fprintf(stderr, "Invalid size, scale or quality\n");
+        return false;
+    }
+    // A zero quiet period captures before the page has painted; a zero timeout fails every page
+    if (options.idleMs <= 0 || options.timeoutMs <= 0) {
+        fprintf(stderr, "--idle-ms and --timeout-ms must be positive\n");
+        return false;
+    }
+    return true;
+}
+
+void PrintResult(const CefBatchRenderResult& result) {
+    if (result.success && result.width == 0) {
+        // PDF
+        printf("ok    %zu %s -> %s (%zu bytes, load %.0f ms, print %.0f ms%s)\n", result.index, result.source.c_str(),
+               result.outputPath.c_str(), result.bytes, result.loadMs, result.encodeMs,
+               result.settled ? "" : ", not settled");
+    } else if (result.success) {
+        printf("ok    %zu %s -> %s (%dx%d, %zu bytes, load %.0f ms, encode %.0f ms%s)\n", result.index,
+               result.source.c_str(), result.outputPath.c_str(), result.width, result.height, result.bytes,
+               result.loadMs, result.encodeMs, result.settled ? "" : ", not settled");
+    } else {
+        printf("FAIL  %zu %s: %s\n", result.index, result.source.c_str(), result.error.c_str());
+    }
+    fflush(stdout);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    Arguments args;
+#if defined(WIN32)
+    const bool browserProcess = CefContext::GetProcessType() == "browser";
+#else
+    const bool browserProcess = CefContext::GetProcessType(argc, argv) == "browser";
+#endif
+    // Sub-processes get CEF's switches, not ours
+    if (browserProcess && !ParseArguments(argc, argv, args)) {
+        PrintUsage();
+        return 2;
+    }
+
+    std::shared_ptr<CefViewAppDelegateInterface> browserDelegate = std::make_shared<BatchAppDelegate>();
+
+    CefConfig cefConfig;
+    cefConfig.multiThreadedMessageLoop = false;
+    cefConfig.windowlessRenderingEnabled = true;
+    cefConfig.backgroundColor = args.options.backgroundColor;
+    cefConfig.remoteDebuggingPort = 0;
+
+    auto& context = CefContext::instance();
+#if defined(WIN32)
+    int initResult = context.initialize(cefConfig, browserDelegate);
+#else
+    int initResult = context.initialize(argc, argv, cefConfig, browserDelegate);
+#endif
+    if (initResult >= 0) {
+        // This is a sub-process, exit immediately with the returned code
+        return initResult;
+    }
+    if (initResult != -1) {
+        return 1;
+    }
+
+    if (!PathUtil::CreatePath(args.outputDir)) {
+        fprintf(stderr, "Cannot create %s\n", args.outputDir.c_str());
+        context.shutdown();
+        return 1;
+    }
+    std::vector<CefBatchRenderJob> jobs;
+    for (size_t i = 0; i < args.sources.size(); ++i) {
+        jobs.push_back({args.sources[i],
+                        CefBatchRenderer::OutputPathFor(args.sources[i], args.outputDir, args.options, i)});
+    }
+
+    // The renderer closes and reuses browsers itself; the loop ends on completion
+    CefViewClient::sShouldTerminate = false;
+    auto renderer = std::make_shared<CefBatchRenderer>(args.options);
+    auto exitCode = std::make_shared<int>(1);
+    CefPostTask(TID_UI, base::BindOnce([](std::shared_ptr<CefBatchRenderer> renderer,
+                                          std::vector<CefBatchRenderJob> jobs, std::shared_ptr<int> exitCode) {
+            const bool started = renderer->start(std::move(jobs), PrintResult,
+                [exitCode](const CefBatchRenderStats& stats) {
+                    printf("%zu of %zu pages in %.1f s, %.1f pages/min (%zu browsers, %zu encoder threads)\n",
+                           stats.succeeded, stats.jobs, stats.seconds, stats.pagesPerMinute, stats.browsers,
+                           stats.encodeThreads);
+                    *exitCode = stats.failed == 0 ? 0 : 1;
+                    CefContext::instance().quitMessageLoop();
+                });
+            if (!started) {
+                CefContext::instance().quitMessageLoop();
+            }
+        }, renderer, std::move(jobs), exitCode));
+
+    context.runMessageLoop();
+    renderer.reset();
+    context.shutdown();
+    return *exitCode;
+}
@@ -176,14 +176,16 @@ bool CefViewApp::OnProcessMessageReceived(CefRefPtr<CefBrowser> browser,
 {
     assert(source_process == PID_BROWSER);
 
-    bool handled = false;
+    // Stop at the first delegate that handles the message
     for (auto& weakDelegate : _viewAppDelegates) {
         if (auto delegate = weakDelegate.lock()) {
-            handled = delegate->onProcessMessageReceived(browser, frame, source_process, message);
+            if (delegate->onProcessMessageReceived(browser, frame, source_process, message)) {
+                return true;
+            }
         }
     }
 
-    return handled;
+    return false;
 }
 
 }  // namespace cefview
@@ -13,6 +13,45 @@
 
 namespace cefview {
 
+CefViewAppDelegateRenderer::CefViewAppDelegateRenderer()
+    : _lastNodeIsEditable(false) {
+    registerMessageHandlers();
+}
+
+void CefViewAppDelegateRenderer::registerMessageHandlers() {
+    _messageRegistry.registerHandler(kExecuteJsCallbackMessage,
+        [this](CefRefPtr<CefBrowser>, CefRefPtr<CefFrame>, CefProcessId, CefRefPtr<CefProcessMessage> message) {
+            if (!_renderJsBridge) {
+                return false;
+            }
+            CefRefPtr<CefListValue> args = message->GetArgumentList();
+            int callbackId = args->GetInt(0);
+            CefString jsonString = args->GetString(1);
+
+            _renderJsBridge->executeJSCallbackFunc(callbackId, jsonString);
+            return true;
+        });
+
+    _messageRegistry.registerHandler(kCallJsFunctionMessage,
+        [this](CefRefPtr<CefBrowser> browser, CefRefPtr<CefFrame>, CefProcessId, CefRefPtr<CefProcessMessage> message) {
+            if (!_renderJsBridge) {
+                return false;
+            }
+            CefRefPtr<CefListValue> args = message->GetArgumentList();
+            CefString functionName = args->GetString(0);
+            CefString jsonString = args->GetString(1);
+            int cppCallbackId = args->GetInt(2);
+            CefString frameId = args->GetString(3);
+
+            // Execute a registered JS function from C++
+            // If frame_id is invalid (browser process browser may be invalid), get main frame to execute
+            _renderJsBridge->executeJSFunc(functionName, jsonString,
+                                           frameId.empty() ? browser->GetMainFrame() : browser->GetFrameByIdentifier(frameId),
+                                           cppCallbackId);
+            return true;
+        });
+}
+
 void CefViewAppDelegateRenderer::onWebKitInitialized() {
     // DWORD pid = GetCurrentProcessId();
     // DWORD tid = GetCurrentThreadId();
@@ -111,26 +150,7 @@ bool CefViewAppDelegateRenderer::onProcessMessageReceived(CefRefPtr<CefBrowser>
                                                           CefRefPtr<CefProcessMessage> message) {
     assert(sourceProcess == PID_BROWSER);
     // Received message reply from browser process
-    const CefString& messageName = message->GetName();
-    if (messageName == kExecuteJsCallbackMessage) {
-        int callbackId = message->GetArgumentList()->GetInt(0);
-        CefString jsonString = message->GetArgumentList()->GetString(1);
-
-        _renderJsBridge->executeJSCallbackFunc(callbackId, jsonString);
-    } else if (messageName == kCallJsFunctionMessage) {
-        CefString functionName = message->GetArgumentList()->GetString(0);
-        CefString jsonString = message->GetArgumentList()->GetString(1);
-        int cppCallbackId = message->GetArgumentList()->GetInt(2);
-        CefString frameId = message->GetArgumentList()->GetString(3);
-
-        // Execute a registered JS function from C++
-        // If frame_id is invalid (browser process browser may be invalid), get main frame to execute
-        _renderJsBridge->executeJSFunc(functionName, jsonString,
-                                       frameId.empty() ? browser->GetMainFrame() : browser->GetFrameByIdentifier(frameId),
-                                       cppCallbackId);
-    }
-
-    return false;
+    return _messageRegistry.dispatch(browser, frame, sourceProcess, message);
 }
 
 }  // namespace cefview
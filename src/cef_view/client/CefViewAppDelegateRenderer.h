@@ -14,6 +14,7 @@
 #include "include/cef_base.h"
 
 #include <client/CefViewAppDelegateInterface.h>
+#include <client/CefViewMessageRegistry.h>
 
 namespace cefview {
 
@@ -21,9 +22,12 @@ class CefJsBridgeRender;
 
 class CefViewAppDelegateRenderer : public CefViewAppDelegateInterface {
 public:
-   CefViewAppDelegateRenderer()
-     : _lastNodeIsEditable(false) {
-   }
+   CefViewAppDelegateRenderer();
+
+   /**
+    * @brief Registry used to dispatch process messages from the browser process.
+    */
+   CefViewMessageRegistry& messageRegistry() { return _messageRegistry; }
 
    virtual void onWebKitInitialized() override;
 
@@ -41,9 +45,13 @@ public:
 
    virtual bool onProcessMessageReceived(CefRefPtr<CefBrowser> browser, CefRefPtr<CefFrame> frame, CefProcessId sourceProcess, CefRefPtr<CefProcessMessage> message) override;
 
+protected:
+   void registerMessageHandlers();
+
 protected:
    bool _lastNodeIsEditable{false};
    std::shared_ptr<CefJsBridgeRender> _renderJsBridge;
+   CefViewMessageRegistry _messageRegistry;
 };
 
 }  // namespace cefview
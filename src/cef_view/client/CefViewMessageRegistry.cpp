@@ -0,0 +1,66 @@
+#include "CefViewMessageRegistry.h"
+
+#include <utility>
+
+namespace cefview {
+
+void CefViewMessageRegistry::registerHandler(const std::string& messageName, Handler handler) {
+    if (messageName.empty() || !handler) {
+        return;
+    }
+    _entries[messageName].handlers.push_back(std::move(handler));
+}
+
+void CefViewMessageRegistry::unregisterHandlers(const std::string& messageName) {
+    auto it = _entries.find(messageName);
+    if (it != _entries.end()) {
+        it->second.handlers.clear();
+    }
+}
+
+bool CefViewMessageRegistry::hasHandler(const std::string& messageName) const {
+    auto it = _entries.find(messageName);
+    return it != _entries.end() && !it->second.handlers.empty();
+}
+
+bool CefViewMessageRegistry::dispatch(CefRefPtr<CefBrowser> browser,
+                                      CefRefPtr<CefFrame> frame,
+                                      CefProcessId sourceProcess,
+                                      CefRefPtr<CefProcessMessage> message) {
+    if (!message) {
+        return false;
+    }
+
+    auto it = _entries.find(message->GetName().ToString());
+    if (it == _entries.end() || it->second.handlers.empty()) {
+        ++_unknownCount;
+        return false;
+    }
+
+    Entry& entry = it->second;
+    ++entry.counters.received;
+    for (const auto& handler : entry.handlers) {
+        if (handler(browser, frame, sourceProcess, message)) {
+            ++entry.counters.handled;
+            return true;
+        }
+    }
+    return false;
+}
+
+CefViewMessageRegistry::Counters CefViewMessageRegistry::getCounters(const std::string& messageName) const {
+    auto it = _entries.find(messageName);
+    if (it == _entries.end()) {
+        return Counters();
+    }
+    return it->second.counters;
+}
+
+void CefViewMessageRegistry::resetCounters() {
+    for (auto& item : _entries) {
+        item.second.counters = Counters();
+    }
+    _unknownCount = 0;
+}
+
+}  // namespace cefview
@@ -0,0 +1,107 @@
+/**
+* @file        CefViewMessageRegistry.h
+* @brief       Name-keyed registry for dispatching CEF process messages
+* @version     1.0
+* @author      heefuture
+* @date        2026.10.18
+* @copyright
+*/
+#ifndef CEFVIEWMESSAGEREGISTRY_H
+#define CEFVIEWMESSAGEREGISTRY_H
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "include/cef_browser.h"
+#include "include/cef_frame.h"
+#include "include/cef_process_message.h"
+
+namespace cefview {
+
+/**
+ * @brief Dispatches process messages to handlers registered per message name.
+ *
+ * Dispatch is a single hash lookup on the message name. Handlers registered
+ * for the same name run in registration order until one returns true.
+ * Not thread-safe: register, dispatch and query on the thread that receives
+ * the messages (browser UI thread or renderer main thread).
+ */
+class CefViewMessageRegistry {
+public:
+    /// Returns true if the message was handled and should not be passed on.
+    using Handler = std::function<bool(CefRefPtr<CefBrowser> browser,
+                                       CefRefPtr<CefFrame> frame,
+                                       CefProcessId sourceProcess,
+                                       CefRefPtr<CefProcessMessage> message)>;
+
+    /// Per-name dispatch counters.
+    struct Counters {
+        uint64_t received = 0;  ///< Messages dispatched with this name
+        uint64_t handled = 0;   ///< Messages a handler returned true for
+    };
+
+    CefViewMessageRegistry() = default;
+    ~CefViewMessageRegistry() = default;
+
+    CefViewMessageRegistry(const CefViewMessageRegistry&) = delete;
+    CefViewMessageRegistry& operator=(const CefViewMessageRegistry&) = delete;
+
+    /**
+     * @brief Register a handler for a message name
+     * @param messageName Process message name
+     * @param handler Handler to append after already registered ones
+     */
+    void registerHandler(const std::string& messageName, Handler handler);
+
+    /**
+     * @brief Remove all handlers registered for a message name
+     * @param messageName Process message name
+     */
+    void unregisterHandlers(const std::string& messageName);
+
+    /**
+     * @brief Check whether any handler is registered for a message name
+     */
+    bool hasHandler(const std::string& messageName) const;
+
+    /**
+     * @brief Dispatch a message to the handlers registered for its name
+     * @return true if a handler handled the message
+     */
+    bool dispatch(CefRefPtr<CefBrowser> browser,
+                  CefRefPtr<CefFrame> frame,
+                  CefProcessId sourceProcess,
+                  CefRefPtr<CefProcessMessage> message);
+
+    /**
+     * @brief Get counters for a message name (zeros if never seen)
+     */
+    Counters getCounters(const std::string& messageName) const;
+
+    /**
+     * @brief Number of dispatched messages that had no registered handler
+     */
+    uint64_t getUnknownCount() const { return _unknownCount; }
+
+    /**
+     * @brief Reset all counters, keeping registered handlers
+     */
+    void resetCounters();
+
+private:
+    struct Entry {
+        std::vector<Handler> handlers;
+        Counters counters;
+    };
+
+    std::unordered_map<std::string, Entry> _entries;
+    uint64_t _unknownCount = 0;
+};
+
+}  // namespace cefview
+
+#endif  // CEFVIEWMESSAGEREGISTRY_H
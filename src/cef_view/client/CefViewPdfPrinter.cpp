@@ -0,0 +1,53 @@
+#include "CefViewPdfPrinter.h"
+
+#include <utility>
+
+#include "include/base/cef_bind.h"
+#include "include/base/cef_callback.h"
+#include "include/cef_task.h"
+#include "include/wrapper/cef_closure_task.h"
+
+#include "utils/LogUtil.h"
+
+namespace cefview {
+
+namespace {
+
+class PdfPrintCallbackAdapter : public CefPdfPrintCallback {
+public:
+    explicit PdfPrintCallbackAdapter(PdfPrintCallback callback) : _callback(std::move(callback)) {}
+
+    void OnPdfPrintFinished(const CefString& path, bool ok) override {
+        if (!ok) {
+            LOGE << "PrintToPDF FAILED for " << path.ToString();
+        }
+        if (_callback) {
+            _callback(ok, path.ToString());
+        }
+    }
+
+private:
+    PdfPrintCallback _callback;
+
+    IMPLEMENT_REFCOUNTING(PdfPrintCallbackAdapter);
+};
+
+}  // namespace
+
+void CefViewPdfPrinter::PrintToPdf(CefRefPtr<CefBrowser> browser,
+                                   const CefPdfPrintSettings& settings,
+                                   const std::string& path,
+                                   PdfPrintCallback callback) {
+    if (!browser) {
+        LOGE << "PrintToPDF without a browser: " << path;
+        if (callback) {
+            CefPostTask(TID_UI, base::BindOnce([](PdfPrintCallback callback, const std::string& path) {
+                    callback(false, path);
+                }, std::move(callback), path));
+        }
+        return;
+    }
+    browser->GetHost()->PrintToPDF(CefString(path), settings, new PdfPrintCallbackAdapter(std::move(callback)));
+}
+
+}  // namespace cefview
@@ -0,0 +1,51 @@
+/**
+* @file        CefViewPdfPrinter.h
+* @brief       Asynchronous PDF export of a browser's page
+* @version     1.0
+* @author      heefuture
+* @date        2026.10.18
+* @copyright
+*/
+#ifndef CEFVIEWPDFPRINTER_H
+#define CEFVIEWPDFPRINTER_H
+#pragma once
+
+#include <functional>
+#include <string>
+
+#include "include/cef_browser.h"
+
+namespace cefview {
+
+/**
+ * @brief Result of a PDF export: success and the file that was written
+ */
+using PdfPrintCallback = std::function<void(bool success, const std::string& path)>;
+
+/**
+ * @brief Wraps CefBrowserHost::PrintToPDF with a std::function callback
+ *
+ * Printing lays the page out for paper in the renderer and writes the file
+ * from the browser process; neither blocks the UI thread. Works for
+ * windowed and windowless browsers, including headless ones on Linux.
+ */
+class CefViewPdfPrinter {
+public:
+    /**
+     * @brief Print the browser's page to a PDF file
+     * The callback always runs on TID_UI and never from within this call,
+     * also when there is no browser to print.
+     * @param browser Browser to print; may be null, which fails the export
+     * @param settings Paper size, margins, scale, background, header/footer
+     * @param path File to write (replaced if it exists)
+     * @param callback Receives the outcome (may be empty)
+     */
+    static void PrintToPdf(CefRefPtr<CefBrowser> browser,
+                           const CefPdfPrintSettings& settings,
+                           const std::string& path,
+                           PdfPrintCallback callback);
+};
+
+}  // namespace cefview
+
+#endif  //!CEFVIEWPDFPRINTER_H
@@ -9,10 +9,10 @@
 
 #include <string>
 
-// On Windows, disable separate sub-process executable.
+// On Windows and Linux, disable separate sub-process executable.
 // The main process handles all CEF functionality in single-process mode.
 // On macOS, Helper app bundles handle sub-processes independently.
-#if defined(WIN32)
+#if defined(WIN32) || defined(__linux__)
 #define SUB_PROCESS_DISABLED
 #endif
 
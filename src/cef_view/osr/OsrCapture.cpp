@@ -0,0 +1,203 @@
+/**
+ * @file OsrCapture.cpp
+ * @brief Asynchronous screenshot and thumbnail implementation
+ *
+ * This file is part of CefView project.
+ * Licensed under BSD-style license.
+ */
+#include "OsrCapture.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "include/base/cef_bind.h"
+#include "include/base/cef_callback.h"
+#include "include/cef_task.h"
+#include "include/wrapper/cef_closure_task.h"
+
+#include "osr/OsrRenderer.h"
+#include "utils/PixelBufferPool.h"
+#include "utils/PixelKernels.h"
+
+namespace cefview {
+
+namespace {
+
+constexpr size_t kBytesPerPixel = 4;
+
+void PostResult(OsrCaptureCallback callback, OsrCaptureResult result) {
+    CefPostTask(TID_UI, base::BindOnce([](OsrCaptureCallback callback, const OsrCaptureResult& result) {
+            callback(result);
+        }, std::move(callback), std::move(result)));
+}
+
+void PostError(OsrCaptureCallback callback, ImageEncoder::Format format, const char* error) {
+    OsrCaptureResult result;
+    result.format = format;
+    result.error = error;
+    PostResult(std::move(callback), std::move(result));
+}
+
+}  // namespace
+
+void OsrCapture::CaptureAsync(OsrRenderer* renderer,
+                              const CefRect& rect,
+                              float scale,
+                              ImageEncoder::Format format,
+                              int quality,
+                              OsrCaptureCallback callback) {
+    if (!callback) {
+        return;
+    }
+
+    if (!renderer) {
+        PostError(std::move(callback), format, "no off-screen renderer");
+        return;
+    }
+
+    PixelBuffer frame;
+    int frameWidth = 0;
+    int frameHeight = 0;
+    if (!renderer->captureFrame(frame, frameWidth, frameHeight)) {
+        PostError(std::move(callback), format, "no frame to capture");
+        return;
+    }
+
+    CefRect region = rect.IsEmpty() ? CefRect(0, 0, frameWidth, frameHeight) : rect;
+    const int left = std::max(region.x, 0);
+    const int top = std::max(region.y, 0);
+    const int right = std::min(region.x + region.width, frameWidth);
+    const int bottom = std::min(region.y + region.height, frameHeight);
+    if (right <= left || bottom <= top) {
+        PostError(std::move(callback), format, "capture rect is outside the frame");
+        return;
+    }
+    region = CefRect(left, top, right - left, bottom - top);
+
+    // The frame buffer is shared, not copied: nothing writes to a captured buffer again
+    CefPostTask(TID_FILE_USER_VISIBLE, base::BindOnce([](PixelBuffer frame, int frameWidth, CefRect region, float scale,
+                                                         ImageEncoder::Format format, int quality,
+                                                         OsrCaptureCallback callback) {
+            const size_t stride = static_cast<size_t>(frameWidth) * kBytesPerPixel;
+            const uint8_t* origin = frame.data() + static_cast<size_t>(region.y) * stride +
+                                    static_cast<size_t>(region.x) * kBytesPerPixel;
+            OsrCaptureResult result;
+            OsrCapture::Encode(origin, stride, region.width, region.height, scale, format, quality, result);
+            frame.reset();
+            PostResult(std::move(callback), std::move(result));
+        }, std::move(frame), frameWidth, region, scale, format, quality, std::move(callback)));
+}
+
+bool OsrCapture::Encode(const uint8_t* pixels,
+                        size_t stride,
+                        int width,
+                        int height,
+                        float scale,
+                        ImageEncoder::Format format,
+                        int quality,
+                        OsrCaptureResult& result) {
+    result = OsrCaptureResult();
+    result.format = format;
+    if (!pixels || width <= 0 || height <= 0) {
+        result.error = "empty image";
+        return false;
+    }
+
+    scale = std::min(std::max(scale, 0.0f), 1.0f);
+    const int targetWidth = std::max(1, static_cast<int>(std::lround(static_cast<float>(width) * scale)));
+    const int targetHeight = std::max(1, static_cast<int>(std::lround(static_cast<float>(height) * scale)));
+
+    // Box-filter halvings while at least 2x too large; each pass reads the previous one
+    const uint8_t* current = pixels;
+    size_t currentStride = stride;
+    int currentWidth = width;
+    int currentHeight = height;
+    PixelBuffer halved;
+    while (currentWidth >= targetWidth * 2 && currentHeight >= targetHeight * 2) {
+        const int halfWidth = currentWidth / 2;
+        const int halfHeight = currentHeight / 2;
+        const size_t halfStride = static_cast<size_t>(halfWidth) * kBytesPerPixel;
+        PixelBuffer next = PixelBufferPool::Shared().acquire(halfStride * static_cast<size_t>(halfHeight));
+        if (!next) {
+            result.error = "out of memory";
+            return false;
+        }
+        PixelKernels::Downscale2x(current, currentStride, next.data(), halfStride, halfWidth, halfHeight);
+        halved = std::move(next);
+        current = halved.data();
+        currentStride = halfStride;
+        currentWidth = halfWidth;
+        currentHeight = halfHeight;
+    }
+
+    PixelBuffer resized;
+    if (currentWidth != targetWidth || currentHeight != targetHeight) {
+        const size_t targetStride = static_cast<size_t>(targetWidth) * kBytesPerPixel;
+        resized = PixelBufferPool::Shared().acquire(targetStride * static_cast<size_t>(targetHeight));
+        if (!resized) {
+            result.error = "out of memory";
+            return false;
+        }
+        ResizeBilinear(current, currentStride, currentWidth, currentHeight, resized.data(), targetWidth, targetHeight);
+        current = resized.data();
+        currentStride = targetStride;
+        currentWidth = targetWidth;
+        currentHeight = targetHeight;
+    }
+
+    if (!ImageEncoder::Encode(format, current, currentStride, currentWidth, currentHeight, result.data, quality)) {
+        result.error = "encoding failed";
+        return false;
+    }
+    result.success = true;
+    result.width = currentWidth;
+    result.height = currentHeight;
+    return true;
+}
+
+void OsrCapture::ResizeBilinear(const uint8_t* src,
+                                size_t srcStride,
+                                int srcWidth,
+                                int srcHeight,
+                                uint8_t* dst,
+                                int dstWidth,
+                                int dstHeight) {
+    // Pixel centers map to pixel centers; weights are 8-bit fixed point
+    auto sampleAxis = [](int dstIndex, int srcSize, int dstSize, int& index, uint32_t& weight) {
+        double position = (dstIndex + 0.5) * srcSize / dstSize - 0.5;
+        position = std::min(std::max(position, 0.0), static_cast<double>(srcSize - 1));
+        index = static_cast<int>(position);
+        weight = static_cast<uint32_t>(std::lround((position - index) * 256.0));
+    };
+
+    std::vector<int> columns(static_cast<size_t>(dstWidth));
+    std::vector<uint32_t> columnWeights(static_cast<size_t>(dstWidth));
+    for (int x = 0; x < dstWidth; ++x) {
+        sampleAxis(x, srcWidth, dstWidth, columns[static_cast<size_t>(x)], columnWeights[static_cast<size_t>(x)]);
+    }
+
+    for (int y = 0; y < dstHeight; ++y) {
+        int row = 0;
+        uint32_t fy = 0;
+        sampleAxis(y, srcHeight, dstHeight, row, fy);
+        const uint8_t* top = src + static_cast<size_t>(row) * srcStride;
+        const uint8_t* bottom = row + 1 < srcHeight ? top + srcStride : top;
+        uint8_t* out = dst + static_cast<size_t>(y) * static_cast<size_t>(dstWidth) * kBytesPerPixel;
+
+        for (int x = 0; x < dstWidth; ++x) {
+            const int column = columns[static_cast<size_t>(x)];
+            const uint32_t fx = columnWeights[static_cast<size_t>(x)];
+            const size_t left = static_cast<size_t>(column) * kBytesPerPixel;
+            const size_t right = column + 1 < srcWidth ? left + kBytesPerPixel : left;
+            for (size_t c = 0; c < kBytesPerPixel; ++c) {
+                const uint32_t upper = uint32_t{top[left + c]} * (256 - fx) + uint32_t{top[right + c]} * fx;
+                const uint32_t lower = uint32_t{bottom[left + c]} * (256 - fx) + uint32_t{bottom[right + c]} * fx;
+                out[c] = static_cast<uint8_t>((upper * (256 - fy) + lower * fy + 32768) >> 16);
+            }
+            out += kBytesPerPixel;
+        }
+    }
+}
+
+}  // namespace cefview
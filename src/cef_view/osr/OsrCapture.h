@@ -0,0 +1,111 @@
+/**
+ * @file OsrCapture.h
+ * @brief Asynchronous screenshots and thumbnails of an off-screen view
+ *
+ * This file is part of CefView project.
+ * Licensed under BSD-style license.
+ */
+#ifndef OSRCAPTURE_H
+#define OSRCAPTURE_H
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "include/cef_render_handler.h"
+
+#include "utils/ImageEncoder.h"
+
+namespace cefview {
+
+class OsrRenderer;
+
+/**
+ * @brief Encoded image delivered by OsrCapture
+ */
+struct OsrCaptureResult {
+    bool success = false;
+    std::string error;                              ///< Reason when success is false
+    ImageEncoder::Format format = ImageEncoder::Format::kPng;
+    int width = 0;                                  ///< Encoded image size in pixels
+    int height = 0;
+    std::vector<uint8_t> data;                      ///< Encoded file contents
+};
+
+using OsrCaptureCallback = std::function<void(const OsrCaptureResult& result)>;
+
+/**
+ * @brief Snapshots a renderer's view frame and encodes it off the UI thread
+ *
+ * Only the read-back of the current frame runs on the calling thread.
+ * Cropping, scaling and encoding run on CEF's TID_FILE_USER_VISIBLE
+ * thread, and the callback is posted back to TID_UI.
+ *
+ * Scaling halves the image with PixelKernels::Downscale2x while it is at
+ * least twice the target size, then finishes with a bilinear pass, so a
+ * thumbnail of a 4K frame costs a few SIMD passes rather than a full
+ * resolution filter.
+ */
+class OsrCapture {
+public:
+    /**
+     * @brief Capture a region of the renderer's current view frame
+     *
+     * The callback is always invoked, on TID_UI and never from within this
+     * call, including when the capture fails.
+     * @param renderer Renderer to read the frame from (call on its paint thread); may be null
+     *                 (windowed mode), which fails the capture
+     * @param rect Region in device pixels; empty captures the whole frame
+     * @param scale Output size relative to rect, in (0, 1]
+     * @param format Output image format
+     * @param quality JPEG quality, 1 to 100
+     * @param callback Receives the encoded image
+     */
+    static void CaptureAsync(OsrRenderer* renderer,
+                             const CefRect& rect,
+                             float scale,
+                             ImageEncoder::Format format,
+                             int quality,
+                             OsrCaptureCallback callback);
+
+    /**
+     * @brief Scale and encode a BGRA image synchronously (the worker half of CaptureAsync)
+     * @param pixels First pixel of the region, top-down BGRA
+     * @param stride Bytes per row
+     * @param width Region width in pixels
+     * @param height Region height in rows
+     * @param scale Output size relative to the region, in (0, 1]
+     * @param format Output image format
+     * @param quality JPEG quality, 1 to 100
+     * @param result Receives the encoded image or the error
+     * @return result.success
+     */
+    static bool Encode(const uint8_t* pixels,
+                       size_t stride,
+                       int width,
+                       int height,
+                       float scale,
+                       ImageEncoder::Format format,
+                       int quality,
+                       OsrCaptureResult& result);
+
+    /**
+     * @brief Resample a BGRA image with a bilinear filter
+     * Meant for the final step below 2x; larger reductions alias.
+     * @param dst Destination, dstWidth * 4 bytes per row
+     */
+    static void ResizeBilinear(const uint8_t* src,
+                               size_t srcStride,
+                               int srcWidth,
+                               int srcHeight,
+                               uint8_t* dst,
+                               int dstWidth,
+                               int dstHeight);
+};
+
+}  // namespace cefview
+
+#endif  // OSRCAPTURE_H
@@ -0,0 +1,327 @@
+/**
+ * @file OsrCompositorGL.cpp
+ * @brief Multi-view OpenGL compositor implementation
+ *
+ * This file is part of CefView project.
+ * Licensed under BSD-style license.
+ */
+#include "OsrCompositorGL.h"
+
+#include <algorithm>
+
+#include "include/base/cef_callback.h"
+#include "include/cef_task.h"
+#include "include/wrapper/cef_closure_task.h"
+
+#include "OsrGLDevice.h"
+#include "OsrGLFunctions.h"
+
+#include "utils/LogUtil.h"
+
+namespace cefview {
+
+namespace {
+
+CefRect IntersectRect(const CefRect& a, const CefRect& b) {
+    int left = std::max(a.x, b.x);
+    int top = std::max(a.y, b.y);
+    int right = std::min(a.x + a.width, b.x + b.width);
+    int bottom = std::min(a.y + a.height, b.y + b.height);
+    if (right <= left || bottom <= top) {
+        return CefRect();
+    }
+    return CefRect(left, top, right - left, bottom - top);
+}
+
+}  // namespace
+
+OsrCompositorGL::OsrCompositorGL(OsrRendererGL::NativeWindowHandle hwnd, int width, int height, bool transparent)
+    :
+#if defined(WIN32)
+      _hwnd(hwnd),
+#endif
+      _width(width),
+      _height(height),
+      _transparent(transparent) {
+}
+
+OsrCompositorGL::~OsrCompositorGL() {
+    uninitialize();
+}
+
+bool OsrCompositorGL::initialize() {
+    if (_initialized) {
+        return true;
+    }
+
+    _device = OsrGLDevice::Acquire();
+    if (!_device) {
+        LOGE << "OsrCompositorGL: OsrGLDevice::Acquire() FAILED";
+        return false;
+    }
+
+    if (!createGLContext()) {
+        LOGE << "OsrCompositorGL: createGLContext() FAILED";
+        _device.reset();
+        return false;
+    }
+
+    makeCurrent();
+    glGenVertexArrays(1, &_vao);
+    _initialized = true;
+    LOGI << "OsrCompositorGL initialized " << _width << "x" << _height;
+    return true;
+}
+
+void OsrCompositorGL::uninitialize() {
+    detachAll();
+    if (!_initialized) {
+        return;
+    }
+
+    makeCurrent();
+    if (_vao != 0) {
+        glDeleteVertexArrays(1, &_vao);
+        _vao = 0;
+    }
+    destroyGLContext();
+    _device.reset();
+    _initialized = false;
+}
+
+void OsrCompositorGL::setBounds(int width, int height) {
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+    _width = width;
+    _height = height;
+    invalidate();
+}
+
+bool OsrCompositorGL::addLayer(OsrRendererGL* renderer, const CefRect& bounds, int zOrder) {
+    if (!_initialized || !renderer || !renderer->_initialized) {
+        LOGE << "OsrCompositorGL::addLayer() needs an initialized compositor and renderer";
+        return false;
+    }
+    if (renderer->isRenderThreadEnabled()) {
+        LOGE << "OsrCompositorGL::addLayer() renderer uses a render thread";
+        return false;
+    }
+    if (findLayer(renderer)) {
+        setLayerBounds(renderer, bounds);
+        setLayerZOrder(renderer, zOrder);
+        return true;
+    }
+    if (auto other = renderer->_compositor.lock()) {
+        other->removeLayer(renderer);
+    }
+
+    Layer layer;
+    layer.renderer = renderer;
+    layer.bounds = bounds;
+    layer.zOrder = zOrder;
+    _layers.push_back(layer);
+    sortLayers();
+
+    renderer->_compositor = weak_from_this();
+    invalidate();
+    return true;
+}
+
+void OsrCompositorGL::removeLayer(OsrRendererGL* renderer) {
+    auto it = std::find_if(_layers.begin(), _layers.end(),
+                           [renderer](const Layer& layer) { return layer.renderer == renderer; });
+    if (it == _layers.end()) {
+        return;
+    }
+    _layers.erase(it);
+    renderer->_compositor.reset();
+    invalidate();
+}
+
+void OsrCompositorGL::setLayerBounds(OsrRendererGL* renderer, const CefRect& bounds) {
+    if (Layer* layer = findLayer(renderer)) {
+        layer->bounds = bounds;
+        invalidate();
+    }
+}
+
+void OsrCompositorGL::setLayerZOrder(OsrRendererGL* renderer, int zOrder) {
+    if (Layer* layer = findLayer(renderer)) {
+        if (layer->zOrder != zOrder) {
+            layer->zOrder = zOrder;
+            sortLayers();
+            invalidate();
+        }
+    }
+}
+
+void OsrCompositorGL::setLayerClip(OsrRendererGL* renderer, const CefRect& clip) {
+    if (Layer* layer = findLayer(renderer)) {
+        layer->clip = clip;
+        invalidate();
+    }
+}
+
+void OsrCompositorGL::setLayerOpacity(OsrRendererGL* renderer, float opacity) {
+    if (Layer* layer = findLayer(renderer)) {
+        layer->opacity = std::min(std::max(opacity, 0.0f), 1.0f);
+        invalidate();
+    }
+}
+
+void OsrCompositorGL::setLayerVisible(OsrRendererGL* renderer, bool visible) {
+    if (Layer* layer = findLayer(renderer)) {
+        layer->visible = visible;
+        invalidate();
+    }
+}
+
+void OsrCompositorGL::invalidate() {
+    ++_invalidateCount;
+    if (!_initialized || _presentPosted) {
+        return;
+    }
+
+    std::weak_ptr<OsrCompositorGL> weakSelf = weak_from_this();
+    if (weakSelf.expired()) {
+        // Not owned by a shared_ptr: a posted task could outlive us, present now
+        present();
+        return;
+    }
+
+    // Paints that arrive in the same burst of UI tasks share this present
+    _presentPosted = true;
+    CefPostTask(TID_UI, base::BindOnce([](std::weak_ptr<OsrCompositorGL> weakSelf) {
+            if (auto self = weakSelf.lock()) {
+                self->_presentPosted = false;
+                self->present();
+            }
+        }, weakSelf));
+}
+
+void OsrCompositorGL::present() {
+    if (!_initialized || _width <= 0 || _height <= 0) {
+        return;
+    }
+
+    auto presentStart = OsrRenderStatsCollector::Clock::now();
+    makeCurrent();
+
+    glViewport(0, 0, _width, _height);
+    glClearColor(0.0f, 0.0f, 0.0f, _transparent ? 0.0f : 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    // Layers overlap, so always blend (CEF pixels are premultiplied)
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    glEnable(GL_SCISSOR_TEST);
+    glActiveTexture(GL_TEXTURE0);
+    glUseProgram(_device->program());
+    glBindVertexArray(_vao);
+
+    const CefRect target(0, 0, _width, _height);
+    for (const auto& layer : _layers) {
+        if (!layer.visible || layer.opacity <= 0.0f || layer.bounds.IsEmpty()) {
+            continue;
+        }
+        CefRect area = IntersectRect(layer.bounds, target);
+        if (!layer.clip.IsEmpty()) {
+            area = IntersectRect(area, layer.clip);
+        }
+        if (area.IsEmpty()) {
+            continue;
+        }
+
+        layer.renderer->waitUploadFence();
+        // Scissor origin is bottom-left
+        glScissor(area.x, _height - area.y - area.height, area.width, area.height);
+        glVertexAttrib4f(OsrGLDevice::kOpacityAttribute, 0.0f, 0.0f, 0.0f, layer.opacity);
+        layer.renderer->drawComposited(layer.bounds, _width, _height);
+    }
+
+    glVertexAttrib4f(OsrGLDevice::kOpacityAttribute, 0.0f, 0.0f, 0.0f, 1.0f);
+    glDisable(GL_SCISSOR_TEST);
+    glDisable(GL_BLEND);
+
+    swapBuffers();
+    ++_presentCount;
+
+    const double presentMs = OsrRenderStatsCollector::ElapsedMs(presentStart);
+    for (const auto& layer : _layers) {
+        layer.renderer->renderStats().recordPresent(presentMs);
+    }
+}
+
+OsrCompositorGL::Layer* OsrCompositorGL::findLayer(OsrRendererGL* renderer) {
+    for (auto& layer : _layers) {
+        if (layer.renderer == renderer) {
+            return &layer;
+        }
+    }
+    return nullptr;
+}
+
+void OsrCompositorGL::sortLayers() {
+    std::stable_sort(_layers.begin(), _layers.end(),
+                     [](const Layer& a, const Layer& b) { return a.zOrder < b.zOrder; });
+}
+
+void OsrCompositorGL::detachAll() {
+    for (auto& layer : _layers) {
+        layer.renderer->_compositor.reset();
+    }
+    _layers.clear();
+}
+
+bool OsrCompositorGL::createGLContext() {
+#if defined(WIN32)
+    _hdc = GetDC(_hwnd);
+    if (!_hdc) {
+        LOGE << "GetDC() FAILED";
+        return false;
+    }
+    _hglrc = _device->createContext(_hdc);
+    if (!_hglrc) {
+        ReleaseDC(_hwnd, _hdc);
+        _hdc = nullptr;
+        return false;
+    }
+    return true;
+#else
+    // Window contexts are only implemented for WGL
+    return false;
+#endif
+}
+
+void OsrCompositorGL::destroyGLContext() {
+#if defined(WIN32)
+    if (_hglrc) {
+        wglMakeCurrent(nullptr, nullptr);
+        wglDeleteContext(_hglrc);
+        _hglrc = nullptr;
+    }
+    if (_hdc) {
+        ReleaseDC(_hwnd, _hdc);
+        _hdc = nullptr;
+    }
+#endif
+}
+
+void OsrCompositorGL::makeCurrent() {
+#if defined(WIN32)
+    if (_hdc && _hglrc) {
+        wglMakeCurrent(_hdc, _hglrc);
+    }
+#endif
+}
+
+void OsrCompositorGL::swapBuffers() {
+#if defined(WIN32)
+    if (_hdc) {
+        SwapBuffers(_hdc);
+    }
+#endif
+}
+
+}  // namespace cefview
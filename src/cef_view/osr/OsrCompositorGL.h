@@ -0,0 +1,150 @@
+/**
+ * @file OsrCompositorGL.h
+ * @brief Presents several OpenGL off-screen views in one window with one swap
+ *
+ * This file is part of CefView project.
+ * Licensed under BSD-style license.
+ */
+#ifndef OSRCOMPOSITORGL_H
+#define OSRCOMPOSITORGL_H
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "include/cef_render_handler.h"
+
+#include "OsrRendererGL.h"
+
+namespace cefview {
+
+class OsrGLDevice;
+
+/**
+ * @brief Draws the textures of several OsrRendererGL views into one window
+ *
+ * Attached renderers keep receiving paints and uploading into their own
+ * textures, but stop presenting: their render() marks the compositor dirty
+ * instead. The compositor then draws every visible layer in z order, with
+ * its clip rect and opacity, and swaps once. Paints from several views that
+ * arrive in the same task burst therefore share a single present.
+ *
+ * Layer textures are shared through OsrGLDevice's share group; each
+ * renderer fences its uploads so the compositor context sees complete
+ * texture data.
+ *
+ * Use from the UI thread. Renderers with the render thread enabled cannot be
+ * attached. Create with std::make_shared (presents are posted with a weak
+ * reference).
+ */
+class OsrCompositorGL : public std::enable_shared_from_this<OsrCompositorGL> {
+public:
+    /**
+     * @brief Constructor
+     * @param hwnd Window presented into
+     * @param width Window client width in pixels
+     * @param height Window client height in pixels
+     * @param transparent Clear to transparent instead of opaque black
+     */
+    OsrCompositorGL(OsrRendererGL::NativeWindowHandle hwnd, int width, int height, bool transparent = false);
+    ~OsrCompositorGL();
+
+    // Disable copy and move
+    OsrCompositorGL(const OsrCompositorGL&) = delete;
+    OsrCompositorGL& operator=(const OsrCompositorGL&) = delete;
+    OsrCompositorGL(OsrCompositorGL&&) = delete;
+    OsrCompositorGL& operator=(OsrCompositorGL&&) = delete;
+
+    bool initialize();
+    void uninitialize();
+
+    /**
+     * @brief Update the window client size
+     */
+    void setBounds(int width, int height);
+
+    /**
+     * @brief Attach an initialized renderer as a layer
+     * @param renderer Renderer to composite; stops presenting to its own window
+     * @param bounds Layer rect in window pixels (the view is scaled to fit)
+     * @param zOrder Higher values are drawn on top; ties keep insertion order
+     * @return false if the renderer cannot be composited
+     */
+    bool addLayer(OsrRendererGL* renderer, const CefRect& bounds, int zOrder = 0);
+
+    /**
+     * @brief Detach a renderer; it presents to its own window again
+     */
+    void removeLayer(OsrRendererGL* renderer);
+
+    void setLayerBounds(OsrRendererGL* renderer, const CefRect& bounds);
+    void setLayerZOrder(OsrRendererGL* renderer, int zOrder);
+
+    /**
+     * @brief Restrict drawing of a layer to a rect in window pixels (empty rect: no clip)
+     */
+    void setLayerClip(OsrRendererGL* renderer, const CefRect& clip);
+
+    /**
+     * @brief Layer opacity, 0 (hidden) to 1 (opaque)
+     */
+    void setLayerOpacity(OsrRendererGL* renderer, float opacity);
+    void setLayerVisible(OsrRendererGL* renderer, bool visible);
+
+    size_t layerCount() const { return _layers.size(); }
+
+    /**
+     * @brief Request a present; requests before the posted present runs are merged
+     */
+    void invalidate();
+
+    /**
+     * @brief Draw all layers and swap now
+     */
+    void present();
+
+    // Statistics
+    uint64_t presentCount() const { return _presentCount; }
+    uint64_t invalidateCount() const { return _invalidateCount; }
+
+private:
+    struct Layer {
+        OsrRendererGL* renderer = nullptr;
+        CefRect bounds;
+        CefRect clip;
+        int zOrder = 0;
+        float opacity = 1.0f;
+        bool visible = true;
+    };
+
+    Layer* findLayer(OsrRendererGL* renderer);
+    void sortLayers();
+    void detachAll();
+
+    bool createGLContext();
+    void destroyGLContext();
+    void makeCurrent();
+    void swapBuffers();
+
+#if defined(WIN32)
+    HWND _hwnd = nullptr;
+    HDC _hdc = nullptr;
+    HGLRC _hglrc = nullptr;
+#endif
+
+    std::shared_ptr<OsrGLDevice> _device;
+    unsigned int _vao = 0;
+    int _width = 0;
+    int _height = 0;
+    bool _transparent = false;
+    bool _initialized = false;
+
+    std::vector<Layer> _layers;  ///< Sorted by zOrder, bottom first
+    bool _presentPosted = false;
+    uint64_t _presentCount = 0;
+    uint64_t _invalidateCount = 0;
+};
+
+}  // namespace cefview
+
+#endif  // OSRCOMPOSITORGL_H
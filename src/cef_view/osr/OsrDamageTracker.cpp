@@ -0,0 +1,133 @@
+/**
+ * @file OsrDamageTracker.cpp
+ * @brief Dirty-rect coalescing implementation
+ *
+ * This file is part of CefView project.
+ * Licensed under BSD-style license.
+ */
+#include "OsrDamageTracker.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace cefview {
+
+namespace {
+
+CefRect unionRect(const CefRect& a, const CefRect& b) {
+    int left = std::min(a.x, b.x);
+    int top = std::min(a.y, b.y);
+    int right = std::max(a.x + a.width, b.x + b.width);
+    int bottom = std::max(a.y + a.height, b.y + b.height);
+    return CefRect(left, top, right - left, bottom - top);
+}
+
+int64_t area(const CefRect& rect) {
+    return static_cast<int64_t>(rect.width) * static_cast<int64_t>(rect.height);
+}
+
+}  // namespace
+
+int64_t OsrDamageTracker::cost(const CefRect& rect) const {
+    return area(rect) + _config.perRectCost;
+}
+
+bool OsrDamageTracker::isNear(const CefRect& a, const CefRect& b) const {
+    // Gap along each axis; negative when the rects overlap on that axis
+    int gapX = std::max(a.x, b.x) - std::min(a.x + a.width, b.x + b.width);
+    int gapY = std::max(a.y, b.y) - std::min(a.y + a.height, b.y + b.height);
+    return gapX <= _config.mergeDistance && gapY <= _config.mergeDistance;
+}
+
+void OsrDamageTracker::mergeNearby() {
+    bool merged = true;
+    while (merged) {
+        merged = false;
+        for (size_t i = 0; i < _rects.size() && !merged; ++i) {
+            for (size_t j = i + 1; j < _rects.size(); ++j) {
+                if (!isNear(_rects[i], _rects[j])) {
+                    continue;
+                }
+                CefRect u = unionRect(_rects[i], _rects[j]);
+                if (cost(u) <= cost(_rects[i]) + cost(_rects[j])) {
+                    _rects[i] = u;
+                    _rects.erase(_rects.begin() + static_cast<std::ptrdiff_t>(j));
+                    merged = true;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+void OsrDamageTracker::enforceMaxRects() {
+    const size_t maxRects = std::max<size_t>(_config.maxRects, 1);
+    while (_rects.size() > maxRects) {
+        // Merge the pair whose union adds the least extra cost
+        size_t bestI = 0;
+        size_t bestJ = 1;
+        int64_t bestDelta = std::numeric_limits<int64_t>::max();
+        for (size_t i = 0; i < _rects.size(); ++i) {
+            for (size_t j = i + 1; j < _rects.size(); ++j) {
+                int64_t delta = cost(unionRect(_rects[i], _rects[j])) - cost(_rects[i]) - cost(_rects[j]);
+                if (delta < bestDelta) {
+                    bestDelta = delta;
+                    bestI = i;
+                    bestJ = j;
+                }
+            }
+        }
+        _rects[bestI] = unionRect(_rects[bestI], _rects[bestJ]);
+        _rects.erase(_rects.begin() + static_cast<std::ptrdiff_t>(bestJ));
+    }
+}
+
+const CefRenderHandler::RectList& OsrDamageTracker::coalesce(const CefRenderHandler::RectList& dirtyRects,
+                                                            int width,
+                                                            int height) {
+    _rects.clear();
+    _fullUpload = false;
+    _totalInputRects += dirtyRects.size();
+
+    if (width <= 0 || height <= 0) {
+        return _rects;
+    }
+
+    // Clip to the buffer and drop empty rects
+    for (const auto& rect : dirtyRects) {
+        int left = std::max(rect.x, 0);
+        int top = std::max(rect.y, 0);
+        int right = std::min(rect.x + rect.width, width);
+        int bottom = std::min(rect.y + rect.height, height);
+        if (right > left && bottom > top) {
+            _rects.emplace_back(left, top, right - left, bottom - top);
+        }
+    }
+
+    if (_rects.size() > 1) {
+        mergeNearby();
+        enforceMaxRects();
+    }
+
+    // Fall back to one full upload when the merged damage covers most of the buffer
+    const CefRect full(0, 0, width, height);
+    int64_t damageCost = 0;
+    for (const auto& rect : _rects) {
+        damageCost += cost(rect);
+    }
+    const double fullCost = static_cast<double>(area(full)) * static_cast<double>(_config.fullUploadRatio) +
+                            static_cast<double>(_config.perRectCost);
+    if (!_rects.empty() && static_cast<double>(damageCost) >= fullCost) {
+        _rects.assign(1, full);
+    }
+
+    // Clipped rects lie inside the buffer, so equal area means the full buffer
+    _fullUpload = _rects.size() == 1 && area(_rects[0]) == area(full);
+    if (_fullUpload) {
+        ++_totalFullUploads;
+    }
+    _totalOutputRects += _rects.size();
+    return _rects;
+}
+
+}  // namespace cefview
@@ -0,0 +1,79 @@
+/**
+ * @file OsrDamageTracker.h
+ * @brief Dirty-rect coalescing for off-screen paint uploads
+ *
+ * This file is part of CefView project.
+ * Licensed under BSD-style license.
+ */
+#ifndef OSRDAMAGETRACKER_H
+#define OSRDAMAGETRACKER_H
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "include/cef_render_handler.h"
+
+namespace cefview {
+
+/**
+ * @brief Merges fragmented dirty rects into a short upload list
+ *
+ * Each upload is modelled as a fixed per-call overhead plus its pixel area.
+ * Two rects closer than mergeDistance are merged when uploading their union
+ * costs no more than uploading both. If the merged damage still covers most
+ * of the buffer, a single full-buffer rect is produced instead.
+ */
+class OsrDamageTracker {
+public:
+    struct Config {
+        int mergeDistance = 32;          ///< Max gap in pixels between rects considered for merging
+        int64_t perRectCost = 8192;      ///< Fixed cost of one upload call, in pixels
+        size_t maxRects = 16;            ///< Upper bound on the number of output rects
+        float fullUploadRatio = 0.7f;    ///< Upload the full buffer once damage reaches this fraction
+    };
+
+    OsrDamageTracker() = default;
+    explicit OsrDamageTracker(const Config& config) : _config(config) {}
+
+    /**
+     * @brief Coalesce dirty rects of a width x height buffer
+     * @param dirtyRects Dirty rects as reported by CEF
+     * @param width Buffer width
+     * @param height Buffer height
+     * @return Clipped, merged rects; valid until the next call
+     */
+    const CefRenderHandler::RectList& coalesce(const CefRenderHandler::RectList& dirtyRects,
+                                               int width,
+                                               int height);
+
+    /**
+     * @brief Whether the last coalesce() collapsed to a single full-buffer upload
+     */
+    bool isFullUpload() const { return _fullUpload; }
+
+    void setConfig(const Config& config) { _config = config; }
+    const Config& config() const { return _config; }
+
+    // Totals since construction, for diagnostics
+    uint64_t totalInputRects() const { return _totalInputRects; }
+    uint64_t totalOutputRects() const { return _totalOutputRects; }
+    uint64_t totalFullUploads() const { return _totalFullUploads; }
+
+private:
+    int64_t cost(const CefRect& rect) const;
+    bool isNear(const CefRect& a, const CefRect& b) const;
+    void mergeNearby();
+    void enforceMaxRects();
+
+    Config _config{};
+    CefRenderHandler::RectList _rects{};
+    bool _fullUpload = false;
+    uint64_t _totalInputRects = 0;
+    uint64_t _totalOutputRects = 0;
+    uint64_t _totalFullUploads = 0;
+};
+
+}  // namespace cefview
+
+#endif  // OSRDAMAGETRACKER_H
@@ -0,0 +1,88 @@
+/**
+ * @file OsrFrameRateController.cpp
+ * @brief Adaptive windowless frame rate implementation
+ *
+ * This file is part of CefView project.
+ * Licensed under BSD-style license.
+ */
+#include "OsrFrameRateController.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace cefview {
+
+namespace {
+
+// Paints dirtying less of the view than this are not counted as activity
+constexpr double kMinorDirtyFraction = 0.01;
+// Observed paint rate, relative to the current rate, that counts as animating
+constexpr double kRaiseRatio = 0.75;
+// Observed paint rate, relative to the current rate, below which the rate decays
+constexpr double kDecayRatio = 0.4;
+
+}  // namespace
+
+void OsrFrameRateController::setRange(int floorRate, int ceilingRate) {
+    _ceiling = std::max(ceilingRate, 1);
+    _floor = std::min(std::max(floorRate, 1), _ceiling);
+    _rate = _ceiling;
+}
+
+bool OsrFrameRateController::onPaint(TimePoint now, double dirtyFraction) {
+    if (_windowPaints == 0 && now - _windowStart > kUpdateInterval * 4) {
+        // First activity after an idle gap: start a fresh window
+        _windowStart = now;
+    }
+    if (dirtyFraction >= kMinorDirtyFraction) {
+        ++_windowPaints;
+    }
+    // At the floor nobody drives update(), so paints do
+    return now - _windowStart >= kUpdateInterval ? update(now) : false;
+}
+
+bool OsrFrameRateController::onInput(TimePoint now) {
+    _lastInput = now;
+    _decayHoldStart = now;
+    return setRate(_ceiling, now);
+}
+
+bool OsrFrameRateController::update(TimePoint now) {
+    const Duration elapsed = now - _windowStart;
+    if (elapsed < kUpdateInterval / 2) {
+        return false;
+    }
+    const double observed = _windowPaints / std::chrono::duration<double>(elapsed).count();
+    _windowStart = now;
+    _windowPaints = 0;
+
+    if (now - _lastInput < kInputHold) {
+        return setRate(_ceiling, now);
+    }
+    if (observed >= _rate * kRaiseRatio) {
+        _decayHoldStart = now;
+        return setRate(std::min(_rate * 2, _ceiling), now);
+    }
+    if (observed < _rate * kDecayRatio && now - _decayHoldStart >= kDecayDelay) {
+        // Halve at most, but never below what the content still paints at
+        const int target = std::max(static_cast<int>(std::ceil(observed * 2.0)), _rate / 2);
+        return setRate(std::max(target, _floor), now);
+    }
+    return false;
+}
+
+bool OsrFrameRateController::setRate(int rate, TimePoint now) {
+    rate = std::min(std::max(rate, _floor), _ceiling);
+    if (rate == _rate) {
+        return false;
+    }
+    if (rate < _rate) {
+        // Space out further decay steps as well
+        _decayHoldStart = now;
+    }
+    _rate = rate;
+    ++_rateChanges;
+    return true;
+}
+
+}  // namespace cefview
@@ -0,0 +1,108 @@
+/**
+ * @file OsrFrameRateController.h
+ * @brief Adaptive windowless frame rate for off-screen views
+ *
+ * This file is part of CefView project.
+ * Licensed under BSD-style license.
+ */
+#ifndef OSRFRAMERATECONTROLLER_H
+#define OSRFRAMERATECONTROLLER_H
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace cefview {
+
+/**
+ * @brief Picks the CEF windowless frame rate from recent content activity
+ *
+ * CEF never paints faster than the windowless frame rate, so a view painting
+ * close to that rate is treated as animating and the rate is doubled (up to
+ * the ceiling). A view painting well below it, or not at all, has its rate
+ * halved at most once per decay delay (down to the floor). User input jumps
+ * straight to the ceiling and holds it briefly, so interaction never waits
+ * for the rate to climb. Paints that only touch a sliver of the view (caret
+ * blink, small spinners) do not count as activity.
+ *
+ * Like OsrFrameScheduler this class only decides; OsrViewScheduler feeds it,
+ * drives update() from the view's timer while frameRate() is above the floor,
+ * and has the view apply the rate with CefBrowserHost::SetWindowlessFrameRate.
+ * Not thread-safe: use from the thread that receives paint callbacks.
+ */
+class OsrFrameRateController {
+public:
+    using Clock = std::chrono::steady_clock;
+    using TimePoint = Clock::time_point;
+    using Duration = Clock::duration;
+
+    /// Sampling window for the observed paint rate
+    static constexpr std::chrono::milliseconds kUpdateInterval{250};
+    /// How long input keeps the ceiling rate
+    static constexpr std::chrono::milliseconds kInputHold{500};
+    /// Minimum time between raising the rate and lowering it again
+    static constexpr std::chrono::milliseconds kDecayDelay{1000};
+
+    OsrFrameRateController() = default;
+
+    /**
+     * @brief Set the allowed range and restart at the ceiling (CEF's initial rate)
+     * @param floorRate Idle frame rate (at least 1)
+     * @param ceilingRate Frame rate used while animating or interacting
+     */
+    void setRange(int floorRate, int ceilingRate);
+
+    int floorRate() const { return _floor; }
+    int ceilingRate() const { return _ceiling; }
+
+    /**
+     * @brief Frame rate to pass to SetWindowlessFrameRate
+     */
+    int frameRate() const { return _rate; }
+
+    /**
+     * @brief Whether the rate has settled at the floor (no update timer needed)
+     */
+    bool isIdle() const { return _rate <= _floor; }
+
+    /**
+     * @brief Record a view paint
+     * @param now Current time
+     * @param dirtyFraction Dirty area divided by view area (0..1)
+     * @return true if frameRate() changed
+     */
+    bool onPaint(TimePoint now, double dirtyFraction);
+
+    /**
+     * @brief Record user input (mouse, key, touch)
+     * @return true if frameRate() changed
+     */
+    bool onInput(TimePoint now);
+
+    /**
+     * @brief Re-evaluate the rate; call every kUpdateInterval while not idle
+     * @return true if frameRate() changed
+     */
+    bool update(TimePoint now);
+
+    // Statistics
+    uint64_t rateChanges() const { return _rateChanges; }
+
+private:
+    bool setRate(int rate, TimePoint now);
+
+    int _floor = 10;
+    int _ceiling = 60;
+    int _rate = 60;
+
+    TimePoint _windowStart{};
+    uint32_t _windowPaints = 0;
+    TimePoint _lastInput{};
+    TimePoint _decayHoldStart{};  ///< The rate does not decay until kDecayDelay after this
+
+    uint64_t _rateChanges = 0;
+};
+
+}  // namespace cefview
+
+#endif  // OSRFRAMERATECONTROLLER_H
@@ -0,0 +1,285 @@
+/**
+ * @file OsrFrameRecorder.cpp
+ * @brief Flight recorder implementation
+ *
+ * This file is part of CefView project.
+ * Licensed under BSD-style license.
+ */
+#include "OsrFrameRecorder.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <utility>
+
+#include "include/base/cef_bind.h"
+#include "include/base/cef_callback.h"
+#include "include/cef_task.h"
+#include "include/wrapper/cef_closure_task.h"
+
+#include "utils/LogUtil.h"
+#include "utils/PixelKernels.h"
+
+namespace cefview {
+
+namespace {
+
+constexpr size_t kBytesPerPixel = 4;
+
+}  // namespace
+
+OsrFrameRecorder::OsrFrameRecorder(double maxSeconds, size_t maxBytes)
+    : _maxSeconds(maxSeconds)
+    , _maxBytes(maxBytes)
+    , _deltas()
+    , _base()
+    , _baseTime() {
+}
+
+void OsrFrameRecorder::record(const CefRenderHandler::RectList& dirtyRects,
+                              const void* buffer,
+                              int width,
+                              int height) {
+    if (!buffer || width <= 0 || height <= 0) {
+        return;
+    }
+
+    Delta delta;
+    delta.time = Clock::now();
+    delta.width = width;
+    delta.height = height;
+    // A new size needs a whole frame to start from
+    delta.full = width != _lastWidth || height != _lastHeight;
+    if (delta.full) {
+        delta.rects.emplace_back(0, 0, width, height);
+    } else {
+        for (const auto& rect : dirtyRects) {
+            const int left = std::max(rect.x, 0);
+            const int top = std::max(rect.y, 0);
+            const int right = std::min(rect.x + rect.width, width);
+            const int bottom = std::min(rect.y + rect.height, height);
+            if (right > left && bottom > top) {
+                delta.rects.emplace_back(left, top, right - left, bottom - top);
+            }
+        }
+        if (delta.rects.empty()) {
+            return;
+        }
+        const CefRect& first = delta.rects.front();
+        delta.full = delta.rects.size() == 1 && first.width == width && first.height == height;
+    }
+
+    size_t bytes = 0;
+    for (const auto& rect : delta.rects) {
+        bytes += static_cast<size_t>(rect.width) * static_cast<size_t>(rect.height) * kBytesPerPixel;
+    }
+    delta.pixels = PixelBufferPool::Shared().acquire(bytes);
+    if (!delta.pixels) {
+        // Leave a gap; the next paint starts again from a whole frame
+        LOGE << "Frame recorder failed to allocate " << bytes << " bytes, paint dropped";
+        _lastWidth = 0;
+        _lastHeight = 0;
+        return;
+    }
+
+    const size_t srcPitch = static_cast<size_t>(width) * kBytesPerPixel;
+    const uint8_t* src = static_cast<const uint8_t*>(buffer);
+    uint8_t* dst = delta.pixels.data();
+    for (const auto& rect : delta.rects) {
+        const size_t dstPitch = static_cast<size_t>(rect.width) * kBytesPerPixel;
+        PixelKernels::CopyRect(src + static_cast<size_t>(rect.y) * srcPitch + static_cast<size_t>(rect.x) * kBytesPerPixel,
+                               srcPitch, dst, dstPitch, rect.width, rect.height);
+        dst += dstPitch * static_cast<size_t>(rect.height);
+    }
+
+    _lastWidth = width;
+    _lastHeight = height;
+    _deltaBytes += bytes;
+    _deltas.push_back(std::move(delta));
+    evict(_deltas.back().time);
+}
+
+void OsrFrameRecorder::clear() {
+    _deltas.clear();
+    _deltaBytes = 0;
+    _base.reset();
+    _baseWidth = 0;
+    _baseHeight = 0;
+    _lastWidth = 0;
+    _lastHeight = 0;
+}
+
+void OsrFrameRecorder::evict(Clock::time_point now) {
+    const auto window = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(_maxSeconds));
+    while (!_deltas.empty() && (_deltaBytes > _maxBytes || now - _deltas.front().time > window)) {
+        const Delta& oldest = _deltas.front();
+        Apply(oldest, _base, _baseWidth, _baseHeight);
+        _baseTime = oldest.time;
+        _deltaBytes -= oldest.pixels.size();
+        _deltas.pop_front();
+    }
+}
+
+void OsrFrameRecorder::Apply(const Delta& delta, PixelBuffer& frame, int& width, int& height) {
+    if (delta.full) {
+        frame = delta.pixels;
+        width = delta.width;
+        height = delta.height;
+        return;
+    }
+    if (frame.empty() || width != delta.width || height != delta.height) {
+        // Partial deltas only follow a full one of the same size
+        return;
+    }
+
+    const size_t pitch = static_cast<size_t>(width) * kBytesPerPixel;
+    if (frame.useCount() > 1) {
+        PixelBuffer copy = PixelBufferPool::Shared().acquire(frame.size());
+        if (!copy) {
+            // Without a frame, later partial deltas are skipped until the next full one
+            frame.reset();
+            return;
+        }
+        memcpy(copy.data(), frame.data(), frame.size());
+        frame = std::move(copy);
+    }
+    const uint8_t* src = delta.pixels.data();
+    for (const auto& rect : delta.rects) {
+        const size_t srcPitch = static_cast<size_t>(rect.width) * kBytesPerPixel;
+        PixelKernels::CopyRect(src, srcPitch,
+                               frame.data() + static_cast<size_t>(rect.y) * pitch + static_cast<size_t>(rect.x) * kBytesPerPixel,
+                               pitch, rect.width, rect.height);
+        src += srcPitch * static_cast<size_t>(rect.height);
+    }
+}
+
+OsrFrameRecorder::Snapshot OsrFrameRecorder::snapshot() const {
+    Snapshot snapshot;
+    snapshot.base = _base;
+    snapshot.baseWidth = _baseWidth;
+    snapshot.baseHeight = _baseHeight;
+    snapshot.baseTime = _baseTime;
+    snapshot.deltas.assign(_deltas.begin(), _deltas.end());
+    snapshot.end = Clock::now();
+
+    const auto window = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(_maxSeconds));
+    Clock::time_point first = !_base.empty() ? _baseTime
+                              : !_deltas.empty() ? _deltas.front().time
+                                                 : snapshot.end;
+    snapshot.start = std::max(first, snapshot.end - window);
+    return snapshot;
+}
+
+void OsrFrameRecorder::dumpAsync(const std::string& path, Format format, int frameRate, DumpCallback callback) const {
+    CefPostTask(TID_FILE_BACKGROUND, base::BindOnce([](Snapshot snapshot, std::string path, Format format, int frameRate,
+                                                       DumpCallback callback) {
+            int width = 0;
+            int height = 0;
+            int frames = 0;
+            bool success = OsrFrameRecorder::Write(snapshot, path, format, frameRate, width, height, frames);
+            snapshot = Snapshot();
+            if (callback) {
+                CefPostTask(TID_UI, base::BindOnce([](DumpCallback callback, bool success, int width, int height,
+                                                      int frames) {
+                        callback(success, width, height, frames);
+                    }, std::move(callback), success, width, height, frames));
+            }
+        }, snapshot(), path, format, frameRate, std::move(callback)));
+}
+
+bool OsrFrameRecorder::Write(const Snapshot& snapshot,
+                             const std::string& path,
+                             Format format,
+                             int frameRate,
+                             int& width,
+                             int& height,
+                             int& frameCount) {
+    frameCount = 0;
+    if (frameRate <= 0) {
+        LOGE << "Frame recording dump needs a positive frame rate";
+        return false;
+    }
+    if (snapshot.deltas.empty() && snapshot.base.empty()) {
+        LOGW << "Frame recording is empty, nothing written to " << path;
+        return false;
+    }
+
+    // Only the newest size is written; the frame size of a video is fixed
+    width = snapshot.deltas.empty() ? snapshot.baseWidth : snapshot.deltas.back().width;
+    height = snapshot.deltas.empty() ? snapshot.baseHeight : snapshot.deltas.back().height;
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        LOGE << "Cannot open " << path << " for the frame recording";
+        return false;
+    }
+
+    const size_t frameBytes = static_cast<size_t>(width) * static_cast<size_t>(height) * kBytesPerPixel;
+    const size_t lumaBytes = static_cast<size_t>(width) * static_cast<size_t>(height);
+    const size_t chromaBytes = static_cast<size_t>((width + 1) / 2) * static_cast<size_t>((height + 1) / 2);
+    PixelBuffer yuv;
+    if (format == Format::kY4m) {
+        yuv = PixelBufferPool::Shared().acquire(lumaBytes + chromaBytes * 2);
+        if (!yuv) {
+            LOGE << "Frame recorder failed to allocate a " << width << "x" << height << " YUV frame";
+            return false;
+        }
+        out << "YUV4MPEG2 W" << width << " H" << height << " F" << frameRate << ":1 Ip A1:1 C420jpeg\n";
+    }
+
+    PixelBuffer frame;
+    int frameWidth = 0;
+    int frameHeight = 0;
+    if (snapshot.baseWidth == width && snapshot.baseHeight == height) {
+        frame = snapshot.base;
+        frameWidth = width;
+        frameHeight = height;
+    }
+
+    const auto interval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / frameRate));
+    // Round up so the last frame shows the state at the end of the window
+    auto intervals = static_cast<int64_t>((snapshot.end - snapshot.start) / interval);
+    if (snapshot.start + interval * intervals < snapshot.end) {
+        ++intervals;
+    }
+    const int64_t frames = intervals + 1;
+    size_t next = 0;
+    for (int64_t i = 0; i < frames && out; ++i) {
+        const Clock::time_point tick = snapshot.start + interval * i;
+        for (; next < snapshot.deltas.size() && snapshot.deltas[next].time <= tick; ++next) {
+            const Delta& delta = snapshot.deltas[next];
+            if (delta.width == width && delta.height == height) {
+                Apply(delta, frame, frameWidth, frameHeight);
+            }
+        }
+        if (frame.empty() || frameWidth != width || frameHeight != height) {
+            continue;
+        }
+
+        if (format == Format::kY4m) {
+            uint8_t* yPlane = yuv.data();
+            const size_t chromaStride = static_cast<size_t>((width + 1) / 2);
+            PixelKernels::ConvertToI420(frame.data(), static_cast<size_t>(width) * kBytesPerPixel,
+                                        yPlane, static_cast<size_t>(width),
+                                        yPlane + lumaBytes, chromaStride,
+                                        yPlane + lumaBytes + chromaBytes, chromaStride,
+                                        width, height);
+            out << "FRAME\n";
+            out.write(reinterpret_cast<const char*>(yPlane), static_cast<std::streamsize>(lumaBytes + chromaBytes * 2));
+        } else {
+            out.write(reinterpret_cast<const char*>(frame.data()), static_cast<std::streamsize>(frameBytes));
+        }
+        ++frameCount;
+    }
+
+    out.flush();
+    if (!out) {
+        LOGE << "Writing the frame recording to " << path << " FAILED";
+        return false;
+    }
+    LOGI << "Frame recording written to " << path << ": " << frameCount << " frames, " << width << "x" << height
+         << " @ " << frameRate << " fps" << (format == Format::kRawBgra ? " (raw bgra)" : "");
+    return frameCount > 0;
+}
+
+}  // namespace cefview
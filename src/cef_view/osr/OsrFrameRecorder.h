@@ -0,0 +1,174 @@
+/**
+ * @file OsrFrameRecorder.h
+ * @brief Flight recorder keeping the last seconds of OSR view paints
+ *
+ * This file is part of CefView project.
+ * Licensed under BSD-style license.
+ */
+#ifndef OSRFRAMERECORDER_H
+#define OSRFRAMERECORDER_H
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "include/cef_render_handler.h"
+
+#include "utils/PixelBufferPool.h"
+
+namespace cefview {
+
+/**
+ * @brief Bounded ring of view paints that can be dumped as video on demand
+ *
+ * Each paint is stored as a delta holding only its dirty rects, so a mostly
+ * static UI costs little memory. Deltas older than the time window, or
+ * beyond the byte budget, are folded into a base frame that reflects the
+ * state just before the oldest delta left. Memory is therefore bounded by
+ * the byte budget plus one full frame.
+ *
+ * record() is a copy of the dirty pixels per paint. dumpAsync() only
+ * snapshots the ring (buffers are shared, not copied) on the calling
+ * thread; rebuilding the frames and writing the file run on CEF's
+ * TID_FILE_BACKGROUND thread.
+ *
+ * Not thread-safe: call from the CEF UI thread.
+ */
+class OsrFrameRecorder {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class Format {
+        kY4m,     ///< YUV4MPEG2, 4:2:0 BT.601; plays in ffplay/mpv, encodes with ffmpeg -i
+        kRawBgra  ///< Headerless BGRA frames: ffmpeg -f rawvideo -pix_fmt bgra -s WxH -r fps -i
+    };
+
+    /**
+     * @brief Called on TID_UI when a dump finished
+     * @param success false if nothing was recorded or the file could not be written
+     * @param width Frame size written
+     * @param height Frame size written
+     * @param frames Number of frames written
+     */
+    using DumpCallback = std::function<void(bool success, int width, int height, int frames)>;
+
+    /// A paint reduced to its dirty rects
+    struct Delta {
+        Clock::time_point time;
+        int width = 0;                     ///< Size of the view frame the paint belongs to
+        int height = 0;
+        CefRenderHandler::RectList rects;
+        PixelBuffer pixels;                ///< Rect contents back to back, rect.width * 4 bytes per row
+        bool full = false;                 ///< Covers the whole frame (first paint or size change)
+    };
+
+    /// Immutable copy of the ring, safe to hand to another thread
+    struct Snapshot {
+        PixelBuffer base;                  ///< State before deltas[0]; empty if nothing was evicted
+        int baseWidth = 0;
+        int baseHeight = 0;
+        Clock::time_point baseTime;
+        std::vector<Delta> deltas;
+        Clock::time_point start;           ///< First instant of the window to write
+        Clock::time_point end;
+    };
+
+    /**
+     * @param maxSeconds Length of the window kept
+     * @param maxBytes Budget for delta pixels; older deltas are folded into the base frame
+     */
+    OsrFrameRecorder(double maxSeconds, size_t maxBytes);
+
+    OsrFrameRecorder(const OsrFrameRecorder&) = delete;
+    OsrFrameRecorder& operator=(const OsrFrameRecorder&) = delete;
+
+    /**
+     * @brief Record a view paint (PET_VIEW buffers from OnPaint)
+     */
+    void record(const CefRenderHandler::RectList& dirtyRects, const void* buffer, int width, int height);
+
+    /**
+     * @brief Drop everything recorded so far
+     */
+    void clear();
+
+    /**
+     * @brief Copy the ring for writing; the window ends now
+     */
+    Snapshot snapshot() const;
+
+    /**
+     * @brief Write the recorded window to a file without blocking the calling thread
+     *
+     * The output has a constant frame rate: each output frame shows the last
+     * paint at or before its time. Only frames of the most recent view size
+     * are written.
+     * @param path Output file
+     * @param format Y4M or raw BGRA
+     * @param frameRate Output frames per second
+     * @param callback Optional, called on TID_UI when done
+     */
+    void dumpAsync(const std::string& path, Format format, int frameRate, DumpCallback callback = nullptr) const;
+
+    /**
+     * @brief Rebuild the frames of a snapshot and write them (the worker half of dumpAsync)
+     * @param frameCount Receives the number of frames written
+     * @return false if the snapshot is empty or the file could not be written
+     */
+    static bool Write(const Snapshot& snapshot,
+                      const std::string& path,
+                      Format format,
+                      int frameRate,
+                      int& width,
+                      int& height,
+                      int& frameCount);
+
+    double maxSeconds() const { return _maxSeconds; }
+    size_t maxBytes() const { return _maxBytes; }
+
+    /**
+     * @brief Deltas currently held
+     */
+    size_t deltaCount() const { return _deltas.size(); }
+
+    /**
+     * @brief Delta pixel bytes currently held (the base frame is not counted)
+     */
+    size_t bufferedBytes() const { return _deltaBytes; }
+
+private:
+    /**
+     * @brief Fold the oldest deltas into the base frame until the window and budget hold
+     */
+    void evict(Clock::time_point now);
+
+    /**
+     * @brief Bring a frame up to date with a delta
+     * A full delta replaces the frame by sharing its buffer; a partial one is
+     * copied in, after detaching the frame if another snapshot shares it.
+     */
+    static void Apply(const Delta& delta, PixelBuffer& frame, int& width, int& height);
+
+    double _maxSeconds;
+    size_t _maxBytes;
+
+    std::deque<Delta> _deltas;             ///< Oldest first
+    size_t _deltaBytes = 0;
+
+    PixelBuffer _base;
+    int _baseWidth = 0;
+    int _baseHeight = 0;
+    Clock::time_point _baseTime;
+
+    int _lastWidth = 0;
+    int _lastHeight = 0;
+};
+
+}  // namespace cefview
+
+#endif  // OSRFRAMERECORDER_H
@@ -0,0 +1,57 @@
+/**
+ * @file OsrFrameScheduler.cpp
+ * @brief Frame pacing implementation
+ *
+ * This file is part of CefView project.
+ * Licensed under BSD-style license.
+ */
+#include "OsrFrameScheduler.h"
+
+namespace cefview {
+
+void OsrFrameScheduler::setFrameRate(double framesPerSecond) {
+    if (framesPerSecond <= 0.0) {
+        return;
+    }
+    _interval = std::chrono::duration_cast<Duration>(std::chrono::duration<double>(1.0 / framesPerSecond));
+}
+
+OsrFrameScheduler::Decision OsrFrameScheduler::onFrameRequested(TimePoint now, Duration& delay) {
+    if (_pending) {
+        // Content will be picked up by the present already scheduled
+        ++_skippedFrames;
+        return Decision::kCoalesced;
+    }
+
+    if (now >= _nextDeadline) {
+        return Decision::kPresentNow;
+    }
+
+    _pending = true;
+    delay = _nextDeadline - now;
+    return Decision::kSchedule;
+}
+
+void OsrFrameScheduler::onFramePresented(TimePoint now) {
+    // A scheduled present that fires a whole interval late missed its deadline
+    if (_pending && now > _nextDeadline + _interval) {
+        ++_missedDeadlines;
+    }
+
+    _pending = false;
+    ++_presentedFrames;
+
+    // Keep presents on the deadline grid; resynchronize after an idle gap
+    _nextDeadline += _interval;
+    if (_nextDeadline <= now) {
+        _nextDeadline = now + _interval;
+    }
+}
+
+void OsrFrameScheduler::resetStatistics() {
+    _presentedFrames = 0;
+    _skippedFrames = 0;
+    _missedDeadlines = 0;
+}
+
+}  // namespace cefview
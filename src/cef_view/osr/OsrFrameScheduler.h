@@ -0,0 +1,89 @@
+/**
+ * @file OsrFrameScheduler.h
+ * @brief Frame pacing for off-screen render presents
+ *
+ * This file is part of CefView project.
+ * Licensed under BSD-style license.
+ */
+#ifndef OSRFRAMESCHEDULER_H
+#define OSRFRAMESCHEDULER_H
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace cefview {
+
+/**
+ * @brief Coalesces paint notifications into at most one present per frame interval
+ *
+ * The scheduler only makes timing decisions; OsrViewScheduler performs the
+ * present and has the view post the delayed task on its own thread. Presents are aligned
+ * to a deadline grid spaced by the frame interval (display refresh period,
+ * or the windowless frame rate when no display rate is known).
+ * Not thread-safe: use from the thread that receives paint callbacks.
+ */
+class OsrFrameScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+    using TimePoint = Clock::time_point;
+    using Duration = Clock::duration;
+
+    enum class Decision {
+        kPresentNow,  ///< Deadline already reached: present immediately
+        kSchedule,    ///< Post a present after the returned delay
+        kCoalesced    ///< A present is already scheduled; nothing to do
+    };
+
+    OsrFrameScheduler() = default;
+
+    /**
+     * @brief Set the frame rate used to space presents
+     * @param framesPerSecond Frames per second; values <= 0 are ignored
+     */
+    void setFrameRate(double framesPerSecond);
+
+    /**
+     * @brief Current frame interval
+     */
+    Duration frameInterval() const { return _interval; }
+
+    /**
+     * @brief Request a present for newly painted content
+     * @param now Current time
+     * @param delay Receives the delay until the next deadline when kSchedule is returned
+     */
+    Decision onFrameRequested(TimePoint now, Duration& delay);
+
+    /**
+     * @brief Record a present and advance the deadline grid
+     * @param now Time the present was issued
+     */
+    void onFramePresented(TimePoint now);
+
+    /**
+     * @brief Drop a scheduled present (e.g. the renderer went away)
+     */
+    void cancel() { _pending = false; }
+
+    bool isPending() const { return _pending; }
+
+    // Statistics
+    uint64_t presentedFrames() const { return _presentedFrames; }
+    uint64_t skippedFrames() const { return _skippedFrames; }
+    uint64_t missedDeadlines() const { return _missedDeadlines; }
+    void resetStatistics();
+
+private:
+    Duration _interval = std::chrono::duration_cast<Duration>(std::chrono::microseconds(16667));
+    TimePoint _nextDeadline{};
+    bool _pending = false;
+
+    uint64_t _presentedFrames = 0;
+    uint64_t _skippedFrames = 0;
+    uint64_t _missedDeadlines = 0;
+};
+
+}  // namespace cefview
+
+#endif  // OSRFRAMESCHEDULER_H
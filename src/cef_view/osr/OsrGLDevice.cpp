@@ -0,0 +1,520 @@
+/**
+ * @file OsrGLDevice.cpp
+ * @brief Shared OpenGL device implementation
+ *
+ * This file is part of CefView project.
+ * Licensed under BSD-style license.
+ */
+#include "OsrGLDevice.h"
+
+#include <cstring>
+#include <mutex>
+
+#include "OsrGLFunctions.h"
+
+#include "utils/LogUtil.h"
+
+#if defined(WIN32)
+// Global function pointers
+PFNGLGENVERTEXARRAYSPROC glGenVertexArrays = nullptr;
+PFNGLBINDVERTEXARRAYPROC glBindVertexArray = nullptr;
+PFNGLDELETEVERTEXARRAYSPROC glDeleteVertexArrays = nullptr;
+PFNGLGENBUFFERSPROC glGenBuffers = nullptr;
+PFNGLBINDBUFFERPROC glBindBuffer = nullptr;
+PFNGLDELETEBUFFERSPROC glDeleteBuffers = nullptr;
+PFNGLBUFFERDATAPROC glBufferData = nullptr;
+PFNGLCREATESHADERPROC glCreateShader = nullptr;
+PFNGLSHADERSOURCEPROC glShaderSource = nullptr;
+PFNGLCOMPILESHADERPROC glCompileShader = nullptr;
+PFNGLGETSHADERIVPROC glGetShaderiv = nullptr;
+PFNGLGETSHADERINFOLOGPROC glGetShaderInfoLog = nullptr;
+PFNGLDELETESHADERPROC glDeleteShader = nullptr;
+PFNGLCREATEPROGRAMPROC glCreateProgram = nullptr;
+PFNGLATTACHSHADERPROC glAttachShader = nullptr;
+PFNGLLINKPROGRAMPROC glLinkProgram = nullptr;
+PFNGLGETPROGRAMIVPROC glGetProgramiv = nullptr;
+PFNGLGETPROGRAMINFOLOGPROC glGetProgramInfoLog = nullptr;
+PFNGLDELETEPROGRAMPROC glDeleteProgram = nullptr;
+PFNGLUSEPROGRAMPROC glUseProgram = nullptr;
+PFNGLGETUNIFORMLOCATIONPROC glGetUniformLocation = nullptr;
+PFNGLUNIFORMMATRIX4FVPROC glUniformMatrix4fv = nullptr;
+PFNGLUNIFORM1IPROC glUniform1i = nullptr;
+PFNGLENABLEVERTEXATTRIBARRAYPROC glEnableVertexAttribArray = nullptr;
+PFNGLVERTEXATTRIB4FPROC glVertexAttrib4f = nullptr;
+PFNGLVERTEXATTRIBPOINTERPROC glVertexAttribPointer = nullptr;
+PFNGLACTIVETEXTUREPROC glActiveTexture = nullptr;
+PFNGLMAPBUFFERRANGEPROC glMapBufferRange = nullptr;
+PFNGLUNMAPBUFFERPROC glUnmapBuffer = nullptr;
+PFNGLFENCESYNCPROC glFenceSync = nullptr;
+PFNGLWAITSYNCPROC glWaitSync = nullptr;
+PFNGLDELETESYNCPROC glDeleteSync = nullptr;
+PFNWGLCREATECONTEXTATTRIBSARBPROC wglCreateContextAttribsARB = nullptr;
+PFNWGLCHOOSEPIXELFORMATARBPROC wglChoosePixelFormatARB = nullptr;
+
+static bool g_glFunctionsLoaded = false;
+
+bool LoadGLFunctions() {
+    if (g_glFunctionsLoaded) {
+        return true;
+    }
+
+    glGenVertexArrays = (PFNGLGENVERTEXARRAYSPROC)wglGetProcAddress("glGenVertexArrays");
+    glBindVertexArray = (PFNGLBINDVERTEXARRAYPROC)wglGetProcAddress("glBindVertexArray");
+    glDeleteVertexArrays = (PFNGLDELETEVERTEXARRAYSPROC)wglGetProcAddress("glDeleteVertexArrays");
+    glGenBuffers = (PFNGLGENBUFFERSPROC)wglGetProcAddress("glGenBuffers");
+    glBindBuffer = (PFNGLBINDBUFFERPROC)wglGetProcAddress("glBindBuffer");
+    glDeleteBuffers = (PFNGLDELETEBUFFERSPROC)wglGetProcAddress("glDeleteBuffers");
+    glBufferData = (PFNGLBUFFERDATAPROC)wglGetProcAddress("glBufferData");
+    glCreateShader = (PFNGLCREATESHADERPROC)wglGetProcAddress("glCreateShader");
+    glShaderSource = (PFNGLSHADERSOURCEPROC)wglGetProcAddress("glShaderSource");
+    glCompileShader = (PFNGLCOMPILESHADERPROC)wglGetProcAddress("glCompileShader");
+    glGetShaderiv = (PFNGLGETSHADERIVPROC)wglGetProcAddress("glGetShaderiv");
+    glGetShaderInfoLog = (PFNGLGETSHADERINFOLOGPROC)wglGetProcAddress("glGetShaderInfoLog");
+    glDeleteShader = (PFNGLDELETESHADERPROC)wglGetProcAddress("glDeleteShader");
+    glCreateProgram = (PFNGLCREATEPROGRAMPROC)wglGetProcAddress("glCreateProgram");
+    glAttachShader = (PFNGLATTACHSHADERPROC)wglGetProcAddress("glAttachShader");
+    glLinkProgram = (PFNGLLINKPROGRAMPROC)wglGetProcAddress("glLinkProgram");
+    glGetProgramiv = (PFNGLGETPROGRAMIVPROC)wglGetProcAddress("glGetProgramiv");
+    glGetProgramInfoLog = (PFNGLGETPROGRAMINFOLOGPROC)wglGetProcAddress("glGetProgramInfoLog");
+    glDeleteProgram = (PFNGLDELETEPROGRAMPROC)wglGetProcAddress("glDeleteProgram");
+    glUseProgram = (PFNGLUSEPROGRAMPROC)wglGetProcAddress("glUseProgram");
+    glGetUniformLocation = (PFNGLGETUNIFORMLOCATIONPROC)wglGetProcAddress("glGetUniformLocation");
+    glUniformMatrix4fv = (PFNGLUNIFORMMATRIX4FVPROC)wglGetProcAddress("glUniformMatrix4fv");
+    glUniform1i = (PFNGLUNIFORM1IPROC)wglGetProcAddress("glUniform1i");
+    glEnableVertexAttribArray = (PFNGLENABLEVERTEXATTRIBARRAYPROC)wglGetProcAddress("glEnableVertexAttribArray");
+    glVertexAttrib4f = (PFNGLVERTEXATTRIB4FPROC)wglGetProcAddress("glVertexAttrib4f");
+    glVertexAttribPointer = (PFNGLVERTEXATTRIBPOINTERPROC)wglGetProcAddress("glVertexAttribPointer");
+    glActiveTexture = (PFNGLACTIVETEXTUREPROC)wglGetProcAddress("glActiveTexture");
+    // Optional: pixel unpack buffers fall back to direct upload when missing
+    glMapBufferRange = (PFNGLMAPBUFFERRANGEPROC)wglGetProcAddress("glMapBufferRange");
+    glUnmapBuffer = (PFNGLUNMAPBUFFERPROC)wglGetProcAddress("glUnmapBuffer");
+    // Optional: compositing falls back to glFinish when sync objects are missing
+    glFenceSync = (PFNGLFENCESYNCPROC)wglGetProcAddress("glFenceSync");
+    glWaitSync = (PFNGLWAITSYNCPROC)wglGetProcAddress("glWaitSync");
+    glDeleteSync = (PFNGLDELETESYNCPROC)wglGetProcAddress("glDeleteSync");
+
+    g_glFunctionsLoaded = (glGenVertexArrays && glBindVertexArray && glGenBuffers &&
+                           glBindBuffer && glBufferData && glCreateShader &&
+                           glShaderSource && glCompileShader && glCreateProgram &&
+                           glAttachShader && glLinkProgram && glUseProgram &&
+                           glGetUniformLocation && glUniformMatrix4fv && glUniform1i &&
+                           glEnableVertexAttribArray && glVertexAttrib4f && glVertexAttribPointer &&
+                           glActiveTexture);
+
+    return g_glFunctionsLoaded;
+}
+
+#endif
+
+namespace cefview {
+
+namespace {
+
+// Vertex shader source (OpenGL 3.3). Transform and opacity are constant
+// vertex attributes rather than uniforms: uniforms live in the shared
+// program, attribute values in each context. An unset attribute reads
+// (0, 0, 0, 1), so opacity defaults to 1.
+const char* g_vertexShaderSource = R"(
+#version 330 core
+layout(location = 0) in vec4 transform;
+layout(location = 1) in vec4 tint;
+out vec2 texCoord;
+out float opacity;
+void main() {
+    float x = float(((uint(gl_VertexID) + 2u) / 3u) % 2u);
+    float y = float(((uint(gl_VertexID) + 1u) / 3u) % 2u);
+    vec2 pos = vec2(-1.0f + x * 2.0f, -1.0f + y * 2.0f);
+    gl_Position = vec4(pos * transform.xy + transform.zw, 0.0f, 1.0f);
+    texCoord = vec2(x, 1.0f - y);
+    opacity = tint.a;
+}
+)";
+
+// Fragment shader source (OpenGL 3.3)
+const char* g_fragmentShaderSource = R"(
+#version 330 core
+out vec4 fragColor;
+in vec2 texCoord;
+in float opacity;
+uniform sampler2D tex;
+void main() {
+    // Premultiplied alpha: scale all channels
+    fragColor = texture(tex, texCoord) * opacity;
+}
+)";
+
+std::mutex g_deviceMutex;
+std::weak_ptr<OsrGLDevice> g_device;
+
+#if defined(WIN32)
+constexpr wchar_t kDeviceWindowClass[] = L"CefViewGLDevice";
+
+const int kContextAttribs[] = {
+    WGL_CONTEXT_MAJOR_VERSION_ARB, 3,
+    WGL_CONTEXT_MINOR_VERSION_ARB, 3,
+    WGL_CONTEXT_PROFILE_MASK_ARB, WGL_CONTEXT_CORE_PROFILE_BIT_ARB,
+    0
+};
+
+/// Restores the calling thread's current context on scope exit
+class ScopedCurrentContext {
+public:
+    ScopedCurrentContext(HDC hdc, HGLRC context)
+        : _previousDC(wglGetCurrentDC()), _previousContext(wglGetCurrentContext()) {
+        wglMakeCurrent(hdc, context);
+    }
+    ~ScopedCurrentContext() { wglMakeCurrent(_previousDC, _previousContext); }
+
+    ScopedCurrentContext(const ScopedCurrentContext&) = delete;
+    ScopedCurrentContext& operator=(const ScopedCurrentContext&) = delete;
+
+private:
+    HDC _previousDC;
+    HGLRC _previousContext;
+};
+#elif !defined(__APPLE__)
+const EGLint kContextAttribs[] = {
+    EGL_CONTEXT_MAJOR_VERSION, 3,
+    EGL_CONTEXT_MINOR_VERSION, 3,
+    EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+    EGL_NONE
+};
+
+bool HasExtension(const char* extensions, const char* name) {
+    if (!extensions) {
+        return false;
+    }
+    const size_t length = std::strlen(name);
+    for (const char* p = std::strstr(extensions, name); p; p = std::strstr(p + length, name)) {
+        if ((p == extensions || p[-1] == ' ') && (p[length] == ' ' || p[length] == '\0')) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/// Restores the calling thread's current context on scope exit
+class ScopedCurrentContext {
+public:
+    ScopedCurrentContext(EGLDisplay display, EGLSurface surface, EGLContext context)
+        : _previousDisplay(eglGetCurrentDisplay()),
+          _previousDraw(eglGetCurrentSurface(EGL_DRAW)),
+          _previousRead(eglGetCurrentSurface(EGL_READ)),
+          _previousContext(eglGetCurrentContext()),
+          _display(display) {
+        eglMakeCurrent(display, surface, surface, context);
+    }
+    ~ScopedCurrentContext() {
+        if (_previousContext != EGL_NO_CONTEXT) {
+            eglMakeCurrent(_previousDisplay, _previousDraw, _previousRead, _previousContext);
+        } else {
+            eglMakeCurrent(_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        }
+    }
+
+    ScopedCurrentContext(const ScopedCurrentContext&) = delete;
+    ScopedCurrentContext& operator=(const ScopedCurrentContext&) = delete;
+
+private:
+    EGLDisplay _previousDisplay;
+    EGLSurface _previousDraw;
+    EGLSurface _previousRead;
+    EGLContext _previousContext;
+    EGLDisplay _display;
+};
+#endif
+
+}  // namespace
+
+std::shared_ptr<OsrGLDevice> OsrGLDevice::Acquire() {
+    std::lock_guard<std::mutex> lock(g_deviceMutex);
+    if (auto device = g_device.lock()) {
+        return device;
+    }
+
+    std::shared_ptr<OsrGLDevice> device(new OsrGLDevice());
+    if (!device->initialize()) {
+        return nullptr;
+    }
+    g_device = device;
+    return device;
+}
+
+OsrGLDevice::~OsrGLDevice() {
+#if defined(WIN32)
+    if (_context) {
+        if (_program != 0) {
+            ScopedCurrentContext current(_hdc, _context);
+            glDeleteProgram(_program);
+        }
+        wglDeleteContext(_context);
+    }
+    if (_hdc) {
+        ReleaseDC(_window, _hdc);
+    }
+    if (_window) {
+        DestroyWindow(_window);
+    }
+#elif !defined(__APPLE__)
+    if (_context) {
+        if (_program != 0) {
+            ScopedCurrentContext current(_display, _surface, _context);
+            glDeleteProgram(_program);
+        }
+        eglDestroyContext(_display, _context);
+    }
+    if (_surface) {
+        eglDestroySurface(_display, _surface);
+    }
+    // The display is process-wide and may be in use elsewhere; it is not terminated
+#endif
+}
+
+bool OsrGLDevice::initialize() {
+#if defined(WIN32)
+    HINSTANCE instance = GetModuleHandle(nullptr);
+    WNDCLASSEXW wc = {};
+    wc.cbSize = sizeof(wc);
+    wc.style = CS_OWNDC;
+    wc.lpfnWndProc = DefWindowProcW;
+    wc.hInstance = instance;
+    wc.lpszClassName = kDeviceWindowClass;
+    if (!RegisterClassExW(&wc) && GetLastError() != ERROR_CLASS_ALREADY_EXISTS) {
+        LOGE << "OsrGLDevice: RegisterClassEx() FAILED";
+        return false;
+    }
+
+    // The root context needs a drawable with a pixel format, never shown
+    _window = CreateWindowExW(0, kDeviceWindowClass, L"", WS_POPUP, 0, 0, 1, 1,
+                              nullptr, nullptr, instance, nullptr);
+    _hdc = _window ? GetDC(_window) : nullptr;
+    if (!_hdc) {
+        LOGE << "OsrGLDevice: hidden window creation FAILED";
+        return false;
+    }
+
+    _pixelFormatDesc.nSize = sizeof(_pixelFormatDesc);
+    _pixelFormatDesc.nVersion = 1;
+    _pixelFormatDesc.dwFlags = PFD_DRAW_TO_WINDOW | PFD_SUPPORT_OPENGL | PFD_DOUBLEBUFFER;
+    _pixelFormatDesc.iPixelType = PFD_TYPE_RGBA;
+    _pixelFormatDesc.cColorBits = 32;
+    _pixelFormatDesc.cDepthBits = 24;
+    _pixelFormatDesc.cStencilBits = 8;
+    _pixelFormatDesc.iLayerType = PFD_MAIN_PLANE;
+
+    _pixelFormat = ChoosePixelFormat(_hdc, &_pixelFormatDesc);
+    if (_pixelFormat == 0 || !SetPixelFormat(_hdc, _pixelFormat, &_pixelFormatDesc)) {
+        LOGE << "OsrGLDevice: pixel format selection FAILED";
+        return false;
+    }
+
+    // A legacy context is needed to load wglCreateContextAttribsARB
+    HGLRC tempContext = wglCreateContext(_hdc);
+    if (!tempContext) {
+        LOGE << "OsrGLDevice: wglCreateContext() FAILED";
+        return false;
+    }
+    {
+        ScopedCurrentContext current(_hdc, tempContext);
+        wglCreateContextAttribsARB =
+            (PFNWGLCREATECONTEXTATTRIBSARBPROC)wglGetProcAddress("wglCreateContextAttribsARB");
+        if (wglCreateContextAttribsARB) {
+            _context = wglCreateContextAttribsARB(_hdc, nullptr, kContextAttribs);
+        }
+    }
+    if (_context) {
+        wglDeleteContext(tempContext);
+    } else {
+        LOGE << "OsrGLDevice: wglCreateContextAttribsARB() FAILED, falling back to legacy context";
+        _context = tempContext;
+    }
+
+    ScopedCurrentContext current(_hdc, _context);
+    if (!LoadGLFunctions()) {
+        LOGE << "OsrGLDevice: LoadGLFunctions() FAILED";
+        return false;
+    }
+    if (!createProgram()) {
+        return false;
+    }
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &_maxTextureSize);
+    LOGI << "OsrGLDevice created, GL_MAX_TEXTURE_SIZE " << _maxTextureSize;
+    return true;
+#elif !defined(__APPLE__)
+    // Mesa's surfaceless platform needs neither an X server nor a GPU (llvmpipe)
+    EGLDisplay display = EGL_NO_DISPLAY;
+    const char* clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    auto getPlatformDisplay =
+        reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    if (getPlatformDisplay && HasExtension(clientExtensions, "EGL_MESA_platform_surfaceless")) {
+        display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    }
+    if (display == EGL_NO_DISPLAY) {
+        display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    }
+    EGLint major = 0;
+    EGLint minor = 0;
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, &major, &minor)) {
+        LOGE << "OsrGLDevice: eglInitialize() FAILED: " << eglGetError();
+        return false;
+    }
+    _display = display;
+
+    if (!eglBindAPI(EGL_OPENGL_API)) {
+        LOGE << "OsrGLDevice: eglBindAPI(EGL_OPENGL_API) FAILED";
+        return false;
+    }
+
+    // Renderers draw into framebuffer objects, so the config only matters for
+    // the pbuffer fallback
+    _surfaceless = HasExtension(eglQueryString(display, EGL_EXTENSIONS), "EGL_KHR_surfaceless_context");
+    const EGLint configAttribs[] = {
+        EGL_SURFACE_TYPE, _surfaceless ? 0 : EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_RED_SIZE, 8,
+        EGL_GREEN_SIZE, 8,
+        EGL_BLUE_SIZE, 8,
+        EGL_ALPHA_SIZE, 8,
+        EGL_NONE
+    };
+    EGLConfig config = nullptr;
+    EGLint configCount = 0;
+    if (!eglChooseConfig(display, configAttribs, &config, 1, &configCount) || configCount == 0) {
+        LOGE << "OsrGLDevice: eglChooseConfig() found no desktop GL config";
+        return false;
+    }
+    _config = config;
+
+    _context = eglCreateContext(display, config, EGL_NO_CONTEXT, kContextAttribs);
+    if (!_context) {
+        LOGE << "OsrGLDevice: eglCreateContext() FAILED: " << eglGetError();
+        return false;
+    }
+    if (!_surfaceless) {
+        _surface = createSurface();
+        if (!_surface) {
+            return false;
+        }
+    }
+
+    ScopedCurrentContext current(display, _surface, _context);
+    if (!createProgram()) {
+        return false;
+    }
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &_maxTextureSize);
+    LOGI << "OsrGLDevice created on EGL " << major << "." << minor << (_surfaceless ? " (surfaceless)" : " (pbuffer)")
+         << ", " << reinterpret_cast<const char*>(glGetString(GL_RENDERER))
+         << ", GL_MAX_TEXTURE_SIZE " << _maxTextureSize;
+    return true;
+#else
+    LOGE << "OsrGLDevice is not implemented on this platform";
+    return false;
+#endif
+}
+
+#if defined(WIN32)
+HGLRC OsrGLDevice::createContext(HDC hdc) const {
+    // Contexts in a share group need compatible pixel formats
+    if (GetPixelFormat(hdc) == 0 && !SetPixelFormat(hdc, _pixelFormat, &_pixelFormatDesc)) {
+        LOGE << "OsrGLDevice: SetPixelFormat() FAILED";
+        return nullptr;
+    }
+
+    HGLRC context = nullptr;
+    if (wglCreateContextAttribsARB) {
+        context = wglCreateContextAttribsARB(hdc, _context, kContextAttribs);
+    }
+    if (context) {
+        return context;
+    }
+
+    // Legacy root context: share through wglShareLists before the context has objects
+    context = wglCreateContext(hdc);
+    if (!context) {
+        LOGE << "OsrGLDevice: wglCreateContext() FAILED";
+        return nullptr;
+    }
+    if (!wglShareLists(_context, context)) {
+        LOGE << "OsrGLDevice: wglShareLists() FAILED";
+        wglDeleteContext(context);
+        return nullptr;
+    }
+    return context;
+}
+#elif !defined(__APPLE__)
+void* OsrGLDevice::createContext() const {
+    EGLContext context = eglCreateContext(_display, _config, _context, kContextAttribs);
+    if (!context) {
+        LOGE << "OsrGLDevice: eglCreateContext() FAILED: " << eglGetError();
+        return nullptr;
+    }
+    return context;
+}
+
+void* OsrGLDevice::createSurface() const {
+    if (_surfaceless) {
+        return nullptr;
+    }
+    const EGLint attribs[] = {EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE};
+    EGLSurface surface = eglCreatePbufferSurface(_display, _config, attribs);
+    if (!surface) {
+        LOGE << "OsrGLDevice: eglCreatePbufferSurface() FAILED: " << eglGetError();
+        return nullptr;
+    }
+    return surface;
+}
+#endif
+
+bool OsrGLDevice::createProgram() {
+    GLint success = 0;
+    char infoLog[512] = {};
+
+    // Create vertex shader
+    GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(vertexShader, 1, &g_vertexShaderSource, nullptr);
+    glCompileShader(vertexShader);
+    glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &success);
+    if (!success) {
+        glGetShaderInfoLog(vertexShader, 512, nullptr, infoLog);
+        LOGE << "Vertex shader compile error: " << infoLog;
+        glDeleteShader(vertexShader);
+        return false;
+    }
+
+    // Create fragment shader
+    GLuint fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(fragmentShader, 1, &g_fragmentShaderSource, nullptr);
+    glCompileShader(fragmentShader);
+    glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &success);
+    if (!success) {
+        glGetShaderInfoLog(fragmentShader, 512, nullptr, infoLog);
+        LOGE << "Fragment shader compile error: " << infoLog;
+        glDeleteShader(vertexShader);
+        glDeleteShader(fragmentShader);
+        return false;
+    }
+
+    // Create shader program
+    _program = glCreateProgram();
+    glAttachShader(_program, vertexShader);
+    glAttachShader(_program, fragmentShader);
+    glLinkProgram(_program);
+    glGetProgramiv(_program, GL_LINK_STATUS, &success);
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+    if (!success) {
+        glGetProgramInfoLog(_program, 512, nullptr, infoLog);
+        LOGE << "Shader program link error: " << infoLog;
+        glDeleteProgram(_program);
+        _program = 0;
+        return false;
+    }
+
+    // The sampler always reads unit 0; set once for every context
+    glUseProgram(_program);
+    glUniform1i(glGetUniformLocation(_program, "tex"), 0);
+    glUseProgram(0);
+    return true;
+}
+
+}  // namespace cefview
@@ -0,0 +1,125 @@
+/**
+ * @file OsrGLDevice.h
+ * @brief Process-wide OpenGL share group for the GL off-screen renderers
+ *
+ * This file is part of CefView project.
+ * Licensed under BSD-style license.
+ */
+#ifndef OSRGLDEVICE_H
+#define OSRGLDEVICE_H
+#pragma once
+
+#include <memory>
+
+#if defined(WIN32)
+#include <windows.h>
+#endif
+
+namespace cefview {
+
+/**
+ * @brief GL objects shared by every OsrRendererGL in the process
+ *
+ * Owns a hidden root context that starts the share group, the compiled quad
+ * program and the context limits. Each renderer creates its window context
+ * through createContext() so it joins the share group, and keeps only
+ * per-view objects itself (textures, pixel buffers and the vertex array,
+ * which GL never shares).
+ *
+ * The program keeps no per-view state: the quad transform and opacity are
+ * passed as constant values of vertex attributes, which belong to each
+ * context, so renderers on different threads can draw concurrently.
+ *
+ * Acquire and release the device on the UI thread; it owns a hidden window.
+ *
+ * On Linux the share group lives on an EGL display instead. Mesa's
+ * surfaceless platform is preferred, so the device also works without an X
+ * server or GPU (llvmpipe); contexts are made current without a surface when
+ * EGL_KHR_surfaceless_context is available, or on a 1x1 pbuffer otherwise.
+ */
+class OsrGLDevice {
+public:
+    /// Vertex attribute holding the quad transform (xy scale, zw translate in NDC)
+    static constexpr unsigned int kTransformAttribute = 0;
+    /// Vertex attribute whose w component is the layer opacity (defaults to 1)
+    static constexpr unsigned int kOpacityAttribute = 1;
+
+    /**
+     * @brief Get the shared device, creating it on first use
+     * @return nullptr if the share group cannot be created
+     */
+    static std::shared_ptr<OsrGLDevice> Acquire();
+
+    ~OsrGLDevice();
+
+    // Disable copy and move
+    OsrGLDevice(const OsrGLDevice&) = delete;
+    OsrGLDevice& operator=(const OsrGLDevice&) = delete;
+    OsrGLDevice(OsrGLDevice&&) = delete;
+    OsrGLDevice& operator=(OsrGLDevice&&) = delete;
+
+#if defined(WIN32)
+    /**
+     * @brief Create a GL 3.3 core context for a window, sharing objects with the device
+     * @param hdc Device context of the target window; its pixel format is set if unset
+     * @return New context, or nullptr on failure
+     */
+    HGLRC createContext(HDC hdc) const;
+#elif !defined(__APPLE__)
+    /**
+     * @brief Create a GL 3.3 core context sharing objects with the device
+     * @return New EGLContext, or nullptr on failure
+     */
+    void* createContext() const;
+
+    /**
+     * @brief Create a 1x1 pbuffer for a context to be current on
+     * @return New EGLSurface, or nullptr on failure (or when surfaceless)
+     */
+    void* createSurface() const;
+
+    void* eglDisplay() const { return _display; }
+
+    /**
+     * @brief Whether contexts can be made current without a surface
+     */
+    bool isSurfaceless() const { return _surfaceless; }
+#endif
+
+    /**
+     * @brief Quad program sampling texture unit 0
+     */
+    unsigned int program() const { return _program; }
+
+    /**
+     * @brief GL_MAX_TEXTURE_SIZE of the share group
+     */
+    int maxTextureSize() const { return _maxTextureSize; }
+
+private:
+    OsrGLDevice() = default;
+
+    bool initialize();
+    bool createProgram();
+
+#if defined(WIN32)
+    HWND _window = nullptr;
+    HDC _hdc = nullptr;
+    HGLRC _context = nullptr;
+    int _pixelFormat = 0;
+    PIXELFORMATDESCRIPTOR _pixelFormatDesc = {};
+#elif !defined(__APPLE__)
+    void* _display = nullptr;  ///< EGLDisplay
+    void* _config = nullptr;   ///< EGLConfig
+    void* _context = nullptr;  ///< EGLContext
+    void* _surface = nullptr;  ///< EGLSurface, only without surfaceless support
+    bool _surfaceless = false;
+#endif
+
+    unsigned int _program = 0;
+    int _maxTextureSize = 0;
+};
+
+}  // namespace cefview
+
+#endif  // OSRGLDEVICE_H
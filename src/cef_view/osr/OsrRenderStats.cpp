@@ -0,0 +1,141 @@
+/**
+ * @file OsrRenderStats.cpp
+ * @brief Rendering statistics implementation
+ *
+ * This file is part of CefView project.
+ * Licensed under BSD-style license.
+ */
+#include "OsrRenderStats.h"
+
+#include "utils/json.hpp"
+
+namespace cefview {
+
+namespace {
+
+double AverageMs(uint64_t totalUs, uint64_t count) {
+    return count ? static_cast<double>(totalUs) / 1000.0 / static_cast<double>(count) : 0.0;
+}
+
+}  // namespace
+
+std::string OsrRenderStats::toJson() const {
+    nlohmann::json json = {
+        {"windowSeconds", windowSeconds},
+        {"paints", paints},
+        {"paintsPerSecond", paintsPerSecond},
+        {"dirtyPixelsPerPaint", dirtyPixelsPerPaint},
+        {"uploads", uploads},
+        {"uploadedBytes", uploadedBytes},
+        {"uploadMsAvg", uploadMsAvg},
+        {"uploadMsMax", uploadMsMax},
+        {"presents", presents},
+        {"presentMsAvg", presentMsAvg},
+        {"presentMsMax", presentMsMax},
+        {"latencyMsAvg", latencyMsAvg},
+        {"latencyMsMax", latencyMsMax},
+        {"droppedFrames", droppedFrames},
+    };
+    return json.dump();
+}
+
+std::string OsrSuspendStats::toJson() const {
+    nlohmann::json json = {
+        {"hides", hides},
+        {"suspensions", suspensions},
+        {"hiddenSeconds", hiddenSeconds},
+        {"releasedTextureBytes", releasedTextureBytes},
+        {"paintsWhileHidden", paintsWhileHidden},
+        {"paintsAvoided", paintsAvoided},
+        {"uploadMsAvoided", uploadMsAvoided},
+    };
+    return json.dump();
+}
+
+OsrRenderStatsCollector::OsrRenderStatsCollector()
+    : _windowStart(Clock::now().time_since_epoch().count()) {
+}
+
+void OsrRenderStatsCollector::recordPaint(const CefRenderHandler::RectList& dirtyRects) {
+    uint64_t area = 0;
+    for (const auto& rect : dirtyRects) {
+        if (rect.width > 0 && rect.height > 0) {
+            area += static_cast<uint64_t>(rect.width) * static_cast<uint64_t>(rect.height);
+        }
+    }
+    _paints.fetch_add(1, std::memory_order_relaxed);
+    _dirtyPixels.fetch_add(area, std::memory_order_relaxed);
+}
+
+void OsrRenderStatsCollector::recordUpload(uint64_t bytes, double milliseconds) {
+    const uint64_t us = ToMicroseconds(milliseconds);
+    _uploads.fetch_add(1, std::memory_order_relaxed);
+    _uploadedBytes.fetch_add(bytes, std::memory_order_relaxed);
+    _uploadUs.fetch_add(us, std::memory_order_relaxed);
+    UpdateMax(_uploadUsMax, us);
+}
+
+void OsrRenderStatsCollector::recordPresent(double milliseconds) {
+    const uint64_t us = ToMicroseconds(milliseconds);
+    _presents.fetch_add(1, std::memory_order_relaxed);
+    _presentUs.fetch_add(us, std::memory_order_relaxed);
+    UpdateMax(_presentUsMax, us);
+}
+
+void OsrRenderStatsCollector::recordLatency(double milliseconds) {
+    const uint64_t us = ToMicroseconds(milliseconds);
+    _latencies.fetch_add(1, std::memory_order_relaxed);
+    _latencyUs.fetch_add(us, std::memory_order_relaxed);
+    UpdateMax(_latencyUsMax, us);
+}
+
+OsrRenderStats OsrRenderStatsCollector::snapshot(bool resetWindow) {
+    const int64_t now = Clock::now().time_since_epoch().count();
+    const int64_t start = resetWindow ? _windowStart.exchange(now, std::memory_order_relaxed)
+                                      : _windowStart.load(std::memory_order_relaxed);
+
+    auto read = [resetWindow](std::atomic<uint64_t>& counter) {
+        return resetWindow ? counter.exchange(0, std::memory_order_relaxed)
+                           : counter.load(std::memory_order_relaxed);
+    };
+
+    OsrRenderStats stats;
+    stats.windowSeconds = std::chrono::duration<double>(Clock::duration(now - start)).count();
+    stats.paints = read(_paints);
+    stats.uploads = read(_uploads);
+    stats.uploadedBytes = read(_uploadedBytes);
+    stats.presents = read(_presents);
+    stats.droppedFrames = read(_droppedFrames);
+
+    const uint64_t dirtyPixels = read(_dirtyPixels);
+    const uint64_t uploadUs = read(_uploadUs);
+    const uint64_t presentUs = read(_presentUs);
+    const uint64_t latencies = read(_latencies);
+    const uint64_t latencyUs = read(_latencyUs);
+
+    if (stats.windowSeconds > 0.0) {
+        stats.paintsPerSecond = static_cast<double>(stats.paints) / stats.windowSeconds;
+    }
+    if (stats.paints) {
+        stats.dirtyPixelsPerPaint = static_cast<double>(dirtyPixels) / static_cast<double>(stats.paints);
+    }
+    stats.uploadMsAvg = AverageMs(uploadUs, stats.uploads);
+    stats.uploadMsMax = static_cast<double>(read(_uploadUsMax)) / 1000.0;
+    stats.presentMsAvg = AverageMs(presentUs, stats.presents);
+    stats.presentMsMax = static_cast<double>(read(_presentUsMax)) / 1000.0;
+    stats.latencyMsAvg = AverageMs(latencyUs, latencies);
+    stats.latencyMsMax = static_cast<double>(read(_latencyUsMax)) / 1000.0;
+    return stats;
+}
+
+uint64_t OsrRenderStatsCollector::ToMicroseconds(double milliseconds) {
+    return milliseconds > 0.0 ? static_cast<uint64_t>(milliseconds * 1000.0 + 0.5) : 0;
+}
+
+void OsrRenderStatsCollector::UpdateMax(std::atomic<uint64_t>& target, uint64_t value) {
+    uint64_t current = target.load(std::memory_order_relaxed);
+    while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+}  // namespace cefview
@@ -0,0 +1,153 @@
+/**
+ * @file OsrRenderStats.h
+ * @brief Counters describing off-screen rendering performance
+ *
+ * This file is part of CefView project.
+ * Licensed under BSD-style license.
+ */
+#ifndef OSRRENDERSTATS_H
+#define OSRRENDERSTATS_H
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "include/cef_render_handler.h"
+
+namespace cefview {
+
+/**
+ * @brief Rendering statistics over one sampling window
+ *
+ * Durations are in milliseconds. Averages are 0 when nothing was recorded.
+ */
+struct OsrRenderStats {
+    double windowSeconds = 0.0;         ///< Length of the sampling window
+
+    uint64_t paints = 0;                ///< OnPaint/OnAcceleratedPaint callbacks
+    double paintsPerSecond = 0.0;
+    double dirtyPixelsPerPaint = 0.0;   ///< Average area reported dirty by CEF
+
+    uint64_t uploads = 0;               ///< Software paints copied to the renderer
+    uint64_t uploadedBytes = 0;
+    double uploadMsAvg = 0.0;
+    double uploadMsMax = 0.0;
+
+    uint64_t presents = 0;              ///< Frames drawn by the renderer
+    double presentMsAvg = 0.0;
+    double presentMsMax = 0.0;
+
+    double latencyMsAvg = 0.0;          ///< First paint after a present to the next present
+    double latencyMsMax = 0.0;
+
+    uint64_t droppedFrames = 0;         ///< Paints folded into an already scheduled present
+
+    /**
+     * @brief Single-line JSON object with all fields
+     */
+    std::string toJson() const;
+};
+
+/**
+ * @brief Savings from suspending an off-screen view while it is hidden
+ *
+ * Avoided paints and upload time are estimates: the paint rate and average
+ * upload time measured before each hide, applied to the time spent hidden.
+ */
+struct OsrSuspendStats {
+    uint64_t hides = 0;                 ///< Visible to hidden transitions
+    uint64_t suspensions = 0;           ///< Hides that outlasted the grace period and released the texture
+    double hiddenSeconds = 0.0;         ///< Total time hidden, including the current hide
+    uint64_t releasedTextureBytes = 0;  ///< Texture memory released by the current suspension
+    uint64_t paintsWhileHidden = 0;     ///< Paints CEF still delivered while hidden
+    double paintsAvoided = 0.0;
+    double uploadMsAvoided = 0.0;
+
+    /**
+     * @brief Single-line JSON object with all fields
+     */
+    std::string toJson() const;
+};
+
+/**
+ * @brief Accumulates OsrRenderStats from the paint and render paths
+ *
+ * Recording only bumps relaxed atomics, so any thread may record (uploads and
+ * presents run on the render thread in OsrRendererGL's render thread mode).
+ * snapshot() reads the counters without stopping writers; a sample recorded
+ * concurrently may land in either window.
+ */
+class OsrRenderStatsCollector {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    OsrRenderStatsCollector();
+
+    /**
+     * @brief Record a paint callback
+     * @param dirtyRects Dirty rects reported by CEF
+     */
+    void recordPaint(const CefRenderHandler::RectList& dirtyRects);
+
+    /**
+     * @brief Record pixels copied into renderer resources
+     * @param bytes Bytes uploaded
+     * @param milliseconds Time spent uploading
+     */
+    void recordUpload(uint64_t bytes, double milliseconds);
+
+    /**
+     * @brief Record one drawn frame
+     * @param milliseconds Time spent drawing and presenting it
+     */
+    void recordPresent(double milliseconds);
+
+    /**
+     * @brief Record the delay between a paint and the present that shows it
+     */
+    void recordLatency(double milliseconds);
+
+    /**
+     * @brief Record a paint coalesced by the frame scheduler
+     */
+    void recordDroppedFrame() { _droppedFrames.fetch_add(1, std::memory_order_relaxed); }
+
+    /**
+     * @brief Statistics since the start of the current window
+     * @param resetWindow Start a new window after reading
+     */
+    OsrRenderStats snapshot(bool resetWindow = false);
+
+    /**
+     * @brief Milliseconds elapsed since a time point, for timing recorded sections
+     */
+    static double ElapsedMs(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+private:
+    static uint64_t ToMicroseconds(double milliseconds);
+    static void UpdateMax(std::atomic<uint64_t>& target, uint64_t value);
+
+    std::atomic<int64_t> _windowStart;  ///< Clock ticks since epoch
+
+    std::atomic<uint64_t> _paints{0};
+    std::atomic<uint64_t> _dirtyPixels{0};
+    std::atomic<uint64_t> _uploads{0};
+    std::atomic<uint64_t> _uploadedBytes{0};
+    std::atomic<uint64_t> _uploadUs{0};
+    std::atomic<uint64_t> _uploadUsMax{0};
+    std::atomic<uint64_t> _presents{0};
+    std::atomic<uint64_t> _presentUs{0};
+    std::atomic<uint64_t> _presentUsMax{0};
+    std::atomic<uint64_t> _latencies{0};
+    std::atomic<uint64_t> _latencyUs{0};
+    std::atomic<uint64_t> _latencyUsMax{0};
+    std::atomic<uint64_t> _droppedFrames{0};
+};
+
+}  // namespace cefview
+
+#endif  // OSRRENDERSTATS_H
@@ -7,10 +7,79 @@
  */
 #include "OsrRenderer.h"
 
+#include <utility>
+
 namespace cefview {
 
 OsrRenderer::OsrRenderer(bool transparent)
     : _transparent(transparent) {
 }
 
+void OsrRenderer::setTileHashEnabled(bool enabled) {
+    if (enabled != _tileHashEnabled) {
+        _tileHasher.reset();
+    }
+    _tileHashEnabled = enabled;
+}
+
+const CefRenderHandler::RectList& OsrRenderer::uploadRects(CefRenderHandler::PaintElementType type,
+                                                           const CefRenderHandler::RectList& dirtyRects,
+                                                           const void* buffer,
+                                                           int width,
+                                                           int height) {
+    // Popups are small and short-lived, so only the view layer is hashed
+    if (!_tileHashEnabled || type != PET_VIEW) {
+        _lastPaintChanged = true;
+        return _damageTracker.coalesce(dirtyRects, width, height);
+    }
+
+    const CefRenderHandler::RectList& changed = _tileHasher.filter(dirtyRects, buffer, width, height);
+    _lastPaintChanged = !changed.empty();
+    return _damageTracker.coalesce(changed, width, height);
+}
+
+bool OsrRenderer::resumeFrame() {
+    if (_suspendedFrame.empty()) {
+        return false;
+    }
+
+    PixelBuffer frame = std::move(_suspendedFrame);
+    _suspendedFrame.reset();
+    // The texture was released, so the restored frame must not be filtered as unchanged
+    _tileHasher.reset();
+    CefRenderHandler::RectList fullRect{CefRect(0, 0, _suspendedWidth, _suspendedHeight)};
+    onPaint(PET_VIEW, fullRect, frame.data(), _suspendedWidth, _suspendedHeight);
+    return true;
+}
+
+bool OsrRenderer::dropSuspendedFrame() {
+    if (_suspendedFrame.empty()) {
+        return false;
+    }
+
+    _suspendedFrame.reset();
+    // The paint lands in a new texture, so nothing may be filtered as unchanged
+    _tileHasher.reset();
+    return true;
+}
+
+bool OsrRenderer::captureFrame(PixelBuffer& pixels, int& width, int& height) {
+    if (!_suspendedFrame.empty()) {
+        // Buffers are shared by reference and the cached frame is never written again
+        pixels = _suspendedFrame;
+        width = _suspendedWidth;
+        height = _suspendedHeight;
+        return true;
+    }
+    return readbackFrame(pixels, width, height);
+}
+
+uint64_t OsrRenderer::byteCount(const CefRenderHandler::RectList& rects) {
+    uint64_t bytes = 0;
+    for (const auto& rect : rects) {
+        bytes += static_cast<uint64_t>(rect.width) * static_cast<uint64_t>(rect.height) * 4;
+    }
+    return bytes;
+}
+
 }  // namespace cefview
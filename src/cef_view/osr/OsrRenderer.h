@@ -9,8 +9,17 @@
 #define OSRRENDERER_H
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
 #include "include/cef_render_handler.h"
 
+#include "osr/OsrDamageTracker.h"
+#include "osr/OsrRenderStats.h"
+#include "osr/OsrTileHasher.h"
+#include "utils/PixelBufferPool.h"
+
 namespace cefview {
 
 /**
@@ -21,6 +30,17 @@ namespace cefview {
  */
 class OsrRenderer {
 public:
+    /**
+     * @brief How the last frame is drawn while the view size differs from it (live resize)
+     *
+     * Renderers keep the last frame's texture until CEF paints at the new
+     * size, so a resize never shows a blank view.
+     */
+    enum class ResizeMode {
+        kStretch,  ///< Scale the last frame to the new view size
+        kCrop      ///< Draw the last frame 1:1 at the top-left; crop it or leave the rest cleared
+    };
+
     virtual ~OsrRenderer() = default;
 
     // Disable copy and move
@@ -73,6 +93,23 @@ public:
                                     const CefRenderHandler::RectList& dirtyRects,
                                     const CefAcceleratedPaintInfo& info) = 0;
 
+    /**
+     * @brief Handle CEF OnPopupShow callback
+     * @param show true when the popup widget (e.g. <select> dropdown) opens, false when it closes
+     */
+    virtual void onPopupShow(bool show) {
+        _popupVisible = show;
+        if (!show) {
+            _popupRect = CefRect();
+        }
+    }
+
+    /**
+     * @brief Handle CEF OnPopupSize callback
+     * @param rect Popup rectangle in device pixels, relative to the view
+     */
+    virtual void onPopupSize(const CefRect& rect) { _popupRect = rect; }
+
     /**
      * @brief Render current frame to window
      */
@@ -97,16 +134,123 @@ public:
     int viewHeight() const { return _viewHeight; }
     bool isTransparent() const { return _transparent; }
     float deviceScaleFactor() const { return _deviceScaleFactor; }
+    bool isPopupVisible() const { return _popupVisible; }
+    const CefRect& popupRect() const { return _popupRect; }
+
+    /**
+     * @brief Dirty-rect coalescer applied to software paint uploads
+     */
+    OsrDamageTracker& damageTracker() { return _damageTracker; }
+
+    /**
+     * @brief Hash view tiles on software paints and drop regions whose pixels did not change
+     */
+    void setTileHashEnabled(bool enabled);
+    bool isTileHashEnabled() const { return _tileHashEnabled; }
+    const OsrTileHasher& tileHasher() const { return _tileHasher; }
+
+    /**
+     * @brief Whether the last onPaint() changed any pixels
+     *
+     * Always true unless tile hashing is enabled. Callers can skip the
+     * present when it returns false.
+     */
+    bool lastPaintChanged() const { return _lastPaintChanged; }
+
+    /**
+     * @brief Select how stale frames are drawn during a resize (may be called from any thread)
+     */
+    void setResizeMode(ResizeMode mode) { _resizeMode.store(mode, std::memory_order_relaxed); }
+    ResizeMode resizeMode() const { return _resizeMode.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Release the view texture while the view is hidden
+     *
+     * The last view frame is read back into system memory first so that
+     * resumeFrame() can restore it without waiting for CEF to repaint.
+     * @return Texture bytes released (0 if unsupported or nothing to release)
+     */
+    virtual uint64_t suspendFrame() { return 0; }
+
+    /**
+     * @brief Re-upload the frame cached by suspendFrame()
+     * @return true if a cached frame was restored
+     */
+    bool resumeFrame();
+
+    bool isFrameSuspended() const { return !_suspendedFrame.empty(); }
+
+    /**
+     * @brief Copy the current view frame into system memory (e.g. for a screenshot)
+     *
+     * Returns the cached frame while suspended, otherwise reads the view
+     * texture back. Popups are not included. Call on the paint thread.
+     * @param pixels Receives the frame as top-down BGRA, width * 4 bytes per row
+     * @param width Receives the frame width in pixels
+     * @param height Receives the frame height in pixels
+     * @return false if no frame is available or the renderer cannot read back
+     */
+    bool captureFrame(PixelBuffer& pixels, int& width, int& height);
+
+    /**
+     * @brief Paint, upload and present statistics for this renderer
+     *
+     * Renderers record uploads and presents; the owning view records paints,
+     * latency and frames dropped by its scheduler.
+     */
+    OsrRenderStatsCollector& renderStats() { return _renderStats; }
 
 protected:
     explicit OsrRenderer(bool transparent);
 
+    /**
+     * @brief Rects to upload for a software paint: tile-hash filtered, then coalesced
+     * @return Upload list (empty when nothing changed); valid until the next call
+     */
+    const CefRenderHandler::RectList& uploadRects(CefRenderHandler::PaintElementType type,
+                                                  const CefRenderHandler::RectList& dirtyRects,
+                                                  const void* buffer,
+                                                  int width,
+                                                  int height);
+
+    /**
+     * @brief BGRA bytes covered by a list of rects
+     */
+    static uint64_t byteCount(const CefRenderHandler::RectList& rects);
+
+    /**
+     * @brief Forget the frame cached by suspendFrame() when CEF paints while the view is hidden
+     * The paint is newer than the cached frame, so resumeFrame() must not restore it.
+     * @return true if a cached frame was dropped; the paint then has to upload the whole view
+     */
+    bool dropSuspendedFrame();
+
+    /**
+     * @brief Read the view texture back into system memory
+     * Used by captureFrame() and suspendFrame(); pixels are top-down BGRA.
+     * @return false if there is no view frame or read-back is unsupported
+     */
+    virtual bool readbackFrame(PixelBuffer& /*pixels*/, int& /*width*/, int& /*height*/) { return false; }
+
     bool _transparent = false;
     float _deviceScaleFactor = 1.0f;
     int _viewX = 0;
     int _viewY = 0;
     int _viewWidth = 0;
     int _viewHeight = 0;
+    bool _popupVisible = false;
+    CefRect _popupRect;
+    OsrDamageTracker _damageTracker;
+    OsrTileHasher _tileHasher;
+    bool _tileHashEnabled = false;
+    bool _lastPaintChanged = true;
+    OsrRenderStatsCollector _renderStats;
+    std::atomic<ResizeMode> _resizeMode{ResizeMode::kStretch};
+
+    // Last view frame (BGRA) kept in system memory while suspended
+    PixelBuffer _suspendedFrame;
+    int _suspendedWidth = 0;
+    int _suspendedHeight = 0;
 };
 
 }  // namespace cefview
@@ -7,183 +7,21 @@
  */
 #include "OsrRendererGL.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <cstring>
+#include <system_error>
 
-#if defined(WIN32)
-#include <windows.h>
-#include <gl/GL.h>
-
-// OpenGL 3.3 function pointers (loaded dynamically on Windows)
-typedef void (APIENTRY* PFNGLGENVERTEXARRAYSPROC)(GLsizei n, GLuint* arrays);
-typedef void (APIENTRY* PFNGLBINDVERTEXARRAYPROC)(GLuint array);
-typedef void (APIENTRY* PFNGLDELETEVERTEXARRAYSPROC)(GLsizei n, const GLuint* arrays);
-typedef void (APIENTRY* PFNGLGENBUFFERSPROC)(GLsizei n, GLuint* buffers);
-typedef void (APIENTRY* PFNGLBINDBUFFERPROC)(GLenum target, GLuint buffer);
-typedef void (APIENTRY* PFNGLDELETEBUFFERSPROC)(GLsizei n, const GLuint* buffers);
-typedef void (APIENTRY* PFNGLBUFFERDATAPROC)(GLenum target, ptrdiff_t size, const void* data, GLenum usage);
-typedef GLuint (APIENTRY* PFNGLCREATESHADERPROC)(GLenum type);
-typedef void (APIENTRY* PFNGLSHADERSOURCEPROC)(GLuint shader, GLsizei count, const char** string, const GLint* length);
-typedef void (APIENTRY* PFNGLCOMPILESHADERPROC)(GLuint shader);
-typedef void (APIENTRY* PFNGLGETSHADERIVPROC)(GLuint shader, GLenum pname, GLint* params);
-typedef void (APIENTRY* PFNGLGETSHADERINFOLOGPROC)(GLuint shader, GLsizei bufSize, GLsizei* length, char* infoLog);
-typedef void (APIENTRY* PFNGLDELETESHADERPROC)(GLuint shader);
-typedef GLuint (APIENTRY* PFNGLCREATEPROGRAMPROC)(void);
-typedef void (APIENTRY* PFNGLATTACHSHADERPROC)(GLuint program, GLuint shader);
-typedef void (APIENTRY* PFNGLLINKPROGRAMPROC)(GLuint program);
-typedef void (APIENTRY* PFNGLGETPROGRAMIVPROC)(GLuint program, GLenum pname, GLint* params);
-typedef void (APIENTRY* PFNGLGETPROGRAMINFOLOGPROC)(GLuint program, GLsizei bufSize, GLsizei* length, char* infoLog);
-typedef void (APIENTRY* PFNGLDELETEPROGRAMPROC)(GLuint program);
-typedef void (APIENTRY* PFNGLUSEPROGRAMPROC)(GLuint program);
-typedef GLint (APIENTRY* PFNGLGETUNIFORMLOCATIONPROC)(GLuint program, const char* name);
-typedef void (APIENTRY* PFNGLUNIFORMMATRIX4FVPROC)(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value);
-typedef void (APIENTRY* PFNGLUNIFORM1IPROC)(GLint location, GLint v0);
-typedef void (APIENTRY* PFNGLENABLEVERTEXATTRIBARRAYPROC)(GLuint index);
-typedef void (APIENTRY* PFNGLVERTEXATTRIBPOINTERPROC)(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer);
-typedef void (APIENTRY* PFNGLACTIVETEXTUREPROC)(GLenum texture);
-
-// WGL extension function pointers
-typedef HGLRC (WINAPI* PFNWGLCREATECONTEXTATTRIBSARBPROC)(HDC hDC, HGLRC hShareContext, const int* attribList);
-typedef BOOL (WINAPI* PFNWGLCHOOSEPIXELFORMATARBPROC)(HDC hdc, const int* piAttribIList, const FLOAT* pfAttribFList, UINT nMaxFormats, int* piFormats, UINT* nNumFormats);
-
-// GL constants
-#define GL_ARRAY_BUFFER 0x8892
-#define GL_STATIC_DRAW 0x88E4
-#define GL_FRAGMENT_SHADER 0x8B30
-#define GL_VERTEX_SHADER 0x8B31
-#define GL_COMPILE_STATUS 0x8B81
-#define GL_LINK_STATUS 0x8B82
-#define GL_INFO_LOG_LENGTH 0x8B84
-#define GL_TEXTURE0 0x84C0
-#define GL_BGRA 0x80E1
-#define GL_UNSIGNED_INT_8_8_8_8_REV 0x8367
-#define GL_CLAMP_TO_EDGE 0x812F
-
-// WGL constants
-#define WGL_CONTEXT_MAJOR_VERSION_ARB 0x2091
-#define WGL_CONTEXT_MINOR_VERSION_ARB 0x2092
-#define WGL_CONTEXT_PROFILE_MASK_ARB 0x9126
-#define WGL_CONTEXT_CORE_PROFILE_BIT_ARB 0x00000001
-#define WGL_DRAW_TO_WINDOW_ARB 0x2001
-#define WGL_SUPPORT_OPENGL_ARB 0x2010
-#define WGL_DOUBLE_BUFFER_ARB 0x2011
-#define WGL_PIXEL_TYPE_ARB 0x2013
-#define WGL_TYPE_RGBA_ARB 0x202B
-#define WGL_COLOR_BITS_ARB 0x2014
-#define WGL_DEPTH_BITS_ARB 0x2022
-#define WGL_STENCIL_BITS_ARB 0x2023
-
-// Global function pointers
-static PFNGLGENVERTEXARRAYSPROC glGenVertexArrays = nullptr;
-static PFNGLBINDVERTEXARRAYPROC glBindVertexArray = nullptr;
-static PFNGLDELETEVERTEXARRAYSPROC glDeleteVertexArrays = nullptr;
-static PFNGLGENBUFFERSPROC glGenBuffers = nullptr;
-static PFNGLBINDBUFFERPROC glBindBuffer = nullptr;
-static PFNGLDELETEBUFFERSPROC glDeleteBuffers = nullptr;
-static PFNGLBUFFERDATAPROC glBufferData = nullptr;
-static PFNGLCREATESHADERPROC glCreateShader = nullptr;
-static PFNGLSHADERSOURCEPROC glShaderSource = nullptr;
-static PFNGLCOMPILESHADERPROC glCompileShader = nullptr;
-static PFNGLGETSHADERIVPROC glGetShaderiv = nullptr;
-static PFNGLGETSHADERINFOLOGPROC glGetShaderInfoLog = nullptr;
-static PFNGLDELETESHADERPROC glDeleteShader = nullptr;
-static PFNGLCREATEPROGRAMPROC glCreateProgram = nullptr;
-static PFNGLATTACHSHADERPROC glAttachShader = nullptr;
-static PFNGLLINKPROGRAMPROC glLinkProgram = nullptr;
-static PFNGLGETPROGRAMIVPROC glGetProgramiv = nullptr;
-static PFNGLGETPROGRAMINFOLOGPROC glGetProgramInfoLog = nullptr;
-static PFNGLDELETEPROGRAMPROC glDeleteProgram = nullptr;
-static PFNGLUSEPROGRAMPROC glUseProgram = nullptr;
-static PFNGLGETUNIFORMLOCATIONPROC glGetUniformLocation = nullptr;
-static PFNGLUNIFORMMATRIX4FVPROC glUniformMatrix4fv = nullptr;
-static PFNGLUNIFORM1IPROC glUniform1i = nullptr;
-static PFNGLENABLEVERTEXATTRIBARRAYPROC glEnableVertexAttribArray = nullptr;
-static PFNGLVERTEXATTRIBPOINTERPROC glVertexAttribPointer = nullptr;
-static PFNGLACTIVETEXTUREPROC glActiveTexture = nullptr;
-static PFNWGLCREATECONTEXTATTRIBSARBPROC wglCreateContextAttribsARB = nullptr;
-static PFNWGLCHOOSEPIXELFORMATARBPROC wglChoosePixelFormatARB = nullptr;
-
-static bool g_glFunctionsLoaded = false;
-
-static bool LoadGLFunctions() {
-    if (g_glFunctionsLoaded) {
-        return true;
-    }
-
-    glGenVertexArrays = (PFNGLGENVERTEXARRAYSPROC)wglGetProcAddress("glGenVertexArrays");
-    glBindVertexArray = (PFNGLBINDVERTEXARRAYPROC)wglGetProcAddress("glBindVertexArray");
-    glDeleteVertexArrays = (PFNGLDELETEVERTEXARRAYSPROC)wglGetProcAddress("glDeleteVertexArrays");
-    glGenBuffers = (PFNGLGENBUFFERSPROC)wglGetProcAddress("glGenBuffers");
-    glBindBuffer = (PFNGLBINDBUFFERPROC)wglGetProcAddress("glBindBuffer");
-    glDeleteBuffers = (PFNGLDELETEBUFFERSPROC)wglGetProcAddress("glDeleteBuffers");
-    glBufferData = (PFNGLBUFFERDATAPROC)wglGetProcAddress("glBufferData");
-    glCreateShader = (PFNGLCREATESHADERPROC)wglGetProcAddress("glCreateShader");
-    glShaderSource = (PFNGLSHADERSOURCEPROC)wglGetProcAddress("glShaderSource");
-    glCompileShader = (PFNGLCOMPILESHADERPROC)wglGetProcAddress("glCompileShader");
-    glGetShaderiv = (PFNGLGETSHADERIVPROC)wglGetProcAddress("glGetShaderiv");
-    glGetShaderInfoLog = (PFNGLGETSHADERINFOLOGPROC)wglGetProcAddress("glGetShaderInfoLog");
-    glDeleteShader = (PFNGLDELETESHADERPROC)wglGetProcAddress("glDeleteShader");
-    glCreateProgram = (PFNGLCREATEPROGRAMPROC)wglGetProcAddress("glCreateProgram");
-    glAttachShader = (PFNGLATTACHSHADERPROC)wglGetProcAddress("glAttachShader");
-    glLinkProgram = (PFNGLLINKPROGRAMPROC)wglGetProcAddress("glLinkProgram");
-    glGetProgramiv = (PFNGLGETPROGRAMIVPROC)wglGetProcAddress("glGetProgramiv");
-    glGetProgramInfoLog = (PFNGLGETPROGRAMINFOLOGPROC)wglGetProcAddress("glGetProgramInfoLog");
-    glDeleteProgram = (PFNGLDELETEPROGRAMPROC)wglGetProcAddress("glDeleteProgram");
-    glUseProgram = (PFNGLUSEPROGRAMPROC)wglGetProcAddress("glUseProgram");
-    glGetUniformLocation = (PFNGLGETUNIFORMLOCATIONPROC)wglGetProcAddress("glGetUniformLocation");
-    glUniformMatrix4fv = (PFNGLUNIFORMMATRIX4FVPROC)wglGetProcAddress("glUniformMatrix4fv");
-    glUniform1i = (PFNGLUNIFORM1IPROC)wglGetProcAddress("glUniform1i");
-    glEnableVertexAttribArray = (PFNGLENABLEVERTEXATTRIBARRAYPROC)wglGetProcAddress("glEnableVertexAttribArray");
-    glVertexAttribPointer = (PFNGLVERTEXATTRIBPOINTERPROC)wglGetProcAddress("glVertexAttribPointer");
-    glActiveTexture = (PFNGLACTIVETEXTUREPROC)wglGetProcAddress("glActiveTexture");
-
-    g_glFunctionsLoaded = (glGenVertexArrays && glBindVertexArray && glGenBuffers &&
-                           glBindBuffer && glBufferData && glCreateShader &&
-                           glShaderSource && glCompileShader && glCreateProgram &&
-                           glAttachShader && glLinkProgram && glUseProgram &&
-                           glGetUniformLocation && glUniformMatrix4fv && glUniform1i &&
-                           glEnableVertexAttribArray && glVertexAttribPointer && glActiveTexture);
-
-    return g_glFunctionsLoaded;
-}
-
-#elif defined(__APPLE__)
-#include <OpenGL/gl3.h>
-#else
-#define GL_GLEXT_PROTOTYPES
-#include <GL/gl.h>
-#include <GL/glx.h>
-#endif
+#include "OsrCompositorGL.h"
+#include "OsrGLDevice.h"
+#include "OsrGLFunctions.h"
 
 #include "utils/LogUtil.h"
+#include "utils/PixelKernels.h"
 
 namespace cefview {
 
-// Vertex shader source (OpenGL 3.3)
-static const char* g_vertexShaderSource = R"(
-#version 330 core
-out vec2 texCoord;
-uniform mat4 transform;
-void main() {
-    float x = float(((uint(gl_VertexID) + 2u) / 3u) % 2u);
-    float y = float(((uint(gl_VertexID) + 1u) / 3u) % 2u);
-    vec4 pos = vec4(-1.0f + x * 2.0f, -1.0f + y * 2.0f, 0.0f, 1.0f);
-    gl_Position = transform * pos;
-    texCoord = vec2(x, 1.0f - y);
-}
-)";
-
-// Fragment shader source (OpenGL 3.3)
-static const char* g_fragmentShaderSource = R"(
-#version 330 core
-out vec4 fragColor;
-in vec2 texCoord;
-uniform sampler2D tex;
-void main() {
-    fragColor = texture(tex, texCoord);
-}
-)";
-
 OsrRendererGL::OsrRendererGL(NativeWindowHandle hwnd, int width, int height, bool transparent)
     : OsrRenderer(transparent)
 #if defined(WIN32)
@@ -205,43 +43,35 @@ OsrRendererGL::~OsrRendererGL() {
 bool OsrRendererGL::initialize() {
     LOGD << "OsrRendererGL::initialize() called";
 
+    // Program and context limits come from the process-wide share group
+    _device = OsrGLDevice::Acquire();
+    if (!_device) {
+        LOGE << "OsrGLDevice::Acquire() FAILED";
+        return false;
+    }
+
     if (!createGLContext()) {
         LOGE << "createGLContext() FAILED";
+        _device.reset();
         return false;
     }
     LOGD << "createGLContext() OK";
 
     makeCurrent();
 
-#if defined(WIN32)
-    if (!LoadGLFunctions()) {
-        LOGE << "LoadGLFunctions() FAILED";
-        destroyGLContext();
-        return false;
-    }
-    LOGD << "LoadGLFunctions() OK";
-#endif
+    // Layer textures are created on the first paint, once the buffer size is known
+    _maxTextureSize = _device->maxTextureSize();
 
-    if (!createShaderProgram()) {
-        LOGE << "createShaderProgram() FAILED";
-        destroyGLContext();
-        return false;
-    }
-    LOGD << "createShaderProgram() OK";
-
-    if (!createTexture()) {
-        LOGE << "createTexture() FAILED";
-        destroyGLContext();
-        return false;
-    }
-    LOGD << "createTexture() OK";
-
-    // Create VAO and VBO
+    // Vertex arrays are never shared between contexts; this one stays empty
+    // because the quad is generated from gl_VertexID
     glGenVertexArrays(1, &_vao);
     glBindVertexArray(_vao);
-    glGenBuffers(1, &_vbo);
-    glBindBuffer(GL_ARRAY_BUFFER, _vbo);
-    glBufferData(GL_ARRAY_BUFFER, 0, nullptr, GL_STATIC_DRAW);
+
+    if (createPixelBuffers()) {
+        LOGD << "createPixelBuffers() OK";
+    } else {
+        LOGW << "Pixel unpack buffers unavailable, using direct texture upload";
+    }
 
     // Set clear color
     if (_transparent) {
@@ -251,6 +81,17 @@ bool OsrRendererGL::initialize() {
     }
 
     _initialized = true;
+
+    if (_renderThreadEnabled) {
+        // The render thread takes ownership of the context
+        doneCurrent();
+        if (!startRenderThread()) {
+            LOGW << "Render thread unavailable, rendering on the paint thread";
+            _renderThreadEnabled = false;
+            makeCurrent();
+        }
+    }
+
     LOGI << "OsrRendererGL initialized successfully";
     return true;
 }
@@ -260,103 +101,94 @@ void OsrRendererGL::uninitialize() {
         return;
     }
 
+    stopRenderThread();
+    // Give the frame copies back to the pool
+    for (int i = 0; i < 3; ++i) {
+        FrameSlot& slot = _frames.slot(i);
+        slot.pixels.reset();
+        slot.width = 0;
+        slot.height = 0;
+        _slotStaleFull[i] = true;
+    }
+    _popupStaging.reset();
+    if (auto compositor = _compositor.lock()) {
+        compositor->removeLayer(this);
+    }
     makeCurrent();
 
-    if (_textureId != 0) {
-        glDeleteTextures(1, &_textureId);
-        _textureId = 0;
+    if (_uploadFence) {
+        glDeleteSync(static_cast<GLsync>(_uploadFence));
+        _uploadFence = nullptr;
     }
 
-    if (_vbo != 0) {
-        glDeleteBuffers(1, &_vbo);
-        _vbo = 0;
-    }
+    destroyPixelBuffers();
+
+    destroyLayer(_viewLayer);
+    destroyLayer(_popupLayer);
 
     if (_vao != 0) {
         glDeleteVertexArrays(1, &_vao);
         _vao = 0;
     }
 
-    if (_shaderProgram != 0) {
-        glDeleteProgram(_shaderProgram);
-        _shaderProgram = 0;
-    }
-
     destroyGLContext();
+    _device.reset();
     _initialized = false;
 }
 
-bool OsrRendererGL::createGLContext() {
-#if defined(WIN32)
-    _hdc = GetDC(_hwnd);
-    if (!_hdc) {
-        LOGE << "GetDC() FAILED";
-        return false;
+uint64_t OsrRendererGL::suspendFrame() {
+    int width = 0;
+    int height = 0;
+    if (!readbackFrame(_suspendedFrame, width, height)) {
+        return 0;
     }
+    _suspendedWidth = width;
+    _suspendedHeight = height;
 
-    // Create a dummy context to load WGL extensions
-    PIXELFORMATDESCRIPTOR pfd = {};
-    pfd.nSize = sizeof(pfd);
-    pfd.nVersion = 1;
-    pfd.dwFlags = PFD_DRAW_TO_WINDOW | PFD_SUPPORT_OPENGL | PFD_DOUBLEBUFFER;
-    pfd.iPixelType = PFD_TYPE_RGBA;
-    pfd.cColorBits = 32;
-    pfd.cDepthBits = 24;
-    pfd.cStencilBits = 8;
-    pfd.iLayerType = PFD_MAIN_PLANE;
-
-    int pixelFormat = ChoosePixelFormat(_hdc, &pfd);
-    if (pixelFormat == 0) {
-        LOGE << "ChoosePixelFormat() FAILED";
-        ReleaseDC(_hwnd, _hdc);
-        _hdc = nullptr;
-        return false;
-    }
+    destroyLayer(_viewLayer);
+    LOGD << "View texture released " << width << "x" << height;
+    return _suspendedFrame.size();
+}
 
-    if (!SetPixelFormat(_hdc, pixelFormat, &pfd)) {
-        LOGE << "SetPixelFormat() FAILED";
-        ReleaseDC(_hwnd, _hdc);
-        _hdc = nullptr;
+bool OsrRendererGL::readbackFrame(PixelBuffer& pixels, int& width, int& height) {
+    // In render thread mode the textures belong to the render thread's context
+    if (!_initialized || _renderThreadEnabled || _viewLayer.tiles.empty()) {
         return false;
     }
 
-    HGLRC tempContext = wglCreateContext(_hdc);
-    if (!tempContext) {
-        LOGE << "wglCreateContext() FAILED";
-        ReleaseDC(_hwnd, _hdc);
-        _hdc = nullptr;
+    makeCurrent();
+    width = _viewLayer.width;
+    height = _viewLayer.height;
+    pixels = PixelBufferPool::Shared().acquire(static_cast<size_t>(width) * static_cast<size_t>(height) * 4);
+    if (!pixels) {
+        LOGE << "readbackFrame() failed to allocate a " << width << "x" << height << " frame";
         return false;
     }
-
-    wglMakeCurrent(_hdc, tempContext);
-
-    // Load WGL extensions
-    wglCreateContextAttribsARB = (PFNWGLCREATECONTEXTATTRIBSARBPROC)wglGetProcAddress("wglCreateContextAttribsARB");
-
-    if (wglCreateContextAttribsARB) {
-        // Create OpenGL 3.3 core context
-        int attribs[] = {
-            WGL_CONTEXT_MAJOR_VERSION_ARB, 3,
-            WGL_CONTEXT_MINOR_VERSION_ARB, 3,
-            WGL_CONTEXT_PROFILE_MASK_ARB, WGL_CONTEXT_CORE_PROFILE_BIT_ARB,
-            0
-        };
-
-        _hglrc = wglCreateContextAttribsARB(_hdc, nullptr, attribs);
+    glPixelStorei(GL_PACK_ROW_LENGTH, width);
+    for (const auto& tile : _viewLayer.tiles) {
+        uint8_t* dest = pixels.data() +
+                        (static_cast<size_t>(tile.bounds.y) * static_cast<size_t>(width) +
+                         static_cast<size_t>(tile.bounds.x)) * 4;
+        glBindTexture(GL_TEXTURE_2D, tile.textureId);
+        glGetTexImage(GL_TEXTURE_2D, 0, GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, dest);
     }
+    glPixelStorei(GL_PACK_ROW_LENGTH, 0);
+    return true;
+}
 
-    wglMakeCurrent(nullptr, nullptr);
-    wglDeleteContext(tempContext);
+bool OsrRendererGL::createGLContext() {
+#if defined(WIN32)
+    _hdc = GetDC(_hwnd);
+    if (!_hdc) {
+        LOGE << "GetDC() FAILED";
+        return false;
+    }
 
+    _hglrc = _device->createContext(_hdc);
     if (!_hglrc) {
-        LOGE << "wglCreateContextAttribsARB() FAILED, falling back to legacy context";
-        _hglrc = wglCreateContext(_hdc);
-        if (!_hglrc) {
-            LOGE << "wglCreateContext() FAILED";
-            ReleaseDC(_hwnd, _hdc);
-            _hdc = nullptr;
-            return false;
-        }
+        ReleaseDC(_hwnd, _hdc);
+        _hdc = nullptr;
+        return false;
     }
 
     return true;
@@ -365,9 +197,20 @@ bool OsrRendererGL::createGLContext() {
     // Not implemented in this version
     return false;
 #else
-    // Linux implementation would use GLX
-    // Not implemented in this version
-    return false;
+    _eglContext = _device->createContext();
+    if (!_eglContext) {
+        return false;
+    }
+    if (!_device->isSurfaceless()) {
+        _eglSurface = _device->createSurface();
+        if (!_eglSurface) {
+            eglDestroyContext(_device->eglDisplay(), _eglContext);
+            _eglContext = nullptr;
+            return false;
+        }
+    }
+    // The draw target is created on the first drawFrame(), once the view size is known
+    return true;
 #endif
 }
 
@@ -385,7 +228,27 @@ void OsrRendererGL::destroyGLContext() {
 #elif defined(__APPLE__)
     // Mac cleanup
 #else
-    // Linux cleanup
+    if (_eglContext) {
+        // Framebuffer objects are not shared; delete them in their own context
+        makeCurrent();
+        if (_framebuffer != 0) {
+            glDeleteFramebuffers(1, &_framebuffer);
+            _framebuffer = 0;
+        }
+        if (_colorRenderbuffer != 0) {
+            glDeleteRenderbuffers(1, &_colorRenderbuffer);
+            _colorRenderbuffer = 0;
+        }
+        _framebufferWidth = 0;
+        _framebufferHeight = 0;
+        doneCurrent();
+        eglDestroyContext(_device->eglDisplay(), _eglContext);
+        _eglContext = nullptr;
+    }
+    if (_eglSurface) {
+        eglDestroySurface(_device->eglDisplay(), _eglSurface);
+        _eglSurface = nullptr;
+    }
 #endif
 }
 
@@ -397,7 +260,21 @@ void OsrRendererGL::makeCurrent() {
 #elif defined(__APPLE__)
     // Mac make current
 #else
-    // Linux make current
+    if (_eglContext) {
+        eglMakeCurrent(_device->eglDisplay(), _eglSurface, _eglSurface, _eglContext);
+    }
+#endif
+}
+
+void OsrRendererGL::doneCurrent() {
+#if defined(WIN32)
+    wglMakeCurrent(nullptr, nullptr);
+#elif defined(__APPLE__)
+    // Mac clear current
+#else
+    if (_device) {
+        eglMakeCurrent(_device->eglDisplay(), EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    }
 #endif
 }
 
@@ -409,74 +286,70 @@ void OsrRendererGL::swapBuffers() {
 #elif defined(__APPLE__)
     // Mac swap buffers
 #else
-    // Linux swap buffers
+    // Nothing to present to; submit the frame so it completes without a reader waiting
+    glFlush();
 #endif
 }
 
-bool OsrRendererGL::createShaderProgram() {
-    GLint success = 0;
-    char infoLog[512] = {};
-
-    // Create vertex shader
-    GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertexShader, 1, &g_vertexShaderSource, nullptr);
-    glCompileShader(vertexShader);
-    glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &success);
-    if (!success) {
-        glGetShaderInfoLog(vertexShader, 512, nullptr, infoLog);
-        LOGE << "Vertex shader compile error: " << infoLog;
-        glDeleteShader(vertexShader);
-        return false;
+#if !defined(WIN32) && !defined(__APPLE__)
+bool OsrRendererGL::resizeFramebuffer(int width, int height) {
+    if (_framebuffer != 0 && width == _framebufferWidth && height == _framebufferHeight) {
+        return true;
     }
 
-    // Create fragment shader
-    GLuint fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragmentShader, 1, &g_fragmentShaderSource, nullptr);
-    glCompileShader(fragmentShader);
-    glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &success);
-    if (!success) {
-        glGetShaderInfoLog(fragmentShader, 512, nullptr, infoLog);
-        LOGE << "Fragment shader compile error: " << infoLog;
-        glDeleteShader(vertexShader);
-        glDeleteShader(fragmentShader);
-        return false;
+    if (_framebuffer == 0) {
+        glGenFramebuffers(1, &_framebuffer);
+        glGenRenderbuffers(1, &_colorRenderbuffer);
     }
-
-    // Create shader program
-    _shaderProgram = glCreateProgram();
-    glAttachShader(_shaderProgram, vertexShader);
-    glAttachShader(_shaderProgram, fragmentShader);
-    glLinkProgram(_shaderProgram);
-    glGetProgramiv(_shaderProgram, GL_LINK_STATUS, &success);
-    if (!success) {
-        glGetProgramInfoLog(_shaderProgram, 512, nullptr, infoLog);
-        LOGE << "Shader program link error: " << infoLog;
-        glDeleteShader(vertexShader);
-        glDeleteShader(fragmentShader);
-        glDeleteProgram(_shaderProgram);
-        _shaderProgram = 0;
+    glBindRenderbuffer(GL_RENDERBUFFER, _colorRenderbuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    glBindFramebuffer(GL_FRAMEBUFFER, _framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, _colorRenderbuffer);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        LOGE << "Off-screen framebuffer " << width << "x" << height << " incomplete";
+        _framebufferWidth = 0;
+        _framebufferHeight = 0;
         return false;
     }
 
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
+    _framebufferWidth = width;
+    _framebufferHeight = height;
+    LOGD << "Off-screen framebuffer resized to " << width << "x" << height;
+    return true;
+}
 
-    // Get uniform locations
-    glUseProgram(_shaderProgram);
-    _transformLoc = glGetUniformLocation(_shaderProgram, "transform");
-    glUniform1i(glGetUniformLocation(_shaderProgram, "tex"), 0);
+bool OsrRendererGL::readFrame(std::vector<uint8_t>& pixels, int& width, int& height) {
+    // In render thread mode the framebuffer belongs to the render thread's context
+    if (!_initialized || _renderThreadEnabled || _framebufferWidth <= 0 || _framebufferHeight <= 0) {
+        return false;
+    }
 
+    makeCurrent();
+    width = _framebufferWidth;
+    height = _framebufferHeight;
+    const size_t pitch = static_cast<size_t>(width) * 4;
+    pixels.resize(pitch * static_cast<size_t>(height));
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glReadPixels(0, 0, width, height, GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, pixels.data());
+
+    // GL rows run bottom-up
+    for (size_t top = 0, bottom = static_cast<size_t>(height) - 1; top < bottom; ++top, --bottom) {
+        std::swap_ranges(pixels.begin() + static_cast<ptrdiff_t>(top * pitch),
+                         pixels.begin() + static_cast<ptrdiff_t>((top + 1) * pitch),
+                         pixels.begin() + static_cast<ptrdiff_t>(bottom * pitch));
+    }
     return true;
 }
+#endif
 
-bool OsrRendererGL::createTexture() {
-    glGenTextures(1, &_textureId);
-    if (_textureId == 0) {
+bool OsrRendererGL::createTexture(unsigned int& textureId) {
+    glGenTextures(1, &textureId);
+    if (textureId == 0) {
         LOGE << "glGenTextures() FAILED";
         return false;
     }
 
-    glBindTexture(GL_TEXTURE_2D, _textureId);
+    glBindTexture(GL_TEXTURE_2D, textureId);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -485,11 +358,165 @@ bool OsrRendererGL::createTexture() {
     return true;
 }
 
+bool OsrRendererGL::layoutLayer(TextureLayer& layer, const void* buffer, int width, int height) {
+    const int maxSize = _maxTextureSize > 0 ? _maxTextureSize : kTileSize;
+    const bool tiled = _tiledTexturesEnabled || width > maxSize || height > maxSize;
+    const int tileSize = tiled ? std::min(kTileSize, maxSize) : std::max(width, height);
+
+    const int columns = (width + tileSize - 1) / tileSize;
+    const int rows = (height + tileSize - 1) / tileSize;
+    const size_t tileCount = static_cast<size_t>(columns) * static_cast<size_t>(rows);
+
+    // Reuse texture names across relayouts; only the storage is respecified
+    while (layer.tiles.size() > tileCount) {
+        glDeleteTextures(1, &layer.tiles.back().textureId);
+        layer.tiles.pop_back();
+    }
+    while (layer.tiles.size() < tileCount) {
+        TextureTile tile;
+        if (!createTexture(tile.textureId)) {
+            destroyLayer(layer);
+            return false;
+        }
+        layer.tiles.push_back(tile);
+    }
+
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, width);
+    for (int row = 0; row < rows; ++row) {
+        for (int col = 0; col < columns; ++col) {
+            TextureTile& tile = layer.tiles[static_cast<size_t>(row * columns + col)];
+            tile.bounds = CefRect(col * tileSize, row * tileSize,
+                                  std::min(tileSize, width - col * tileSize),
+                                  std::min(tileSize, height - row * tileSize));
+            glPixelStorei(GL_UNPACK_SKIP_PIXELS, tile.bounds.x);
+            glPixelStorei(GL_UNPACK_SKIP_ROWS, tile.bounds.y);
+            glBindTexture(GL_TEXTURE_2D, tile.textureId);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, tile.bounds.width, tile.bounds.height, 0,
+                         GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, buffer);
+        }
+    }
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+    glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+
+    layer.width = width;
+    layer.height = height;
+    if (&layer == &_viewLayer) {
+        _viewTileCount.store(static_cast<int>(tileCount), std::memory_order_relaxed);
+    }
+    LOGD << "Layer laid out " << width << "x" << height << " as " << columns << "x" << rows << " tiles";
+    return true;
+}
+
+void OsrRendererGL::destroyLayer(TextureLayer& layer) {
+    for (auto& tile : layer.tiles) {
+        glDeleteTextures(1, &tile.textureId);
+    }
+    layer.tiles.clear();
+    layer.width = 0;
+    layer.height = 0;
+    if (&layer == &_viewLayer) {
+        _viewTileCount.store(0, std::memory_order_relaxed);
+    }
+}
+
+bool OsrRendererGL::createPixelBuffers() {
+#if defined(WIN32)
+    if (!glMapBufferRange || !glUnmapBuffer) {
+        return false;
+    }
+#endif
+
+    glGenBuffers(kPixelBufferCount, _pixelBuffers);
+    for (int i = 0; i < kPixelBufferCount; ++i) {
+        if (_pixelBuffers[i] == 0) {
+            LOGE << "glGenBuffers() FAILED for pixel unpack buffer";
+            destroyPixelBuffers();
+            return false;
+        }
+    }
+
+    _pixelBufferIndex = 0;
+    _pixelBuffersEnabled = true;
+    return true;
+}
+
+void OsrRendererGL::destroyPixelBuffers() {
+    for (int i = 0; i < kPixelBufferCount; ++i) {
+        if (_pixelBuffers[i] != 0) {
+            glDeleteBuffers(1, &_pixelBuffers[i]);
+            _pixelBuffers[i] = 0;
+        }
+    }
+    _pixelBuffersEnabled = false;
+}
+
+bool OsrRendererGL::uploadWithPixelBuffer(const std::vector<TileUpload>& uploads,
+                                          const void* buffer,
+                                          int width) {
+    size_t totalBytes = 0;
+    for (const auto& upload : uploads) {
+        totalBytes += static_cast<size_t>(upload.rect.width) * static_cast<size_t>(upload.rect.height) * 4;
+    }
+    if (totalBytes == 0) {
+        return true;
+    }
+
+    // Rotate through the ring and orphan the store so the driver never waits
+    // on a buffer the GPU may still be reading from
+    _pixelBufferIndex = (_pixelBufferIndex + 1) % kPixelBufferCount;
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _pixelBuffers[_pixelBufferIndex]);
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<ptrdiff_t>(totalBytes), nullptr, GL_STREAM_DRAW);
+
+    void* mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<ptrdiff_t>(totalBytes),
+                                    GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    if (!mapped) {
+        LOGE << "glMapBufferRange() FAILED, disabling pixel unpack buffers";
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        destroyPixelBuffers();
+        return false;
+    }
+
+    // Pack each dirty rect tightly into the mapped buffer. The mapping is
+    // usually write-combined memory, so use non-temporal stores
+    const size_t srcPitch = static_cast<size_t>(width) * 4;
+    uint8_t* dst = static_cast<uint8_t*>(mapped);
+    for (const auto& upload : uploads) {
+        const CefRect& rect = upload.rect;
+        const size_t rowBytes = static_cast<size_t>(rect.width) * 4;
+        const uint8_t* src = static_cast<const uint8_t*>(buffer) +
+                             static_cast<size_t>(rect.y) * srcPitch + static_cast<size_t>(rect.x) * 4;
+        PixelKernels::StreamRect(src, srcPitch, dst, rowBytes, rect.width, rect.height);
+        dst += rowBytes * static_cast<size_t>(rect.height);
+    }
+    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+    // Texture updates now source from the buffer object and return without
+    // waiting for the copy to complete
+    size_t offset = 0;
+    unsigned int boundTexture = 0;
+    for (const auto& upload : uploads) {
+        const CefRect& rect = upload.rect;
+        if (upload.textureId != boundTexture) {
+            glBindTexture(GL_TEXTURE_2D, upload.textureId);
+            boundTexture = upload.textureId;
+        }
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, rect.width);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, rect.x - upload.tileX, rect.y - upload.tileY, rect.width, rect.height,
+                        GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, reinterpret_cast<const void*>(offset));
+        offset += static_cast<size_t>(rect.width) * static_cast<size_t>(rect.height) * 4;
+    }
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    return true;
+}
+
 void OsrRendererGL::setBounds(int x, int y, int width, int height) {
     if (width <= 0 || height <= 0) {
         return;
     }
 
+    std::lock_guard<std::mutex> lock(_stateMutex);
     _viewX = x;
     _viewY = y;
     _viewWidth = width;
@@ -505,36 +532,90 @@ void OsrRendererGL::onPaint(CefRenderHandler::PaintElementType type,
         return;
     }
 
-    if (type != PET_VIEW) {
+    // A paint while suspended replaces the cached frame; the released layer is laid out again in full
+    if (type == PET_VIEW) {
+        dropSuspendedFrame();
+    }
+
+    if (_renderThreadEnabled) {
+        // Only copy pixels here; the render thread uploads and presents
+        if (type == PET_POPUP) {
+            stagePopup(buffer, width, height);
+        } else {
+            const CefRenderHandler::RectList& rects = uploadRects(type, dirtyRects, buffer, width, height);
+            if (!rects.empty()) {
+                publishFrame(rects, buffer, width, height);
+            }
+        }
+        return;
+    }
+
+    const CefRenderHandler::RectList& rects = uploadRects(type, dirtyRects, buffer, width, height);
+    if (rects.empty()) {
         return;
     }
 
     makeCurrent();
 
-    glBindTexture(GL_TEXTURE_2D, _textureId);
+    auto uploadStart = std::chrono::steady_clock::now();
 
-    // Check if we need to resize texture
-    static int lastWidth = 0;
-    static int lastHeight = 0;
+    // The popup has its own layer so opening or moving it never re-uploads the view
+    uint64_t bytes = uploadLayer(type == PET_POPUP ? _popupLayer : _viewLayer, rects, buffer, width, height);
 
-    if (width != lastWidth || height != lastHeight) {
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0,
-                     GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, buffer);
-        lastWidth = width;
-        lastHeight = height;
-        LOGD << "onPaint() texture resized " << width << "x" << height;
-    } else {
+    double uploadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - uploadStart).count();
+    _lastUploadTimeMs.store(uploadMs, std::memory_order_relaxed);
+    _renderStats.recordUpload(bytes, uploadMs);
+}
+
+uint64_t OsrRendererGL::uploadLayer(TextureLayer& layer,
+                                    const CefRenderHandler::RectList& rects,
+                                    const void* buffer,
+                                    int width,
+                                    int height) {
+    if (width != layer.width || height != layer.height) {
+        layoutLayer(layer, buffer, width, height);
+        return static_cast<uint64_t>(width) * static_cast<uint64_t>(height) * 4;
+    }
+
+    // Split the dirty rects along tile boundaries
+    _tileUploads.clear();
+    for (const auto& tile : layer.tiles) {
+        for (const auto& rect : rects) {
+            const int left = std::max(rect.x, tile.bounds.x);
+            const int top = std::max(rect.y, tile.bounds.y);
+            const int right = std::min(rect.x + rect.width, tile.bounds.x + tile.bounds.width);
+            const int bottom = std::min(rect.y + rect.height, tile.bounds.y + tile.bounds.height);
+            if (right > left && bottom > top) {
+                _tileUploads.push_back(
+                    TileUpload{tile.textureId, CefRect(left, top, right - left, bottom - top), tile.bounds.x, tile.bounds.y});
+            }
+        }
+    }
+
+    if (!_pixelBuffersEnabled || !uploadWithPixelBuffer(_tileUploads, buffer, width)) {
         glPixelStorei(GL_UNPACK_ROW_LENGTH, width);
-        for (const auto& rect : dirtyRects) {
+        unsigned int boundTexture = 0;
+        for (const auto& upload : _tileUploads) {
+            const CefRect& rect = upload.rect;
+            if (upload.textureId != boundTexture) {
+                glBindTexture(GL_TEXTURE_2D, upload.textureId);
+                boundTexture = upload.textureId;
+            }
             glPixelStorei(GL_UNPACK_SKIP_PIXELS, rect.x);
             glPixelStorei(GL_UNPACK_SKIP_ROWS, rect.y);
-            glTexSubImage2D(GL_TEXTURE_2D, 0, rect.x, rect.y, rect.width, rect.height,
+            glTexSubImage2D(GL_TEXTURE_2D, 0, rect.x - upload.tileX, rect.y - upload.tileY, rect.width, rect.height,
                             GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, buffer);
         }
         glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
         glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
         glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
     }
+
+    uint64_t bytes = 0;
+    for (const auto& upload : _tileUploads) {
+        bytes += static_cast<uint64_t>(upload.rect.width) * static_cast<uint64_t>(upload.rect.height) * 4;
+    }
+    return bytes;
 }
 
 void OsrRendererGL::onAcceleratedPaint(CefRenderHandler::PaintElementType type,
@@ -549,18 +630,49 @@ void OsrRendererGL::render() {
         return;
     }
 
+    if (_renderThreadEnabled) {
+        {
+            std::lock_guard<std::mutex> lock(_renderMutex);
+            _renderRequested = true;
+        }
+        _renderCondition.notify_one();
+        return;
+    }
+
+    if (auto compositor = _compositor.lock()) {
+        // Uploads were issued in onPaint(); the compositor draws and presents
+        makeCurrent();
+        fenceUploads();
+        compositor->invalidate();
+        return;
+    }
+
     makeCurrent();
+    drawFrame();
+}
+
+void OsrRendererGL::drawFrame() {
+    auto presentStart = std::chrono::steady_clock::now();
+    int viewWidth = 0;
+    int viewHeight = 0;
+    bool popupVisible = false;
+    CefRect popupRect;
+    {
+        std::lock_guard<std::mutex> lock(_stateMutex);
+        viewWidth = _viewWidth;
+        viewHeight = _viewHeight;
+        popupVisible = _popupVisible;
+        popupRect = _popupRect;
+    }
+
+#if !defined(WIN32) && !defined(__APPLE__)
+    if (viewWidth <= 0 || viewHeight <= 0 || !resizeFramebuffer(viewWidth, viewHeight)) {
+        return;
+    }
+#endif
 
     glClear(GL_COLOR_BUFFER_BIT);
-    glViewport(0, 0, _viewWidth, _viewHeight);
-
-    // Identity transform matrix
-    float transform[16] = {
-        1.0f, 0.0f, 0.0f, 0.0f,
-        0.0f, 1.0f, 0.0f, 0.0f,
-        0.0f, 0.0f, 1.0f, 0.0f,
-        0.0f, 0.0f, 0.0f, 1.0f
-    };
+    glViewport(0, 0, viewWidth, viewHeight);
 
     if (_transparent) {
         glEnable(GL_BLEND);
@@ -568,19 +680,331 @@ void OsrRendererGL::render() {
     }
 
     glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, _textureId);
-
-    glUseProgram(_shaderProgram);
-    glUniformMatrix4fv(_transformLoc, 1, GL_FALSE, transform);
-
+    glUseProgram(_device->program());
     glBindVertexArray(_vao);
-    glDrawArrays(GL_TRIANGLES, 0, 6);
+
+    // Until CEF paints at the new size the layer holds the previous frame:
+    // stretch it over the viewport or draw it 1:1
+    CefRect viewDest(0, 0, viewWidth, viewHeight);
+    if (resizeMode() == ResizeMode::kCrop && _viewLayer.width > 0 && _viewLayer.height > 0) {
+        viewDest = CefRect(0, 0, _viewLayer.width, _viewLayer.height);
+    }
+    drawLayer(_viewLayer, viewDest, viewWidth, viewHeight);
 
     if (_transparent) {
         glDisable(GL_BLEND);
     }
 
+    if (popupVisible) {
+        drawLayer(_popupLayer, popupRect, viewWidth, viewHeight);
+    }
+
     swapBuffers();
+
+    _renderStats.recordPresent(
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - presentStart).count());
+}
+
+void OsrRendererGL::drawLayer(const TextureLayer& layer, const CefRect& dest, int viewWidth, int viewHeight) {
+    if (layer.tiles.empty() || layer.width <= 0 || layer.height <= 0 ||
+        dest.IsEmpty() || viewWidth <= 0 || viewHeight <= 0) {
+        return;
+    }
+
+    const float width = static_cast<float>(viewWidth);
+    const float height = static_cast<float>(viewHeight);
+    const float layerScaleX = static_cast<float>(dest.width) / static_cast<float>(layer.width);
+    const float layerScaleY = static_cast<float>(dest.height) / static_cast<float>(layer.height);
+
+    for (const auto& tile : layer.tiles) {
+        // Tile rect in view pixels (origin top-left)
+        const float x = static_cast<float>(dest.x) + static_cast<float>(tile.bounds.x) * layerScaleX;
+        const float y = static_cast<float>(dest.y) + static_cast<float>(tile.bounds.y) * layerScaleY;
+        const float w = static_cast<float>(tile.bounds.width) * layerScaleX;
+        const float h = static_cast<float>(tile.bounds.height) * layerScaleY;
+
+        // Map the unit quad onto the tile rect
+        const float scaleX = w / width;
+        const float scaleY = h / height;
+        const float translateX = (2.0f * x + w) / width - 1.0f;
+        const float translateY = 1.0f - (2.0f * y + h) / height;
+
+        glBindTexture(GL_TEXTURE_2D, tile.textureId);
+        glVertexAttrib4f(OsrGLDevice::kTransformAttribute, scaleX, scaleY, translateX, translateY);
+        glDrawArrays(GL_TRIANGLES, 0, 6);
+    }
+}
+
+void OsrRendererGL::drawComposited(const CefRect& dest, int targetWidth, int targetHeight) {
+    int viewWidth = 0;
+    int viewHeight = 0;
+    bool popupVisible = false;
+    CefRect popupRect;
+    {
+        std::lock_guard<std::mutex> lock(_stateMutex);
+        viewWidth = _viewWidth;
+        viewHeight = _viewHeight;
+        popupVisible = _popupVisible;
+        popupRect = _popupRect;
+    }
+
+    drawLayer(_viewLayer, dest, targetWidth, targetHeight);
+
+    if (popupVisible && viewWidth > 0 && viewHeight > 0) {
+        // Popup rect is in view pixels; scale it with the layer
+        const float scaleX = static_cast<float>(dest.width) / static_cast<float>(viewWidth);
+        const float scaleY = static_cast<float>(dest.height) / static_cast<float>(viewHeight);
+        CefRect popupDest(dest.x + static_cast<int>(std::lround(static_cast<float>(popupRect.x) * scaleX)),
+                          dest.y + static_cast<int>(std::lround(static_cast<float>(popupRect.y) * scaleY)),
+                          static_cast<int>(std::lround(static_cast<float>(popupRect.width) * scaleX)),
+                          static_cast<int>(std::lround(static_cast<float>(popupRect.height) * scaleY)));
+        drawLayer(_popupLayer, popupDest, targetWidth, targetHeight);
+    }
+}
+
+void OsrRendererGL::fenceUploads() {
+#if defined(WIN32)
+    if (!glFenceSync || !glWaitSync || !glDeleteSync) {
+        glFinish();
+        return;
+    }
+#endif
+    if (_uploadFence) {
+        glDeleteSync(static_cast<GLsync>(_uploadFence));
+    }
+    _uploadFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    // The fence must reach the GPU before another context waits on it
+    glFlush();
+}
+
+void OsrRendererGL::waitUploadFence() {
+    if (!_uploadFence) {
+        return;
+    }
+    glWaitSync(static_cast<GLsync>(_uploadFence), 0, GL_TIMEOUT_IGNORED);
+    glDeleteSync(static_cast<GLsync>(_uploadFence));
+    _uploadFence = nullptr;
+}
+
+void OsrRendererGL::onPopupShow(bool show) {
+    std::lock_guard<std::mutex> lock(_stateMutex);
+    OsrRenderer::onPopupShow(show);
+    if (!show && !_renderThreadEnabled) {
+        // Force a full upload when the popup is shown again
+        _popupLayer.width = 0;
+        _popupLayer.height = 0;
+    }
+}
+
+void OsrRendererGL::onPopupSize(const CefRect& rect) {
+    std::lock_guard<std::mutex> lock(_stateMutex);
+    OsrRenderer::onPopupSize(rect);
+}
+
+void OsrRendererGL::setTiledTexturesEnabled(bool enabled) {
+    if (_initialized) {
+        LOGW << "setTiledTexturesEnabled() ignored after initialize()";
+        return;
+    }
+    _tiledTexturesEnabled = enabled;
+}
+
+void OsrRendererGL::setRenderThreadEnabled(bool enabled) {
+    if (_initialized) {
+        LOGW << "setRenderThreadEnabled() ignored after initialize()";
+        return;
+    }
+    _renderThreadEnabled = enabled;
+}
+
+void OsrRendererGL::publishFrame(const CefRenderHandler::RectList& dirtyRects,
+                                 const void* buffer,
+                                 int width,
+                                 int height) {
+    FrameSlot& slot = _frames.writeSlot();
+    const int index = _frames.writeIndex();
+    const size_t pitch = static_cast<size_t>(width) * 4;
+    const unsigned char* src = static_cast<const unsigned char*>(buffer);
+
+    // Keep our own copy of the damage first: dirtyRects may be the damage
+    // tracker's list, which the coalesce() below reuses
+    const bool sizeChanged = slot.width != width || slot.height != height;
+    _damageHistory.push_back(DamageRecord{0, dirtyRects, sizeChanged});
+    const CefRenderHandler::RectList& damage = _damageHistory.back().rects;
+
+    if (sizeChanged) {
+        slot.pixels = PixelBufferPool::Shared().acquire(pitch * static_cast<size_t>(height));
+        if (!slot.pixels) {
+            LOGE << "publishFrame() failed to allocate a " << width << "x" << height << " frame";
+            slot.width = 0;
+            slot.height = 0;
+            _damageHistory.pop_back();
+            return;
+        }
+        slot.width = width;
+        slot.height = height;
+        _slotStaleFull[index] = true;
+    }
+
+    // CEF's buffer always holds the complete frame, so the slot catches up on
+    // everything it missed while the other slots were being written
+    auto copyRects = [&](const CefRenderHandler::RectList& rects) {
+        for (const auto& rect : rects) {
+            const size_t offset = static_cast<size_t>(rect.y) * pitch + static_cast<size_t>(rect.x) * 4;
+            PixelKernels::CopyRect(src + offset, pitch, slot.pixels.data() + offset, pitch, rect.width, rect.height);
+        }
+    };
+    if (_slotStaleFull[index]) {
+        std::memcpy(slot.pixels.data(), src, pitch * static_cast<size_t>(height));
+    } else {
+        copyRects(_slotStaleRects[index]);
+        copyRects(damage);
+    }
+    _slotStaleFull[index] = false;
+    _slotStaleRects[index].clear();
+
+    for (int i = 0; i < 3; ++i) {
+        if (i == index || _slotStaleFull[i]) {
+            continue;
+        }
+        if (_slotStaleRects[i].size() + damage.size() > 32) {
+            _slotStaleFull[i] = true;
+            _slotStaleRects[i].clear();
+        } else {
+            _slotStaleRects[i].insert(_slotStaleRects[i].end(), damage.begin(), damage.end());
+        }
+    }
+
+    // The render thread may have skipped frames, so upload the damage of every
+    // frame published since the one it last consumed
+    slot.seq = ++_publishedSeq;
+    _damageHistory.back().seq = slot.seq;
+
+    const uint64_t consumed = _consumedSeq.load(std::memory_order_acquire);
+    while (!_damageHistory.empty() && _damageHistory.front().seq <= consumed) {
+        _damageHistory.pop_front();
+    }
+    while (_damageHistory.size() > kMaxDamageHistory) {
+        _damageHistory.pop_front();
+    }
+
+    bool full = _damageHistory.empty() || _damageHistory.front().seq != consumed + 1;
+    CefRenderHandler::RectList pending;
+    for (const auto& record : _damageHistory) {
+        if (record.full) {
+            full = true;
+            break;
+        }
+        pending.insert(pending.end(), record.rects.begin(), record.rects.end());
+    }
+    if (full) {
+        slot.uploadRects.assign(1, CefRect(0, 0, width, height));
+    } else {
+        slot.uploadRects = _damageTracker.coalesce(pending, width, height);
+    }
+
+    _frames.publish();
+}
+
+void OsrRendererGL::stagePopup(const void* buffer, int width, int height) {
+    const unsigned char* src = static_cast<const unsigned char*>(buffer);
+    const size_t size = static_cast<size_t>(width) * static_cast<size_t>(height) * 4;
+
+    // A fresh buffer each time: the render thread may still hold the previous one
+    PixelBuffer staging = PixelBufferPool::Shared().acquire(size);
+    if (!staging) {
+        return;
+    }
+    std::memcpy(staging.data(), src, size);
+
+    std::lock_guard<std::mutex> lock(_stateMutex);
+    _popupStaging = staging;
+    _popupStagingWidth = width;
+    _popupStagingHeight = height;
+    _popupStagingDirty = true;
+}
+
+void OsrRendererGL::uploadPendingFrames() {
+    auto uploadStart = std::chrono::steady_clock::now();
+    bool uploaded = false;
+    uint64_t bytes = 0;
+
+    if (_frames.acquire()) {
+        const FrameSlot& slot = _frames.readSlot();
+        bytes += uploadLayer(_viewLayer, slot.uploadRects, slot.pixels.data(), slot.width, slot.height);
+        _consumedSeq.store(slot.seq, std::memory_order_release);
+        uploaded = true;
+    }
+
+    PixelBuffer popup;
+    int popupWidth = 0;
+    int popupHeight = 0;
+    {
+        std::lock_guard<std::mutex> lock(_stateMutex);
+        if (_popupStagingDirty) {
+            popup = _popupStaging;
+            _popupStaging.reset();
+            popupWidth = _popupStagingWidth;
+            popupHeight = _popupStagingHeight;
+            _popupStagingDirty = false;
+        }
+    }
+    if (!popup.empty()) {
+        CefRenderHandler::RectList rects(1, CefRect(0, 0, popupWidth, popupHeight));
+        bytes += uploadLayer(_popupLayer, rects, popup.data(), popupWidth, popupHeight);
+        uploaded = true;
+    }
+
+    if (uploaded) {
+        double uploadMs =
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - uploadStart).count();
+        _lastUploadTimeMs.store(uploadMs, std::memory_order_relaxed);
+        _renderStats.recordUpload(bytes, uploadMs);
+    }
+}
+
+bool OsrRendererGL::startRenderThread() {
+    _renderThreadStop = false;
+    _renderRequested = false;
+    try {
+        _renderThread = std::thread(&OsrRendererGL::renderThreadMain, this);
+    } catch (const std::system_error& e) {
+        LOGE << "Failed to start render thread: " << e.what();
+        return false;
+    }
+    return true;
+}
+
+void OsrRendererGL::stopRenderThread() {
+    if (!_renderThread.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(_renderMutex);
+        _renderThreadStop = true;
+    }
+    _renderCondition.notify_one();
+    _renderThread.join();
+}
+
+void OsrRendererGL::renderThreadMain() {
+    makeCurrent();
+
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(_renderMutex);
+            _renderCondition.wait(lock, [this] { return _renderRequested || _renderThreadStop; });
+            if (_renderThreadStop) {
+                break;
+            }
+            _renderRequested = false;
+        }
+
+        uploadPendingFrames();
+        drawFrame();
+    }
+
+    doneCurrent();
 }
 
 }  // namespace cefview
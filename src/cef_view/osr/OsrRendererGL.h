@@ -9,24 +9,55 @@
 #define OSRRENDERERGL_H
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 #include "OsrRenderer.h"
+#include "OsrTripleBuffer.h"
+#include "utils/PixelBufferPool.h"
 
 #if defined(WIN32)
 #include <windows.h>
 #elif defined(__APPLE__)
 // Mac forward declarations
-#else
-// Linux forward declarations
 #endif
 
 namespace cefview {
 
+class OsrCompositorGL;
+class OsrGLDevice;
+
 /**
  * @brief OpenGL 3.3 shader-based renderer for CEF off-screen rendering mode
  *
  * Cross-platform OpenGL implementation using modern shader pipeline.
  * Supports OnPaint (software rendering) on all platforms.
  * OnAcceleratedPaint is only supported on Mac (IOSurface).
+ *
+ * With the render thread enabled, onPaint() only copies dirty pixels into a
+ * triple-buffered frame slot and render() wakes a dedicated thread that owns
+ * the GL context, uploads the newest frame and presents it. The paint thread
+ * never waits on the driver.
+ *
+ * Each layer (view, popup) is stored as one texture, or as a grid of tiles
+ * when the frame exceeds GL_MAX_TEXTURE_SIZE or tiling is forced. Dirty rects
+ * are split per tile, so a partial upload only touches the tiles it hits.
+ *
+ * All instances share one OsrGLDevice: their contexts join its share group
+ * and draw with its program, so a renderer only owns per-view objects.
+ * Attached to an OsrCompositorGL, a renderer uploads as usual but leaves
+ * drawing and presenting to the compositor.
+ *
+ * On Linux the context comes from EGL (surfaceless where available) and
+ * frames are drawn into a framebuffer object sized to the view instead of a
+ * window, so the renderer runs headless, e.g. on Mesa llvmpipe in CI.
+ * readFrame() returns the last drawn frame.
  */
 class OsrRendererGL : public OsrRenderer {
 public:
@@ -35,7 +66,7 @@ public:
 #elif defined(__APPLE__)
     using NativeWindowHandle = void*;  // NSView*
 #else
-    using NativeWindowHandle = unsigned long;  // X11 Window
+    using NativeWindowHandle = unsigned long;  // X11 Window, unused: frames stay off-screen
 #endif
 
     /**
@@ -65,16 +96,179 @@ public:
                             const CefRenderHandler::RectList& dirtyRects,
                             const CefAcceleratedPaintInfo& info) override;
     void render() override;
+    uint64_t suspendFrame() override;
+    void onPopupShow(bool show) override;
+    void onPopupSize(const CefRect& rect) override;
+
+    /**
+     * @brief Upload and present on a dedicated render thread
+     * Must be called before initialize().
+     * @param enabled true to enable the render thread
+     */
+    void setRenderThreadEnabled(bool enabled);
+    bool isRenderThreadEnabled() const { return _renderThreadEnabled; }
+
+    /**
+     * @brief Always split layers into kTileSize tiles, even below GL_MAX_TEXTURE_SIZE
+     * Must be called before initialize().
+     */
+    void setTiledTexturesEnabled(bool enabled);
+
+    /**
+     * @brief Number of textures the view layer is currently stored in (1 when untiled)
+     */
+    int viewTileCount() const { return _viewTileCount.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief GL_MAX_TEXTURE_SIZE of the context (0 before initialize())
+     */
+    int maxTextureSize() const { return _maxTextureSize; }
+
+    /**
+     * @brief CPU time spent in the last texture upload, in milliseconds
+     */
+    double lastUploadTimeMs() const { return _lastUploadTimeMs.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Whether uploads go through the pixel unpack buffer ring
+     */
+    bool isPixelBufferEnabled() const { return _pixelBuffersEnabled; }
+
+    /**
+     * @brief Whether an OsrCompositorGL presents this renderer's frames
+     */
+    bool isComposited() const { return !_compositor.expired(); }
+
+#if !defined(WIN32) && !defined(__APPLE__)
+    /**
+     * @brief Read back the last drawn frame as top-down BGRA
+     * Call on the paint thread; not available with the render thread enabled.
+     * @return false if nothing has been drawn yet
+     */
+    bool readFrame(std::vector<uint8_t>& pixels, int& width, int& height);
+#endif
 
 protected:
+    /// Side length of layer tiles, clamped to GL_MAX_TEXTURE_SIZE
+    static constexpr int kTileSize = 1024;
+
+    /// One texture of a layer holding the bounds region of the paint buffer
+    struct TextureTile {
+        unsigned int textureId = 0;
+        CefRect bounds;
+    };
+
+    /// A paint layer stored as a single texture or a grid of tiles
+    struct TextureLayer {
+        std::vector<TextureTile> tiles;
+        int width = 0;   ///< Size of the paint buffer the tiles were laid out for
+        int height = 0;
+    };
+
+    /// Part of a dirty rect that falls inside one tile
+    struct TileUpload {
+        unsigned int textureId = 0;
+        CefRect rect;      ///< In paint buffer pixels
+        int tileX = 0;     ///< Tile origin in paint buffer pixels
+        int tileY = 0;
+    };
+
+    bool readbackFrame(PixelBuffer& pixels, int& width, int& height) override;
+
     bool createGLContext();
     void destroyGLContext();
-    bool createShaderProgram();
-    bool createTexture();
+    bool createTexture(unsigned int& textureId);
+
+    /**
+     * @brief Lay the layer out for a new buffer size and upload the whole buffer
+     * Existing texture names are reused; surplus tiles are deleted.
+     */
+    bool layoutLayer(TextureLayer& layer, const void* buffer, int width, int height);
+    void destroyLayer(TextureLayer& layer);
+
+    /**
+     * @brief Upload a paint buffer into a layer, laying it out again on size change
+     * @param rects Already coalesced rects to upload
+     * @return Bytes uploaded
+     */
+    uint64_t uploadLayer(TextureLayer& layer,
+                         const CefRenderHandler::RectList& rects,
+                         const void* buffer,
+                         int width,
+                         int height);
+
+    /**
+     * @brief Draw every tile of a layer, mapping the layer onto dest (view pixels)
+     */
+    void drawLayer(const TextureLayer& layer, const CefRect& dest, int viewWidth, int viewHeight);
+
+    /**
+     * @brief Clear, draw the view and popup, and swap (GL context must be current)
+     */
+    void drawFrame();
+
     void makeCurrent();
+    void doneCurrent();
     void swapBuffers();
 
+#if !defined(WIN32) && !defined(__APPLE__)
+    /**
+     * @brief Create or resize the off-screen draw target and bind it
+     */
+    bool resizeFramebuffer(int width, int height);
+#endif
+
+    /**
+     * @brief Copy a view paint into the triple buffer (render thread mode, paint thread)
+     */
+    void publishFrame(const CefRenderHandler::RectList& dirtyRects, const void* buffer, int width, int height);
+
+    /**
+     * @brief Copy a popup paint into the staging buffer (render thread mode, paint thread)
+     */
+    void stagePopup(const void* buffer, int width, int height);
+
+    /**
+     * @brief Upload the newest published frame and staged popup (render thread)
+     */
+    void uploadPendingFrames();
+
+    /**
+     * @brief Draw the view and popup layers into dest of the compositor's target
+     * Called by OsrCompositorGL with its context current.
+     */
+    void drawComposited(const CefRect& dest, int targetWidth, int targetHeight);
+
+    /**
+     * @brief Fence the uploads issued so far so another context can sample them
+     */
+    void fenceUploads();
+
+    /**
+     * @brief Make the current context wait for the last fenced uploads
+     */
+    void waitUploadFence();
+
+    bool startRenderThread();
+    void stopRenderThread();
+    void renderThreadMain();
+
+    /**
+     * @brief Create the pixel unpack buffer ring used for asynchronous uploads
+     * @return false if buffer objects are unavailable
+     */
+    bool createPixelBuffers();
+    void destroyPixelBuffers();
+
+    /**
+     * @brief Copy tile uploads into the next pixel unpack buffer and start the texture uploads
+     * @return false if the buffer could not be mapped (caller should upload directly)
+     */
+    bool uploadWithPixelBuffer(const std::vector<TileUpload>& uploads, const void* buffer, int width);
+
 private:
+    friend class OsrCompositorGL;
+
 #if defined(WIN32)
     HWND _hwnd = nullptr;
     HDC _hdc = nullptr;
@@ -84,16 +278,73 @@ private:
     void* _nsGLContext = nullptr;
 #else
     unsigned long _window = 0;
-    void* _display = nullptr;
-    void* _glxContext = nullptr;
+    void* _eglContext = nullptr;  ///< EGLContext
+    void* _eglSurface = nullptr;  ///< EGLSurface, only without surfaceless support
+    unsigned int _framebuffer = 0;
+    unsigned int _colorRenderbuffer = 0;
+    int _framebufferWidth = 0;
+    int _framebufferHeight = 0;
 #endif
 
-    // OpenGL 3.3 resources
+    // Shared program and context limits; per-view vertex array
+    std::shared_ptr<OsrGLDevice> _device;
     unsigned int _vao = 0;
-    unsigned int _vbo = 0;
-    unsigned int _textureId = 0;
-    unsigned int _shaderProgram = 0;
-    int _transformLoc = -1;
+
+    // Compositing (UI thread only)
+    std::weak_ptr<OsrCompositorGL> _compositor;
+    void* _uploadFence = nullptr;  ///< GLsync
+
+    // View (PET_VIEW) and popup (PET_POPUP) layers; GL thread only
+    TextureLayer _viewLayer;
+    TextureLayer _popupLayer;
+    std::vector<TileUpload> _tileUploads;
+    int _maxTextureSize = 0;
+    bool _tiledTexturesEnabled = false;
+    std::atomic<int> _viewTileCount{0};
+
+    // Pixel unpack buffer ring for asynchronous texture upload
+    static constexpr int kPixelBufferCount = 3;
+    unsigned int _pixelBuffers[kPixelBufferCount] = {};
+    int _pixelBufferIndex = 0;
+    bool _pixelBuffersEnabled = false;
+    std::atomic<double> _lastUploadTimeMs{0.0};
+
+    // Render thread mode
+    struct FrameSlot {
+        PixelBuffer pixels;
+        int width = 0;
+        int height = 0;
+        uint64_t seq = 0;
+        CefRenderHandler::RectList uploadRects;  // Damage since the last frame the render thread consumed
+    };
+    struct DamageRecord {
+        uint64_t seq = 0;
+        CefRenderHandler::RectList rects;
+        bool full = false;
+    };
+    static constexpr size_t kMaxDamageHistory = 8;
+
+    bool _renderThreadEnabled = false;
+    std::thread _renderThread;
+    std::mutex _renderMutex;
+    std::condition_variable _renderCondition;
+    bool _renderRequested = false;
+    bool _renderThreadStop = false;
+
+    OsrTripleBuffer<FrameSlot> _frames;
+    std::atomic<uint64_t> _consumedSeq{0};
+    // Paint-thread only
+    uint64_t _publishedSeq = 0;
+    std::deque<DamageRecord> _damageHistory;
+    CefRenderHandler::RectList _slotStaleRects[3];
+    bool _slotStaleFull[3] = {true, true, true};
+
+    // Guards bounds, popup state and the staged popup buffer shared with the render thread
+    std::mutex _stateMutex;
+    PixelBuffer _popupStaging;
+    int _popupStagingWidth = 0;
+    int _popupStagingHeight = 0;
+    bool _popupStagingDirty = false;
 
     bool _initialized = false;
 };
@@ -0,0 +1,310 @@
+/**
+ * @file OsrRendererSoftware.cpp
+ * @brief CPU-only off-screen renderer implementation
+ *
+ * This file is part of CefView project.
+ * Licensed under BSD-style license.
+ */
+#include "OsrRendererSoftware.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "utils/LogUtil.h"
+#include "utils/PixelKernels.h"
+
+namespace cefview {
+
+namespace {
+
+constexpr size_t kLayerAlignment = 64;
+constexpr int kBytesPerPixel = 4;
+constexpr size_t kMaxPendingDirtyRects = 64;
+
+CefRect IntersectRect(const CefRect& a, const CefRect& b) {
+    int left = std::max(a.x, b.x);
+    int top = std::max(a.y, b.y);
+    int right = std::min(a.x + a.width, b.x + b.width);
+    int bottom = std::min(a.y + a.height, b.y + b.height);
+    if (right <= left || bottom <= top) {
+        return CefRect();
+    }
+    return CefRect(left, top, right - left, bottom - top);
+}
+
+}  // namespace
+
+bool OsrRendererSoftware::Layer::resize(int newWidth, int newHeight) {
+    if (newWidth == width && newHeight == height && data) {
+        return true;
+    }
+
+    const size_t rowBytes = static_cast<size_t>(newWidth) * kBytesPerPixel;
+    const size_t alignedStride = (rowBytes + kLayerAlignment - 1) & ~(kLayerAlignment - 1);
+    PixelBuffer buffer = PixelBufferPool::Shared().acquire(alignedStride * static_cast<size_t>(newHeight));
+    if (!buffer) {
+        LOGE << "OsrRendererSoftware: failed to allocate " << newWidth << "x" << newHeight << " layer";
+        reset();
+        return false;
+    }
+
+    data = buffer;
+    width = newWidth;
+    height = newHeight;
+    stride = static_cast<int>(alignedStride);
+    // Pooled memory may hold an earlier frame
+    std::memset(data.data(), 0, alignedStride * static_cast<size_t>(newHeight));
+    return true;
+}
+
+void OsrRendererSoftware::Layer::reset() {
+    data.reset();
+    width = 0;
+    height = 0;
+    stride = 0;
+}
+
+OsrRendererSoftware::OsrRendererSoftware(int width, int height, bool transparent)
+    : OsrRenderer(transparent) {
+    _viewWidth = width;
+    _viewHeight = height;
+}
+
+OsrRendererSoftware::~OsrRendererSoftware() {
+    uninitialize();
+}
+
+bool OsrRendererSoftware::initialize() {
+    _initialized = true;
+    return true;
+}
+
+void OsrRendererSoftware::uninitialize() {
+    if (!_initialized) {
+        return;
+    }
+
+    _view.reset();
+    _popup.reset();
+    _composed.reset();
+    _composing = false;
+    _pendingDirty.clear();
+    _initialized = false;
+}
+
+void OsrRendererSoftware::setBounds(int x, int y, int width, int height) {
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+
+    _viewX = x;
+    _viewY = y;
+    _viewWidth = width;
+    _viewHeight = height;
+}
+
+const uint8_t* OsrRendererSoftware::frameData() const {
+    return _composing ? _composed.data.data() : _view.data.data();
+}
+
+bool OsrRendererSoftware::readbackFrame(PixelBuffer& pixels, int& width, int& height) {
+    if (_view.data.empty()) {
+        return false;
+    }
+    // The view layer has a padded stride; captures are tightly packed
+    width = _view.width;
+    height = _view.height;
+    const size_t pitch = static_cast<size_t>(width) * kBytesPerPixel;
+    pixels = PixelBufferPool::Shared().acquire(pitch * static_cast<size_t>(height));
+    if (!pixels) {
+        LOGE << "OsrRendererSoftware: failed to allocate a " << width << "x" << height << " capture";
+        return false;
+    }
+    PixelKernels::CopyRect(_view.data.data(), static_cast<size_t>(_view.stride), pixels.data(), pitch, width, height);
+    return true;
+}
+
+void OsrRendererSoftware::copyRects(Layer& layer,
+                                    const CefRenderHandler::RectList& rects,
+                                    const void* buffer,
+                                    int bufferWidth) {
+    if (rects.empty()) {
+        return;
+    }
+    auto uploadStart = OsrRenderStatsCollector::Clock::now();
+    const size_t srcPitch = static_cast<size_t>(bufferWidth) * kBytesPerPixel;
+    const uint8_t* src = static_cast<const uint8_t*>(buffer);
+    for (const auto& rect : rects) {
+        const size_t xOffset = static_cast<size_t>(rect.x) * kBytesPerPixel;
+        PixelKernels::CopyRect(src + static_cast<size_t>(rect.y) * srcPitch + xOffset, srcPitch,
+                               layer.row(rect.y) + xOffset, static_cast<size_t>(layer.stride),
+                               rect.width, rect.height);
+    }
+    _renderStats.recordUpload(byteCount(rects), OsrRenderStatsCollector::ElapsedMs(uploadStart));
+}
+
+void OsrRendererSoftware::onPaint(CefRenderHandler::PaintElementType type,
+                                  const CefRenderHandler::RectList& dirtyRects,
+                                  const void* buffer,
+                                  int width,
+                                  int height) {
+    if (!_initialized || !buffer || width <= 0 || height <= 0) {
+        return;
+    }
+
+    if (type == PET_POPUP) {
+        bool sizeChanged = _popup.width != width || _popup.height != height;
+        if (!_popup.resize(width, height)) {
+            return;
+        }
+        if (sizeChanged) {
+            copyRects(_popup, CefRenderHandler::RectList(1, CefRect(0, 0, width, height)), buffer, width);
+            _lastPaintChanged = true;
+        } else {
+            copyRects(_popup, uploadRects(type, dirtyRects, buffer, width, height), buffer, width);
+        }
+        if (_composing) {
+            CefRect area = clipToFrame(_popupRect);
+            composeRect(area);
+            addDirtyRect(area);
+        }
+        return;
+    }
+
+    if (_view.width != width || _view.height != height) {
+        if (!_view.resize(width, height)) {
+            return;
+        }
+        copyRects(_view, CefRenderHandler::RectList(1, CefRect(0, 0, width, height)), buffer, width);
+        if (_composing) {
+            _composing = false;
+            beginComposition();
+        }
+        _pendingDirty.assign(1, CefRect(0, 0, width, height));
+        _lastPaintChanged = true;
+        return;
+    }
+
+    const CefRenderHandler::RectList& rects = uploadRects(type, dirtyRects, buffer, width, height);
+    copyRects(_view, rects, buffer, width);
+    for (const auto& rect : rects) {
+        if (_composing) {
+            composeRect(rect);
+        }
+        addDirtyRect(rect);
+    }
+}
+
+void OsrRendererSoftware::onAcceleratedPaint(CefRenderHandler::PaintElementType type,
+                                             const CefRenderHandler::RectList& dirtyRects,
+                                             const CefAcceleratedPaintInfo& info) {
+    // Shared textures need a GPU; browsers using this renderer must disable shared_texture_enabled
+    LOGW << "OsrRendererSoftware does not support OnAcceleratedPaint";
+}
+
+void OsrRendererSoftware::render() {
+    if (!_initialized || !_view.data) {
+        return;
+    }
+
+    auto presentStart = OsrRenderStatsCollector::Clock::now();
+    ++_frameCount;
+    if (_frameCallback) {
+        _frameCallback(frameData(), _view.width, _view.height, _view.stride,
+                       _damageTracker.coalesce(_pendingDirty, _view.width, _view.height));
+    }
+    _pendingDirty.clear();
+    _renderStats.recordPresent(OsrRenderStatsCollector::ElapsedMs(presentStart));
+}
+
+void OsrRendererSoftware::onPopupShow(bool show) {
+    CefRect oldRect = clipToFrame(_popupRect);
+    OsrRenderer::onPopupShow(show);
+
+    if (!show) {
+        // Without a popup the view layer is the frame again
+        _composing = false;
+        _composed.reset();
+        _popup.reset();
+        addDirtyRect(oldRect);
+        return;
+    }
+    beginComposition();
+}
+
+void OsrRendererSoftware::onPopupSize(const CefRect& rect) {
+    CefRect oldRect = clipToFrame(_popupRect);
+    OsrRenderer::onPopupSize(rect);
+    CefRect newRect = clipToFrame(_popupRect);
+
+    if (!_composing) {
+        return;
+    }
+    composeRect(oldRect);
+    composeRect(newRect);
+    addDirtyRect(oldRect);
+    addDirtyRect(newRect);
+}
+
+bool OsrRendererSoftware::beginComposition() {
+    if (_composing || !_view.data) {
+        return _composing;
+    }
+    if (!_composed.resize(_view.width, _view.height)) {
+        return false;
+    }
+
+    _composing = true;
+    composeRect(CefRect(0, 0, _view.width, _view.height));
+    addDirtyRect(clipToFrame(_popupRect));
+    return true;
+}
+
+void OsrRendererSoftware::composeRect(const CefRect& rect) {
+    CefRect area = clipToFrame(rect);
+    if (area.IsEmpty()) {
+        return;
+    }
+
+    const size_t xOffset = static_cast<size_t>(area.x) * kBytesPerPixel;
+    const size_t stride = static_cast<size_t>(_view.stride);
+    PixelKernels::CopyRect(_view.row(area.y) + xOffset, stride, _composed.row(area.y) + xOffset, stride,
+                           area.width, area.height);
+
+    if (!_popupVisible || !_popup.data) {
+        return;
+    }
+
+    // Popups are opaque widgets, so they replace the view pixels underneath
+    CefRect popupArea(_popupRect.x, _popupRect.y,
+                      std::min(_popupRect.width, _popup.width),
+                      std::min(_popupRect.height, _popup.height));
+    CefRect overlap = IntersectRect(area, popupArea);
+    if (overlap.IsEmpty()) {
+        return;
+    }
+
+    const size_t dstX = static_cast<size_t>(overlap.x) * kBytesPerPixel;
+    const size_t srcX = static_cast<size_t>(overlap.x - _popupRect.x) * kBytesPerPixel;
+    PixelKernels::CopyRect(_popup.row(overlap.y - _popupRect.y) + srcX, static_cast<size_t>(_popup.stride),
+                           _composed.row(overlap.y) + dstX, static_cast<size_t>(_composed.stride),
+                           overlap.width, overlap.height);
+}
+
+void OsrRendererSoftware::addDirtyRect(const CefRect& rect) {
+    if (rect.IsEmpty()) {
+        return;
+    }
+    // Bound the list when render() is not called for a while
+    if (_pendingDirty.size() >= kMaxPendingDirtyRects) {
+        _pendingDirty.assign(1, CefRect(0, 0, _view.width, _view.height));
+        return;
+    }
+    _pendingDirty.push_back(rect);
+}
+
+CefRect OsrRendererSoftware::clipToFrame(const CefRect& rect) const {
+    return IntersectRect(rect, CefRect(0, 0, _view.width, _view.height));
+}
+
+}  // namespace cefview
@@ -0,0 +1,146 @@
+/**
+ * @file OsrRendererSoftware.h
+ * @brief CPU-only off-screen renderer keeping the composed frame in memory
+ *
+ * This file is part of CefView project.
+ * Licensed under BSD-style license.
+ */
+#ifndef OSRRENDERERSOFTWARE_H
+#define OSRRENDERERSOFTWARE_H
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include "OsrRenderer.h"
+#include "utils/PixelBufferPool.h"
+
+namespace cefview {
+
+/**
+ * @brief Software renderer for headless and GPU-less environments
+ *
+ * Keeps the view and popup layers in 64-byte aligned BGRA framebuffers and
+ * applies dirty rects incrementally. While a popup is visible, a composed
+ * frame (view plus popup) is maintained; otherwise the view layer is the
+ * frame. Consumers read the frame in place through frameData() or the frame
+ * callback invoked by render(); no copy is made.
+ *
+ * Not thread-safe: call from the CEF UI thread. Frame pointers stay valid
+ * until the next onPaint()/onPopup*() call or a size change.
+ */
+class OsrRendererSoftware : public OsrRenderer {
+public:
+    /**
+     * @brief Called by render() with the current frame
+     * @param pixels BGRA pixels, top-down, premultiplied alpha
+     * @param width Frame width in pixels
+     * @param height Frame height in pixels
+     * @param stride Bytes per row
+     * @param dirtyRects Regions changed since the previous render()
+     */
+    using FrameCallback = std::function<void(const uint8_t* pixels,
+                                             int width,
+                                             int height,
+                                             int stride,
+                                             const CefRenderHandler::RectList& dirtyRects)>;
+
+    /**
+     * @brief Constructor
+     * @param width Initial view width
+     * @param height Initial view height
+     * @param transparent Enable transparent rendering
+     */
+    OsrRendererSoftware(int width, int height, bool transparent = false);
+    ~OsrRendererSoftware() override;
+
+    // OsrRenderer interface
+    bool initialize() override;
+    void uninitialize() override;
+    void setBounds(int x, int y, int width, int height) override;
+    void onPaint(CefRenderHandler::PaintElementType type,
+                 const CefRenderHandler::RectList& dirtyRects,
+                 const void* buffer,
+                 int width,
+                 int height) override;
+    void onAcceleratedPaint(CefRenderHandler::PaintElementType type,
+                            const CefRenderHandler::RectList& dirtyRects,
+                            const CefAcceleratedPaintInfo& info) override;
+    void render() override;
+    void onPopupShow(bool show) override;
+    void onPopupSize(const CefRect& rect) override;
+
+    /**
+     * @brief Set the callback invoked by render() with the composed frame
+     */
+    void setFrameCallback(FrameCallback callback) { _frameCallback = std::move(callback); }
+
+    // Zero-copy frame access
+    const uint8_t* frameData() const;
+    int frameWidth() const { return _view.width; }
+    int frameHeight() const { return _view.height; }
+    int frameStride() const { return _view.stride; }
+
+    /**
+     * @brief Number of frames presented by render()
+     */
+    uint64_t frameCount() const { return _frameCount; }
+
+    /**
+     * @brief Regions changed since the previous render()
+     */
+    const CefRenderHandler::RectList& pendingDirtyRects() const { return _pendingDirty; }
+
+protected:
+    /// Page-aligned BGRA layer with a 64-byte padded stride, borrowed from PixelBufferPool
+    struct Layer {
+        PixelBuffer data;
+        int width = 0;
+        int height = 0;
+        int stride = 0;
+
+        bool resize(int newWidth, int newHeight);
+        void reset();
+        uint8_t* row(int y) const { return data.data() + static_cast<size_t>(y) * static_cast<size_t>(stride); }
+    };
+
+    bool readbackFrame(PixelBuffer& pixels, int& width, int& height) override;
+
+    /**
+     * @brief Copy rects from a tightly packed CEF buffer into a layer
+     */
+    void copyRects(Layer& layer,
+                   const CefRenderHandler::RectList& rects,
+                   const void* buffer,
+                   int bufferWidth);
+
+    /**
+     * @brief Rebuild a region of the composed frame from the view and popup layers
+     */
+    void composeRect(const CefRect& rect);
+
+    /**
+     * @brief Start maintaining the composed frame (popup became visible)
+     */
+    bool beginComposition();
+
+    void addDirtyRect(const CefRect& rect);
+    CefRect clipToFrame(const CefRect& rect) const;
+
+protected:
+    Layer _view;
+    Layer _popup;
+    Layer _composed;
+    bool _composing = false;
+
+    CefRenderHandler::RectList _pendingDirty;
+    FrameCallback _frameCallback;
+    uint64_t _frameCount = 0;
+    bool _initialized = false;
+};
+
+}  // namespace cefview
+
+#endif  // OSRRENDERERSOFTWARE_H
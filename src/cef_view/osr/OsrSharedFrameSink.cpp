@@ -0,0 +1,354 @@
+/**
+ * @file OsrSharedFrameSink.cpp
+ * @brief Shared memory frame export implementation
+ *
+ * This file is part of CefView project.
+ * Licensed under BSD-style license.
+ */
+#include "OsrSharedFrameSink.h"
+
+#include "utils/LogUtil.h"
+
+#if defined(WIN32)
+
+namespace cefview {
+
+// POSIX shared memory only: the sink never opens on Windows
+OsrSharedFrameSink::OsrSharedFrameSink(const std::string& name)
+    : _name(name)
+    , _slotDamage() {
+}
+
+OsrSharedFrameSink::~OsrSharedFrameSink() {
+}
+
+bool OsrSharedFrameSink::open(int, int) {
+    LOGE << "Shared memory frame export is not supported on Windows";
+    return false;
+}
+
+void OsrSharedFrameSink::close() {
+}
+
+bool OsrSharedFrameSink::publish(const CefRenderHandler::RectList&, const void*, int, int) {
+    return false;
+}
+
+}  // namespace cefview
+
+#else
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+#include "cefview_frame_shm.h"
+
+#include "utils/PixelKernels.h"
+
+namespace cefview {
+
+static_assert(OsrSharedFrameSink::kSlotCount == CVF_SLOT_COUNT, "slot count must match the shared layout");
+
+namespace {
+
+constexpr size_t kBytesPerPixel = 4;
+constexpr size_t kPageBytes = 4096;
+// Beyond this, a slot's pending damage is collapsed to its bounds
+constexpr size_t kMaxDamageRects = 32;
+
+size_t AlignToPage(size_t bytes) {
+    return (bytes + kPageBytes - 1) & ~(kPageBytes - 1);
+}
+
+// Fields readers may see change are written with atomic stores, as the C reader loads them
+template <typename T>
+void StoreRelaxed(T* field, T value) {
+    __atomic_store_n(field, value, __ATOMIC_RELAXED);
+}
+
+template <typename T>
+void StoreRelease(T* field, T value) {
+    __atomic_store_n(field, value, __ATOMIC_RELEASE);
+}
+
+void WakeReaders(uint32_t* word) {
+    __atomic_add_fetch(word, 1u, __ATOMIC_RELEASE);
+#if defined(__linux__)
+    // Not FUTEX_PRIVATE_FLAG: the waiters are other processes
+    syscall(SYS_futex, word, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+#endif
+}
+
+CefRect BoundingRect(const CefRenderHandler::RectList& rects) {
+    int left = INT_MAX;
+    int top = INT_MAX;
+    int right = INT_MIN;
+    int bottom = INT_MIN;
+    for (const auto& rect : rects) {
+        left = std::min(left, rect.x);
+        top = std::min(top, rect.y);
+        right = std::max(right, rect.x + rect.width);
+        bottom = std::max(bottom, rect.y + rect.height);
+    }
+    return rects.empty() ? CefRect() : CefRect(left, top, right - left, bottom - top);
+}
+
+// Whether the segment under name may be unlinked: there is none, or it is a
+// frame export whose writer closed it or is no longer running
+bool IsStaleSegment(const std::string& name) {
+    const int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        if (errno == ENOENT) {
+            return true;
+        }
+        LOGE << "Checking the frame export " << name << " FAILED: " << strerror(errno);
+        return false;
+    }
+    struct stat info {};
+    void* mapping = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && static_cast<size_t>(info.st_size) >= sizeof(cvf_header)) {
+        mapping = mmap(nullptr, sizeof(cvf_header), PROT_READ, MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        LOGE << "Shared memory " << name << " exists and is not a frame export, not replacing it";
+        return false;
+    }
+
+    const auto* header = static_cast<const cvf_header*>(mapping);
+    const bool frameExport = __atomic_load_n(&header->magic, __ATOMIC_ACQUIRE) == CVF_MAGIC;
+    const bool closed = __atomic_load_n(&header->state, __ATOMIC_ACQUIRE) == CVF_STATE_CLOSED;
+    const pid_t writer = static_cast<pid_t>(header->writer_pid);
+    munmap(mapping, sizeof(cvf_header));
+    if (!frameExport) {
+        LOGE << "Shared memory " << name << " exists and is not a frame export, not replacing it";
+        return false;
+    }
+    if (closed || (kill(writer, 0) != 0 && errno == ESRCH)) {
+        return true;
+    }
+    LOGE << "Frame export " << name << " is in use by process " << writer;
+    return false;
+}
+
+}  // namespace
+
+OsrSharedFrameSink::OsrSharedFrameSink(const std::string& name)
+    : _name(name)
+    , _slotDamage() {
+}
+
+OsrSharedFrameSink::~OsrSharedFrameSink() {
+    close();
+}
+
+bool OsrSharedFrameSink::open(int width, int height) {
+    if (_mapping) {
+        return true;
+    }
+    return create(width, height);
+}
+
+void OsrSharedFrameSink::close() {
+    release(true);
+}
+
+bool OsrSharedFrameSink::create(int width, int height) {
+    if (_name.empty() || width <= 0 || height <= 0) {
+        LOGE << "OsrSharedFrameSink needs a name and a frame size";
+        return false;
+    }
+
+    const size_t headerBytes = AlignToPage(sizeof(cvf_header));
+    const size_t slotBytes = AlignToPage(static_cast<size_t>(width) * static_cast<size_t>(height) * kBytesPerPixel);
+    const size_t segmentBytes = headerBytes + slotBytes * kSlotCount;
+
+    // Replaces our previous segment when growing, or a stale one left by a
+    // crashed writer, never the segment of another running writer.
+    // Readers of the previous segment move on once it is marked closed below.
+    if (!_mapping && !IsStaleSegment(_name)) {
+        return false;
+    }
+    shm_unlink(_name.c_str());
+    int fd = shm_open(_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0) {
+        LOGE << "shm_open(" << _name << ") FAILED: " << strerror(errno);
+        return false;
+    }
+    if (ftruncate(fd, static_cast<off_t>(segmentBytes)) != 0) {
+        LOGE << "Sizing the frame export " << _name << " to " << segmentBytes << " bytes FAILED: " << strerror(errno);
+        ::close(fd);
+        shm_unlink(_name.c_str());
+        return false;
+    }
+    void* mapping = mmap(nullptr, segmentBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        LOGE << "Mapping the frame export " << _name << " FAILED: " << strerror(errno);
+        shm_unlink(_name.c_str());
+        return false;
+    }
+
+    // The segment starts zero-filled; magic goes last so readers never map a partial header
+    auto* header = static_cast<cvf_header*>(mapping);
+    header->version = CVF_VERSION;
+    header->header_bytes = static_cast<uint32_t>(sizeof(cvf_header));
+    header->format = CVF_FORMAT_BGRA;
+    header->slot_bytes = slotBytes;
+    header->segment_bytes = segmentBytes;
+    header->writer_pid = static_cast<uint32_t>(getpid());
+    header->state = CVF_STATE_LIVE;
+    for (int i = 0; i < kSlotCount; ++i) {
+        header->slots[i].data_offset = headerBytes + slotBytes * static_cast<size_t>(i);
+    }
+    StoreRelease(&header->magic, CVF_MAGIC);
+
+    release(false);
+    _mapping = static_cast<uint8_t*>(mapping);
+    _mappingBytes = segmentBytes;
+    _slotBytes = slotBytes;
+    _nextSlot = 0;
+    _width = 0;
+    _height = 0;
+    for (int i = 0; i < kSlotCount; ++i) {
+        _slotDamage[i].clear();
+        _slotValid[i] = false;
+    }
+    LOGI << "Frame export " << _name << ": " << kSlotCount << " slots of " << width << "x" << height;
+    return true;
+}
+
+void OsrSharedFrameSink::release(bool unlinkName) {
+    if (_mapping) {
+        auto* header = reinterpret_cast<cvf_header*>(_mapping);
+        StoreRelease(&header->state, CVF_STATE_CLOSED);
+        WakeReaders(&header->notify);
+        munmap(_mapping, _mappingBytes);
+        if (unlinkName) {
+            shm_unlink(_name.c_str());
+        }
+    }
+    _mapping = nullptr;
+    _mappingBytes = 0;
+    _slotBytes = 0;
+}
+
+bool OsrSharedFrameSink::publish(const CefRenderHandler::RectList& dirtyRects,
+                                 const void* buffer,
+                                 int width,
+                                 int height) {
+    if (!buffer || width <= 0 || height <= 0) {
+        return false;
+    }
+    const size_t stride = static_cast<size_t>(width) * kBytesPerPixel;
+    if (!_mapping || stride * static_cast<size_t>(height) > _slotBytes) {
+        if (!create(width, height)) {
+            return false;
+        }
+    }
+
+    CefRenderHandler::RectList rects;
+    if (width != _width || height != _height) {
+        _width = width;
+        _height = height;
+        for (int i = 0; i < kSlotCount; ++i) {
+            _slotDamage[i].clear();
+            _slotValid[i] = false;
+        }
+        rects.emplace_back(0, 0, width, height);
+    } else {
+        for (const auto& rect : dirtyRects) {
+            const int left = std::max(rect.x, 0);
+            const int top = std::max(rect.y, 0);
+            const int right = std::min(rect.x + rect.width, width);
+            const int bottom = std::min(rect.y + rect.height, height);
+            if (right > left && bottom > top) {
+                rects.emplace_back(left, top, right - left, bottom - top);
+            }
+        }
+        if (rects.empty()) {
+            return true;
+        }
+    }
+
+    auto* header = reinterpret_cast<cvf_header*>(_mapping);
+    const uint32_t index = _nextSlot;
+    cvf_slot& slot = header->slots[index];
+    uint8_t* pixels = _mapping + slot.data_offset;
+
+    // Bring the slot up to date: everything, or what changed since it was last written
+    CefRenderHandler::RectList& damage = _slotDamage[index];
+    if (!_slotValid[index]) {
+        damage.assign(1, CefRect(0, 0, width, height));
+    } else {
+        AddDamage(damage, rects);
+    }
+
+    const uint32_t seq = slot.seq;
+    StoreRelaxed(&slot.seq, seq + 1);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    const uint8_t* src = static_cast<const uint8_t*>(buffer);
+    for (const auto& rect : damage) {
+        const size_t offset = static_cast<size_t>(rect.y) * stride + static_cast<size_t>(rect.x) * kBytesPerPixel;
+        PixelKernels::CopyRect(src + offset, stride, pixels + offset, stride, rect.width, rect.height);
+        _copiedBytes += static_cast<uint64_t>(rect.width) * static_cast<uint64_t>(rect.height) * kBytesPerPixel;
+    }
+
+    StoreRelaxed(&slot.width, static_cast<uint32_t>(width));
+    StoreRelaxed(&slot.height, static_cast<uint32_t>(height));
+    StoreRelaxed(&slot.stride, static_cast<uint32_t>(stride));
+    StoreRelaxed(&slot.frame, ++_frame);
+    CefRenderHandler::RectList reported;
+    if (rects.size() > CVF_MAX_DIRTY_RECTS) {
+        reported.push_back(BoundingRect(rects));
+    }
+    const CefRenderHandler::RectList& dirty = reported.empty() ? rects : reported;
+    for (size_t i = 0; i < dirty.size(); ++i) {
+        StoreRelaxed(&slot.dirty[i].x, static_cast<int32_t>(dirty[i].x));
+        StoreRelaxed(&slot.dirty[i].y, static_cast<int32_t>(dirty[i].y));
+        StoreRelaxed(&slot.dirty[i].width, static_cast<int32_t>(dirty[i].width));
+        StoreRelaxed(&slot.dirty[i].height, static_cast<int32_t>(dirty[i].height));
+    }
+    StoreRelaxed(&slot.dirty_count, static_cast<uint32_t>(dirty.size()));
+
+    StoreRelease(&slot.seq, seq + 2);
+
+    damage.clear();
+    _slotValid[index] = true;
+    for (int i = 0; i < kSlotCount; ++i) {
+        if (static_cast<uint32_t>(i) != index && _slotValid[i]) {
+            AddDamage(_slotDamage[i], rects);
+        }
+    }
+    _nextSlot = (index + 1) % kSlotCount;
+
+    StoreRelease(&header->latest_slot, index);
+    StoreRelease(&header->latest_frame, _frame);
+    WakeReaders(&header->notify);
+    return true;
+}
+
+void OsrSharedFrameSink::AddDamage(CefRenderHandler::RectList& damage, const CefRenderHandler::RectList& rects) {
+    damage.insert(damage.end(), rects.begin(), rects.end());
+    if (damage.size() > kMaxDamageRects) {
+        const CefRect bounds = BoundingRect(damage);
+        damage.assign(1, bounds);
+    }
+}
+
+}  // namespace cefview
+
+#endif  // WIN32
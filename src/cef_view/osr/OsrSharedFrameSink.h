@@ -0,0 +1,109 @@
+/**
+ * @file OsrSharedFrameSink.h
+ * @brief Exports OSR view frames to other processes over POSIX shared memory
+ *
+ * This file is part of CefView project.
+ * Licensed under BSD-style license.
+ */
+#ifndef OSRSHAREDFRAMESINK_H
+#define OSRSHAREDFRAMESINK_H
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "include/cef_render_handler.h"
+
+namespace cefview {
+
+/**
+ * @brief Writer side of a shared memory frame ring (see cefview_frame_shm.h)
+ *
+ * Frames go into a segment opened with shm_open, holding a few full BGRA
+ * slots guarded by seqlocks. Each slot is kept complete, but a paint only
+ * copies into it what changed since the slot was last written. Readers in
+ * other processes map the segment by name with the C library in
+ * src/frame_reader and use the pixels in place. On Linux a futex wakes them
+ * per frame.
+ *
+ * One writer per name: open() only replaces a segment left by a writer
+ * that is no longer running. Not supported on Windows: open() fails there.
+ * Not thread-safe: call from the paint thread.
+ */
+class OsrSharedFrameSink {
+public:
+    /// Frames kept in the segment (CVF_SLOT_COUNT)
+    static constexpr int kSlotCount = 3;
+
+    /**
+     * @param name shm_open name, e.g. "/cefview-main" (at most 31 characters on macOS)
+     */
+    explicit OsrSharedFrameSink(const std::string& name);
+    ~OsrSharedFrameSink();
+
+    OsrSharedFrameSink(const OsrSharedFrameSink&) = delete;
+    OsrSharedFrameSink& operator=(const OsrSharedFrameSink&) = delete;
+
+    /**
+     * @brief Create the segment, sized for the given frame
+     * publish() opens it on demand; calling open() first lets readers attach
+     * before the first paint.
+     * @return false if the segment cannot be created or another writer owns
+     *         the name (LOGE explains)
+     */
+    bool open(int width, int height);
+
+    /**
+     * @brief Mark the segment closed, wake readers and unlink it
+     */
+    void close();
+
+    /**
+     * @brief Publish a view paint (PET_VIEW buffers from OnPaint)
+     * A paint larger than the segment recreates it; readers follow.
+     * @return false if the segment cannot be created
+     */
+    bool publish(const CefRenderHandler::RectList& dirtyRects, const void* buffer, int width, int height);
+
+    const std::string& name() const { return _name; }
+    bool isOpen() const { return _mapping != nullptr; }
+
+    /**
+     * @brief Frames published since construction
+     */
+    uint64_t frameCount() const { return _frame; }
+
+    /**
+     * @brief Pixel bytes copied into slots since construction
+     */
+    uint64_t copiedBytes() const { return _copiedBytes; }
+
+private:
+    bool create(int width, int height);
+    void release(bool unlinkName);
+
+    /**
+     * @brief Add rects to a damage list, collapsing it to its bounds when it grows too long
+     */
+    static void AddDamage(CefRenderHandler::RectList& damage, const CefRenderHandler::RectList& rects);
+
+    std::string _name;
+    uint8_t* _mapping = nullptr;
+    size_t _mappingBytes = 0;
+    size_t _slotBytes = 0;
+
+    uint64_t _frame = 0;
+    uint64_t _copiedBytes = 0;
+    uint32_t _nextSlot = 0;
+    int _width = 0;
+    int _height = 0;
+
+    // Per slot: what changed since the slot was last written
+    CefRenderHandler::RectList _slotDamage[kSlotCount];
+    bool _slotValid[kSlotCount] = {};
+};
+
+}  // namespace cefview
+
+#endif  // OSRSHAREDFRAMESINK_H
@@ -0,0 +1,248 @@
+/**
+ * @file OsrStreamClient.cpp
+ * @brief Minimal subscriber of OsrStreamServer
+ *
+ * This file is part of CefView project.
+ * Licensed under BSD-style license.
+ */
+#include "OsrStreamClient.h"
+
+#include <cerrno>
+#include <chrono>
+
+#if !defined(WIN32)
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include "osr/OsrStreamProtocol.h"
+#include "utils/TileCodec.h"
+
+namespace cefview {
+
+namespace {
+
+constexpr size_t kBytesPerPixel = 4;
+// Guards against a corrupt length; a full 8K frame sent raw is well below it
+constexpr uint32_t kMaxServerMessage = 1u << 30;
+
+#if defined(MSG_NOSIGNAL)
+constexpr int kSendFlags = MSG_NOSIGNAL;
+#else
+constexpr int kSendFlags = 0;
+#endif
+
+}  // namespace
+
+OsrStreamClient::OsrStreamClient()
+    : _in()
+    , _canvas() {
+}
+
+OsrStreamClient::~OsrStreamClient() {
+    close();
+}
+
+bool OsrStreamClient::connect(const std::string& address, int timeoutMs) {
+    close();
+    _fd = OsrStreamProtocol::Connect(address);
+    if (_fd < 0) {
+        return false;
+    }
+#if defined(SO_NOSIGPIPE)
+    int noSigPipe = 1;
+    setsockopt(_fd, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+
+    std::vector<uint8_t> message;
+    if (!readMessage(message, timeoutMs)) {
+        close();
+        return false;
+    }
+    OsrStreamProtocol::Reader reader(message.data(), message.size());
+    if (reader.u8() != OsrStreamProtocol::kHello || reader.u32() != OsrStreamProtocol::kMagic ||
+        reader.u32() != OsrStreamProtocol::kVersion || !reader.ok()) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void OsrStreamClient::close() {
+#if !defined(WIN32)
+    if (_fd >= 0) {
+        ::close(_fd);
+    }
+#endif
+    _fd = -1;
+    _in.clear();
+}
+
+bool OsrStreamClient::readMessage(std::vector<uint8_t>& message, int timeoutMs) {
+#if defined(WIN32)
+    (void)message;
+    (void)timeoutMs;
+    return false;
+#else
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    for (;;) {
+        if (_in.size() >= 4) {
+            OsrStreamProtocol::Reader header(_in.data(), 4);
+            const uint32_t length = header.u32();
+            if (length == 0 || length > kMaxServerMessage) {
+                return false;
+            }
+            if (_in.size() - 4 >= length) {
+                message.assign(_in.begin() + 4, _in.begin() + 4 + static_cast<std::ptrdiff_t>(length));
+                _in.erase(_in.begin(), _in.begin() + 4 + static_cast<std::ptrdiff_t>(length));
+                return true;
+            }
+        }
+        if (_fd < 0) {
+            return false;
+        }
+
+        const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now()).count();
+        if (remaining <= 0) {
+            return false;
+        }
+        pollfd fd{_fd, POLLIN, 0};
+        const int ready = poll(&fd, 1, static_cast<int>(remaining));
+        if (ready < 0 && errno != EINTR) {
+            return false;
+        }
+        if (ready <= 0) {
+            continue;
+        }
+        uint8_t chunk[65536];
+        const ssize_t received = recv(_fd, chunk, sizeof(chunk), 0);
+        if (received == 0 || (received < 0 && errno != EINTR && errno != EAGAIN)) {
+            close();
+            return false;
+        }
+        if (received > 0) {
+            _in.insert(_in.end(), chunk, chunk + received);
+        }
+    }
+#endif
+}
+
+bool OsrStreamClient::readFrame(int timeoutMs) {
+    std::vector<uint8_t> message;
+    if (!readMessage(message, timeoutMs)) {
+        return false;
+    }
+    OsrStreamProtocol::Reader reader(message.data(), message.size());
+    if (reader.u8() != OsrStreamProtocol::kFrame) {
+        return false;
+    }
+    const uint64_t frame = reader.u64();
+    const int width = static_cast<int>(reader.u32());
+    const int height = static_cast<int>(reader.u32());
+    const uint32_t tileCount = reader.u32();
+    if (!reader.ok() || width <= 0 || height <= 0 || width > 16384 || height > 16384) {
+        return false;
+    }
+    if (width != _width || height != _height) {
+        _width = width;
+        _height = height;
+        _canvas.assign(static_cast<size_t>(width) * static_cast<size_t>(height) * kBytesPerPixel, 0);
+    }
+
+    const size_t stride = static_cast<size_t>(width) * kBytesPerPixel;
+    for (uint32_t i = 0; i < tileCount; ++i) {
+        const int x = reader.u16();
+        const int y = reader.u16();
+        const int tileWidth = reader.u16();
+        const int tileHeight = reader.u16();
+        const auto encoding = static_cast<TileCodec::Encoding>(reader.u8());
+        const uint32_t bytes = reader.u32();
+        const uint8_t* data = reader.bytes(bytes);
+        if (!reader.ok() || tileWidth <= 0 || tileHeight <= 0 || x + tileWidth > width || y + tileHeight > height) {
+            return false;
+        }
+        uint8_t* dst = _canvas.data() + static_cast<size_t>(y) * stride + static_cast<size_t>(x) * kBytesPerPixel;
+        if (!TileCodec::Decode(encoding, data, bytes, dst, stride, tileWidth, tileHeight)) {
+            return false;
+        }
+    }
+    _frame = frame;
+    _lastTileCount = tileCount;
+    _lastMessageBytes = message.size() + 4;
+    return true;
+}
+
+bool OsrStreamClient::sendAll(const std::vector<uint8_t>& bytes) {
+#if defined(WIN32)
+    (void)bytes;
+    return false;
+#else
+    size_t offset = 0;
+    while (_fd >= 0 && offset < bytes.size()) {
+        const ssize_t written = send(_fd, bytes.data() + offset, bytes.size() - offset, kSendFlags);
+        if (written > 0) {
+            offset += static_cast<size_t>(written);
+        } else if (written < 0 && errno != EINTR) {
+            return false;
+        }
+    }
+    return offset == bytes.size();
+#endif
+}
+
+bool OsrStreamClient::sendMouseMove(int x, int y, uint32_t modifiers, bool leave) {
+    std::vector<uint8_t> bytes;
+    {
+        OsrStreamProtocol::Writer message(bytes, OsrStreamProtocol::kMouseMove);
+        message.i32(x);
+        message.i32(y);
+        message.u32(modifiers);
+        message.u8(leave ? 1 : 0);
+    }
+    return sendAll(bytes);
+}
+
+bool OsrStreamClient::sendMouseClick(int x, int y, uint32_t modifiers, int button, bool mouseUp, int clickCount) {
+    std::vector<uint8_t> bytes;
+    {
+        OsrStreamProtocol::Writer message(bytes, OsrStreamProtocol::kMouseButton);
+        message.i32(x);
+        message.i32(y);
+        message.u32(modifiers);
+        message.u8(static_cast<uint8_t>(button));
+        message.u8(mouseUp ? 1 : 0);
+        message.u8(static_cast<uint8_t>(clickCount));
+    }
+    return sendAll(bytes);
+}
+
+bool OsrStreamClient::sendMouseWheel(int x, int y, uint32_t modifiers, int deltaX, int deltaY) {
+    std::vector<uint8_t> bytes;
+    {
+        OsrStreamProtocol::Writer message(bytes, OsrStreamProtocol::kMouseWheel);
+        message.i32(x);
+        message.i32(y);
+        message.u32(modifiers);
+        message.i32(deltaX);
+        message.i32(deltaY);
+    }
+    return sendAll(bytes);
+}
+
+bool OsrStreamClient::sendKey(const CefKeyEvent& event) {
+    std::vector<uint8_t> bytes;
+    {
+        OsrStreamProtocol::Writer message(bytes, OsrStreamProtocol::kKey);
+        message.u8(static_cast<uint8_t>(event.type));
+        message.u32(event.modifiers);
+        message.i32(event.windows_key_code);
+        message.i32(event.native_key_code);
+        message.u16(static_cast<uint16_t>(event.character));
+        message.u16(static_cast<uint16_t>(event.unmodified_character));
+    }
+    return sendAll(bytes);
+}
+
+}  // namespace cefview
@@ -0,0 +1,84 @@
+/**
+ * @file OsrStreamClient.h
+ * @brief Minimal subscriber of OsrStreamServer
+ *
+ * This file is part of CefView project.
+ * Licensed under BSD-style license.
+ */
+#ifndef OSRSTREAMCLIENT_H
+#define OSRSTREAMCLIENT_H
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "include/cef_render_handler.h"
+
+namespace cefview {
+
+/**
+ * @brief Blocking client that rebuilds the streamed frame and sends input
+ *
+ * Reference implementation of the protocol in OsrStreamProtocol.h, e.g. for
+ * a remote viewer or an end-to-end check on localhost. Not thread-safe.
+ */
+class OsrStreamClient {
+public:
+    OsrStreamClient();
+    ~OsrStreamClient();
+
+    OsrStreamClient(const OsrStreamClient&) = delete;
+    OsrStreamClient& operator=(const OsrStreamClient&) = delete;
+
+    /**
+     * @brief Connect and read the server greeting
+     * @param address Same syntax as OsrStreamServer::start()
+     */
+    bool connect(const std::string& address, int timeoutMs = 5000);
+    void close();
+
+    /**
+     * @brief Wait for the next frame and apply its tiles to the canvas
+     * @return false on timeout, disconnect or a malformed message
+     */
+    bool readFrame(int timeoutMs);
+
+    /**
+     * @brief Frame as rebuilt so far, BGRA, width * 4 bytes per row
+     */
+    const std::vector<uint8_t>& canvas() const { return _canvas; }
+    int width() const { return _width; }
+    int height() const { return _height; }
+    uint64_t frame() const { return _frame; }
+
+    /**
+     * @brief Tiles and bytes of the last frame message
+     */
+    size_t lastTileCount() const { return _lastTileCount; }
+    size_t lastMessageBytes() const { return _lastMessageBytes; }
+
+    /// Input, in frame pixels; false once the connection is gone
+    bool sendMouseMove(int x, int y, uint32_t modifiers, bool leave = false);
+    bool sendMouseClick(int x, int y, uint32_t modifiers, int button, bool mouseUp, int clickCount = 1);
+    bool sendMouseWheel(int x, int y, uint32_t modifiers, int deltaX, int deltaY);
+    bool sendKey(const CefKeyEvent& event);
+
+private:
+    bool readMessage(std::vector<uint8_t>& message, int timeoutMs);
+    bool sendAll(const std::vector<uint8_t>& bytes);
+
+    int _fd = -1;
+    std::vector<uint8_t> _in;
+    std::vector<uint8_t> _canvas;
+    int _width = 0;
+    int _height = 0;
+    uint64_t _frame = 0;
+    size_t _lastTileCount = 0;
+    size_t _lastMessageBytes = 0;
+};
+
+}  // namespace cefview
+
+#endif  // OSRSTREAMCLIENT_H
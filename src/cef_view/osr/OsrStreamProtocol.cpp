@@ -0,0 +1,294 @@
+/**
+ * @file OsrStreamProtocol.cpp
+ * @brief Wire format and socket helpers of the OSR tile streaming server
+ *
+ * This file is part of CefView project.
+ * Licensed under BSD-style license.
+ */
+#include "OsrStreamProtocol.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+#if !defined(WIN32)
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#include "utils/LogUtil.h"
+
+namespace cefview {
+
+namespace {
+
+constexpr char kUnixPrefix[] = "unix:";
+constexpr char kTcpPrefix[] = "tcp:";
+
+void PutLittleEndian(uint8_t* out, uint64_t value, size_t bytes) {
+    for (size_t i = 0; i < bytes; ++i) {
+        out[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+#if !defined(WIN32)
+struct SocketAddress {
+    sockaddr_storage storage{};
+    socklen_t length = 0;
+    bool unixSocket = false;
+    std::string path;
+};
+
+bool ParseAddress(const std::string& address, SocketAddress& result) {
+    if (address.compare(0, sizeof(kUnixPrefix) - 1, kUnixPrefix) == 0) {
+        auto* un = reinterpret_cast<sockaddr_un*>(&result.storage);
+        result.path = address.substr(sizeof(kUnixPrefix) - 1);
+        if (result.path.empty() || result.path.size() >= sizeof(un->sun_path)) {
+            return false;
+        }
+        un->sun_family = AF_UNIX;
+        memcpy(un->sun_path, result.path.c_str(), result.path.size() + 1);
+        result.length = static_cast<socklen_t>(sizeof(sockaddr_un));
+        result.unixSocket = true;
+        return true;
+    }
+    if (address.compare(0, sizeof(kTcpPrefix) - 1, kTcpPrefix) == 0) {
+        const std::string hostPort = address.substr(sizeof(kTcpPrefix) - 1);
+        const size_t colon = hostPort.rfind(':');
+        if (colon == std::string::npos) {
+            return false;
+        }
+        auto* in = reinterpret_cast<sockaddr_in*>(&result.storage);
+        in->sin_family = AF_INET;
+        char* end = nullptr;
+        const long port = strtol(hostPort.c_str() + colon + 1, &end, 10);
+        if (*end != '\0' || port < 0 || port > 65535 ||
+            inet_pton(AF_INET, hostPort.substr(0, colon).c_str(), &in->sin_addr) != 1) {
+            return false;
+        }
+        in->sin_port = htons(static_cast<uint16_t>(port));
+        result.length = static_cast<socklen_t>(sizeof(sockaddr_in));
+        return true;
+    }
+    return false;
+}
+
+// A socket file left by a previous run makes bind() fail. Remove it only when
+// it really is a socket and nobody accepts on it any more; anything else at
+// that path is not ours to delete.
+bool RemoveStaleSocket(const SocketAddress& address) {
+    struct stat info {};
+    if (lstat(address.path.c_str(), &info) != 0) {
+        if (errno == ENOENT) {
+            return true;
+        }
+        LOGE << "Checking " << address.path << " FAILED: " << strerror(errno);
+        return false;
+    }
+    if (!S_ISSOCK(info.st_mode)) {
+        LOGE << address.path << " exists and is not a socket, not replacing it";
+        return false;
+    }
+    const int probe = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (probe < 0) {
+        LOGE << "socket() FAILED: " << strerror(errno);
+        return false;
+    }
+    const bool live = connect(probe, reinterpret_cast<const sockaddr*>(&address.storage), address.length) == 0;
+    close(probe);
+    if (live) {
+        LOGE << address.path << " is in use by another server";
+        return false;
+    }
+    if (unlink(address.path.c_str()) != 0 && errno != ENOENT) {
+        LOGE << "Removing stale socket " << address.path << " FAILED: " << strerror(errno);
+        return false;
+    }
+    return true;
+}
+#endif
+
+}  // namespace
+
+OsrStreamProtocol::Writer::Writer(std::vector<uint8_t>& out, MessageType type)
+    : _out(out)
+    , _start(out.size()) {
+    _out.resize(_start + 4);
+    _out.push_back(type);
+}
+
+OsrStreamProtocol::Writer::~Writer() {
+    PutLittleEndian(_out.data() + _start, _out.size() - _start - 4, 4);
+}
+
+void OsrStreamProtocol::Writer::u8(uint8_t value) {
+    _out.push_back(value);
+}
+
+void OsrStreamProtocol::Writer::u16(uint16_t value) {
+    const size_t pos = _out.size();
+    _out.resize(pos + 2);
+    PutLittleEndian(_out.data() + pos, value, 2);
+}
+
+void OsrStreamProtocol::Writer::u32(uint32_t value) {
+    const size_t pos = _out.size();
+    _out.resize(pos + 4);
+    PutLittleEndian(_out.data() + pos, value, 4);
+}
+
+void OsrStreamProtocol::Writer::u64(uint64_t value) {
+    const size_t pos = _out.size();
+    _out.resize(pos + 8);
+    PutLittleEndian(_out.data() + pos, value, 8);
+}
+
+void OsrStreamProtocol::Writer::bytes(const void* data, size_t size) {
+    const uint8_t* begin = static_cast<const uint8_t*>(data);
+    _out.insert(_out.end(), begin, begin + size);
+}
+
+const uint8_t* OsrStreamProtocol::Reader::bytes(size_t size) {
+    if (!_ok || _size - _pos < size) {
+        _ok = false;
+        return nullptr;
+    }
+    const uint8_t* result = _data + _pos;
+    _pos += size;
+    return result;
+}
+
+uint8_t OsrStreamProtocol::Reader::u8() {
+    const uint8_t* p = bytes(1);
+    return p ? p[0] : 0;
+}
+
+uint16_t OsrStreamProtocol::Reader::u16() {
+    const uint8_t* p = bytes(2);
+    return p ? static_cast<uint16_t>(p[0] | p[1] << 8) : uint16_t{0};
+}
+
+uint32_t OsrStreamProtocol::Reader::u32() {
+    const uint8_t* p = bytes(4);
+    return p ? static_cast<uint32_t>(p[0]) | static_cast<uint32_t>(p[1]) << 8 | static_cast<uint32_t>(p[2]) << 16 |
+                   static_cast<uint32_t>(p[3]) << 24
+             : 0;
+}
+
+uint64_t OsrStreamProtocol::Reader::u64() {
+    const uint64_t low = u32();
+    const uint64_t high = u32();
+    return low | high << 32;
+}
+
+bool OsrStreamProtocol::TakeMessages(std::vector<uint8_t>& buffer, uint32_t maxLength,
+                                     std::vector<std::vector<uint8_t>>& messages) {
+    size_t pos = 0;
+    bool ok = true;
+    while (buffer.size() - pos >= 4) {
+        Reader header(buffer.data() + pos, 4);
+        const uint32_t length = header.u32();
+        if (length == 0 || length > maxLength) {
+            ok = false;
+            break;
+        }
+        if (buffer.size() - pos - 4 < length) {
+            break;
+        }
+        messages.emplace_back(buffer.begin() + static_cast<std::ptrdiff_t>(pos + 4),
+                              buffer.begin() + static_cast<std::ptrdiff_t>(pos + 4 + length));
+        pos += 4 + length;
+    }
+    buffer.erase(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(pos));
+    return ok;
+}
+
+bool OsrStreamProtocol::SetNonBlocking(int fd) {
+#if defined(WIN32)
+    (void)fd;
+    return false;
+#else
+    const int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+#endif
+}
+
+int OsrStreamProtocol::Listen(const std::string& address, std::string& boundAddress) {
+#if defined(WIN32)
+    (void)address;
+    (void)boundAddress;
+    LOGE << "OSR streaming is not supported on Windows";
+    return -1;
+#else
+    SocketAddress parsed;
+    if (!ParseAddress(address, parsed)) {
+        LOGE << "Invalid stream address " << address << ", expected unix:/path or tcp:host:port";
+        return -1;
+    }
+
+    if (parsed.unixSocket && !RemoveStaleSocket(parsed)) {
+        return -1;
+    }
+
+    int fd = socket(parsed.storage.ss_family, SOCK_STREAM, 0);
+    if (fd < 0) {
+        LOGE << "socket() FAILED: " << strerror(errno);
+        return -1;
+    }
+    if (!parsed.unixSocket) {
+        int reuse = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    }
+    if (bind(fd, reinterpret_cast<const sockaddr*>(&parsed.storage), parsed.length) != 0 || listen(fd, 8) != 0) {
+        LOGE << "Listening on " << address << " FAILED: " << strerror(errno);
+        close(fd);
+        return -1;
+    }
+
+    boundAddress = address;
+    if (!parsed.unixSocket) {
+        sockaddr_in bound{};
+        socklen_t length = sizeof(bound);
+        if (getsockname(fd, reinterpret_cast<sockaddr*>(&bound), &length) == 0) {
+            char host[INET_ADDRSTRLEN] = {};
+            inet_ntop(AF_INET, &bound.sin_addr, host, sizeof(host));
+            boundAddress = std::string(kTcpPrefix) + host + ":" + std::to_string(ntohs(bound.sin_port));
+        }
+    }
+    return fd;
+#endif
+}
+
+int OsrStreamProtocol::Connect(const std::string& address) {
+#if defined(WIN32)
+    (void)address;
+    return -1;
+#else
+    SocketAddress parsed;
+    if (!ParseAddress(address, parsed)) {
+        return -1;
+    }
+    int fd = socket(parsed.storage.ss_family, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    if (connect(fd, reinterpret_cast<const sockaddr*>(&parsed.storage), parsed.length) != 0) {
+        close(fd);
+        return -1;
+    }
+    if (!parsed.unixSocket) {
+        // Input events are small and latency sensitive
+        int noDelay = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+    }
+    return fd;
+#endif
+}
+
+}  // namespace cefview
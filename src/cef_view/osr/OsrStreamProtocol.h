@@ -0,0 +1,142 @@
+/**
+ * @file OsrStreamProtocol.h
+ * @brief Wire format of the OSR tile streaming server
+ *
+ * This file is part of CefView project.
+ * Licensed under BSD-style license.
+ */
+#ifndef OSRSTREAMPROTOCOL_H
+#define OSRSTREAMPROTOCOL_H
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace cefview {
+
+/**
+ * @brief Messages exchanged by OsrStreamServer and its subscribers
+ *
+ * Every message, in both directions, is
+ *
+ *   u32 length   bytes after this field (type + body)
+ *   u8  type
+ *   ... body
+ *
+ * All integers little endian.
+ *
+ * Server to subscriber:
+ *   kHello   u32 magic 'CVST', u32 version, u32 tileSize
+ *   kFrame   u64 frame, u32 width, u32 height, u32 tileCount, then per tile:
+ *            u16 x, u16 y, u16 width, u16 height, u8 encoding (TileCodec::Encoding),
+ *            u32 bytes, payload
+ *            The tiles changed since the previous frame sent to this
+ *            subscriber; all of them on the first frame and after a resize.
+ *
+ * Subscriber to server (coordinates in frame pixels):
+ *   kMouseMove    i32 x, i32 y, u32 modifiers, u8 leave
+ *   kMouseButton  i32 x, i32 y, u32 modifiers, u8 button (0 left, 1 middle, 2 right),
+ *                 u8 up, u8 clickCount
+ *   kMouseWheel   i32 x, i32 y, u32 modifiers, i32 deltaX, i32 deltaY
+ *   kKey          u8 type (cef_key_event_type_t), u32 modifiers, i32 windowsKeyCode,
+ *                 i32 nativeKeyCode, u16 character, u16 unmodifiedCharacter
+ */
+class OsrStreamProtocol {
+public:
+    static constexpr uint32_t kMagic = 0x54535643u;  // "CVST"
+    static constexpr uint32_t kVersion = 1;
+    static constexpr int kTileSize = 64;
+    /// Largest message a subscriber may send
+    static constexpr uint32_t kMaxInputMessage = 64;
+
+    enum MessageType : uint8_t {
+        kHello = 1,
+        kFrame = 2,
+        kMouseMove = 16,
+        kMouseButton = 17,
+        kMouseWheel = 18,
+        kKey = 19
+    };
+
+    /**
+     * @brief Serializes one message
+     */
+    class Writer {
+    public:
+        Writer(std::vector<uint8_t>& out, MessageType type);
+        ~Writer();
+
+        Writer(const Writer&) = delete;
+        Writer& operator=(const Writer&) = delete;
+
+        void u8(uint8_t value);
+        void u16(uint16_t value);
+        void u32(uint32_t value);
+        void u64(uint64_t value);
+        void i32(int32_t value) { u32(static_cast<uint32_t>(value)); }
+        void bytes(const void* data, size_t size);
+
+    private:
+        std::vector<uint8_t>& _out;
+        size_t _start;
+    };
+
+    /**
+     * @brief Reads one message body; reads past the end fail and return zero
+     */
+    class Reader {
+    public:
+        Reader(const uint8_t* data, size_t size) : _data(data), _size(size) {}
+
+        uint8_t u8();
+        uint16_t u16();
+        uint32_t u32();
+        uint64_t u64();
+        int32_t i32() { return static_cast<int32_t>(u32()); }
+        const uint8_t* bytes(size_t size);
+
+        bool ok() const { return _ok; }
+        size_t remaining() const { return _size - _pos; }
+
+    private:
+        const uint8_t* _data;
+        size_t _size;
+        size_t _pos = 0;
+        bool _ok = true;
+    };
+
+    /**
+     * @brief Split complete messages off the front of a receive buffer
+     * @param buffer Received bytes; complete messages are removed
+     * @param maxLength Longest acceptable message
+     * @param messages Receives type + body of each complete message
+     * @return false if the stream is corrupt (a length beyond maxLength)
+     */
+    static bool TakeMessages(std::vector<uint8_t>& buffer, uint32_t maxLength,
+                             std::vector<std::vector<uint8_t>>& messages);
+
+    /**
+     * @brief Create a listening socket
+     * @param address "unix:/path/to.sock" or "tcp:127.0.0.1:port" (port 0 picks a free one)
+     * @param boundAddress Receives the address actually bound (with the chosen port)
+     * @return The socket, or -1 (LOGE explains)
+     */
+    static int Listen(const std::string& address, std::string& boundAddress);
+
+    /**
+     * @brief Connect to a server address (blocking)
+     * @return The socket, or -1
+     */
+    static int Connect(const std::string& address);
+
+    /**
+     * @brief Make a socket non-blocking
+     */
+    static bool SetNonBlocking(int fd);
+};
+
+}  // namespace cefview
+
+#endif  // OSRSTREAMPROTOCOL_H
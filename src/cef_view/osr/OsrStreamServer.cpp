@@ -0,0 +1,583 @@
+/**
+ * @file OsrStreamServer.cpp
+ * @brief Tile streaming server implementation
+ *
+ * This file is part of CefView project.
+ * Licensed under BSD-style license.
+ */
+#include "OsrStreamServer.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <system_error>
+#include <utility>
+
+#if !defined(WIN32)
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include "include/base/cef_bind.h"
+#include "include/base/cef_callback.h"
+#include "include/cef_task.h"
+#include "include/wrapper/cef_closure_task.h"
+
+#include "osr/OsrStreamProtocol.h"
+#include "utils/LogUtil.h"
+#include "utils/PixelKernels.h"
+
+namespace cefview {
+
+namespace {
+
+constexpr size_t kBytesPerPixel = 4;
+constexpr int kTileSize = OsrStreamProtocol::kTileSize;
+constexpr size_t kReadChunk = 4096;
+
+#if defined(MSG_NOSIGNAL)
+constexpr int kSendFlags = MSG_NOSIGNAL;
+#else
+constexpr int kSendFlags = 0;  // SO_NOSIGPIPE is set on the socket instead
+#endif
+
+}  // namespace
+
+bool OsrStreamServer::ParseInput(const std::vector<uint8_t>& message, OsrStreamInput& input) {
+    OsrStreamProtocol::Reader reader(message.data(), message.size());
+    const uint8_t type = reader.u8();
+    switch (type) {
+    case OsrStreamProtocol::kMouseMove:
+        input.type = OsrStreamInput::Type::kMouseMove;
+        input.mouse.x = reader.i32();
+        input.mouse.y = reader.i32();
+        input.mouse.modifiers = reader.u32();
+        input.mouseLeave = reader.u8() != 0;
+        break;
+    case OsrStreamProtocol::kMouseButton:
+        input.type = OsrStreamInput::Type::kMouseButton;
+        input.mouse.x = reader.i32();
+        input.mouse.y = reader.i32();
+        input.mouse.modifiers = reader.u32();
+        input.button = reader.u8();
+        input.mouseUp = reader.u8() != 0;
+        input.clickCount = reader.u8();
+        if (input.button > 2) {
+            return false;
+        }
+        break;
+    case OsrStreamProtocol::kMouseWheel:
+        input.type = OsrStreamInput::Type::kMouseWheel;
+        input.mouse.x = reader.i32();
+        input.mouse.y = reader.i32();
+        input.mouse.modifiers = reader.u32();
+        input.deltaX = reader.i32();
+        input.deltaY = reader.i32();
+        break;
+    case OsrStreamProtocol::kKey: {
+        input.type = OsrStreamInput::Type::kKey;
+        const uint8_t keyType = reader.u8();
+        if (keyType > KEYEVENT_CHAR) {
+            return false;
+        }
+        input.key.type = static_cast<cef_key_event_type_t>(keyType);
+        input.key.modifiers = reader.u32();
+        input.key.windows_key_code = reader.i32();
+        input.key.native_key_code = reader.i32();
+        input.key.character = static_cast<char16_t>(reader.u16());
+        input.key.unmodified_character = static_cast<char16_t>(reader.u16());
+        break;
+    }
+    default:
+        return false;
+    }
+    return reader.ok() && reader.remaining() == 0;
+}
+
+OsrStreamServer::OsrStreamServer()
+    : _subscribers()
+    , _tileCache()
+    , _address()
+    , _unixPath()
+    , _inputHandler()
+    , _thread()
+    , _mutex()
+    , _frame()
+    , _tileVersions()
+    , _stats() {
+}
+
+OsrStreamServer::~OsrStreamServer() {
+    stop();
+}
+
+bool OsrStreamServer::start(const std::string& address, InputHandler inputHandler) {
+#if defined(WIN32)
+    (void)address;
+    (void)inputHandler;
+    LOGE << "OSR streaming is not supported on Windows";
+    return false;
+#else
+    if (isRunning()) {
+        LOGE << "OSR stream server already listens on " << _address;
+        return false;
+    }
+
+    std::string boundAddress;
+    const int listenFd = OsrStreamProtocol::Listen(address, boundAddress);
+    if (listenFd < 0) {
+        return false;
+    }
+    if (!OsrStreamProtocol::SetNonBlocking(listenFd) || pipe(_wakeFds) != 0 ||
+        !OsrStreamProtocol::SetNonBlocking(_wakeFds[0]) || !OsrStreamProtocol::SetNonBlocking(_wakeFds[1])) {
+        LOGE << "Setting up the OSR stream server FAILED: " << strerror(errno);
+        ::close(listenFd);
+        for (int& fd : _wakeFds) {
+            if (fd >= 0) {
+                ::close(fd);
+                fd = -1;
+            }
+        }
+        return false;
+    }
+
+    _listenFd = listenFd;
+    _address = boundAddress;
+    _unixPath = address.compare(0, 5, "unix:") == 0 ? address.substr(5) : std::string();
+    _inputHandler = std::move(inputHandler);
+    _stop = false;
+    try {
+        _thread = std::thread(&OsrStreamServer::serverThreadMain, this);
+    } catch (const std::system_error& e) {
+        LOGE << "Failed to start the OSR stream server thread: " << e.what();
+        closeSockets();
+        for (int& fd : _wakeFds) {
+            ::close(fd);
+            fd = -1;
+        }
+        return false;
+    }
+    LOGI << "OSR stream server listening on " << _address;
+    return true;
+#endif
+}
+
+void OsrStreamServer::stop() {
+#if !defined(WIN32)
+    if (!_thread.joinable()) {
+        return;
+    }
+    _stop = true;
+    wake();
+    _thread.join();
+    // Closed only now: publish() may wake the thread until it is joined
+    for (int& fd : _wakeFds) {
+        ::close(fd);
+        fd = -1;
+    }
+#endif
+}
+
+void OsrStreamServer::wake() {
+#if !defined(WIN32)
+    const uint8_t byte = 1;
+    // A full pipe already guarantees a wake-up
+    ssize_t written = write(_wakeFds[1], &byte, 1);
+    (void)written;
+#endif
+}
+
+void OsrStreamServer::publish(const CefRenderHandler::RectList& dirtyRects, const void* buffer, int width, int height) {
+    if (!buffer || width <= 0 || height <= 0 || !isRunning()) {
+        return;
+    }
+
+    const uint8_t* src = static_cast<const uint8_t*>(buffer);
+    const size_t stride = static_cast<size_t>(width) * kBytesPerPixel;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        const uint64_t version = _frameNumber + 1;
+        if (_frame.empty() || width != _width || height != _height) {
+            PixelBuffer frame = PixelBufferPool::Shared().acquire(stride * static_cast<size_t>(height));
+            if (!frame) {
+                // Subscribers keep the previous frame; the next paint tries again
+                LOGE << "OSR stream server failed to allocate a " << width << "x" << height << " frame";
+                return;
+            }
+            _frame = std::move(frame);
+            _width = width;
+            _height = height;
+            _tileColumns = (width + kTileSize - 1) / kTileSize;
+            _tileRows = (height + kTileSize - 1) / kTileSize;
+            _tileVersions.assign(static_cast<size_t>(_tileColumns) * static_cast<size_t>(_tileRows), version);
+            PixelKernels::CopyRect(src, stride, _frame.data(), stride, width, height);
+        } else {
+            bool changed = false;
+            for (const auto& rect : dirtyRects) {
+                const int left = std::max(rect.x, 0);
+                const int top = std::max(rect.y, 0);
+                const int right = std::min(rect.x + rect.width, width);
+                const int bottom = std::min(rect.y + rect.height, height);
+                if (right <= left || bottom <= top) {
+                    continue;
+                }
+                const size_t offset = static_cast<size_t>(top) * stride + static_cast<size_t>(left) * kBytesPerPixel;
+                PixelKernels::CopyRect(src + offset, stride, _frame.data() + offset, stride, right - left, bottom - top);
+                for (int row = top / kTileSize; row <= (bottom - 1) / kTileSize; ++row) {
+                    for (int column = left / kTileSize; column <= (right - 1) / kTileSize; ++column) {
+                        _tileVersions[static_cast<size_t>(row * _tileColumns + column)] = version;
+                    }
+                }
+                changed = true;
+            }
+            if (!changed) {
+                return;
+            }
+        }
+        _frameNumber = version;
+        ++_stats.framesPublished;
+    }
+    wake();
+}
+
+OsrStreamServer::Stats OsrStreamServer::stats() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _stats;
+}
+
+void OsrStreamServer::serverThreadMain() {
+#if !defined(WIN32)
+    std::vector<pollfd> fds;
+    while (!_stop) {
+        fds.clear();
+        fds.push_back({_wakeFds[0], POLLIN, 0});
+        fds.push_back({_listenFd, POLLIN, 0});
+        for (const auto& subscriber : _subscribers) {
+            const bool pending = subscriber->outOffset < subscriber->out.size();
+            fds.push_back({subscriber->fd, static_cast<short>(POLLIN | (pending ? POLLOUT : 0)), 0});
+        }
+        if (poll(fds.data(), static_cast<nfds_t>(fds.size()), -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            LOGE << "OSR stream server poll() FAILED: " << strerror(errno);
+            break;
+        }
+
+        if (fds[0].revents & POLLIN) {
+            uint8_t drain[64];
+            while (read(_wakeFds[0], drain, sizeof(drain)) > 0) {
+            }
+        }
+
+        // Subscribers accepted below are appended after the polled ones
+        const size_t polled = fds.size() - 2;
+        for (size_t i = 0; i < polled; ++i) {
+            Subscriber& subscriber = *_subscribers[i];
+            const short events = fds[i + 2].revents;
+            bool alive = !(events & (POLLERR | POLLNVAL));
+            if (alive && (events & (POLLIN | POLLHUP))) {
+                alive = readInput(subscriber);
+            }
+            if (alive && (events & POLLOUT)) {
+                alive = flush(subscriber);
+            }
+            if (!alive) {
+                ::close(subscriber.fd);
+                subscriber.fd = -1;
+            }
+        }
+        if (fds[1].revents & POLLIN) {
+            acceptSubscriber();
+        }
+
+        // Backpressure: a subscriber gets a new frame only once the last one left the socket
+        for (auto& subscriber : _subscribers) {
+            if (subscriber->fd >= 0 && subscriber->outOffset == subscriber->out.size()) {
+                queueFrame(*subscriber);
+                if (!flush(*subscriber)) {
+                    ::close(subscriber->fd);
+                    subscriber->fd = -1;
+                }
+            }
+        }
+
+        const size_t before = _subscribers.size();
+        _subscribers.erase(std::remove_if(_subscribers.begin(), _subscribers.end(),
+                                          [](const std::unique_ptr<Subscriber>& s) { return s->fd < 0; }),
+                           _subscribers.end());
+        if (_subscribers.size() != before) {
+            LOGI << "OSR stream subscriber disconnected, " << _subscribers.size() << " left";
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stats.subscribers = _subscribers.size();
+        }
+    }
+    closeSockets();
+#endif
+}
+
+void OsrStreamServer::acceptSubscriber() {
+#if !defined(WIN32)
+    for (;;) {
+        const int fd = accept(_listenFd, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        if (!OsrStreamProtocol::SetNonBlocking(fd)) {
+            ::close(fd);
+            continue;
+        }
+#if defined(SO_NOSIGPIPE)
+        int noSigPipe = 1;
+        setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+        auto subscriber = std::make_unique<Subscriber>();
+        subscriber->fd = fd;
+        {
+            OsrStreamProtocol::Writer hello(subscriber->out, OsrStreamProtocol::kHello);
+            hello.u32(OsrStreamProtocol::kMagic);
+            hello.u32(OsrStreamProtocol::kVersion);
+            hello.u32(static_cast<uint32_t>(kTileSize));
+        }
+        _subscribers.push_back(std::move(subscriber));
+        LOGI << "OSR stream subscriber connected, " << _subscribers.size() << " total";
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stats.subscribers = _subscribers.size();
+    }
+#endif
+}
+
+bool OsrStreamServer::readInput(Subscriber& subscriber) {
+#if defined(WIN32)
+    (void)subscriber;
+    return false;
+#else
+    uint8_t chunk[kReadChunk];
+    for (;;) {
+        const ssize_t received = recv(subscriber.fd, chunk, sizeof(chunk), 0);
+        if (received > 0) {
+            subscriber.in.insert(subscriber.in.end(), chunk, chunk + received);
+            continue;
+        }
+        if (received == 0) {
+            return false;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            break;
+        }
+        return false;
+    }
+
+    std::vector<std::vector<uint8_t>> messages;
+    if (!OsrStreamProtocol::TakeMessages(subscriber.in, OsrStreamProtocol::kMaxInputMessage, messages)) {
+        LOGW << "OSR stream subscriber sent a malformed message, disconnecting";
+        return false;
+    }
+    for (const auto& message : messages) {
+        OsrStreamInput input;
+        if (!ParseInput(message, input)) {
+            LOGW << "OSR stream subscriber sent an unknown input message";
+            continue;
+        }
+        if (_inputHandler) {
+            CefPostTask(TID_UI, base::BindOnce([](InputHandler handler, const OsrStreamInput& input) {
+                    handler(input);
+                }, _inputHandler, input));
+        }
+    }
+    return true;
+#endif
+}
+
+bool OsrStreamServer::flush(Subscriber& subscriber) {
+#if defined(WIN32)
+    (void)subscriber;
+    return false;
+#else
+    uint64_t sent = 0;
+    bool alive = true;
+    while (subscriber.outOffset < subscriber.out.size()) {
+        const ssize_t written = send(subscriber.fd, subscriber.out.data() + subscriber.outOffset,
+                                     subscriber.out.size() - subscriber.outOffset, kSendFlags);
+        if (written > 0) {
+            subscriber.outOffset += static_cast<size_t>(written);
+            sent += static_cast<uint64_t>(written);
+            continue;
+        }
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        alive = written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+        break;
+    }
+    if (subscriber.outOffset == subscriber.out.size()) {
+        subscriber.out.clear();
+        subscriber.outOffset = 0;
+    }
+    if (sent) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stats.bytesSent += sent;
+    }
+    return alive;
+#endif
+}
+
+void OsrStreamServer::queueFrame(Subscriber& subscriber) {
+    struct PendingTile {
+        size_t index;
+        uint64_t version;
+        int width;
+        int height;
+        std::vector<uint8_t> pixels;
+    };
+
+    std::vector<size_t> tiles;
+    std::vector<PendingTile> pending;
+    uint64_t frame = 0;
+    int width = 0;
+    int height = 0;
+    int columns = 0;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_frameNumber == 0 || _frameNumber == subscriber.sentFrame) {
+            return;
+        }
+        frame = _frameNumber;
+        width = _width;
+        height = _height;
+        columns = _tileColumns;
+        if (_cacheWidth != width || _cacheHeight != height) {
+            _tileCache.assign(_tileVersions.size(), CachedTile());
+            _cacheWidth = width;
+            _cacheHeight = height;
+        }
+
+        const bool full = subscriber.sentWidth != width || subscriber.sentHeight != height;
+        const size_t stride = static_cast<size_t>(width) * kBytesPerPixel;
+        for (size_t i = 0; i < _tileVersions.size(); ++i) {
+            if (!full && _tileVersions[i] <= subscriber.sentFrame) {
+                continue;
+            }
+            tiles.push_back(i);
+            if (_tileCache[i].version == _tileVersions[i]) {
+                continue;
+            }
+            // Copy under the lock, encode outside it
+            const int x = static_cast<int>(i % static_cast<size_t>(columns)) * kTileSize;
+            const int y = static_cast<int>(i / static_cast<size_t>(columns)) * kTileSize;
+            PendingTile tile{i, _tileVersions[i], std::min(kTileSize, width - x), std::min(kTileSize, height - y), {}};
+            const size_t tileStride = static_cast<size_t>(tile.width) * kBytesPerPixel;
+            tile.pixels.resize(tileStride * static_cast<size_t>(tile.height));
+            PixelKernels::CopyRect(_frame.data() + static_cast<size_t>(y) * stride + static_cast<size_t>(x) * kBytesPerPixel,
+                                   stride, tile.pixels.data(), tileStride, tile.width, tile.height);
+            pending.push_back(std::move(tile));
+        }
+        if (!full && subscriber.sentFrame > 0) {
+            _stats.framesSkipped += frame - subscriber.sentFrame - 1;
+        }
+        ++_stats.framesSent;
+        _stats.tilesSent += tiles.size();
+        _stats.tilesEncoded += pending.size();
+    }
+
+    for (auto& tile : pending) {
+        CachedTile& cached = _tileCache[tile.index];
+        cached.encoding = TileCodec::Encode(tile.pixels.data(), static_cast<size_t>(tile.width) * kBytesPerPixel,
+                                            tile.width, tile.height, cached.data);
+        cached.version = tile.version;
+    }
+
+    uint64_t rawBytes = 0;
+    {
+        OsrStreamProtocol::Writer message(subscriber.out, OsrStreamProtocol::kFrame);
+        message.u64(frame);
+        message.u32(static_cast<uint32_t>(width));
+        message.u32(static_cast<uint32_t>(height));
+        message.u32(static_cast<uint32_t>(tiles.size()));
+        for (size_t index : tiles) {
+            const int x = static_cast<int>(index % static_cast<size_t>(columns)) * kTileSize;
+            const int y = static_cast<int>(index / static_cast<size_t>(columns)) * kTileSize;
+            const int tileWidth = std::min(kTileSize, width - x);
+            const int tileHeight = std::min(kTileSize, height - y);
+            const CachedTile& cached = _tileCache[index];
+            message.u16(static_cast<uint16_t>(x));
+            message.u16(static_cast<uint16_t>(y));
+            message.u16(static_cast<uint16_t>(tileWidth));
+            message.u16(static_cast<uint16_t>(tileHeight));
+            message.u8(static_cast<uint8_t>(cached.encoding));
+            message.u32(static_cast<uint32_t>(cached.data.size()));
+            message.bytes(cached.data.data(), cached.data.size());
+            rawBytes += static_cast<uint64_t>(tileWidth) * static_cast<uint64_t>(tileHeight) * kBytesPerPixel;
+        }
+    }
+    subscriber.sentFrame = frame;
+    subscriber.sentWidth = width;
+    subscriber.sentHeight = height;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stats.rawTileBytes += rawBytes;
+}
+
+void OsrStreamServer::closeSockets() {
+#if !defined(WIN32)
+    for (auto& subscriber : _subscribers) {
+        ::close(subscriber->fd);
+    }
+    _subscribers.clear();
+    if (_listenFd >= 0) {
+        ::close(_listenFd);
+        _listenFd = -1;
+    }
+    if (!_unixPath.empty()) {
+        unlink(_unixPath.c_str());
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stats.subscribers = 0;
+#endif
+}
+
+void OsrStreamServer::DispatchToBrowser(CefRefPtr<CefBrowser> browser, const OsrStreamInput& input,
+                                        float deviceScaleFactor) {
+    if (!browser) {
+        return;
+    }
+    CefRefPtr<CefBrowserHost> host = browser->GetHost();
+    if (!host) {
+        return;
+    }
+
+    // CEF takes view coordinates
+    CefMouseEvent mouse = input.mouse;
+    if (deviceScaleFactor > 0.0f) {
+        mouse.x = static_cast<int>(std::lround(static_cast<float>(mouse.x) / deviceScaleFactor));
+        mouse.y = static_cast<int>(std::lround(static_cast<float>(mouse.y) / deviceScaleFactor));
+    }
+
+    switch (input.type) {
+    case OsrStreamInput::Type::kMouseMove:
+        host->SendMouseMoveEvent(mouse, input.mouseLeave);
+        break;
+    case OsrStreamInput::Type::kMouseButton: {
+        static const CefBrowserHost::MouseButtonType kButtons[] = {MBT_LEFT, MBT_MIDDLE, MBT_RIGHT};
+        host->SendMouseClickEvent(mouse, kButtons[std::min(std::max(input.button, 0), 2)], input.mouseUp,
+                                  input.clickCount);
+        break;
+    }
+    case OsrStreamInput::Type::kMouseWheel:
+        host->SendMouseWheelEvent(mouse, input.deltaX, input.deltaY);
+        break;
+    case OsrStreamInput::Type::kKey:
+        host->SendKeyEvent(input.key);
+        break;
+    }
+}
+
+}  // namespace cefview
@@ -0,0 +1,186 @@
+/**
+ * @file OsrStreamServer.h
+ * @brief Streams changed tiles of an OSR view to socket subscribers
+ *
+ * This file is part of CefView project.
+ * Licensed under BSD-style license.
+ */
+#ifndef OSRSTREAMSERVER_H
+#define OSRSTREAMSERVER_H
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "include/cef_browser.h"
+#include "include/cef_render_handler.h"
+
+#include "utils/PixelBufferPool.h"
+#include "utils/TileCodec.h"
+
+namespace cefview {
+
+/**
+ * @brief Input event received from a subscriber
+ */
+struct OsrStreamInput {
+    enum class Type {
+        kMouseMove,
+        kMouseButton,
+        kMouseWheel,
+        kKey
+    };
+
+    Type type = Type::kMouseMove;
+    CefMouseEvent mouse;        ///< Position in frame (device) pixels and modifiers
+    bool mouseLeave = false;    ///< kMouseMove
+    int button = 0;             ///< kMouseButton: 0 left, 1 middle, 2 right
+    bool mouseUp = false;       ///< kMouseButton
+    int clickCount = 1;         ///< kMouseButton
+    int deltaX = 0;             ///< kMouseWheel
+    int deltaY = 0;
+    CefKeyEvent key;            ///< kKey
+};
+
+/**
+ * @brief VNC-like server: subscribers get the tiles that changed, they send input back
+ *
+ * publish() keeps a copy of the view frame up to date from the dirty rects
+ * of each paint and records which 64x64 tiles changed in which frame. A
+ * server thread sends each subscriber the tiles changed since the last
+ * frame it received, compressed with TileCodec (each tile version is
+ * encoded once, whatever the number of subscribers).
+ *
+ * Backpressure is per subscriber: a new frame is only built once the
+ * previous one left the socket, so a slow subscriber skips intermediate
+ * frames and receives their combined changes instead of a growing queue.
+ *
+ * Input messages are parsed on the server thread and handed to the input
+ * handler on CEF's UI thread. The wire format is in OsrStreamProtocol.h;
+ * OsrStreamClient is a matching client.
+ *
+ * Unix domain or TCP sockets; meant for loopback and trusted networks, as
+ * there is no authentication or encryption. Not supported on Windows.
+ */
+class OsrStreamServer {
+public:
+    using InputHandler = std::function<void(const OsrStreamInput& input)>;
+
+    struct Stats {
+        size_t subscribers = 0;
+        uint64_t framesPublished = 0;
+        uint64_t framesSent = 0;       ///< Over all subscribers
+        uint64_t framesSkipped = 0;    ///< Published frames folded into a later one by backpressure
+        uint64_t tilesSent = 0;
+        uint64_t tilesEncoded = 0;
+        uint64_t bytesSent = 0;
+        uint64_t rawTileBytes = 0;     ///< What the sent tiles would take uncompressed
+    };
+
+    OsrStreamServer();
+    ~OsrStreamServer();
+
+    OsrStreamServer(const OsrStreamServer&) = delete;
+    OsrStreamServer& operator=(const OsrStreamServer&) = delete;
+
+    /**
+     * @brief Listen and start the server thread
+     * @param address "unix:/path/to.sock" or "tcp:127.0.0.1:port" (port 0 picks a free one)
+     * @param inputHandler Called on TID_UI per input event; may be empty for view-only streams
+     * @return false if the address cannot be bound (LOGE explains)
+     */
+    bool start(const std::string& address, InputHandler inputHandler);
+
+    /**
+     * @brief Disconnect everyone and stop the server thread
+     */
+    void stop();
+
+    /**
+     * @brief Update the frame from a view paint (PET_VIEW buffers from OnPaint)
+     * Copies the dirty rects; encoding and sending happen on the server thread.
+     */
+    void publish(const CefRenderHandler::RectList& dirtyRects, const void* buffer, int width, int height);
+
+    bool isRunning() const { return _thread.joinable(); }
+
+    /**
+     * @brief Address bound by start(), with the actual port for tcp:...:0
+     */
+    const std::string& address() const { return _address; }
+
+    Stats stats() const;
+
+    /**
+     * @brief Forward an input event to a browser, e.g. from the input handler
+     * @param deviceScaleFactor Frame pixels per view coordinate
+     */
+    static void DispatchToBrowser(CefRefPtr<CefBrowser> browser, const OsrStreamInput& input, float deviceScaleFactor);
+
+    /**
+     * @brief Decode one subscriber message (type + body, as split by TakeMessages)
+     * @return false for an unknown type, an out of range value or a body of the wrong size
+     */
+    static bool ParseInput(const std::vector<uint8_t>& message, OsrStreamInput& input);
+
+private:
+    struct Subscriber {
+        int fd = -1;
+        std::vector<uint8_t> out;   ///< Bytes not yet written
+        size_t outOffset = 0;
+        std::vector<uint8_t> in;    ///< Partial input messages
+        uint64_t sentFrame = 0;
+        int sentWidth = 0;
+        int sentHeight = 0;
+    };
+
+    struct CachedTile {
+        uint64_t version = 0;
+        TileCodec::Encoding encoding = TileCodec::Encoding::kRaw;
+        std::vector<uint8_t> data;
+    };
+
+    void serverThreadMain();
+    void wake();
+    void acceptSubscriber();
+    bool readInput(Subscriber& subscriber);
+    bool flush(Subscriber& subscriber);
+    void queueFrame(Subscriber& subscriber);
+    void closeSockets();
+
+    // Server thread only
+    int _listenFd = -1;
+    int _wakeFds[2] = {-1, -1};
+    std::vector<std::unique_ptr<Subscriber>> _subscribers;
+    std::vector<CachedTile> _tileCache;
+    int _cacheWidth = 0;
+    int _cacheHeight = 0;
+
+    std::string _address;
+    std::string _unixPath;
+    InputHandler _inputHandler;
+    std::thread _thread;
+    std::atomic<bool> _stop{false};
+
+    // Shared with the paint thread
+    mutable std::mutex _mutex;
+    PixelBuffer _frame;
+    int _width = 0;
+    int _height = 0;
+    int _tileColumns = 0;
+    int _tileRows = 0;
+    uint64_t _frameNumber = 0;
+    std::vector<uint64_t> _tileVersions;  ///< Frame in which each tile last changed
+    Stats _stats;
+};
+
+}  // namespace cefview
+
+#endif  // OSRSTREAMSERVER_H
@@ -0,0 +1,130 @@
+/**
+ * @file OsrTileHasher.cpp
+ * @brief Tile hashing implementation
+ *
+ * This file is part of CefView project.
+ * Licensed under BSD-style license.
+ */
+#include "OsrTileHasher.h"
+
+#include <algorithm>
+
+#include "utils/PixelKernels.h"
+
+namespace cefview {
+
+namespace {
+
+constexpr uint8_t kTileNotVisited = 0;
+constexpr uint8_t kTileUnchanged = 1;
+constexpr uint8_t kTileChanged = 2;
+
+}  // namespace
+
+OsrTileHasher::OsrTileHasher(int tileSize)
+    : _tileSize(std::max(tileSize, 8)) {
+}
+
+void OsrTileHasher::reset() {
+    std::fill(_valid.begin(), _valid.end(), static_cast<uint8_t>(0));
+}
+
+const CefRenderHandler::RectList& OsrTileHasher::filter(const CefRenderHandler::RectList& dirtyRects,
+                                                        const void* buffer,
+                                                        int width,
+                                                        int height) {
+    _rects.clear();
+    if (!buffer || width <= 0 || height <= 0) {
+        return _rects;
+    }
+
+    if (width != _width || height != _height) {
+        _width = width;
+        _height = height;
+        _columns = (width + _tileSize - 1) / _tileSize;
+        _rows = (height + _tileSize - 1) / _tileSize;
+        const size_t tileCount = static_cast<size_t>(_columns) * static_cast<size_t>(_rows);
+        _hashes.assign(tileCount, 0);
+        _valid.assign(tileCount, 0);
+        _state.assign(tileCount, kTileNotVisited);
+    } else {
+        std::fill(_state.begin(), _state.end(), kTileNotVisited);
+    }
+
+    const uint8_t* pixels = static_cast<const uint8_t*>(buffer);
+    const size_t stride = static_cast<size_t>(width) * 4;
+
+    for (const auto& dirty : dirtyRects) {
+        const int left = std::max(dirty.x, 0);
+        const int top = std::max(dirty.y, 0);
+        const int right = std::min(dirty.x + dirty.width, width);
+        const int bottom = std::min(dirty.y + dirty.height, height);
+        if (right <= left || bottom <= top) {
+            continue;
+        }
+
+        for (int row = top / _tileSize; row <= (bottom - 1) / _tileSize; ++row) {
+            const int tileTop = row * _tileSize;
+            const int tileHeight = std::min(_tileSize, height - tileTop);
+
+            // Emit one rect per horizontal run of changed tiles
+            int runStart = -1;
+            for (int col = left / _tileSize; col <= (right - 1) / _tileSize + 1; ++col) {
+                bool changed = false;
+                if (col <= (right - 1) / _tileSize) {
+                    const size_t index = static_cast<size_t>(row) * static_cast<size_t>(_columns) +
+                                         static_cast<size_t>(col);
+                    if (_state[index] == kTileNotVisited) {
+                        const int tileLeft = col * _tileSize;
+                        const uint64_t hash = PixelKernels::HashRect(
+                            pixels + static_cast<size_t>(tileTop) * stride + static_cast<size_t>(tileLeft) * 4,
+                            stride, std::min(_tileSize, width - tileLeft), tileHeight);
+                        ++_tilesHashed;
+                        if (_valid[index] && _hashes[index] == hash) {
+                            ++_tilesUnchanged;
+                            _state[index] = kTileUnchanged;
+                        } else {
+                            _hashes[index] = hash;
+                            _valid[index] = 1;
+                            _state[index] = kTileChanged;
+                        }
+                    }
+                    changed = _state[index] == kTileChanged;
+                }
+
+                if (changed && runStart < 0) {
+                    runStart = col;
+                } else if (!changed && runStart >= 0) {
+                    const int runLeft = std::max(left, runStart * _tileSize);
+                    const int runRight = std::min(right, col * _tileSize);
+                    const int runTop = std::max(top, tileTop);
+                    const int runBottom = std::min(bottom, tileTop + tileHeight);
+                    _rects.emplace_back(runLeft, runTop, runRight - runLeft, runBottom - runTop);
+                    runStart = -1;
+                }
+            }
+        }
+    }
+
+    ++_framesFiltered;
+    if (_rects.empty()) {
+        ++_framesUnchanged;
+    }
+    return _rects;
+}
+
+double OsrTileHasher::tileHitRate() const {
+    if (_tilesHashed == 0) {
+        return 0.0;
+    }
+    return static_cast<double>(_tilesUnchanged) / static_cast<double>(_tilesHashed);
+}
+
+void OsrTileHasher::resetStatistics() {
+    _tilesHashed = 0;
+    _tilesUnchanged = 0;
+    _framesFiltered = 0;
+    _framesUnchanged = 0;
+}
+
+}  // namespace cefview
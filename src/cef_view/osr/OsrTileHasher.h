@@ -0,0 +1,89 @@
+/**
+ * @file OsrTileHasher.h
+ * @brief Content hashing of frame tiles to drop unchanged dirty regions
+ *
+ * This file is part of CefView project.
+ * Licensed under BSD-style license.
+ */
+#ifndef OSRTILEHASHER_H
+#define OSRTILEHASHER_H
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "include/cef_render_handler.h"
+
+namespace cefview {
+
+/**
+ * @brief Filters dirty rects down to the tiles whose pixels actually changed
+ *
+ * Chromium reports dirty rects for repaints that produce identical pixels
+ * (caret blinks, invalidations). The frame is split into square tiles; every
+ * tile touched by a dirty rect is hashed and compared with the hash recorded
+ * for it last time. Dirty rects are reduced to their parts inside changed
+ * tiles, so an empty result means the paint changed nothing.
+ *
+ * Not thread-safe: call from the thread that receives paint callbacks.
+ */
+class OsrTileHasher {
+public:
+    static constexpr int kDefaultTileSize = 64;
+
+    explicit OsrTileHasher(int tileSize = kDefaultTileSize);
+
+    /**
+     * @brief Reduce dirty rects to the regions that changed
+     * @param dirtyRects Dirty rects as reported by CEF
+     * @param buffer Complete BGRA frame, width * 4 bytes per row
+     * @param width Frame width
+     * @param height Frame height
+     * @return Clipped rects inside changed tiles; valid until the next call
+     */
+    const CefRenderHandler::RectList& filter(const CefRenderHandler::RectList& dirtyRects,
+                                             const void* buffer,
+                                             int width,
+                                             int height);
+
+    /**
+     * @brief Forget all recorded hashes (next frame is treated as changed)
+     */
+    void reset();
+
+    int tileSize() const { return _tileSize; }
+
+    // Statistics
+    uint64_t tilesHashed() const { return _tilesHashed; }
+    uint64_t tilesUnchanged() const { return _tilesUnchanged; }
+    uint64_t framesFiltered() const { return _framesFiltered; }
+    uint64_t framesUnchanged() const { return _framesUnchanged; }
+
+    /**
+     * @brief Fraction of hashed tiles found unchanged (0 when nothing was hashed)
+     */
+    double tileHitRate() const;
+
+    void resetStatistics();
+
+private:
+    int _tileSize = kDefaultTileSize;
+    int _width = 0;
+    int _height = 0;
+    int _columns = 0;
+    int _rows = 0;
+
+    std::vector<uint64_t> _hashes{};
+    std::vector<uint8_t> _valid{};
+    std::vector<uint8_t> _state{};  ///< Per-frame: 0 not visited, 1 unchanged, 2 changed
+    CefRenderHandler::RectList _rects{};
+
+    uint64_t _tilesHashed = 0;
+    uint64_t _tilesUnchanged = 0;
+    uint64_t _framesFiltered = 0;
+    uint64_t _framesUnchanged = 0;
+};
+
+}  // namespace cefview
+
+#endif  // OSRTILEHASHER_H
@@ -0,0 +1,72 @@
+/**
+ * @file OsrTripleBuffer.h
+ * @brief Lock-free single-producer/single-consumer triple buffer
+ *
+ * This file is part of CefView project.
+ * Licensed under BSD-style license.
+ */
+#ifndef OSRTRIPLEBUFFER_H
+#define OSRTRIPLEBUFFER_H
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace cefview {
+
+/**
+ * @brief Hands complete frames from one producer thread to one consumer thread
+ *
+ * The producer always owns a write slot and the consumer a read slot; the
+ * third slot is exchanged atomically between them. Neither side ever waits:
+ * publish() replaces any frame the consumer has not picked up yet, and
+ * acquire() returns the newest published frame.
+ */
+template <typename T>
+class OsrTripleBuffer {
+public:
+    OsrTripleBuffer() = default;
+
+    OsrTripleBuffer(const OsrTripleBuffer&) = delete;
+    OsrTripleBuffer& operator=(const OsrTripleBuffer&) = delete;
+
+    /// Producer: slot to fill for the next frame
+    T& writeSlot() { return _slots[_writeIndex]; }
+    int writeIndex() const { return _writeIndex; }
+
+    /// Producer: make the write slot the newest frame
+    void publish() {
+        uint8_t previous = _middle.exchange(static_cast<uint8_t>(_writeIndex | kFreshBit), std::memory_order_acq_rel);
+        _writeIndex = previous & kIndexMask;
+    }
+
+    /// Consumer: take the newest frame if one was published since the last call
+    bool acquire() {
+        if ((_middle.load(std::memory_order_acquire) & kFreshBit) == 0) {
+            return false;
+        }
+        uint8_t previous = _middle.exchange(static_cast<uint8_t>(_readIndex), std::memory_order_acq_rel);
+        _readIndex = previous & kIndexMask;
+        return true;
+    }
+
+    /// Consumer: the frame returned by the last successful acquire()
+    T& readSlot() { return _slots[_readIndex]; }
+    const T& readSlot() const { return _slots[_readIndex]; }
+
+    /// Direct slot access for setup and teardown when neither thread is running
+    T& slot(int index) { return _slots[index]; }
+
+private:
+    static constexpr uint8_t kIndexMask = 0x3;
+    static constexpr uint8_t kFreshBit = 0x4;
+
+    T _slots[3];
+    int _writeIndex = 0;
+    std::atomic<uint8_t> _middle{1};
+    int _readIndex = 2;
+};
+
+}  // namespace cefview
+
+#endif  // OSRTRIPLEBUFFER_H
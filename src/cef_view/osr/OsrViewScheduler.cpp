@@ -0,0 +1,178 @@
+/**
+ * @file OsrViewScheduler.cpp
+ * @brief Present pacing, adaptive frame rate and hidden suspension shared by the off-screen views
+ *
+ * This file is part of CefView project.
+ * Licensed under BSD-style license.
+ */
+#include "OsrViewScheduler.h"
+
+#include "OsrRenderer.h"
+#include "utils/LogUtil.h"
+
+namespace cefview {
+
+void OsrViewScheduler::requestPresent() {
+    OsrRenderer* renderer = this->renderer();
+    if (!renderer) {
+        return;
+    }
+
+    Duration delay{};
+    const TimePoint now = Clock::now();
+    if (!_hasUnpresentedPaint) {
+        _firstUnpresentedPaint = now;
+        _hasUnpresentedPaint = true;
+    }
+    switch (_frameScheduler.onFrameRequested(now, delay)) {
+        case OsrFrameScheduler::Decision::kPresentNow:
+            presentFrame(renderer, now);
+            break;
+        case OsrFrameScheduler::Decision::kSchedule:
+            // The task is dropped with the view, and this object with it; present now if it cannot be posted
+            if (!_host.postDelayedTask || !_host.postDelayedTask([this] { presentScheduledFrame(); }, delay)) {
+                presentFrame(renderer, now);
+            }
+            break;
+        case OsrFrameScheduler::Decision::kCoalesced:
+            renderer->renderStats().recordDroppedFrame();
+            break;
+    }
+}
+
+void OsrViewScheduler::presentScheduledFrame() {
+    if (!_frameScheduler.isPending()) {
+        return;
+    }
+    OsrRenderer* renderer = this->renderer();
+    if (!renderer) {
+        _frameScheduler.cancel();
+        _hasUnpresentedPaint = false;
+        return;
+    }
+    presentFrame(renderer, Clock::now());
+}
+
+void OsrViewScheduler::presentFrame(OsrRenderer* renderer, TimePoint now) {
+    renderer->scheduleRender();
+    _frameScheduler.onFramePresented(now);
+    if (_hasUnpresentedPaint) {
+        renderer->renderStats().recordLatency(
+            std::chrono::duration<double, std::milli>(now - _firstUnpresentedPaint).count());
+        _hasUnpresentedPaint = false;
+    }
+}
+
+void OsrViewScheduler::setAdaptiveFrameRate(int floorRate, int ceilingRate) {
+    _frameRateController.setRange(floorRate, ceilingRate);
+    _adaptiveFrameRate = true;
+}
+
+void OsrViewScheduler::trackPaint(const CefRenderHandler::RectList& dirtyRects, int width, int height) {
+    if (!_adaptiveFrameRate || width <= 0 || height <= 0) {
+        return;
+    }
+
+    int64_t dirtyArea = 0;
+    for (const auto& rect : dirtyRects) {
+        dirtyArea += static_cast<int64_t>(rect.width) * rect.height;
+    }
+    const double dirtyFraction = static_cast<double>(dirtyArea) / (static_cast<double>(width) * height);
+    applyFrameRate(_frameRateController.onPaint(Clock::now(), dirtyFraction));
+}
+
+void OsrViewScheduler::trackInput() {
+    if (!_adaptiveFrameRate) {
+        return;
+    }
+    applyFrameRate(_frameRateController.onInput(Clock::now()));
+}
+
+void OsrViewScheduler::applyFrameRate(bool changed) {
+    if (changed && _host.setFrameRate) {
+        _host.setFrameRate(_frameRateController.frameRate());
+    }
+    if (_frameRateController.isIdle() || _frameRateUpdatePosted || !_host.postDelayedTask) {
+        return;
+    }
+
+    // Decay needs a clock while the page is quiet; at the floor, paints drive it
+    _frameRateUpdatePosted = _host.postDelayedTask(
+        [this] {
+            _frameRateUpdatePosted = false;
+            applyFrameRate(_frameRateController.update(Clock::now()));
+        },
+        OsrFrameRateController::kUpdateInterval);
+}
+
+void OsrViewScheduler::recordPaint() {
+    if (_hidden) {
+        ++_suspendStats.paintsWhileHidden;
+    }
+}
+
+bool OsrViewScheduler::setHidden(bool hidden, int suspendDelayMs) {
+    if (hidden == _hidden) {
+        return false;
+    }
+    _hidden = hidden;
+    ++_hideGeneration;
+    const TimePoint now = Clock::now();
+
+    if (hidden) {
+        ++_suspendStats.hides;
+        _hiddenSince = now;
+        OsrRenderer* renderer = this->renderer();
+        const OsrRenderStats renderStats = renderer ? renderer->renderStats().snapshot() : OsrRenderStats();
+        _paintsPerSecondBeforeHide = renderStats.paintsPerSecond;
+        _uploadMsBeforeHide = renderStats.uploadMsAvg;
+
+        if (suspendDelayMs >= 0 && _host.postDelayedTask) {
+            const uint64_t hideGeneration = _hideGeneration;
+            _host.postDelayedTask([this, hideGeneration] { suspendHiddenFrame(hideGeneration); },
+                                  std::chrono::milliseconds(suspendDelayMs));
+        }
+        return true;
+    }
+
+    addHiddenTime(_suspendStats, now);
+
+    // Put the last frame back on screen before CEF has painted again
+    OsrRenderer* renderer = this->renderer();
+    if (renderer && renderer->resumeFrame()) {
+        _suspendStats.releasedTextureBytes = 0;
+        requestPresent();
+    }
+    return true;
+}
+
+OsrSuspendStats OsrViewScheduler::suspendStats() const {
+    OsrSuspendStats stats = _suspendStats;
+    if (_hidden) {
+        addHiddenTime(stats, Clock::now());
+    }
+    return stats;
+}
+
+void OsrViewScheduler::suspendHiddenFrame(uint64_t hideGeneration) {
+    OsrRenderer* renderer = this->renderer();
+    if (!_hidden || hideGeneration != _hideGeneration || !renderer) {
+        return;
+    }
+
+    const uint64_t releasedBytes = renderer->suspendFrame();
+    if (renderer->isFrameSuspended() || releasedBytes > 0) {
+        ++_suspendStats.suspensions;
+        _suspendStats.releasedTextureBytes = releasedBytes;
+        LOGI << "OSR view suspended, released " << releasedBytes << " texture bytes";
+    }
+}
+
+void OsrViewScheduler::addHiddenTime(OsrSuspendStats& stats, TimePoint now) const {
+    const double hiddenSeconds = std::chrono::duration<double>(now - _hiddenSince).count();
+    stats.hiddenSeconds += hiddenSeconds;
+    stats.paintsAvoided += hiddenSeconds * _paintsPerSecondBeforeHide;
+    stats.uploadMsAvoided += hiddenSeconds * _paintsPerSecondBeforeHide * _uploadMsBeforeHide;
+}
+
+}  // namespace cefview
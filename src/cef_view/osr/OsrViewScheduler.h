@@ -0,0 +1,154 @@
+/**
+ * @file OsrViewScheduler.h
+ * @brief Present pacing, adaptive frame rate and hidden suspension shared by the off-screen views
+ *
+ * This file is part of CefView project.
+ * Licensed under BSD-style license.
+ */
+#ifndef OSRVIEWSCHEDULER_H
+#define OSRVIEWSCHEDULER_H
+#pragma once
+
+#include <functional>
+
+#include "include/cef_render_handler.h"
+
+#include "OsrFrameRateController.h"
+#include "OsrFrameScheduler.h"
+#include "OsrRenderStats.h"
+
+namespace cefview {
+
+class OsrRenderer;
+
+/**
+ * @brief Drives OsrFrameScheduler and OsrFrameRateController for one off-screen view
+ *
+ * Holds the logic the Windows and macOS views share around both: presenting
+ * through the renderer, coalescing, paint-to-present latency, feeding paints
+ * and input to the frame rate controller and running its decay timer. It
+ * also suspends a hidden view: the texture is released once a hide outlasts
+ * its grace period and restored on show, and OsrSuspendStats are kept.
+ * The view supplies the platform glue through Host: its renderer, a way to
+ * run a task later on the thread that receives paint callbacks, and
+ * SetWindowlessFrameRate.
+ * Not thread-safe: use from that thread.
+ */
+class OsrViewScheduler {
+public:
+    using Clock = OsrFrameScheduler::Clock;
+    using TimePoint = OsrFrameScheduler::TimePoint;
+    using Duration = OsrFrameScheduler::Duration;
+    using Task = std::function<void()>;
+
+    struct Host {
+        /// Current renderer, or nullptr when there is none
+        std::function<OsrRenderer*()> renderer;
+        /// Run a task after a delay, dropping it if the view is gone by then.
+        /// Returns false when nothing can be posted.
+        std::function<bool(Task task, Duration delay)> postDelayedTask;
+        /// Apply a new windowless frame rate (CefBrowserHost::SetWindowlessFrameRate)
+        std::function<void(int framesPerSecond)> setFrameRate;
+    };
+
+    OsrViewScheduler() = default;
+
+    OsrViewScheduler(const OsrViewScheduler&) = delete;
+    OsrViewScheduler& operator=(const OsrViewScheduler&) = delete;
+
+    void setHost(Host host) { _host = std::move(host); }
+
+    /**
+     * @brief Frame pacing state (presented/skipped counts, frame interval)
+     */
+    OsrFrameScheduler& frameScheduler() { return _frameScheduler; }
+    const OsrFrameScheduler& frameScheduler() const { return _frameScheduler; }
+
+    /**
+     * @brief Present newly painted content, coalesced to one present per frame interval
+     */
+    void requestPresent();
+
+    /**
+     * @brief Turn on the adaptive frame rate, starting at the ceiling
+     * @param floorRate Idle frame rate
+     * @param ceilingRate Frame rate used while animating or interacting
+     */
+    void setAdaptiveFrameRate(int floorRate, int ceilingRate);
+
+    const OsrFrameRateController& frameRateController() const { return _frameRateController; }
+
+    /**
+     * @brief Feed a view paint to the adaptive frame rate (no-op unless enabled)
+     * @param dirtyRects Rects CEF repainted
+     * @param width View width in the pixels of dirtyRects
+     * @param height View height in the pixels of dirtyRects
+     */
+    void trackPaint(const CefRenderHandler::RectList& dirtyRects, int width, int height);
+
+    /**
+     * @brief Feed user input to the adaptive frame rate (no-op unless enabled)
+     */
+    void trackInput();
+
+    /**
+     * @brief Count a paint of any element type, for paintsWhileHidden
+     */
+    void recordPaint();
+
+    /**
+     * @brief Hide or show the view
+     *
+     * Hiding schedules the texture release after the grace period; showing
+     * puts the cached frame back on screen before CEF paints again.
+     * @param hidden New hidden state
+     * @param suspendDelayMs Grace period before the release; negative never releases
+     * @return true if the state changed; the view then calls WasHidden(hidden)
+     */
+    bool setHidden(bool hidden, int suspendDelayMs);
+
+    bool isHidden() const { return _hidden; }
+
+    /**
+     * @brief Suspension statistics, including the current hide
+     */
+    OsrSuspendStats suspendStats() const;
+
+private:
+    OsrRenderer* renderer() const { return _host.renderer ? _host.renderer() : nullptr; }
+
+    /// Present the frame deferred by requestPresent()
+    void presentScheduledFrame();
+
+    /// Render the current frame and record its paint-to-present latency
+    void presentFrame(OsrRenderer* renderer, TimePoint now);
+
+    /// Push a changed frame rate to the host and keep the decay timer running
+    void applyFrameRate(bool changed);
+
+    /// Release the view texture once the grace period of a hide has passed
+    void suspendHiddenFrame(uint64_t hideGeneration);
+
+    /// Add the hide that started at _hiddenSince, up to now, to the statistics
+    void addHiddenTime(OsrSuspendStats& stats, TimePoint now) const;
+
+    Host _host;
+    OsrFrameScheduler _frameScheduler;
+    TimePoint _firstUnpresentedPaint{};
+    bool _hasUnpresentedPaint = false;
+
+    OsrFrameRateController _frameRateController;
+    bool _adaptiveFrameRate = false;
+    bool _frameRateUpdatePosted = false;
+
+    bool _hidden = false;
+    uint64_t _hideGeneration = 0;  ///< Invalidates a release still waiting for its grace period
+    TimePoint _hiddenSince{};
+    double _paintsPerSecondBeforeHide = 0.0;
+    double _uploadMsBeforeHide = 0.0;
+    OsrSuspendStats _suspendStats;
+};
+
+}  // namespace cefview
+
+#endif  // OSRVIEWSCHEDULER_H
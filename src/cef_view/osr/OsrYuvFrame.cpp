@@ -0,0 +1,132 @@
+/**
+ * @file OsrYuvFrame.cpp
+ * @brief Persistent I420/NV12 frame implementation
+ *
+ * This file is part of CefView project.
+ * Licensed under BSD-style license.
+ */
+#include "OsrYuvFrame.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "utils/LogUtil.h"
+#include "utils/PixelKernels.h"
+
+namespace cefview {
+
+namespace {
+
+constexpr size_t kBytesPerPixel = 4;
+
+}  // namespace
+
+OsrYuvFrame::OsrYuvFrame(Format format)
+    : _format(format)
+    , _buffer()
+    , _changedRects() {
+}
+
+void OsrYuvFrame::reset() {
+    _buffer.reset();
+    _width = 0;
+    _height = 0;
+}
+
+bool OsrYuvFrame::allocate(int width, int height) {
+    const size_t lumaStride = static_cast<size_t>(width);
+    const size_t chromaWidth = static_cast<size_t>((width + 1) / 2);
+    const size_t chromaHeight = static_cast<size_t>((height + 1) / 2);
+    const size_t lumaBytes = lumaStride * static_cast<size_t>(height);
+
+    _strides[0] = lumaStride;
+    _offsets[0] = 0;
+    if (_format == Format::kI420) {
+        _strides[1] = chromaWidth;
+        _strides[2] = chromaWidth;
+        _offsets[1] = lumaBytes;
+        _offsets[2] = lumaBytes + chromaWidth * chromaHeight;
+    } else {
+        _strides[1] = chromaWidth * 2;
+        _strides[2] = 0;
+        _offsets[1] = lumaBytes;
+        _offsets[2] = 0;
+    }
+    _buffer = PixelBufferPool::Shared().acquire(lumaBytes + chromaWidth * chromaHeight * 2);
+    if (!_buffer) {
+        LOGE << "OsrYuvFrame: failed to allocate a " << width << "x" << height << " frame";
+        reset();
+        return false;
+    }
+    _width = width;
+    _height = height;
+    return true;
+}
+
+const CefRenderHandler::RectList& OsrYuvFrame::update(const CefRenderHandler::RectList& dirtyRects,
+                                                      const void* buffer,
+                                                      int width,
+                                                      int height) {
+    _changedRects.clear();
+    if (!buffer || width <= 0 || height <= 0) {
+        return _changedRects;
+    }
+
+    const uint8_t* pixels = static_cast<const uint8_t*>(buffer);
+    if (_buffer.empty() || width != _width || height != _height) {
+        if (!allocate(width, height)) {
+            return _changedRects;
+        }
+        _changedRects.emplace_back(0, 0, width, height);
+        convert(_changedRects.back(), pixels);
+        return _changedRects;
+    }
+    if (_buffer.useCount() > 1) {
+        // A consumer kept the previous frame; leave it untouched
+        PixelBuffer copy = PixelBufferPool::Shared().acquire(_buffer.size());
+        if (!copy) {
+            // Skip this paint; the next one converts the whole frame
+            LOGE << "OsrYuvFrame: failed to copy a " << _width << "x" << _height << " frame";
+            reset();
+            return _changedRects;
+        }
+        memcpy(copy.data(), _buffer.data(), _buffer.size());
+        _buffer = std::move(copy);
+    }
+
+    for (const auto& rect : dirtyRects) {
+        // Chroma samples cover 2x2 blocks, so convert whole blocks
+        const int left = std::max(rect.x, 0) & ~1;
+        const int top = std::max(rect.y, 0) & ~1;
+        const int right = std::min((rect.x + rect.width + 1) & ~1, width);
+        const int bottom = std::min((rect.y + rect.height + 1) & ~1, height);
+        if (right <= left || bottom <= top) {
+            continue;
+        }
+        _changedRects.emplace_back(left, top, right - left, bottom - top);
+        convert(_changedRects.back(), pixels);
+    }
+    return _changedRects;
+}
+
+void OsrYuvFrame::convert(const CefRect& rect, const uint8_t* buffer) {
+    const size_t srcStride = static_cast<size_t>(_width) * kBytesPerPixel;
+    const uint8_t* src = buffer + static_cast<size_t>(rect.y) * srcStride + static_cast<size_t>(rect.x) * kBytesPerPixel;
+    uint8_t* base = _buffer.data();
+    uint8_t* y = base + _offsets[0] + static_cast<size_t>(rect.y) * _strides[0] + static_cast<size_t>(rect.x);
+    const size_t chromaRow = static_cast<size_t>(rect.y / 2);
+    const size_t chromaColumn = static_cast<size_t>(rect.x / 2);
+
+    if (_format == Format::kI420) {
+        uint8_t* u = base + _offsets[1] + chromaRow * _strides[1] + chromaColumn;
+        uint8_t* v = base + _offsets[2] + chromaRow * _strides[2] + chromaColumn;
+        PixelKernels::ConvertToI420(src, srcStride, y, _strides[0], u, _strides[1], v, _strides[2],
+                                    rect.width, rect.height);
+    } else {
+        uint8_t* uv = base + _offsets[1] + chromaRow * _strides[1] + chromaColumn * 2;
+        PixelKernels::ConvertToNV12(src, srcStride, y, _strides[0], uv, _strides[1], rect.width, rect.height);
+    }
+}
+
+}  // namespace cefview
@@ -0,0 +1,117 @@
+/**
+ * @file OsrYuvFrame.h
+ * @brief Persistent I420/NV12 copy of the OSR view frame
+ *
+ * This file is part of CefView project.
+ * Licensed under BSD-style license.
+ */
+#ifndef OSRYUVFRAME_H
+#define OSRYUVFRAME_H
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "include/cef_render_handler.h"
+
+#include "utils/PixelBufferPool.h"
+
+namespace cefview {
+
+/**
+ * @brief YUV 4:2:0 frame kept up to date from BGRA view paints
+ *
+ * Only the dirty rects of each paint are converted (with the SIMD kernels
+ * of PixelKernels), into a frame that persists across paints, so unchanged
+ * areas are never converted twice. Rects are widened to even coordinates
+ * because each chroma sample covers a 2x2 block.
+ *
+ * The planes are tightly packed and contiguous (Y, then U and V, or UV for
+ * NV12), so buffer() is a complete frame as encoders expect it: 1.5 bytes
+ * per pixel instead of 4.
+ *
+ * Not thread-safe: call from the paint thread.
+ */
+class OsrYuvFrame {
+public:
+    enum class Format {
+        kI420,  ///< Three planes: Y, U, V
+        kNV12   ///< Two planes: Y, interleaved UV
+    };
+
+    /**
+     * @brief Called after each paint with the frame and the regions that changed
+     * Planes may only be read during the call; to keep a frame, hold a copy of
+     * buffer(), which later paints will not overwrite.
+     */
+    using FrameCallback = std::function<void(const OsrYuvFrame& frame, const CefRenderHandler::RectList& changedRects)>;
+
+    explicit OsrYuvFrame(Format format = Format::kI420);
+
+    OsrYuvFrame(const OsrYuvFrame&) = delete;
+    OsrYuvFrame& operator=(const OsrYuvFrame&) = delete;
+
+    /**
+     * @brief Convert the dirty rects of a view paint
+     * @param dirtyRects Dirty rects reported by CEF
+     * @param buffer BGRA paint buffer, width * 4 bytes per row
+     * @param width Buffer width
+     * @param height Buffer height
+     * @return Regions converted, widened to even coordinates; the whole frame after a size change,
+     *         empty when the frame could not be allocated
+     */
+    const CefRenderHandler::RectList& update(const CefRenderHandler::RectList& dirtyRects,
+                                             const void* buffer,
+                                             int width,
+                                             int height);
+
+    /**
+     * @brief Drop the frame; the next update() converts everything
+     */
+    void reset();
+
+    Format format() const { return _format; }
+    int width() const { return _width; }
+    int height() const { return _height; }
+    bool empty() const { return _buffer.empty(); }
+
+    /**
+     * @brief 3 for I420, 2 for NV12
+     */
+    int planeCount() const { return _format == Format::kI420 ? 3 : 2; }
+
+    /**
+     * @brief First byte of a plane (0 = Y, 1 = U or UV, 2 = V)
+     */
+    const uint8_t* plane(int index) const { return _buffer.data() + _offsets[index]; }
+
+    /**
+     * @brief Bytes per row of a plane
+     */
+    size_t stride(int index) const { return _strides[index]; }
+
+    /**
+     * @brief All planes back to back
+     * The buffer is shared: a copy held elsewhere stays unchanged, the next
+     * update() detaches from it first.
+     */
+    const PixelBuffer& buffer() const { return _buffer; }
+    size_t byteSize() const { return _buffer.size(); }
+
+private:
+    bool allocate(int width, int height);
+    void convert(const CefRect& rect, const uint8_t* buffer);
+
+    Format _format;
+    PixelBuffer _buffer;
+    int _width = 0;
+    int _height = 0;
+    size_t _offsets[3] = {};
+    size_t _strides[3] = {};
+    CefRenderHandler::RectList _changedRects;
+};
+
+}  // namespace cefview
+
+#endif  // OSRYUVFRAME_H
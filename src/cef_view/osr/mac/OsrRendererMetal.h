@@ -51,9 +51,13 @@ public:
                             const CefRenderHandler::RectList& dirtyRects,
                             const CefAcceleratedPaintInfo& info) override;
     void render() override;
+    uint64_t suspendFrame() override;
     void scheduleRender() override;
     void setDeviceScaleFactor(float scaleFactor) override;
 
+protected:
+    bool readbackFrame(PixelBuffer& pixels, int& width, int& height) override;
+
 private:
     /// Create Metal device, CAMetalLayer and command queue
     bool createMetalDevice();
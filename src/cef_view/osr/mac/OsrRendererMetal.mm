@@ -295,7 +295,12 @@ void OsrRendererMetal::updateSoftwareTexture(const void* buffer,
     int bytesPerPixel = 4;
     int bytesPerRow = width * bytesPerPixel;
 
-    for (const auto& rect : dirtyRects) {
+    const CefRenderHandler::RectList& rects = uploadRects(PET_VIEW, dirtyRects, buffer, width, height);
+    if (rects.empty()) {
+        return;
+    }
+    auto uploadStart = OsrRenderStatsCollector::Clock::now();
+    for (const auto& rect : rects) {
         MTLRegion region = MTLRegionMake2D(
             static_cast<NSUInteger>(rect.x),
             static_cast<NSUInteger>(rect.y),
@@ -310,6 +315,7 @@ void OsrRendererMetal::updateSoftwareTexture(const void* buffer,
                      withBytes:srcData
                    bytesPerRow:static_cast<NSUInteger>(bytesPerRow)];
     }
+    _renderStats.recordUpload(byteCount(rects), OsrRenderStatsCollector::ElapsedMs(uploadStart));
 }
 
 bool OsrRendererMetal::createTextureFromIOSurface(void* ioSurfaceRef) {
@@ -386,9 +392,17 @@ void OsrRendererMetal::onPaint(CefRenderHandler::PaintElementType type,
             LOGE << "createSoftwareTexture() FAILED";
             return;
         }
+        // A new texture holds nothing, so no tile may be skipped as unchanged
+        _tileHasher.reset();
     }
 
-    updateSoftwareTexture(buffer, width, height, dirtyRects);
+    // A paint while suspended replaces the cached frame in a new texture, so upload all of it
+    CefRenderHandler::RectList fullRect;
+    if (dropSuspendedFrame()) {
+        fullRect.emplace_back(0, 0, width, height);
+    }
+
+    updateSoftwareTexture(buffer, width, height, fullRect.empty() ? dirtyRects : fullRect);
 }
 
 void OsrRendererMetal::onAcceleratedPaint(CefRenderHandler::PaintElementType type,
@@ -404,6 +418,9 @@ void OsrRendererMetal::onAcceleratedPaint(CefRenderHandler::PaintElementType typ
         return;
     }
 
+    // The IOSurface holds a whole frame newer than the one cached by suspendFrame()
+    dropSuspendedFrame();
+
     if (static_cast<void*>(ioSurface) != _currentIOSurface) {
         if (!createTextureFromIOSurface(static_cast<void*>(ioSurface))) {
             LOGE << "createTextureFromIOSurface() FAILED";
@@ -413,11 +430,68 @@ void OsrRendererMetal::onAcceleratedPaint(CefRenderHandler::PaintElementType typ
     }
 }
 
+uint64_t OsrRendererMetal::suspendFrame() {
+    int width = 0;
+    int height = 0;
+    if (!readbackFrame(_suspendedFrame, width, height)) {
+        return 0;
+    }
+    _suspendedWidth = width;
+    _suspendedHeight = height;
+
+    // The IOSurface belongs to CEF; only the software texture is our memory
+    uint64_t bytes = _softwareTexture
+        ? static_cast<uint64_t>(_softwareTextureWidth) * static_cast<uint64_t>(_softwareTextureHeight) * 4
+        : 0;
+    if (_softwareTexture) {
+        CFRelease(_softwareTexture);
+        _softwareTexture = nullptr;
+    }
+    _softwareTextureWidth = 0;
+    _softwareTextureHeight = 0;
+    if (_ioSurfaceTexture) {
+        CFRelease(_ioSurfaceTexture);
+        _ioSurfaceTexture = nullptr;
+    }
+    _currentIOSurface = nullptr;
+    return bytes;
+}
+
+bool OsrRendererMetal::readbackFrame(PixelBuffer& pixels, int& width, int& height) {
+    if (!_initialized) {
+        return false;
+    }
+
+    // Both textures use shared storage, so the frame can be read directly
+    void* source = _ioSurfaceTexture ? _ioSurfaceTexture : _softwareTexture;
+    if (!source) {
+        return false;
+    }
+    id<MTLTexture> texture = (__bridge id<MTLTexture>)source;
+    const NSUInteger textureWidth = texture.width;
+    const NSUInteger textureHeight = texture.height;
+    const NSUInteger bytesPerRow = textureWidth * 4;
+    pixels = PixelBufferPool::Shared().acquire(bytesPerRow * textureHeight);
+    if (!pixels) {
+        LOGE << "readbackFrame() failed to allocate a " << textureWidth << "x" << textureHeight << " frame";
+        return false;
+    }
+    [texture getBytes:pixels.data()
+          bytesPerRow:bytesPerRow
+           fromRegion:MTLRegionMake2D(0, 0, textureWidth, textureHeight)
+          mipmapLevel:0];
+    width = static_cast<int>(textureWidth);
+    height = static_cast<int>(textureHeight);
+    return true;
+}
+
 void OsrRendererMetal::render() {
     if (!_initialized) {
         return;
     }
 
+    auto presentStart = OsrRenderStatsCollector::Clock::now();
+
     if (_hasPendingResize) {
         applyPendingResize();
     }
@@ -456,6 +530,12 @@ void OsrRendererMetal::render() {
 
     id<MTLRenderCommandEncoder> encoder = [commandBuffer renderCommandEncoderWithDescriptor:passDesc];
 
+    // The texture keeps the previous frame until CEF paints at the new size;
+    // the default viewport stretches it over the drawable
+    if (resizeMode() == ResizeMode::kCrop) {
+        [encoder setViewport:(MTLViewport){0.0, 0.0, static_cast<double>(texture.width),
+                                           static_cast<double>(texture.height), 0.0, 1.0}];
+    }
     [encoder setRenderPipelineState:(__bridge id<MTLRenderPipelineState>)_pipelineState];
     [encoder setVertexBuffer:(__bridge id<MTLBuffer>)_vertexBuffer offset:0 atIndex:0];
     [encoder setFragmentTexture:texture atIndex:0];
@@ -466,6 +546,8 @@ void OsrRendererMetal::render() {
 
     [commandBuffer presentDrawable:drawable];
     [commandBuffer commit];
+    // Encode and submit time; the GPU finishes the frame asynchronously
+    _renderStats.recordPresent(OsrRenderStatsCollector::ElapsedMs(presentStart));
 }
 
 void OsrRendererMetal::scheduleRender() {
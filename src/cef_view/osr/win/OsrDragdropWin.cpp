@@ -19,6 +19,8 @@
 #include "WinUtil.h"
 #include "osr/BytesWriteHandler.h"
 #include "utils/LogUtil.h"
+#include "utils/PixelBufferPool.h"
+#include "utils/PixelKernels.h"
 
 namespace cefview {
 
@@ -551,27 +553,14 @@ HBITMAP DropSourceWin::CreateBitmapFromCefImage(CefRefPtr<CefImage> cefImage, fl
     }
 
     size_t dataSize = bitmapData->GetSize();
-    std::vector<unsigned char> buffer(dataSize);
-    bitmapData->GetData(&buffer[0], dataSize, 0);
+    PixelBuffer buffer = PixelBufferPool::Shared().acquire(dataSize);
+    if (!buffer) {
+        return nullptr;
+    }
+    bitmapData->GetData(buffer.data(), dataSize, 0);
 
     // CEF provides premultiplied alpha, but Windows IDragSourceHelper needs non-premultiplied
-    // Un-premultiply the alpha channel
-    for (size_t i = 0; i < dataSize; i += 4) {
-        unsigned char b = buffer[i];
-        unsigned char g = buffer[i + 1];
-        unsigned char r = buffer[i + 2];
-        unsigned char a = buffer[i + 3];
-
-        if (a > 0 && a < 255) {
-            // Un-premultiply: color = (color_premul * 255 + alpha / 2) / alpha
-            // Adding alpha/2 for proper rounding
-            buffer[i] = static_cast<unsigned char>(std::min(255, (b * 255 + a / 2) / a));
-            buffer[i + 1] = static_cast<unsigned char>(std::min(255, (g * 255 + a / 2) / a));
-            buffer[i + 2] = static_cast<unsigned char>(std::min(255, (r * 255 + a / 2) / a));
-        }
-        // If a == 0, keep RGB as is (fully transparent)
-        // If a == 255, no change needed (fully opaque, r/g/b already correct)
-    }
+    PixelKernels::Unpremultiply(buffer.data(), dataSize / 4);
 
     // Create 32-bit BGRA DIB section
     BITMAPINFO bmi = {};
@@ -588,7 +577,7 @@ HBITMAP DropSourceWin::CreateBitmapFromCefImage(CefRefPtr<CefImage> cefImage, fl
     ReleaseDC(nullptr, hdc);
 
     if (hBitmap && bits) {
-        memcpy(bits, &buffer[0], dataSize);
+        memcpy(bits, buffer.data(), dataSize);
         outWidth = static_cast<int>(pixelWidth);
         outHeight = static_cast<int>(pixelHeight);
     } else {
@@ -13,11 +13,14 @@
 #include <DirectXMath.h>
 
 #include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <vector>
 
 #include "utils/LogUtil.h"
 #include "utils/PathUtil.h"
+#include "utils/PixelBufferPool.h"
+#include "utils/PixelKernels.h"
 
 // Helper function to save texture to BMP file for debugging
 static bool SaveTextureToBMP(ID3D11Device* device,
@@ -116,31 +119,23 @@ static bool SaveTextureToBMP(ID3D11Device* device,
     file.write(reinterpret_cast<char*>(bmpFileHeader), 14);
     file.write(reinterpret_cast<char*>(bmpInfoHeader), headerSize);
 
-    // Write pixel data (BMP: bottom-to-top, BGRA order)
-    std::vector<uint8_t> rowBuffer(rowSize, 0);
-    for (int y = static_cast<int>(desc.Height) - 1; y >= 0; --y) {
-        const uint8_t* srcRow = static_cast<const uint8_t*>(mapped.pData) + y * mapped.RowPitch;
-        for (UINT x = 0; x < desc.Width; ++x) {
-            // Source: BGRA, BMP 32-bit needs BGRA (same order)
-            rowBuffer[x * 4 + 0] = srcRow[x * 4 + 0];  // B
-            rowBuffer[x * 4 + 1] = srcRow[x * 4 + 1];  // G
-            rowBuffer[x * 4 + 2] = srcRow[x * 4 + 2];  // R
-            rowBuffer[x * 4 + 3] = srcRow[x * 4 + 3];  // A
-        }
-        file.write(reinterpret_cast<char*>(rowBuffer.data()), rowSize);
+    // Write pixel data (BMP: bottom-to-top). Source and BMP are both BGRA, so
+    // flip the rows into one buffer and drop the staging row padding
+    cefview::PixelBuffer pixels = cefview::PixelBufferPool::Shared().acquire(imageSize);
+    if (!pixels) {
+        context->Unmap(stagingTexture.Get(), 0);
+        return false;
     }
-
-    file.close();
-    context->Unmap(stagingTexture.Get(), 0);
-
-    // Log alpha values of first few pixels for debugging
     const uint8_t* srcData = static_cast<const uint8_t*>(mapped.pData);
-    for (int i = 0; i < 5; ++i) {
-        uint8_t b = srcData[i * 4 + 0];
-        uint8_t g = srcData[i * 4 + 1];
-        uint8_t r = srcData[i * 4 + 2];
-        uint8_t a = srcData[i * 4 + 3];
+    for (UINT y = 0; y < desc.Height; ++y) {
+        cefview::PixelKernels::CopyRect(srcData + static_cast<size_t>(desc.Height - 1 - y) * mapped.RowPitch, mapped.RowPitch,
+                                        pixels.data() + static_cast<size_t>(y) * rowSize, rowSize,
+                                        static_cast<int>(desc.Width), 1);
     }
+    context->Unmap(stagingTexture.Get(), 0);
+
+    file.write(reinterpret_cast<char*>(pixels.data()), imageSize);
+    file.close();
 
     return true;
 }
@@ -250,6 +245,7 @@ bool OsrRendererD3D11::initialize() {
 }
 
 void OsrRendererD3D11::uninitialize() {
+    _stagingTexture.Reset();
     _sharedTextureSRV.Reset();
     _sharedTexture.Reset();
     _sharedTextureHandle = nullptr;
@@ -550,6 +546,13 @@ void OsrRendererD3D11::onPaint(CefRenderHandler::PaintElementType type,
         return;
     }
 
+    // Feature level 11 guarantees 16384x16384 textures, so views are never tiled here
+    if (width > D3D11_REQ_TEXTURE2D_U_OR_V_DIMENSION || height > D3D11_REQ_TEXTURE2D_U_OR_V_DIMENSION) {
+        LOGE << "onPaint() " << width << "x" << height << " exceeds the D3D11 texture limit of "
+             << D3D11_REQ_TEXTURE2D_U_OR_V_DIMENSION;
+        return;
+    }
+
     // Check if texture size needs to be recreated
     if (_cefViewTexture) {
         D3D11_TEXTURE2D_DESC desc;
@@ -591,11 +594,26 @@ void OsrRendererD3D11::onPaint(CefRenderHandler::PaintElementType type,
             return;
         }
         LOGD << "onPaint() texture created " << width << "x" << height;
+
+        // A new texture holds nothing, so no tile may be skipped as unchanged
+        _tileHasher.reset();
     }
 
-    // Update texture data (only update dirty rectangles)
-    for (size_t i = 0; i < dirtyRects.size(); ++i) {
-        const CefRect& rect = dirtyRects[i];
+    // A paint while suspended replaces the cached frame in a new texture, so upload all of it
+    CefRenderHandler::RectList fullRect;
+    if (dropSuspendedFrame()) {
+        fullRect.emplace_back(0, 0, width, height);
+    }
+
+    // Update texture data (only update changed, coalesced dirty rectangles)
+    const CefRenderHandler::RectList& rects =
+        uploadRects(type, fullRect.empty() ? dirtyRects : fullRect, buffer, width, height);
+    if (rects.empty()) {
+        return;
+    }
+    auto uploadStart = OsrRenderStatsCollector::Clock::now();
+    for (size_t i = 0; i < rects.size(); ++i) {
+        const CefRect& rect = rects[i];
 
         int srcPitch = width * 4;
         const unsigned char* srcData = static_cast<const unsigned char*>(buffer);
@@ -611,6 +629,7 @@ void OsrRendererD3D11::onPaint(CefRenderHandler::PaintElementType type,
 
         _d3dContext->UpdateSubresource(_cefViewTexture.Get(), 0, &destBox, srcData, srcPitch, 0);
     }
+    _renderStats.recordUpload(byteCount(rects), OsrRenderStatsCollector::ElapsedMs(uploadStart));
 }
 
 void OsrRendererD3D11::onAcceleratedPaint(CefRenderHandler::PaintElementType type,
@@ -630,6 +649,9 @@ void OsrRendererD3D11::onAcceleratedPaint(CefRenderHandler::PaintElementType typ
         return;
     }
 
+    // The shared texture holds a whole frame newer than the one cached by suspendFrame()
+    dropSuspendedFrame();
+
     // If handle hasn't changed, nothing to do
     if (_sharedTextureHandle == sharedHandle && _sharedTexture && _sharedTextureSRV) {
         return;
@@ -691,6 +713,8 @@ void OsrRendererD3D11::render() {
         return;
     }
 
+    auto presentStart = OsrRenderStatsCollector::Clock::now();
+
     // Apply pending resize if any (CEFClient pattern: resize during render)
     if (_hasPendingResize) {
         applyPendingResize();
@@ -705,11 +729,28 @@ void OsrRendererD3D11::render() {
 
     // Select texture SRV: prefer shared texture (hardware), fallback to local texture (software)
     ID3D11ShaderResourceView* textureSRV = nullptr;
+    ID3D11Texture2D* texture = nullptr;
     if (_sharedTextureSRV) {
         textureSRV = _sharedTextureSRV.Get();
+        texture = _sharedTexture.Get();
     } else if (_cefViewShaderResourceView) {
         textureSRV = _cefViewShaderResourceView.Get();
+        texture = _cefViewTexture.Get();
+    }
+
+    // The texture keeps the previous frame until CEF paints at the new size:
+    // the full-view viewport stretches it, a texture-sized one draws it 1:1
+    D3D11_VIEWPORT viewport = {};
+    viewport.Width = static_cast<float>(_viewWidth);
+    viewport.Height = static_cast<float>(_viewHeight);
+    viewport.MaxDepth = 1.0f;
+    if (texture && resizeMode() == ResizeMode::kCrop) {
+        D3D11_TEXTURE2D_DESC desc;
+        texture->GetDesc(&desc);
+        viewport.Width = static_cast<float>(desc.Width);
+        viewport.Height = static_cast<float>(desc.Height);
     }
+    _d3dContext->RSSetViewports(1, &viewport);
 
     // Draw View texture (fullscreen quad)
     if (textureSRV) {
@@ -744,7 +785,100 @@ void OsrRendererD3D11::render() {
     HRESULT hr = _swapChain->Present(1, 0);
     if (FAILED(hr)) {
         LOGE << "render() Present FAILED hr=0x" << std::hex << hr;
+        return;
+    }
+    _renderStats.recordPresent(OsrRenderStatsCollector::ElapsedMs(presentStart));
+}
+
+uint64_t OsrRendererD3D11::suspendFrame() {
+    if (!_sharedTexture && !_cefViewTexture) {
+        return 0;
+    }
+
+    int width = 0;
+    int height = 0;
+    if (readbackFrame(_suspendedFrame, width, height)) {
+        _suspendedWidth = width;
+        _suspendedHeight = height;
+    } else {
+        // Without a cached frame the view stays blank on show until CEF repaints
+        LOGE << "suspendFrame() readback FAILED";
+    }
+
+    // Only the local texture is ours; shared textures belong to CEF's pool
+    uint64_t bytes = 0;
+    if (_cefViewTexture) {
+        D3D11_TEXTURE2D_DESC localDesc;
+        _cefViewTexture->GetDesc(&localDesc);
+        bytes = static_cast<uint64_t>(localDesc.Width) * localDesc.Height * 4;
     }
+    _cefViewShaderResourceView.Reset();
+    _cefViewTexture.Reset();
+    _sharedTextureSRV.Reset();
+    _sharedTexture.Reset();
+    _sharedTextureHandle = nullptr;
+    _stagingTexture.Reset();
+    LOGD << "suspendFrame() released " << bytes << " texture bytes";
+    return bytes;
+}
+
+bool OsrRendererD3D11::readbackFrame(PixelBuffer& pixels, int& width, int& height) {
+    ID3D11Texture2D* texture = _sharedTexture ? _sharedTexture.Get() : _cefViewTexture.Get();
+    if (!_d3dDevice || !_d3dContext || !texture) {
+        return false;
+    }
+
+    D3D11_TEXTURE2D_DESC desc;
+    texture->GetDesc(&desc);
+    if (desc.Format != DXGI_FORMAT_B8G8R8A8_UNORM) {
+        LOGE << "readbackFrame() unsupported format " << desc.Format;
+        return false;
+    }
+
+    // Read the frame back through a staging copy, kept until the size changes
+    if (_stagingTexture) {
+        D3D11_TEXTURE2D_DESC stagingDesc;
+        _stagingTexture->GetDesc(&stagingDesc);
+        if (stagingDesc.Width != desc.Width || stagingDesc.Height != desc.Height) {
+            _stagingTexture.Reset();
+        }
+    }
+    if (!_stagingTexture) {
+        D3D11_TEXTURE2D_DESC stagingDesc = desc;
+        stagingDesc.MipLevels = 1;
+        stagingDesc.ArraySize = 1;
+        stagingDesc.Usage = D3D11_USAGE_STAGING;
+        stagingDesc.BindFlags = 0;
+        stagingDesc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
+        stagingDesc.MiscFlags = 0;
+        HRESULT hr = _d3dDevice->CreateTexture2D(&stagingDesc, nullptr, _stagingTexture.GetAddressOf());
+        if (FAILED(hr)) {
+            LOGE << "readbackFrame() CreateTexture2D FAILED hr=0x" << std::hex << hr;
+            return false;
+        }
+    }
+
+    _d3dContext->CopyResource(_stagingTexture.Get(), texture);
+    D3D11_MAPPED_SUBRESOURCE mapped = {};
+    HRESULT hr = _d3dContext->Map(_stagingTexture.Get(), 0, D3D11_MAP_READ, 0, &mapped);
+    if (FAILED(hr)) {
+        LOGE << "readbackFrame() Map FAILED hr=0x" << std::hex << hr;
+        return false;
+    }
+
+    width = static_cast<int>(desc.Width);
+    height = static_cast<int>(desc.Height);
+    const size_t rowBytes = static_cast<size_t>(desc.Width) * 4;
+    pixels = PixelBufferPool::Shared().acquire(rowBytes * desc.Height);
+    if (!pixels) {
+        LOGE << "readbackFrame() failed to allocate a " << width << "x" << height << " frame";
+        _d3dContext->Unmap(_stagingTexture.Get(), 0);
+        return false;
+    }
+    PixelKernels::CopyRect(static_cast<const uint8_t*>(mapped.pData), mapped.RowPitch, pixels.data(), rowBytes,
+                           width, height);
+    _d3dContext->Unmap(_stagingTexture.Get(), 0);
+    return true;
 }
 
 void OsrRendererD3D11::setBounds(int x, int y, int width, int height) {
@@ -58,8 +58,11 @@ public:
                             const CefRenderHandler::RectList& dirtyRects,
                             const CefAcceleratedPaintInfo& info) override;
     void render() override;
+    uint64_t suspendFrame() override;
 
 protected:
+    bool readbackFrame(PixelBuffer& pixels, int& width, int& height) override;
+
     bool createDeviceAndSwapchain();
     bool createDirectComposition();
     bool createShaderResource();
@@ -127,6 +130,9 @@ protected:
     Microsoft::WRL::ComPtr<ID3D11Texture2D> _sharedTexture;
     Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> _sharedTextureSRV;
 
+    // CPU-readable copy of the view texture for readbackFrame()
+    Microsoft::WRL::ComPtr<ID3D11Texture2D> _stagingTexture;
+
     // Pending resize state (deferred until next render)
     int _pendingWidth = 0;
     int _pendingHeight = 0;
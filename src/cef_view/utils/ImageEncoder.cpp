@@ -0,0 +1,107 @@
+#include "ImageEncoder.h"
+
+#include <algorithm>
+
+#include "PixelBufferPool.h"
+#include "PixelKernels.h"
+
+// stb is built here only, with internal linkage and no stdio, so it cannot
+// clash with another copy linked into the host application
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wconversion"
+#pragma clang diagnostic ignored "-Wsign-conversion"
+#pragma clang diagnostic ignored "-Wunused-function"
+#pragma clang diagnostic ignored "-Wmissing-field-initializers"
+#pragma clang diagnostic ignored "-Wimplicit-fallthrough"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#pragma GCC diagnostic ignored "-Wsign-conversion"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wmissing-field-initializers"
+#pragma GCC diagnostic ignored "-Wimplicit-fallthrough"
+#elif defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable : 4244 4245 4267 4996)
+#endif
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#define STB_IMAGE_WRITE_STATIC
+#define STBI_WRITE_NO_STDIO
+#include "stb_image_write.h"
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#elif defined(__GNUC__)
+#pragma GCC diagnostic pop
+#elif defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
+namespace cefview {
+
+namespace {
+
+void AppendToVector(void* context, void* data, int size) {
+    auto* out = static_cast<std::vector<uint8_t>*>(context);
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    out->insert(out->end(), bytes, bytes + size);
+}
+
+}  // namespace
+
+bool ImageEncoder::Encode(Format format, const uint8_t* pixels, size_t stride, int width, int height,
+                          std::vector<uint8_t>& out, int quality) {
+    out.clear();
+    if (!pixels || width <= 0 || height <= 0) {
+        return false;
+    }
+
+    // stb wants tightly packed RGBA
+    const size_t pitch = static_cast<size_t>(width) * 4;
+    PixelBuffer rgba = PixelBufferPool::Shared().acquire(pitch * static_cast<size_t>(height));
+    if (!rgba) {
+        return false;
+    }
+    for (int y = 0; y < height; ++y) {
+        PixelKernels::SwizzleRB(pixels + static_cast<size_t>(y) * stride, rgba.data() + static_cast<size_t>(y) * pitch,
+                                static_cast<size_t>(width));
+    }
+    const size_t pixelCount = static_cast<size_t>(width) * static_cast<size_t>(height);
+    if (format != Format::kJpeg) {
+        PixelKernels::Unpremultiply(rgba.data(), pixelCount);
+    }
+
+    // Compressed output is usually well under a quarter of the raw size
+    out.reserve(format == Format::kBmp ? pitch * static_cast<size_t>(height) + 256 : pixelCount);
+    int written = 0;
+    switch (format) {
+        case Format::kPng:
+            written = stbi_write_png_to_func(AppendToVector, &out, width, height, 4, rgba.data(), static_cast<int>(pitch));
+            break;
+        case Format::kJpeg:
+            written = stbi_write_jpg_to_func(AppendToVector, &out, width, height, 4, rgba.data(),
+                                             std::min(std::max(quality, 1), 100));
+            break;
+        case Format::kBmp:
+            written = stbi_write_bmp_to_func(AppendToVector, &out, width, height, 4, rgba.data());
+            break;
+    }
+    if (!written) {
+        out.clear();
+        return false;
+    }
+    return true;
+}
+
+const char* ImageEncoder::MimeType(Format format) {
+    switch (format) {
+        case Format::kJpeg:
+            return "image/jpeg";
+        case Format::kBmp:
+            return "image/bmp";
+        default:
+            return "image/png";
+    }
+}
+
+}  // namespace cefview
@@ -0,0 +1,52 @@
+/**
+ * @file        ImageEncoder.h
+ * @brief       PNG, JPEG and BMP encoding of BGRA frames
+ * @version     1.0
+ * @date        2026.10.18
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cefview {
+
+/**
+ * @brief Encodes CEF's premultiplied BGRA pixels with stb_image_write
+ *
+ * PNG and BMP keep the alpha channel (unpremultiplied, as both formats
+ * expect). JPEG has no alpha and keeps the premultiplied colors, i.e. the
+ * frame as it looks over black.
+ *
+ * Thread-safe; meant to run off the UI thread.
+ */
+class ImageEncoder {
+public:
+    enum class Format {
+        kPng,
+        kJpeg,
+        kBmp
+    };
+
+    /**
+     * @brief Encode a top-down BGRA image into memory
+     * @param format Output format
+     * @param pixels First pixel of the image
+     * @param stride Bytes per row
+     * @param width Image width in pixels
+     * @param height Image height in rows
+     * @param out Receives the encoded file
+     * @param quality JPEG quality, 1 to 100 (ignored for PNG and BMP)
+     * @return false if the image is empty or encoding failed
+     */
+    static bool Encode(Format format, const uint8_t* pixels, size_t stride, int width, int height,
+                       std::vector<uint8_t>& out, int quality = 90);
+
+    /**
+     * @brief MIME type of a format, e.g. for data URLs
+     */
+    static const char* MimeType(Format format);
+};
+
+}  // namespace cefview
@@ -0,0 +1,235 @@
+#include "PixelBufferPool.h"
+
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace cefview {
+
+namespace {
+
+using Block = PixelBuffer::Block;
+
+size_t RoundUp(size_t value, size_t granularity) {
+    return (value + granularity - 1) / granularity * granularity;
+}
+
+#if defined(_WIN32)
+bool EnableLockMemoryPrivilege() {
+    HANDLE token = nullptr;
+    if (!OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token)) {
+        return false;
+    }
+    TOKEN_PRIVILEGES privileges = {};
+    privileges.PrivilegeCount = 1;
+    privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+    bool enabled = LookupPrivilegeValueW(nullptr, L"SeLockMemoryPrivilege", &privileges.Privileges[0].Luid) &&
+                   AdjustTokenPrivileges(token, FALSE, &privileges, 0, nullptr, nullptr) &&
+                   GetLastError() == ERROR_SUCCESS;
+    CloseHandle(token);
+    return enabled;
+}
+#endif
+
+uint8_t* SystemAllocate(size_t bytes, bool tryHugePages, bool& hugePages) {
+    hugePages = false;
+#if defined(_WIN32)
+    if (tryHugePages) {
+        // Large pages fail without SeLockMemoryPrivilege; find that out once
+        static const bool privilege = EnableLockMemoryPrivilege();
+        const size_t largePage = GetLargePageMinimum();
+        if (privilege && largePage > 0) {
+            void* ptr = VirtualAlloc(nullptr, RoundUp(bytes, largePage),
+                                     MEM_COMMIT | MEM_RESERVE | MEM_LARGE_PAGES, PAGE_READWRITE);
+            if (ptr) {
+                hugePages = true;
+                return static_cast<uint8_t*>(ptr);
+            }
+        }
+    }
+    return static_cast<uint8_t*>(VirtualAlloc(nullptr, bytes, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+#else
+    void* ptr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
+    if (ptr == MAP_FAILED) {
+        return nullptr;
+    }
+#if defined(MADV_HUGEPAGE)
+    if (tryHugePages && madvise(ptr, bytes, MADV_HUGEPAGE) == 0) {
+        hugePages = true;
+    }
+#else
+    (void)tryHugePages;
+#endif
+    return static_cast<uint8_t*>(ptr);
+#endif
+}
+
+void SystemFree(Block* block) {
+#if defined(_WIN32)
+    VirtualFree(block->data, 0, MEM_RELEASE);
+#else
+    munmap(block->data, block->capacity);
+#endif
+    delete block;
+}
+
+}  // namespace
+
+struct PixelBufferPool::State {
+    mutable std::mutex mutex;
+    std::unordered_map<size_t, std::vector<Block*>> freeLists;  ///< Keyed by size class
+    size_t maxIdleBytes = 256u * 1024 * 1024;
+    bool hugePagesEnabled = false;
+    Stats stats;
+
+    void noteReserved() {
+        stats.highWaterBytesInUse = std::max(stats.highWaterBytesInUse, stats.bytesInUse);
+        stats.highWaterBytesReserved = std::max(stats.highWaterBytesReserved, stats.bytesInUse + stats.bytesIdle);
+    }
+
+    void release(Block* block) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stats.bytesInUse -= block->capacity;
+            if (stats.bytesIdle + block->capacity <= maxIdleBytes) {
+                freeLists[block->capacity].push_back(block);
+                stats.bytesIdle += block->capacity;
+                return;
+            }
+        }
+        SystemFree(block);
+    }
+
+    std::vector<Block*> takeIdle() {
+        std::vector<Block*> idle;
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto& entry : freeLists) {
+            idle.insert(idle.end(), entry.second.begin(), entry.second.end());
+        }
+        freeLists.clear();
+        stats.bytesIdle = 0;
+        return idle;
+    }
+};
+
+void PixelBuffer::Release(Block* block) {
+    if (auto state = std::static_pointer_cast<PixelBufferPool::State>(block->pool.lock())) {
+        state->release(block);
+    } else {
+        SystemFree(block);
+    }
+}
+
+PixelBufferPool::PixelBufferPool()
+    : _state(std::make_shared<State>()) {
+}
+
+PixelBufferPool::~PixelBufferPool() {
+    trim();
+}
+
+PixelBufferPool& PixelBufferPool::Shared() {
+    // Never destroyed: buffers may be released during static destruction
+    static PixelBufferPool* pool = new PixelBufferPool();
+    return *pool;
+}
+
+size_t PixelBufferPool::SizeClass(size_t bytes) {
+    if (bytes <= kPageSize) {
+        return kPageSize;
+    }
+    // Four classes per power of two
+    size_t octave = kPageSize;
+    while (octave * 2 <= bytes) {
+        octave *= 2;
+    }
+    return RoundUp(RoundUp(bytes, octave / 4), kPageSize);
+}
+
+PixelBuffer PixelBufferPool::acquire(size_t bytes) {
+    PixelBuffer buffer;
+    if (bytes == 0) {
+        return buffer;
+    }
+
+    const size_t capacity = SizeClass(bytes);
+    Block* block = nullptr;
+    bool tryHugePages = false;
+    {
+        std::lock_guard<std::mutex> lock(_state->mutex);
+        ++_state->stats.acquires;
+        auto it = _state->freeLists.find(capacity);
+        if (it != _state->freeLists.end() && !it->second.empty()) {
+            block = it->second.back();
+            it->second.pop_back();
+            _state->stats.bytesIdle -= capacity;
+            ++_state->stats.reuses;
+        }
+        tryHugePages = _state->hugePagesEnabled && capacity >= kHugePageThreshold;
+    }
+
+    const bool fresh = block == nullptr;
+    if (fresh) {
+        bool hugePages = false;
+        uint8_t* data = SystemAllocate(capacity, tryHugePages, hugePages);
+        if (!data) {
+            return buffer;
+        }
+        block = new Block();
+        block->data = data;
+        block->capacity = capacity;
+        block->hugePages = hugePages;
+        block->pool = _state;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_state->mutex);
+        _state->stats.bytesInUse += capacity;
+        if (fresh) {
+            ++_state->stats.systemAllocations;
+            _state->stats.hugePageAllocations += block->hugePages ? 1 : 0;
+        }
+        _state->noteReserved();
+    }
+
+    block->refs.store(1, std::memory_order_relaxed);
+    buffer._block = block;
+    buffer._size = bytes;
+    return buffer;
+}
+
+void PixelBufferPool::setMaxIdleBytes(size_t bytes) {
+    {
+        std::lock_guard<std::mutex> lock(_state->mutex);
+        _state->maxIdleBytes = bytes;
+        if (_state->stats.bytesIdle <= bytes) {
+            return;
+        }
+    }
+    trim();
+}
+
+void PixelBufferPool::setHugePagesEnabled(bool enabled) {
+    std::lock_guard<std::mutex> lock(_state->mutex);
+    _state->hugePagesEnabled = enabled;
+}
+
+void PixelBufferPool::trim() {
+    for (Block* block : _state->takeIdle()) {
+        SystemFree(block);
+    }
+}
+
+PixelBufferPool::Stats PixelBufferPool::stats() const {
+    std::lock_guard<std::mutex> lock(_state->mutex);
+    return _state->stats;
+}
+
+}  // namespace cefview
@@ -0,0 +1,189 @@
+/**
+ * @file        PixelBufferPool.h
+ * @brief       Pool of page-aligned, reference-counted buffers for frame copies
+ * @version     1.0
+ * @date        2026.10.18
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace cefview {
+
+class PixelBufferPool;
+
+/**
+ * @brief Page-aligned memory borrowed from a PixelBufferPool
+ *
+ * Copies share the same memory. When the last copy is destroyed or reset
+ * the memory goes back to its pool (or to the system if the pool is gone).
+ * The contents of a freshly acquired buffer are unspecified.
+ */
+class PixelBuffer {
+public:
+    PixelBuffer() = default;
+    PixelBuffer(const PixelBuffer& other)
+        : _block(other._block)
+        , _size(other._size) {
+        if (_block) {
+            _block->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    PixelBuffer(PixelBuffer&& other) noexcept
+        : _block(other._block)
+        , _size(other._size) {
+        other._block = nullptr;
+        other._size = 0;
+    }
+    PixelBuffer& operator=(const PixelBuffer& other) {
+        PixelBuffer copy(other);
+        swap(copy);
+        return *this;
+    }
+    PixelBuffer& operator=(PixelBuffer&& other) noexcept {
+        PixelBuffer moved(std::move(other));
+        swap(moved);
+        return *this;
+    }
+    ~PixelBuffer() { reset(); }
+
+    uint8_t* data() const { return _block ? _block->data : nullptr; }
+
+    /**
+     * @brief Bytes requested when the buffer was acquired
+     */
+    size_t size() const { return _size; }
+
+    /**
+     * @brief Bytes actually reserved (the size class)
+     */
+    size_t capacity() const { return _block ? _block->capacity : 0; }
+
+    bool empty() const { return !_block; }
+    explicit operator bool() const { return _block != nullptr; }
+
+    /**
+     * @brief Number of PixelBuffer copies sharing this memory
+     */
+    long useCount() const { return _block ? _block->refs.load(std::memory_order_acquire) : 0; }
+
+    /**
+     * @brief Drop this reference
+     */
+    void reset() {
+        if (_block && _block->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            Release(_block);
+        }
+        _block = nullptr;
+        _size = 0;
+    }
+
+    void swap(PixelBuffer& other) noexcept {
+        std::swap(_block, other._block);
+        std::swap(_size, other._size);
+    }
+
+    /// Pool storage shared by copies; use data() and capacity() instead.
+    /// The count lives in the block, so reusing a pooled block allocates nothing.
+    struct Block {
+        uint8_t* data = nullptr;
+        size_t capacity = 0;
+        bool hugePages = false;
+        std::atomic<long> refs{0};
+        std::weak_ptr<void> pool{};  ///< PixelBufferPool state the block returns to
+    };
+
+private:
+    friend class PixelBufferPool;
+
+    /// Back to the pool, or to the system if the pool is gone
+    static void Release(Block* block);
+
+    Block* _block = nullptr;
+    size_t _size = 0;
+};
+
+/**
+ * @brief Size-classed free lists of page-aligned pixel buffers
+ *
+ * Frame copies (render thread slots, software layers, popup staging,
+ * screenshots) acquire buffers here instead of calling malloc/free for every
+ * frame. Requests are rounded up to a size class (four classes per power of
+ * two, so at most ~19% slack) and released buffers are kept for reuse until
+ * the idle total exceeds the retention limit.
+ *
+ * Buffers of 2 MB and more can be backed by huge pages: large pages on
+ * Windows (needs SeLockMemoryPrivilege) and transparent huge pages on Linux.
+ * Huge pages are best effort; allocation falls back to normal pages.
+ *
+ * Thread-safe.
+ */
+class PixelBufferPool {
+public:
+    struct Stats {
+        size_t bytesInUse = 0;         ///< Capacity of buffers currently acquired
+        size_t bytesIdle = 0;          ///< Capacity kept in the free lists
+        size_t highWaterBytesInUse = 0;
+        size_t highWaterBytesReserved = 0;  ///< Peak of in-use plus idle
+        uint64_t acquires = 0;
+        uint64_t reuses = 0;           ///< Acquires served from a free list
+        uint64_t systemAllocations = 0;
+        uint64_t hugePageAllocations = 0;
+    };
+
+    /// Alignment and granularity of all buffers
+    static constexpr size_t kPageSize = 4096;
+    /// Smallest buffer eligible for huge pages
+    static constexpr size_t kHugePageThreshold = 2 * 1024 * 1024;
+
+    PixelBufferPool();
+    ~PixelBufferPool();
+
+    PixelBufferPool(const PixelBufferPool&) = delete;
+    PixelBufferPool& operator=(const PixelBufferPool&) = delete;
+
+    /**
+     * @brief Process-wide pool used by the renderers
+     */
+    static PixelBufferPool& Shared();
+
+    /**
+     * @brief Size class a request is rounded up to
+     */
+    static size_t SizeClass(size_t bytes);
+
+    /**
+     * @brief Borrow a buffer of at least the given size
+     * @return Empty buffer if bytes is 0 or the system is out of memory
+     */
+    PixelBuffer acquire(size_t bytes);
+
+    /**
+     * @brief Maximum idle bytes kept for reuse (default 256 MB)
+     */
+    void setMaxIdleBytes(size_t bytes);
+
+    /**
+     * @brief Back large buffers with huge pages when available (default off)
+     */
+    void setHugePagesEnabled(bool enabled);
+
+    /**
+     * @brief Return all idle buffers to the system
+     */
+    void trim();
+
+    Stats stats() const;
+
+private:
+    friend class PixelBuffer;
+    struct State;
+
+    std::shared_ptr<State> _state;
+};
+
+}  // namespace cefview
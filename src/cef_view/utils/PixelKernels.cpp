@@ -0,0 +1,930 @@
+#include "PixelKernels.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+#define CEFVIEW_PIXEL_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define CEFVIEW_PIXEL_NEON 1
+#include <arm_neon.h>
+#endif
+
+// GCC and Clang only emit SSE2/AVX2 instructions inside functions that opt in;
+// MSVC allows the intrinsics anywhere
+#if defined(CEFVIEW_PIXEL_X86) && (defined(__GNUC__) || defined(__clang__))
+#define CEFVIEW_TARGET_SSE2 __attribute__((target("sse2")))
+#define CEFVIEW_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define CEFVIEW_TARGET_SSE2
+#define CEFVIEW_TARGET_AVX2
+#endif
+
+namespace cefview {
+
+namespace {
+
+using SwizzleFn = void (*)(const uint8_t*, uint8_t*, size_t);
+using InPlaceFn = void (*)(uint8_t*, size_t);
+using HashBlocksFn = void (*)(const uint8_t*, size_t, size_t, int, uint32_t*);
+using HalveRowFn = void (*)(const uint8_t*, const uint8_t*, uint8_t*, size_t);
+using LumaRowFn = void (*)(const uint8_t*, uint8_t*, size_t);
+using ChromaRowFn = void (*)(const uint8_t*, const uint8_t*, uint8_t*, uint8_t*, size_t);
+
+struct KernelTable {
+    PixelKernels::Isa isa;
+    SwizzleFn swizzle;
+    InPlaceFn premultiply;
+    InPlaceFn unpremultiply;
+    HashBlocksFn hashBlocks;
+    HalveRowFn halveRow;
+    LumaRowFn lumaRow;
+    ChromaRowFn chromaRowI420;
+    ChromaRowFn chromaRowNV12;
+};
+
+// Hash: sixteen 32-bit lanes each absorb one word of every 64-byte block
+// (xxHash32 round); words past the last whole block of a row go through a
+// scalar 64-bit accumulator. Every variant computes the same value. Sixteen
+// lanes give each SIMD variant at least two independent multiply chains.
+constexpr uint32_t kHashPrime1 = 2654435761u;
+constexpr uint32_t kHashPrime2 = 2246822519u;
+constexpr uint64_t kHashPrime64 = 0x9E3779B97F4A7C15ull;
+constexpr size_t kHashBlockBytes = 64;
+constexpr int kHashLanes = 16;
+
+// ============================================================================
+// Scalar reference implementations (also used for loop tails)
+// ============================================================================
+
+/// round(x / 255) for x in [0, 255 * 255]
+inline uint8_t Div255(uint32_t x) {
+    x += 128;
+    return static_cast<uint8_t>((x + (x >> 8)) >> 8);
+}
+
+void SwizzleScalar(const uint8_t* src, uint8_t* dst, size_t pixelCount) {
+    for (size_t i = 0; i < pixelCount; ++i, src += 4, dst += 4) {
+        uint8_t b = src[0];
+        uint8_t g = src[1];
+        uint8_t r = src[2];
+        uint8_t a = src[3];
+        dst[0] = r;
+        dst[1] = g;
+        dst[2] = b;
+        dst[3] = a;
+    }
+}
+
+void PremultiplyScalar(uint8_t* pixels, size_t pixelCount) {
+    for (size_t i = 0; i < pixelCount; ++i, pixels += 4) {
+        uint32_t a = pixels[3];
+        pixels[0] = Div255(pixels[0] * a);
+        pixels[1] = Div255(pixels[1] * a);
+        pixels[2] = Div255(pixels[2] * a);
+    }
+}
+
+void UnpremultiplyScalar(uint8_t* pixels, size_t pixelCount) {
+    for (size_t i = 0; i < pixelCount; ++i, pixels += 4) {
+        uint32_t a = pixels[3];
+        if (a == 0) {
+            continue;
+        }
+        // color = (color_premul * 255 + alpha / 2) / alpha
+        for (int c = 0; c < 3; ++c) {
+            pixels[c] = static_cast<uint8_t>(std::min<uint32_t>(255, (pixels[c] * 255u + a / 2) / a));
+        }
+    }
+}
+
+void HashBlocksScalar(const uint8_t* src, size_t stride, size_t blocksPerRow, int height, uint32_t* lanes) {
+    for (int y = 0; y < height; ++y, src += stride) {
+        const uint8_t* block = src;
+        for (size_t b = 0; b < blocksPerRow; ++b, block += kHashBlockBytes) {
+            for (int k = 0; k < kHashLanes; ++k) {
+                uint32_t word;
+                std::memcpy(&word, block + k * 4, 4);
+                uint32_t acc = lanes[k] + word * kHashPrime2;
+                lanes[k] = ((acc << 13) | (acc >> 19)) * kHashPrime1;
+            }
+        }
+    }
+}
+
+/// Rounding average, as pavgb / vrhadd compute it
+inline uint8_t Avg(uint32_t a, uint32_t b) {
+    return static_cast<uint8_t>((a + b + 1) >> 1);
+}
+
+/// One output row of a 2x2 box filter: average vertically, then horizontally
+void HalveRowScalar(const uint8_t* top, const uint8_t* bottom, uint8_t* dst, size_t dstPixels) {
+    for (size_t i = 0; i < dstPixels; ++i, top += 8, bottom += 8, dst += 4) {
+        for (int c = 0; c < 4; ++c) {
+            dst[c] = Avg(Avg(top[c], bottom[c]), Avg(top[c + 4], bottom[c + 4]));
+        }
+    }
+}
+
+// BT.601 limited range in 8-bit fixed point. Every intermediate fits in 16
+// bits (unsigned for luma, signed for chroma), which the SIMD variants rely on.
+inline uint8_t LumaOf(int b, int g, int r) {
+    return static_cast<uint8_t>(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+}
+
+inline uint8_t ChromaUOf(int b, int g, int r) {
+    return static_cast<uint8_t>(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+}
+
+inline uint8_t ChromaVOf(int b, int g, int r) {
+    return static_cast<uint8_t>(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+}
+
+void LumaRowScalar(const uint8_t* src, uint8_t* dst, size_t pixelCount) {
+    for (size_t i = 0; i < pixelCount; ++i, src += 4) {
+        dst[i] = LumaOf(src[0], src[1], src[2]);
+    }
+}
+
+/// Chroma of one row pair; each sample averages a 2x2 block (an odd last column repeats)
+template <bool Interleaved>
+void ChromaRowScalar(const uint8_t* top, const uint8_t* bottom, uint8_t* u, uint8_t* v, size_t pixelCount) {
+    for (size_t x = 0; x < pixelCount; x += 2) {
+        const size_t left = x * 4;
+        const size_t right = x + 1 < pixelCount ? left + 4 : left;
+        const int b = (top[left] + top[right] + bottom[left] + bottom[right] + 2) >> 2;
+        const int g = (top[left + 1] + top[right + 1] + bottom[left + 1] + bottom[right + 1] + 2) >> 2;
+        const int r = (top[left + 2] + top[right + 2] + bottom[left + 2] + bottom[right + 2] + 2) >> 2;
+        if (Interleaved) {
+            u[x] = ChromaUOf(b, g, r);
+            u[x + 1] = ChromaVOf(b, g, r);
+        } else {
+            u[x / 2] = ChromaUOf(b, g, r);
+            v[x / 2] = ChromaVOf(b, g, r);
+        }
+    }
+}
+
+// ============================================================================
+// SSE2 / AVX2
+// ============================================================================
+#if defined(CEFVIEW_PIXEL_X86)
+
+CEFVIEW_TARGET_SSE2 void SwizzleSSE2(const uint8_t* src, uint8_t* dst, size_t pixelCount) {
+    const __m128i agMask = _mm_set1_epi32(static_cast<int>(0xFF00FF00u));
+    const __m128i rbMask = _mm_set1_epi32(0x00FF00FF);
+    size_t i = 0;
+    for (; i + 4 <= pixelCount; i += 4) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+        __m128i rb = _mm_and_si128(v, rbMask);
+        __m128i swapped = _mm_or_si128(_mm_slli_epi32(rb, 16), _mm_srli_epi32(rb, 16));
+        v = _mm_or_si128(_mm_and_si128(v, agMask), swapped);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), v);
+    }
+    SwizzleScalar(src + i * 4, dst + i * 4, pixelCount - i);
+}
+
+/// Premultiply two pixels widened to 16-bit lanes
+CEFVIEW_TARGET_SSE2 inline __m128i PremultiplyWideSSE2(__m128i px) {
+    // Broadcast each pixel's alpha to its lanes; the alpha lane itself is
+    // multiplied by 255 so it comes out unchanged
+    const __m128i colorLanes = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+    const __m128i alphaLanes = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    const __m128i bias = _mm_set1_epi16(128);
+    __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(px, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+    alpha = _mm_or_si128(_mm_and_si128(alpha, colorLanes), alphaLanes);
+    __m128i t = _mm_add_epi16(_mm_mullo_epi16(px, alpha), bias);
+    return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+}
+
+CEFVIEW_TARGET_SSE2 void PremultiplySSE2(uint8_t* pixels, size_t pixelCount) {
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 4 <= pixelCount; i += 4) {
+        __m128i* p = reinterpret_cast<__m128i*>(pixels + i * 4);
+        __m128i v = _mm_loadu_si128(p);
+        __m128i lo = PremultiplyWideSSE2(_mm_unpacklo_epi8(v, zero));
+        __m128i hi = PremultiplyWideSSE2(_mm_unpackhi_epi8(v, zero));
+        _mm_storeu_si128(p, _mm_packus_epi16(lo, hi));
+    }
+    PremultiplyScalar(pixels + i * 4, pixelCount - i);
+}
+
+/// Unpremultiply one pixel held as four 32-bit lanes
+CEFVIEW_TARGET_SSE2 inline __m128i UnpremultiplyPixelSSE2(__m128i px) {
+    // Float division is exact enough here: quotients below 256 are at least
+    // 1/255 away from the next integer, far more than the rounding error
+    const __m128 scale = _mm_set1_ps(255.0f);
+    const __m128 one = _mm_set1_ps(1.0f);
+    __m128i alpha = _mm_shuffle_epi32(px, _MM_SHUFFLE(3, 3, 3, 3));
+    __m128 num = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(px), scale), _mm_cvtepi32_ps(_mm_srli_epi32(alpha, 1)));
+    __m128 q = _mm_div_ps(num, _mm_max_ps(_mm_cvtepi32_ps(alpha), one));
+    return _mm_cvttps_epi32(q);
+}
+
+CEFVIEW_TARGET_SSE2 void UnpremultiplySSE2(uint8_t* pixels, size_t pixelCount) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+    size_t i = 0;
+    for (; i + 4 <= pixelCount; i += 4) {
+        __m128i* p = reinterpret_cast<__m128i*>(pixels + i * 4);
+        __m128i v = _mm_loadu_si128(p);
+        __m128i lo = _mm_unpacklo_epi8(v, zero);
+        __m128i hi = _mm_unpackhi_epi8(v, zero);
+        __m128i q0 = UnpremultiplyPixelSSE2(_mm_unpacklo_epi16(lo, zero));
+        __m128i q1 = UnpremultiplyPixelSSE2(_mm_unpackhi_epi16(lo, zero));
+        __m128i q2 = UnpremultiplyPixelSSE2(_mm_unpacklo_epi16(hi, zero));
+        __m128i q3 = UnpremultiplyPixelSSE2(_mm_unpackhi_epi16(hi, zero));
+        // Saturating packs clamp quotients above 255
+        __m128i result = _mm_packus_epi16(_mm_packs_epi32(q0, q1), _mm_packs_epi32(q2, q3));
+
+        // Keep the original alpha, and the whole pixel where alpha is 0
+        __m128i keep = _mm_or_si128(_mm_cmpeq_epi32(_mm_and_si128(v, alphaMask), zero), alphaMask);
+        _mm_storeu_si128(p, _mm_or_si128(_mm_and_si128(keep, v), _mm_andnot_si128(keep, result)));
+    }
+    UnpremultiplyScalar(pixels + i * 4, pixelCount - i);
+}
+
+/// 32-bit lane multiply; SSE2 only has the 32x32->64 form
+CEFVIEW_TARGET_SSE2 inline __m128i Mullo32SSE2(__m128i a, __m128i b) {
+    __m128i even = _mm_mul_epu32(a, b);
+    __m128i odd = _mm_mul_epu32(_mm_srli_si128(a, 4), _mm_srli_si128(b, 4));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                              _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+CEFVIEW_TARGET_SSE2 inline __m128i HashRoundSSE2(__m128i acc, __m128i words) {
+    const __m128i prime1 = _mm_set1_epi32(static_cast<int>(kHashPrime1));
+    const __m128i prime2 = _mm_set1_epi32(static_cast<int>(kHashPrime2));
+    acc = _mm_add_epi32(acc, Mullo32SSE2(words, prime2));
+    acc = _mm_or_si128(_mm_slli_epi32(acc, 13), _mm_srli_epi32(acc, 19));
+    return Mullo32SSE2(acc, prime1);
+}
+
+CEFVIEW_TARGET_SSE2 void HashBlocksSSE2(const uint8_t* src, size_t stride, size_t blocksPerRow, int height, uint32_t* lanes) {
+    __m128i acc[4];
+    for (int k = 0; k < 4; ++k) {
+        acc[k] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes + k * 4));
+    }
+    for (int y = 0; y < height; ++y, src += stride) {
+        const uint8_t* block = src;
+        for (size_t b = 0; b < blocksPerRow; ++b, block += kHashBlockBytes) {
+            for (int k = 0; k < 4; ++k) {
+                acc[k] = HashRoundSSE2(acc[k], _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + k * 16)));
+            }
+        }
+    }
+    for (int k = 0; k < 4; ++k) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes + k * 4), acc[k]);
+    }
+}
+
+CEFVIEW_TARGET_AVX2 void HashBlocksAVX2(const uint8_t* src, size_t stride, size_t blocksPerRow, int height, uint32_t* lanes) {
+    const __m256i prime1 = _mm256_set1_epi32(static_cast<int>(kHashPrime1));
+    const __m256i prime2 = _mm256_set1_epi32(static_cast<int>(kHashPrime2));
+    __m256i acc[2];
+    for (int k = 0; k < 2; ++k) {
+        acc[k] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lanes + k * 8));
+    }
+    for (int y = 0; y < height; ++y, src += stride) {
+        const uint8_t* block = src;
+        for (size_t b = 0; b < blocksPerRow; ++b, block += kHashBlockBytes) {
+            for (int k = 0; k < 2; ++k) {
+                __m256i words = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + k * 32));
+                acc[k] = _mm256_add_epi32(acc[k], _mm256_mullo_epi32(words, prime2));
+                acc[k] = _mm256_or_si256(_mm256_slli_epi32(acc[k], 13), _mm256_srli_epi32(acc[k], 19));
+                acc[k] = _mm256_mullo_epi32(acc[k], prime1);
+            }
+        }
+    }
+    for (int k = 0; k < 2; ++k) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes + k * 8), acc[k]);
+    }
+}
+
+CEFVIEW_TARGET_AVX2 void SwizzleAVX2(const uint8_t* src, uint8_t* dst, size_t pixelCount) {
+    const __m256i shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+                                             2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    size_t i = 0;
+    for (; i + 8 <= pixelCount; i += 8) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 4));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), _mm256_shuffle_epi8(v, shuffle));
+    }
+    SwizzleScalar(src + i * 4, dst + i * 4, pixelCount - i);
+}
+
+CEFVIEW_TARGET_AVX2 inline __m256i PremultiplyWideAVX2(__m256i px) {
+    const __m256i colorLanes = _mm256_set_epi16(0, -1, -1, -1, 0, -1, -1, -1, 0, -1, -1, -1, 0, -1, -1, -1);
+    const __m256i alphaLanes = _mm256_set_epi16(255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0);
+    const __m256i bias = _mm256_set1_epi16(128);
+    __m256i alpha =
+        _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(px, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+    alpha = _mm256_or_si256(_mm256_and_si256(alpha, colorLanes), alphaLanes);
+    __m256i t = _mm256_add_epi16(_mm256_mullo_epi16(px, alpha), bias);
+    return _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8);
+}
+
+CEFVIEW_TARGET_AVX2 void PremultiplyAVX2(uint8_t* pixels, size_t pixelCount) {
+    const __m256i zero = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= pixelCount; i += 8) {
+        __m256i* p = reinterpret_cast<__m256i*>(pixels + i * 4);
+        __m256i v = _mm256_loadu_si256(p);
+        // Unpack and pack both work per 128-bit lane, so pixel order is preserved
+        __m256i lo = PremultiplyWideAVX2(_mm256_unpacklo_epi8(v, zero));
+        __m256i hi = PremultiplyWideAVX2(_mm256_unpackhi_epi8(v, zero));
+        _mm256_storeu_si256(p, _mm256_packus_epi16(lo, hi));
+    }
+    PremultiplyScalar(pixels + i * 4, pixelCount - i);
+}
+
+CEFVIEW_TARGET_SSE2 void HalveRowSSE2(const uint8_t* top, const uint8_t* bottom, uint8_t* dst, size_t dstPixels) {
+    size_t i = 0;
+    for (; i + 4 <= dstPixels; i += 4) {
+        __m128i v0 = _mm_avg_epu8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(top + i * 8)),
+                                  _mm_loadu_si128(reinterpret_cast<const __m128i*>(bottom + i * 8)));
+        __m128i v1 = _mm_avg_epu8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(top + i * 8 + 16)),
+                                  _mm_loadu_si128(reinterpret_cast<const __m128i*>(bottom + i * 8 + 16)));
+        // Split even and odd pixels
+        __m128 even = _mm_shuffle_ps(_mm_castsi128_ps(v0), _mm_castsi128_ps(v1), _MM_SHUFFLE(2, 0, 2, 0));
+        __m128 odd = _mm_shuffle_ps(_mm_castsi128_ps(v0), _mm_castsi128_ps(v1), _MM_SHUFFLE(3, 1, 3, 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4),
+                         _mm_avg_epu8(_mm_castps_si128(even), _mm_castps_si128(odd)));
+    }
+    HalveRowScalar(top + i * 8, bottom + i * 8, dst + i * 4, dstPixels - i);
+}
+
+CEFVIEW_TARGET_AVX2 void HalveRowAVX2(const uint8_t* top, const uint8_t* bottom, uint8_t* dst, size_t dstPixels) {
+    size_t i = 0;
+    for (; i + 8 <= dstPixels; i += 8) {
+        __m256i v0 = _mm256_avg_epu8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(top + i * 8)),
+                                     _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bottom + i * 8)));
+        __m256i v1 = _mm256_avg_epu8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(top + i * 8 + 32)),
+                                     _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bottom + i * 8 + 32)));
+        // Shuffles stay within 128-bit lanes; the permute restores pixel order
+        __m256 even = _mm256_shuffle_ps(_mm256_castsi256_ps(v0), _mm256_castsi256_ps(v1), _MM_SHUFFLE(2, 0, 2, 0));
+        __m256 odd = _mm256_shuffle_ps(_mm256_castsi256_ps(v0), _mm256_castsi256_ps(v1), _MM_SHUFFLE(3, 1, 3, 1));
+        __m256i avg = _mm256_avg_epu8(_mm256_castps_si256(even), _mm256_castps_si256(odd));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4),
+                            _mm256_permute4x64_epi64(avg, _MM_SHUFFLE(3, 1, 2, 0)));
+    }
+    HalveRowSSE2(top + i * 8, bottom + i * 8, dst + i * 4, dstPixels - i);
+}
+
+/// Split 8 BGRA pixels into 16-bit B, G and R lanes
+CEFVIEW_TARGET_SSE2 inline void SplitChannelsSSE2(const uint8_t* src, __m128i& b, __m128i& g, __m128i& r) {
+    const __m128i mask = _mm_set1_epi32(0xFF);
+    __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 16));
+    b = _mm_packs_epi32(_mm_and_si128(v0, mask), _mm_and_si128(v1, mask));
+    g = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(v0, 8), mask), _mm_and_si128(_mm_srli_epi32(v1, 8), mask));
+    r = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(v0, 16), mask), _mm_and_si128(_mm_srli_epi32(v1, 16), mask));
+}
+
+/// Luma of 16-bit channel lanes; the sum may exceed 32767, so it is shifted unsigned
+CEFVIEW_TARGET_SSE2 inline __m128i LumaSSE2(__m128i b, __m128i g, __m128i r) {
+    __m128i y = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(r, _mm_set1_epi16(66)),
+                                            _mm_mullo_epi16(g, _mm_set1_epi16(129))),
+                              _mm_add_epi16(_mm_mullo_epi16(b, _mm_set1_epi16(25)), _mm_set1_epi16(128)));
+    return _mm_add_epi16(_mm_srli_epi16(y, 8), _mm_set1_epi16(16));
+}
+
+CEFVIEW_TARGET_SSE2 void LumaRowSSE2(const uint8_t* src, uint8_t* dst, size_t pixelCount) {
+    size_t i = 0;
+    for (; i + 16 <= pixelCount; i += 16) {
+        __m128i b0, g0, r0, b1, g1, r1;
+        SplitChannelsSSE2(src + i * 4, b0, g0, r0);
+        SplitChannelsSSE2(src + i * 4 + 32, b1, g1, r1);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                         _mm_packus_epi16(LumaSSE2(b0, g0, r0), LumaSSE2(b1, g1, r1)));
+    }
+    LumaRowScalar(src + i * 4, dst + i, pixelCount - i);
+}
+
+/// Sums of the 2x2 blocks under 8 pixels of a row pair, as four 32-bit lanes per channel
+CEFVIEW_TARGET_SSE2 inline void BlockSumsSSE2(const uint8_t* top, const uint8_t* bottom,
+                                              __m128i& b, __m128i& g, __m128i& r) {
+    const __m128i ones = _mm_set1_epi16(1);
+    __m128i bt, gt, rt, bb, gb, rb;
+    SplitChannelsSSE2(top, bt, gt, rt);
+    SplitChannelsSSE2(bottom, bb, gb, rb);
+    // pmaddwd adds horizontal neighbours
+    b = _mm_madd_epi16(_mm_add_epi16(bt, bb), ones);
+    g = _mm_madd_epi16(_mm_add_epi16(gt, gb), ones);
+    r = _mm_madd_epi16(_mm_add_epi16(rt, rb), ones);
+}
+
+template <bool Interleaved>
+CEFVIEW_TARGET_SSE2 void ChromaRowSSE2(const uint8_t* top, const uint8_t* bottom, uint8_t* u, uint8_t* v,
+                                       size_t pixelCount) {
+    const __m128i two = _mm_set1_epi16(2);
+    const __m128i bias = _mm_set1_epi16(128);
+    size_t i = 0;
+    for (; i + 16 <= pixelCount; i += 16) {
+        __m128i b0, g0, r0, b1, g1, r1;
+        BlockSumsSSE2(top + i * 4, bottom + i * 4, b0, g0, r0);
+        BlockSumsSSE2(top + i * 4 + 32, bottom + i * 4 + 32, b1, g1, r1);
+        __m128i b = _mm_srli_epi16(_mm_add_epi16(_mm_packs_epi32(b0, b1), two), 2);
+        __m128i g = _mm_srli_epi16(_mm_add_epi16(_mm_packs_epi32(g0, g1), two), 2);
+        __m128i r = _mm_srli_epi16(_mm_add_epi16(_mm_packs_epi32(r0, r1), two), 2);
+
+        __m128i cu = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(r, _mm_set1_epi16(-38)),
+                                                 _mm_mullo_epi16(g, _mm_set1_epi16(-74))),
+                                   _mm_add_epi16(_mm_mullo_epi16(b, _mm_set1_epi16(112)), bias));
+        __m128i cv = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(r, _mm_set1_epi16(112)),
+                                                 _mm_mullo_epi16(g, _mm_set1_epi16(-94))),
+                                   _mm_add_epi16(_mm_mullo_epi16(b, _mm_set1_epi16(-18)), bias));
+        cu = _mm_add_epi16(_mm_srai_epi16(cu, 8), bias);
+        cv = _mm_add_epi16(_mm_srai_epi16(cv, 8), bias);
+        __m128i uv = _mm_packus_epi16(cu, cv);  // 8 U then 8 V
+        if (Interleaved) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(u + i), _mm_unpacklo_epi8(uv, _mm_srli_si128(uv, 8)));
+        } else {
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(u + i / 2), uv);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(v + i / 2), _mm_srli_si128(uv, 8));
+        }
+    }
+    if (Interleaved) {
+        ChromaRowScalar<true>(top + i * 4, bottom + i * 4, u + i, nullptr, pixelCount - i);
+    } else {
+        ChromaRowScalar<false>(top + i * 4, bottom + i * 4, u + i / 2, v + i / 2, pixelCount - i);
+    }
+}
+
+CEFVIEW_TARGET_AVX2 inline void SplitChannelsAVX2(const uint8_t* src, __m256i& b, __m256i& g, __m256i& r) {
+    const __m256i mask = _mm256_set1_epi32(0xFF);
+    __m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+    __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 32));
+    b = _mm256_packs_epi32(_mm256_and_si256(v0, mask), _mm256_and_si256(v1, mask));
+    g = _mm256_packs_epi32(_mm256_and_si256(_mm256_srli_epi32(v0, 8), mask),
+                           _mm256_and_si256(_mm256_srli_epi32(v1, 8), mask));
+    r = _mm256_packs_epi32(_mm256_and_si256(_mm256_srli_epi32(v0, 16), mask),
+                           _mm256_and_si256(_mm256_srli_epi32(v1, 16), mask));
+}
+
+CEFVIEW_TARGET_AVX2 inline __m256i LumaAVX2(__m256i b, __m256i g, __m256i r) {
+    __m256i y = _mm256_add_epi16(_mm256_add_epi16(_mm256_mullo_epi16(r, _mm256_set1_epi16(66)),
+                                                  _mm256_mullo_epi16(g, _mm256_set1_epi16(129))),
+                                 _mm256_add_epi16(_mm256_mullo_epi16(b, _mm256_set1_epi16(25)),
+                                                  _mm256_set1_epi16(128)));
+    return _mm256_add_epi16(_mm256_srli_epi16(y, 8), _mm256_set1_epi16(16));
+}
+
+CEFVIEW_TARGET_AVX2 void LumaRowAVX2(const uint8_t* src, uint8_t* dst, size_t pixelCount) {
+    // The packs interleave 128-bit lanes; the final permute puts 4-pixel groups back in order
+    const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    size_t i = 0;
+    for (; i + 32 <= pixelCount; i += 32) {
+        __m256i b0, g0, r0, b1, g1, r1;
+        SplitChannelsAVX2(src + i * 4, b0, g0, r0);
+        SplitChannelsAVX2(src + i * 4 + 64, b1, g1, r1);
+        __m256i y = _mm256_packus_epi16(LumaAVX2(b0, g0, r0), LumaAVX2(b1, g1, r1));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_permutevar8x32_epi32(y, order));
+    }
+    LumaRowSSE2(src + i * 4, dst + i, pixelCount - i);
+}
+
+CEFVIEW_TARGET_SSE2 void StreamRectSSE2(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride, int width, int height) {
+    const size_t rowBytes = static_cast<size_t>(width) * 4;
+    for (int y = 0; y < height; ++y, src += srcStride, dst += dstStride) {
+        size_t head = std::min(rowBytes, (16 - (reinterpret_cast<uintptr_t>(dst) & 15)) & 15);
+        std::memcpy(dst, src, head);
+        size_t x = head;
+        for (; x + 16 <= rowBytes; x += 16) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x));
+            _mm_stream_si128(reinterpret_cast<__m128i*>(dst + x), v);
+        }
+        std::memcpy(dst + x, src + x, rowBytes - x);
+    }
+    // Make the streamed stores visible before the buffer is handed off
+    _mm_sfence();
+}
+
+#endif  // CEFVIEW_PIXEL_X86
+
+// ============================================================================
+// NEON
+// ============================================================================
+#if defined(CEFVIEW_PIXEL_NEON)
+
+void SwizzleNEON(const uint8_t* src, uint8_t* dst, size_t pixelCount) {
+    size_t i = 0;
+    for (; i + 16 <= pixelCount; i += 16) {
+        uint8x16x4_t v = vld4q_u8(src + i * 4);
+        uint8x16_t b = v.val[0];
+        v.val[0] = v.val[2];
+        v.val[2] = b;
+        vst4q_u8(dst + i * 4, v);
+    }
+    SwizzleScalar(src + i * 4, dst + i * 4, pixelCount - i);
+}
+
+/// round(c * a / 255) for 8 channel values
+inline uint8x8_t PremultiplyHalfNEON(uint8x8_t c, uint8x8_t a) {
+    uint16x8_t t = vmull_u8(c, a);
+    return vraddhn_u16(t, vrshrq_n_u16(t, 8));
+}
+
+void PremultiplyNEON(uint8_t* pixels, size_t pixelCount) {
+    size_t i = 0;
+    for (; i + 16 <= pixelCount; i += 16) {
+        uint8x16x4_t v = vld4q_u8(pixels + i * 4);
+        uint8x8_t aLo = vget_low_u8(v.val[3]);
+        uint8x8_t aHi = vget_high_u8(v.val[3]);
+        for (int c = 0; c < 3; ++c) {
+            v.val[c] = vcombine_u8(PremultiplyHalfNEON(vget_low_u8(v.val[c]), aLo),
+                                   PremultiplyHalfNEON(vget_high_u8(v.val[c]), aHi));
+        }
+        vst4q_u8(pixels + i * 4, v);
+    }
+    PremultiplyScalar(pixels + i * 4, pixelCount - i);
+}
+
+/// Widen 16 bytes to four vectors of 32-bit lanes
+inline void WidenNEON(uint8x16_t v, uint32x4_t out[4]) {
+    uint16x8_t lo = vmovl_u8(vget_low_u8(v));
+    uint16x8_t hi = vmovl_u8(vget_high_u8(v));
+    out[0] = vmovl_u16(vget_low_u16(lo));
+    out[1] = vmovl_u16(vget_high_u16(lo));
+    out[2] = vmovl_u16(vget_low_u16(hi));
+    out[3] = vmovl_u16(vget_high_u16(hi));
+}
+
+void UnpremultiplyNEON(uint8_t* pixels, size_t pixelCount) {
+    const uint32x4_t one = vdupq_n_u32(1);
+    size_t i = 0;
+    for (; i + 16 <= pixelCount; i += 16) {
+        uint8x16x4_t v = vld4q_u8(pixels + i * 4);
+        uint32x4_t alpha[4];
+        WidenNEON(v.val[3], alpha);
+        float32x4_t divisor[4];
+        uint32x4_t half[4];
+        for (int k = 0; k < 4; ++k) {
+            divisor[k] = vcvtq_f32_u32(vmaxq_u32(alpha[k], one));
+            half[k] = vshrq_n_u32(alpha[k], 1);
+        }
+
+        const uint8x16_t transparent = vceqq_u8(v.val[3], vdupq_n_u8(0));
+        for (int c = 0; c < 3; ++c) {
+            uint32x4_t color[4];
+            WidenNEON(v.val[c], color);
+            uint16x4_t q[4];
+            for (int k = 0; k < 4; ++k) {
+                float32x4_t num = vcvtq_f32_u32(vmlaq_n_u32(half[k], color[k], 255));
+                q[k] = vqmovn_u32(vcvtq_u32_f32(vdivq_f32(num, divisor[k])));
+            }
+            uint8x16_t result = vcombine_u8(vqmovn_u16(vcombine_u16(q[0], q[1])), vqmovn_u16(vcombine_u16(q[2], q[3])));
+            v.val[c] = vbslq_u8(transparent, v.val[c], result);
+        }
+        vst4q_u8(pixels + i * 4, v);
+    }
+    UnpremultiplyScalar(pixels + i * 4, pixelCount - i);
+}
+
+inline uint32x4_t HashRoundNEON(uint32x4_t acc, uint32x4_t words) {
+    acc = vmlaq_n_u32(acc, words, kHashPrime2);
+    acc = vorrq_u32(vshlq_n_u32(acc, 13), vshrq_n_u32(acc, 19));
+    return vmulq_n_u32(acc, kHashPrime1);
+}
+
+void HalveRowNEON(const uint8_t* top, const uint8_t* bottom, uint8_t* dst, size_t dstPixels) {
+    size_t i = 0;
+    for (; i + 4 <= dstPixels; i += 4) {
+        // De-interleave loads split even and odd pixels
+        uint32x4x2_t t = vld2q_u32(reinterpret_cast<const uint32_t*>(top + i * 8));
+        uint32x4x2_t b = vld2q_u32(reinterpret_cast<const uint32_t*>(bottom + i * 8));
+        uint8x16_t even = vrhaddq_u8(vreinterpretq_u8_u32(t.val[0]), vreinterpretq_u8_u32(b.val[0]));
+        uint8x16_t odd = vrhaddq_u8(vreinterpretq_u8_u32(t.val[1]), vreinterpretq_u8_u32(b.val[1]));
+        vst1q_u8(dst + i * 4, vrhaddq_u8(even, odd));
+    }
+    HalveRowScalar(top + i * 8, bottom + i * 8, dst + i * 4, dstPixels - i);
+}
+
+inline uint16x8_t LumaNEON(uint16x8_t b, uint16x8_t g, uint16x8_t r) {
+    uint16x8_t y = vmlaq_n_u16(vmlaq_n_u16(vmulq_n_u16(r, 66), g, 129), b, 25);
+    return vaddq_u16(vshrq_n_u16(vaddq_u16(y, vdupq_n_u16(128)), 8), vdupq_n_u16(16));
+}
+
+void LumaRowNEON(const uint8_t* src, uint8_t* dst, size_t pixelCount) {
+    size_t i = 0;
+    for (; i + 16 <= pixelCount; i += 16) {
+        uint8x16x4_t px = vld4q_u8(src + i * 4);
+        uint16x8_t lo = LumaNEON(vmovl_u8(vget_low_u8(px.val[0])), vmovl_u8(vget_low_u8(px.val[1])),
+                                 vmovl_u8(vget_low_u8(px.val[2])));
+        uint16x8_t hi = LumaNEON(vmovl_u8(vget_high_u8(px.val[0])), vmovl_u8(vget_high_u8(px.val[1])),
+                                 vmovl_u8(vget_high_u8(px.val[2])));
+        vst1q_u8(dst + i, vcombine_u8(vmovn_u16(lo), vmovn_u16(hi)));
+    }
+    LumaRowScalar(src + i * 4, dst + i, pixelCount - i);
+}
+
+template <bool Interleaved>
+void ChromaRowNEON(const uint8_t* top, const uint8_t* bottom, uint8_t* u, uint8_t* v, size_t pixelCount) {
+    size_t i = 0;
+    for (; i + 16 <= pixelCount; i += 16) {
+        uint8x16x4_t t = vld4q_u8(top + i * 4);
+        uint8x16x4_t w = vld4q_u8(bottom + i * 4);
+        // Pairwise widening adds sum horizontal neighbours; the rounding shift adds 2
+        int16x8_t b = vreinterpretq_s16_u16(vrshrq_n_u16(vaddq_u16(vpaddlq_u8(t.val[0]), vpaddlq_u8(w.val[0])), 2));
+        int16x8_t g = vreinterpretq_s16_u16(vrshrq_n_u16(vaddq_u16(vpaddlq_u8(t.val[1]), vpaddlq_u8(w.val[1])), 2));
+        int16x8_t r = vreinterpretq_s16_u16(vrshrq_n_u16(vaddq_u16(vpaddlq_u8(t.val[2]), vpaddlq_u8(w.val[2])), 2));
+        const int16x8_t bias = vdupq_n_s16(128);
+        int16x8_t cu = vmlaq_n_s16(vmlaq_n_s16(vmlaq_n_s16(bias, r, -38), g, -74), b, 112);
+        int16x8_t cv = vmlaq_n_s16(vmlaq_n_s16(vmlaq_n_s16(bias, r, 112), g, -94), b, -18);
+        uint8x8_t pu = vqmovun_s16(vaddq_s16(vshrq_n_s16(cu, 8), bias));
+        uint8x8_t pv = vqmovun_s16(vaddq_s16(vshrq_n_s16(cv, 8), bias));
+        if (Interleaved) {
+            vst2_u8(u + i, uint8x8x2_t{{pu, pv}});
+        } else {
+            vst1_u8(u + i / 2, pu);
+            vst1_u8(v + i / 2, pv);
+        }
+    }
+    if (Interleaved) {
+        ChromaRowScalar<true>(top + i * 4, bottom + i * 4, u + i, nullptr, pixelCount - i);
+    } else {
+        ChromaRowScalar<false>(top + i * 4, bottom + i * 4, u + i / 2, v + i / 2, pixelCount - i);
+    }
+}
+
+void HashBlocksNEON(const uint8_t* src, size_t stride, size_t blocksPerRow, int height, uint32_t* lanes) {
+    uint32x4_t acc[4];
+    for (int k = 0; k < 4; ++k) {
+        acc[k] = vld1q_u32(lanes + k * 4);
+    }
+    for (int y = 0; y < height; ++y, src += stride) {
+        const uint8_t* block = src;
+        for (size_t b = 0; b < blocksPerRow; ++b, block += kHashBlockBytes) {
+            for (int k = 0; k < 4; ++k) {
+                acc[k] = HashRoundNEON(acc[k], vreinterpretq_u32_u8(vld1q_u8(block + k * 16)));
+            }
+        }
+    }
+    for (int k = 0; k < 4; ++k) {
+        vst1q_u32(lanes + k * 4, acc[k]);
+    }
+}
+
+#endif  // CEFVIEW_PIXEL_NEON
+
+// ============================================================================
+// Dispatch
+// ============================================================================
+
+constexpr KernelTable kScalarTable{PixelKernels::Isa::kScalar, SwizzleScalar, PremultiplyScalar, UnpremultiplyScalar,
+                                  HashBlocksScalar, HalveRowScalar, LumaRowScalar, ChromaRowScalar<false>,
+                                  ChromaRowScalar<true>};
+#if defined(CEFVIEW_PIXEL_X86)
+constexpr KernelTable kSSE2Table{PixelKernels::Isa::kSSE2, SwizzleSSE2, PremultiplySSE2, UnpremultiplySSE2,
+                                HashBlocksSSE2, HalveRowSSE2, LumaRowSSE2, ChromaRowSSE2<false>, ChromaRowSSE2<true>};
+// Unpremultiply is bound by the division unit, so AVX2 reuses the SSE2 kernel.
+// Chroma needs two lane-crossing fixups per pack in AVX2, so it stays SSE2 too.
+constexpr KernelTable kAVX2Table{PixelKernels::Isa::kAVX2, SwizzleAVX2, PremultiplyAVX2, UnpremultiplySSE2,
+                                HashBlocksAVX2, HalveRowAVX2, LumaRowAVX2, ChromaRowSSE2<false>, ChromaRowSSE2<true>};
+#endif
+#if defined(CEFVIEW_PIXEL_NEON)
+constexpr KernelTable kNEONTable{PixelKernels::Isa::kNEON, SwizzleNEON, PremultiplyNEON, UnpremultiplyNEON,
+                                HashBlocksNEON, HalveRowNEON, LumaRowNEON, ChromaRowNEON<false>, ChromaRowNEON<true>};
+#endif
+
+bool IsSupported(PixelKernels::Isa isa) {
+    switch (isa) {
+        case PixelKernels::Isa::kScalar:
+            return true;
+#if defined(CEFVIEW_PIXEL_X86)
+        case PixelKernels::Isa::kSSE2:
+        case PixelKernels::Isa::kAVX2: {
+#if defined(_MSC_VER)
+            int info[4] = {};
+            __cpuid(info, 0);
+            const int maxLeaf = info[0];
+            __cpuid(info, 1);
+            const bool sse2 = (info[3] & (1 << 26)) != 0;
+            if (isa == PixelKernels::Isa::kSSE2) {
+                return sse2;
+            }
+            // AVX2 also needs the OS to save YMM state (OSXSAVE + XCR0)
+            const bool osxsave = (info[2] & (1 << 27)) != 0;
+            if (maxLeaf < 7 || !osxsave || (_xgetbv(0) & 0x6) != 0x6) {
+                return false;
+            }
+            __cpuidex(info, 7, 0);
+            return (info[1] & (1 << 5)) != 0;
+#else
+            __builtin_cpu_init();
+            return isa == PixelKernels::Isa::kSSE2 ? __builtin_cpu_supports("sse2") != 0
+                                                   : __builtin_cpu_supports("avx2") != 0;
+#endif
+        }
+#endif
+#if defined(CEFVIEW_PIXEL_NEON)
+        case PixelKernels::Isa::kNEON:
+            return true;
+#endif
+        default:
+            return false;
+    }
+}
+
+const KernelTable* TableFor(PixelKernels::Isa isa) {
+    if (!IsSupported(isa)) {
+        return &kScalarTable;
+    }
+    switch (isa) {
+#if defined(CEFVIEW_PIXEL_X86)
+        case PixelKernels::Isa::kSSE2:
+            return &kSSE2Table;
+        case PixelKernels::Isa::kAVX2:
+            return &kAVX2Table;
+#endif
+#if defined(CEFVIEW_PIXEL_NEON)
+        case PixelKernels::Isa::kNEON:
+            return &kNEONTable;
+#endif
+        default:
+            return &kScalarTable;
+    }
+}
+
+const KernelTable* DetectTable() {
+    const PixelKernels::Isa preferred[] = {PixelKernels::Isa::kAVX2, PixelKernels::Isa::kSSE2,
+                                           PixelKernels::Isa::kNEON};
+    for (PixelKernels::Isa isa : preferred) {
+        if (IsSupported(isa)) {
+            return TableFor(isa);
+        }
+    }
+    return &kScalarTable;
+}
+
+std::atomic<const KernelTable*> g_kernelTable{nullptr};
+
+const KernelTable& Kernels() {
+    const KernelTable* table = g_kernelTable.load(std::memory_order_acquire);
+    if (!table) {
+        // Detection is idempotent, so a race only repeats the work
+        table = DetectTable();
+        g_kernelTable.store(table, std::memory_order_release);
+    }
+    return *table;
+}
+
+}  // namespace
+
+PixelKernels::Isa PixelKernels::ActiveIsa() {
+    return Kernels().isa;
+}
+
+const char* PixelKernels::IsaName(Isa isa) {
+    switch (isa) {
+        case Isa::kSSE2:
+            return "SSE2";
+        case Isa::kAVX2:
+            return "AVX2";
+        case Isa::kNEON:
+            return "NEON";
+        default:
+            return "scalar";
+    }
+}
+
+void PixelKernels::SetIsa(Isa isa) {
+    g_kernelTable.store(TableFor(isa), std::memory_order_release);
+}
+
+void PixelKernels::SwizzleRB(const uint8_t* src, uint8_t* dst, size_t pixelCount) {
+    Kernels().swizzle(src, dst, pixelCount);
+}
+
+void PixelKernels::Premultiply(uint8_t* pixels, size_t pixelCount) {
+    Kernels().premultiply(pixels, pixelCount);
+}
+
+void PixelKernels::Unpremultiply(uint8_t* pixels, size_t pixelCount) {
+    Kernels().unpremultiply(pixels, pixelCount);
+}
+
+void PixelKernels::CopyRect(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride, int width, int height) {
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+    const size_t rowBytes = static_cast<size_t>(width) * 4;
+    // The C runtime's memcpy is already vectorized; the win is in issuing one
+    // call for contiguous rows
+    if (srcStride == rowBytes && dstStride == rowBytes) {
+        std::memcpy(dst, src, rowBytes * static_cast<size_t>(height));
+        return;
+    }
+    for (int y = 0; y < height; ++y, src += srcStride, dst += dstStride) {
+        std::memcpy(dst, src, rowBytes);
+    }
+}
+
+void PixelKernels::StreamRect(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride, int width, int height) {
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+#if defined(CEFVIEW_PIXEL_X86)
+    if (Kernels().isa != Isa::kScalar) {
+        StreamRectSSE2(src, srcStride, dst, dstStride, width, height);
+        return;
+    }
+#endif
+    CopyRect(src, srcStride, dst, dstStride, width, height);
+}
+
+void PixelKernels::Downscale2x(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride,
+                               int dstWidth, int dstHeight) {
+    if (dstWidth <= 0 || dstHeight <= 0) {
+        return;
+    }
+    const HalveRowFn halveRow = Kernels().halveRow;
+    for (int y = 0; y < dstHeight; ++y, src += srcStride * 2, dst += dstStride) {
+        halveRow(src, src + srcStride, dst, static_cast<size_t>(dstWidth));
+    }
+}
+
+void PixelKernels::ConvertToI420(const uint8_t* src, size_t srcStride,
+                                 uint8_t* y, size_t yStride,
+                                 uint8_t* u, size_t uStride,
+                                 uint8_t* v, size_t vStride,
+                                 int width, int height) {
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+    const KernelTable& kernels = Kernels();
+    const size_t pixelCount = static_cast<size_t>(width);
+    for (int row = 0; row < height; row += 2, src += srcStride * 2, y += yStride * 2, u += uStride, v += vStride) {
+        const uint8_t* bottom = row + 1 < height ? src + srcStride : src;
+        kernels.lumaRow(src, y, pixelCount);
+        if (row + 1 < height) {
+            kernels.lumaRow(bottom, y + yStride, pixelCount);
+        }
+        kernels.chromaRowI420(src, bottom, u, v, pixelCount);
+    }
+}
+
+void PixelKernels::ConvertToNV12(const uint8_t* src, size_t srcStride,
+                                 uint8_t* y, size_t yStride,
+                                 uint8_t* uv, size_t uvStride,
+                                 int width, int height) {
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+    const KernelTable& kernels = Kernels();
+    const size_t pixelCount = static_cast<size_t>(width);
+    for (int row = 0; row < height; row += 2, src += srcStride * 2, y += yStride * 2, uv += uvStride) {
+        const uint8_t* bottom = row + 1 < height ? src + srcStride : src;
+        kernels.lumaRow(src, y, pixelCount);
+        if (row + 1 < height) {
+            kernels.lumaRow(bottom, y + yStride, pixelCount);
+        }
+        kernels.chromaRowNV12(src, bottom, uv, nullptr, pixelCount);
+    }
+}
+
+uint64_t PixelKernels::HashRect(const uint8_t* src, size_t stride, int width, int height) {
+    if (width <= 0 || height <= 0) {
+        return 0;
+    }
+    const size_t rowBytes = static_cast<size_t>(width) * 4;
+    const size_t blocksPerRow = rowBytes / kHashBlockBytes;
+
+    uint32_t lanes[kHashLanes];
+    for (int k = 0; k < kHashLanes; ++k) {
+        lanes[k] = kHashPrime1 * static_cast<uint32_t>(k + 1);
+    }
+    Kernels().hashBlocks(src, stride, blocksPerRow, height, lanes);
+
+    uint64_t hash = static_cast<uint64_t>(rowBytes) * kHashPrime64 ^ static_cast<uint64_t>(height);
+    const size_t tailStart = blocksPerRow * kHashBlockBytes;
+    if (tailStart < rowBytes) {
+        const uint8_t* row = src;
+        for (int y = 0; y < height; ++y, row += stride) {
+            for (size_t x = tailStart; x < rowBytes; x += 4) {
+                uint32_t word;
+                std::memcpy(&word, row + x, 4);
+                hash = (hash ^ word) * kHashPrime64;
+            }
+        }
+    }
+    for (int k = 0; k < kHashLanes; ++k) {
+        hash = (hash ^ lanes[k]) * kHashPrime64;
+        hash ^= hash >> 29;
+    }
+
+    // Final avalanche (MurmurHash3 fmix64)
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDull;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+}  // namespace cefview
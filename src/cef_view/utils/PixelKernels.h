@@ -0,0 +1,139 @@
+/**
+ * @file        PixelKernels.h
+ * @brief       SIMD kernels for 32-bit BGRA pixel buffers
+ * @version     1.0
+ * @date        2026.10.18
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cefview {
+
+/**
+ * @brief Per-pixel operations on CEF's BGRA frames
+ *
+ * Each operation has scalar, SSE2, AVX2 and NEON variants. The variant is
+ * selected once at first use from the CPU features reported at runtime
+ * (AVX2 via cpuid on x86; NEON is always present on arm64). All variants
+ * produce bit-identical results.
+ *
+ * Buffers need no particular alignment. Functions are thread-safe.
+ */
+class PixelKernels {
+public:
+    enum class Isa {
+        kScalar,
+        kSSE2,
+        kAVX2,
+        kNEON
+    };
+
+    /**
+     * @brief Instruction set selected for this process
+     */
+    static Isa ActiveIsa();
+
+    /**
+     * @brief Human readable name of an instruction set
+     */
+    static const char* IsaName(Isa isa);
+
+    /**
+     * @brief Force an instruction set (falls back to scalar if unsupported)
+     * @note Meant for comparing variants; not thread-safe with concurrent kernel calls
+     */
+    static void SetIsa(Isa isa);
+
+    /**
+     * @brief Swap the R and B channels (BGRA <-> RGBA)
+     * @param src Source pixels
+     * @param dst Destination pixels, may equal src
+     * @param pixelCount Number of pixels
+     */
+    static void SwizzleRB(const uint8_t* src, uint8_t* dst, size_t pixelCount);
+
+    /**
+     * @brief Multiply color channels by alpha in place, rounding to nearest
+     */
+    static void Premultiply(uint8_t* pixels, size_t pixelCount);
+
+    /**
+     * @brief Divide color channels by alpha in place, rounding to nearest
+     *
+     * Pixels with alpha 0 are left unchanged.
+     */
+    static void Unpremultiply(uint8_t* pixels, size_t pixelCount);
+
+    /**
+     * @brief 64-bit content hash of a rectangle of pixels
+     *
+     * Non-cryptographic; meant for change detection of frame tiles. Equal
+     * pixels give equal hashes regardless of stride or instruction set.
+     * @param src First pixel of the rectangle
+     * @param stride Bytes per row
+     * @param width Rectangle width in pixels
+     * @param height Rectangle height in rows
+     */
+    static uint64_t HashRect(const uint8_t* src, size_t stride, int width, int height);
+
+    /**
+     * @brief Copy a rectangle of rows between two strided buffers
+     * @param src First source pixel of the rectangle
+     * @param srcStride Source bytes per row
+     * @param dst First destination pixel of the rectangle
+     * @param dstStride Destination bytes per row
+     * @param width Rectangle width in pixels
+     * @param height Rectangle height in rows
+     */
+    static void CopyRect(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride, int width, int height);
+
+    /**
+     * @brief CopyRect variant using non-temporal stores
+     *
+     * For destinations the CPU will not read back, such as mapped GPU upload
+     * buffers (write-combined memory): avoids polluting the cache with the
+     * frame and avoids read-for-ownership traffic.
+     */
+    static void StreamRect(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride, int width, int height);
+
+    /**
+     * @brief Halve a rectangle with a 2x2 box filter
+     *
+     * Each destination pixel is the rounded average of a 2x2 source block
+     * (rows first, then columns, as pavgb rounds). The source must hold
+     * 2 * dstWidth by 2 * dstHeight pixels; an odd last column or row is
+     * left out. dst must not overlap src.
+     * @param dstWidth Destination width in pixels
+     * @param dstHeight Destination height in rows
+     */
+    static void Downscale2x(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride,
+                            int dstWidth, int dstHeight);
+
+    /**
+     * @brief Convert a BGRA rectangle to planar I420 (BT.601, limited range)
+     *
+     * Each chroma sample averages a 2x2 block; an odd last column or row
+     * repeats its edge. To update part of a frame, start the rectangle at
+     * even coordinates and pass plane pointers offset to match (chroma at
+     * x / 2, y / 2). Alpha is ignored, i.e. premultiplied pixels show over black.
+     * @param width Rectangle width in pixels
+     * @param height Rectangle height in rows
+     */
+    static void ConvertToI420(const uint8_t* src, size_t srcStride,
+                              uint8_t* y, size_t yStride,
+                              uint8_t* u, size_t uStride,
+                              uint8_t* v, size_t vStride,
+                              int width, int height);
+
+    /**
+     * @brief ConvertToI420 with interleaved chroma (NV12: one UV plane, U first)
+     */
+    static void ConvertToNV12(const uint8_t* src, size_t srcStride,
+                              uint8_t* y, size_t yStride,
+                              uint8_t* uv, size_t uvStride,
+                              int width, int height);
+};
+
+}  // namespace cefview
@@ -0,0 +1,217 @@
+#include "TileCodec.h"
+
+#include <cstring>
+
+namespace cefview {
+
+namespace {
+
+constexpr size_t kBytesPerPixel = 4;
+
+constexpr uint8_t kOpIndex = 0x00;  // 00iiiiii
+constexpr uint8_t kOpDiff = 0x40;   // 01rrggbb, each delta in -2..1
+constexpr uint8_t kOpLuma = 0x80;   // 10gggggg rrrrbbbb, green -32..31, red/blue relative to green -8..7
+constexpr uint8_t kOpRun = 0xc0;    // 11llllll, 1..62 repeats of the previous pixel
+constexpr uint8_t kOpRgb = 0xfe;
+constexpr uint8_t kOpRgba = 0xff;
+constexpr uint8_t kOpMask = 0xc0;
+constexpr int kMaxRun = 62;
+
+struct Pixel {
+    uint8_t b = 0;
+    uint8_t g = 0;
+    uint8_t r = 0;
+    uint8_t a = 255;
+
+    bool operator==(const Pixel& other) const {
+        return b == other.b && g == other.g && r == other.r && a == other.a;
+    }
+    bool operator!=(const Pixel& other) const { return !(*this == other); }
+};
+
+inline int Hash(const Pixel& p) {
+    return (p.r * 3 + p.g * 5 + p.b * 7 + p.a * 11) % 64;
+}
+
+inline Pixel Load(const uint8_t* src) {
+    Pixel p;
+    p.b = src[0];
+    p.g = src[1];
+    p.r = src[2];
+    p.a = src[3];
+    return p;
+}
+
+inline void Store(uint8_t* dst, const Pixel& p) {
+    dst[0] = p.b;
+    dst[1] = p.g;
+    dst[2] = p.r;
+    dst[3] = p.a;
+}
+
+// Wrapping 8-bit difference, as QOI defines it
+inline int Delta(uint8_t value, uint8_t previous) {
+    return static_cast<int8_t>(static_cast<uint8_t>(value - previous));
+}
+
+}  // namespace
+
+TileCodec::Encoding TileCodec::Encode(const uint8_t* pixels, size_t stride, int width, int height,
+                                      std::vector<uint8_t>& out) {
+    out.clear();
+    if (!pixels || width <= 0 || height <= 0) {
+        return Encoding::kRaw;
+    }
+
+    const size_t rowBytes = static_cast<size_t>(width) * kBytesPerPixel;
+    const size_t rawBytes = rowBytes * static_cast<size_t>(height);
+    out.reserve(rawBytes / 4);
+
+    Pixel index[64];
+    Pixel previous;
+    int run = 0;
+    for (int y = 0; y < height; ++y) {
+        const uint8_t* row = pixels + static_cast<size_t>(y) * stride;
+        for (int x = 0; x < width; ++x) {
+            const Pixel pixel = Load(row + static_cast<size_t>(x) * kBytesPerPixel);
+            if (pixel == previous) {
+                if (++run == kMaxRun) {
+                    out.push_back(static_cast<uint8_t>(kOpRun | (run - 1)));
+                    run = 0;
+                }
+                continue;
+            }
+            if (run > 0) {
+                out.push_back(static_cast<uint8_t>(kOpRun | (run - 1)));
+                run = 0;
+            }
+
+            const int hash = Hash(pixel);
+            if (index[hash] == pixel) {
+                out.push_back(static_cast<uint8_t>(kOpIndex | hash));
+            } else {
+                index[hash] = pixel;
+                if (pixel.a == previous.a) {
+                    const int dr = Delta(pixel.r, previous.r);
+                    const int dg = Delta(pixel.g, previous.g);
+                    const int db = Delta(pixel.b, previous.b);
+                    const int drg = dr - dg;
+                    const int dbg = db - dg;
+                    if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1) {
+                        out.push_back(static_cast<uint8_t>(kOpDiff | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2)));
+                    } else if (dg >= -32 && dg <= 31 && drg >= -8 && drg <= 7 && dbg >= -8 && dbg <= 7) {
+                        out.push_back(static_cast<uint8_t>(kOpLuma | (dg + 32)));
+                        out.push_back(static_cast<uint8_t>((drg + 8) << 4 | (dbg + 8)));
+                    } else {
+                        out.push_back(kOpRgb);
+                        out.push_back(pixel.r);
+                        out.push_back(pixel.g);
+                        out.push_back(pixel.b);
+                    }
+                } else {
+                    out.push_back(kOpRgba);
+                    out.push_back(pixel.r);
+                    out.push_back(pixel.g);
+                    out.push_back(pixel.b);
+                    out.push_back(pixel.a);
+                }
+            }
+            previous = pixel;
+        }
+        if (out.size() >= rawBytes) {
+            break;
+        }
+    }
+    if (run > 0) {
+        out.push_back(static_cast<uint8_t>(kOpRun | (run - 1)));
+    }
+
+    if (out.size() < rawBytes) {
+        return Encoding::kQoi;
+    }
+    // Noise: sending it as is is smaller and cheaper to decode
+    out.resize(rawBytes);
+    for (int y = 0; y < height; ++y) {
+        memcpy(out.data() + static_cast<size_t>(y) * rowBytes, pixels + static_cast<size_t>(y) * stride, rowBytes);
+    }
+    return Encoding::kRaw;
+}
+
+bool TileCodec::Decode(Encoding encoding, const uint8_t* data, size_t size, uint8_t* dst, size_t stride,
+                       int width, int height) {
+    if (!dst || width <= 0 || height <= 0) {
+        return false;
+    }
+    const size_t rowBytes = static_cast<size_t>(width) * kBytesPerPixel;
+
+    if (encoding == Encoding::kRaw) {
+        if (size != rowBytes * static_cast<size_t>(height)) {
+            return false;
+        }
+        for (int y = 0; y < height; ++y) {
+            memcpy(dst + static_cast<size_t>(y) * stride, data + static_cast<size_t>(y) * rowBytes, rowBytes);
+        }
+        return true;
+    }
+    if (encoding != Encoding::kQoi) {
+        return false;
+    }
+
+    Pixel index[64];
+    Pixel pixel;
+    int run = 0;
+    size_t pos = 0;
+    for (int y = 0; y < height; ++y) {
+        uint8_t* row = dst + static_cast<size_t>(y) * stride;
+        for (int x = 0; x < width; ++x) {
+            if (run > 0) {
+                --run;
+            } else {
+                if (pos >= size) {
+                    return false;
+                }
+                const uint8_t op = data[pos++];
+                if (op == kOpRgb) {
+                    if (size - pos < 3) {
+                        return false;
+                    }
+                    pixel.r = data[pos];
+                    pixel.g = data[pos + 1];
+                    pixel.b = data[pos + 2];
+                    pos += 3;
+                } else if (op == kOpRgba) {
+                    if (size - pos < 4) {
+                        return false;
+                    }
+                    pixel.r = data[pos];
+                    pixel.g = data[pos + 1];
+                    pixel.b = data[pos + 2];
+                    pixel.a = data[pos + 3];
+                    pos += 4;
+                } else if ((op & kOpMask) == kOpIndex) {
+                    pixel = index[op];
+                } else if ((op & kOpMask) == kOpDiff) {
+                    pixel.r = static_cast<uint8_t>(pixel.r + ((op >> 4) & 0x03) - 2);
+                    pixel.g = static_cast<uint8_t>(pixel.g + ((op >> 2) & 0x03) - 2);
+                    pixel.b = static_cast<uint8_t>(pixel.b + (op & 0x03) - 2);
+                } else if ((op & kOpMask) == kOpLuma) {
+                    if (pos >= size) {
+                        return false;
+                    }
+                    const uint8_t next = data[pos++];
+                    const int dg = (op & 0x3f) - 32;
+                    pixel.r = static_cast<uint8_t>(pixel.r + dg - 8 + ((next >> 4) & 0x0f));
+                    pixel.g = static_cast<uint8_t>(pixel.g + dg);
+                    pixel.b = static_cast<uint8_t>(pixel.b + dg - 8 + (next & 0x0f));
+                } else {
+                    run = op & 0x3f;
+                }
+                index[Hash(pixel)] = pixel;
+            }
+            Store(row + static_cast<size_t>(x) * kBytesPerPixel, pixel);
+        }
+    }
+    return run == 0 && pos == size;
+}
+
+}  // namespace cefview
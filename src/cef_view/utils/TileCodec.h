@@ -0,0 +1,51 @@
+/**
+ * @file        TileCodec.h
+ * @brief       Fast lossless compression of BGRA tiles for frame streaming
+ * @version     1.0
+ * @date        2026.10.18
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cefview {
+
+/**
+ * @brief Lossless tile codec cheap enough to run per frame
+ *
+ * Uses the op set of the QOI image format (index of recent colors, small
+ * deltas, runs), applied to BGRA pixels in a single pass without entropy
+ * coding. UI content (flat areas, text, gradients) usually shrinks 5-20x.
+ * Tiles that would not shrink are sent raw.
+ *
+ * Thread-safe.
+ */
+class TileCodec {
+public:
+    enum class Encoding : uint8_t {
+        kRaw = 0,  ///< width * height * 4 bytes, rows packed
+        kQoi = 1   ///< QOI ops, no header or end marker
+    };
+
+    /**
+     * @brief Compress a tile
+     * @param pixels First pixel of the tile
+     * @param stride Bytes per row of the source
+     * @param out Receives the payload (replaced)
+     * @return Encoding of out
+     */
+    static Encoding Encode(const uint8_t* pixels, size_t stride, int width, int height, std::vector<uint8_t>& out);
+
+    /**
+     * @brief Decompress a tile
+     * @param dst First pixel of the destination
+     * @param stride Bytes per row of the destination
+     * @return false if the payload is malformed or does not match the size
+     */
+    static bool Decode(Encoding encoding, const uint8_t* data, size_t size, uint8_t* dst, size_t stride,
+                       int width, int height);
+};
+
+}  // namespace cefview
@@ -250,6 +250,24 @@ float WinUtil::GetDeviceScaleFactor() {
     return scaleFactor;
 }
 
+int WinUtil::GetWindowRefreshRate(HWND hwnd) {
+    HMONITOR monitor = ::MonitorFromWindow(hwnd, MONITOR_DEFAULTTONEAREST);
+    MONITORINFOEXW monitorInfo = {};
+    monitorInfo.cbSize = sizeof(monitorInfo);
+    if (!monitor || !::GetMonitorInfoW(monitor, &monitorInfo)) {
+        return 0;
+    }
+
+    DEVMODEW devMode = {};
+    devMode.dmSize = sizeof(devMode);
+    if (!::EnumDisplaySettingsW(monitorInfo.szDevice, ENUM_CURRENT_SETTINGS, &devMode)) {
+        return 0;
+    }
+
+    // 0 and 1 mean "hardware default"
+    return devMode.dmDisplayFrequency > 1 ? static_cast<int>(devMode.dmDisplayFrequency) : 0;
+}
+
 CefRect WinUtil::GetWindowRect(HWND hwnd, float deviceScaleFactor) {
     RECT windowRect;
     ::GetWindowRect(hwnd, &windowRect);
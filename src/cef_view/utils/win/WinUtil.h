@@ -111,6 +111,13 @@ public:
      */
     static float GetDeviceScaleFactor();
 
+    /**
+     * @brief Get the refresh rate of the monitor displaying a window
+     * @param hwnd Window handle
+     * @return Refresh rate in Hz, or 0 if unknown
+     */
+    static int GetWindowRefreshRate(HWND hwnd);
+
     /**
      * @brief Get window rectangle in logical coordinates
      * @param hwnd Window handle
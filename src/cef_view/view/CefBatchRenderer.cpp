@@ -0,0 +1,565 @@
+#include "CefBatchRenderer.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <system_error>
+#include <utility>
+
+#include "include/base/cef_bind.h"
+#include "include/base/cef_callback.h"
+#include "include/cef_task.h"
+#include "include/wrapper/cef_closure_task.h"
+
+#include "osr/OsrCapture.h"
+#include "utils/FileUtil.h"
+#include "utils/LogUtil.h"
+#include "view/CefHeadlessView.h"
+#include "view/CefWebViewSetting.h"
+
+namespace cefview {
+
+namespace {
+
+constexpr int64_t kTickMs = 20;
+constexpr size_t kBytesPerPixel = 4;
+// More browsers than this mostly add renderer processes competing for the same cores
+constexpr unsigned kMaxDefaultBrowsers = 8;
+// Printed by the page through console.log() in full-page mode
+constexpr char kHeightMessagePrefix[] = "cefview-batch-height:";
+constexpr char kMeasureScript[] =
+    "console.log('cefview-batch-height:' + Math.ceil(Math.max("
+    "document.documentElement.scrollHeight, document.body ? document.body.scrollHeight : 0)));";
+
+double MillisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+unsigned HardwareThreads() {
+    const unsigned count = std::thread::hardware_concurrency();
+    return count > 0 ? count : 4;
+}
+
+const char* FileExtension(const CefBatchRenderer::Options& options) {
+    if (options.output == CefBatchRenderer::Output::kPdf) {
+        return ".pdf";
+    }
+    switch (options.format) {
+    case ImageEncoder::Format::kJpeg:
+        return ".jpg";
+    case ImageEncoder::Format::kBmp:
+        return ".bmp";
+    case ImageEncoder::Format::kPng:
+    default:
+        return ".png";
+    }
+}
+
+bool IsUrl(const std::string& source) {
+    return source.find("://") != std::string::npos || source.compare(0, 5, "data:") == 0 ||
+           source.compare(0, 6, "about:") == 0;
+}
+
+}  // namespace
+
+CefBatchRenderer::CefBatchRenderer(const Options& options)
+    : _options(options)
+    , _jobs()
+    , _progress()
+    , _completion()
+    , _slots()
+    , _stats()
+    , _startTime()
+    , _workers()
+    , _queueMutex()
+    , _queueCondition()
+    , _queue() {
+}
+
+CefBatchRenderer::~CefBatchRenderer() {
+    stopWorkers();
+}
+
+bool CefBatchRenderer::start(std::vector<CefBatchRenderJob> jobs, ProgressCallback progress,
+                             CompletionCallback completion) {
+    if (_running) {
+        LOGE << "Batch render already running";
+        return false;
+    }
+
+    const unsigned hardwareThreads = HardwareThreads();
+    int encodeThreads = _options.encodeThreads > 0 ? _options.encodeThreads : static_cast<int>(hardwareThreads);
+    if (_options.output == Output::kPdf) {
+        encodeThreads = 0;  // The browser writes the PDF
+    }
+    size_t browsers = _options.concurrency > 0 ? static_cast<size_t>(_options.concurrency)
+                                               : (hardwareThreads < kMaxDefaultBrowsers ? hardwareThreads
+                                                                                        : kMaxDefaultBrowsers);
+    if (browsers > jobs.size()) {
+        browsers = jobs.size();
+    }
+    if (!startWorkers(encodeThreads)) {
+        return false;
+    }
+
+    _jobs = std::move(jobs);
+    _progress = std::move(progress);
+    _completion = std::move(completion);
+    _slots.clear();
+    for (size_t i = 0; i < browsers; ++i) {
+        _slots.push_back(std::make_unique<Slot>());
+    }
+    _nextJob = 0;
+    _finishedJobs = 0;
+    _pendingEncodes = 0;
+    _running = true;
+    _closing = false;
+    _stats = CefBatchRenderStats();
+    _stats.jobs = _jobs.size();
+    _stats.browsers = browsers;
+    _stats.encodeThreads = static_cast<size_t>(encodeThreads);
+    _startTime = Clock::now();
+
+    LOGI << "Batch render of " << _jobs.size() << " pages with " << browsers << " browsers and "
+         << encodeThreads << " encoder threads";
+    // Start from a task so the callbacks never run within start()
+    scheduleTick();
+    return true;
+}
+
+void CefBatchRenderer::cancel() {
+    if (!_running) {
+        return;
+    }
+    for (; _nextJob < _jobs.size(); ++_nextJob) {
+        CefBatchRenderResult result;
+        result.index = _nextJob;
+        result.source = _jobs[_nextJob].source;
+        result.outputPath = _jobs[_nextJob].outputPath;
+        result.error = "cancelled";
+        finishJob(result);
+    }
+}
+
+std::string CefBatchRenderer::SourceToUrl(const std::string& source) {
+    if (IsUrl(source)) {
+        return source;
+    }
+
+    std::error_code error;
+    std::filesystem::path path = std::filesystem::absolute(std::filesystem::u8path(source), error);
+    const std::string absolute = error ? source : path.generic_u8string();
+
+    static const char kHex[] = "0123456789ABCDEF";
+    std::string url = "file://";
+    if (absolute.empty() || absolute[0] != '/') {
+        url += '/';  // Windows drive letter
+    }
+    for (const char c : absolute) {
+        const unsigned char byte = static_cast<unsigned char>(c);
+        if ((byte >= 'a' && byte <= 'z') || (byte >= 'A' && byte <= 'Z') || (byte >= '0' && byte <= '9') ||
+            c == '/' || c == ':' || c == '-' || c == '_' || c == '.' || c == '~') {
+            url += c;
+        } else {
+            url += '%';
+            url += kHex[byte >> 4];
+            url += kHex[byte & 0x0F];
+        }
+    }
+    return url;
+}
+
+std::string CefBatchRenderer::OutputPathFor(const std::string& source, const std::string& outputDir,
+                                            const Options& options, size_t index) {
+    // Last path segment without query, fragment and extension
+    std::string name = source.substr(0, source.find_first_of("?#"));
+    while (!name.empty() && (name.back() == '/' || name.back() == '\\')) {
+        name.pop_back();
+    }
+    const size_t slash = name.find_last_of("/\\");
+    if (slash != std::string::npos) {
+        name = name.substr(slash + 1);
+    }
+    const size_t dot = name.rfind('.');
+    if (dot != std::string::npos && dot > 0) {
+        name.resize(dot);
+    }
+    for (char& c : name) {
+        const bool safe = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '-' ||
+                          c == '_' || c == '.';
+        if (!safe) {
+            c = '_';
+        }
+    }
+    if (name.empty()) {
+        name = "page";
+    }
+
+    char number[32];
+    snprintf(number, sizeof(number), "%04zu-", index);
+    return FileUtil::JoinPath(outputDir, number + name + FileExtension(options));
+}
+
+void CefBatchRenderer::scheduleTick() {
+    CefPostDelayedTask(TID_UI, base::BindOnce([](std::weak_ptr<CefBatchRenderer> weakSelf) {
+            if (auto self = weakSelf.lock()) {
+                self->tick();
+            }
+        }, weak_from_this()), kTickMs);
+}
+
+void CefBatchRenderer::tick() {
+    if (!_running || _closing) {
+        return;
+    }
+    for (auto& slot : _slots) {
+        updateSlot(*slot);
+    }
+    fillSlots();
+
+    if (_finishedJobs == _jobs.size()) {
+        closeBrowsers();
+        return;
+    }
+    scheduleTick();
+}
+
+void CefBatchRenderer::fillSlots() {
+    const size_t maxPendingEncodes = _workers.size() * 2;
+    for (auto& slot : _slots) {
+        if (_nextJob >= _jobs.size() ||
+            (_options.output == Output::kImage && _pendingEncodes >= maxPendingEncodes)) {
+            return;
+        }
+        if (slot->state == SlotState::kFree) {
+            startJob(*slot, _nextJob++);
+        }
+    }
+}
+
+void CefBatchRenderer::startJob(Slot& slot, size_t job) {
+    slot.job = job;
+    slot.state = SlotState::kLoading;
+    slot.started = Clock::now();
+    slot.paintsAtResize = 0;
+
+    const std::string url = SourceToUrl(_jobs[job].source);
+    if (slot.view) {
+        slot.view->resize(_options.width, _options.height);
+        slot.view->loadUrl(url);
+        return;
+    }
+
+    CefWebViewSetting settings;
+    settings.url = url;
+    settings.offScreenRenderingEnabled = true;
+    settings.width = _options.width;
+    settings.height = _options.height;
+    settings.windowlessFrameRate = 30;
+    settings.backgroundColor = _options.backgroundColor;
+    slot.view = std::make_shared<CefHeadlessView>(settings, _options.deviceScaleFactor);
+    // The views are owned by this renderer, so their callbacks cannot outlive it
+    Slot* slotPtr = &slot;
+    slot.view->setConsoleMessageCallback([this, slotPtr](const std::string& message) {
+        onPageHeight(*slotPtr, message);
+    });
+    if (!slot.view->create()) {
+        slot.view.reset();
+        failJob(slot, "cannot create a browser");
+    }
+}
+
+void CefBatchRenderer::updateSlot(Slot& slot) {
+    // A print in flight cannot be cancelled; its callback frees the slot
+    if (slot.state == SlotState::kFree || slot.state == SlotState::kPrinting) {
+        return;
+    }
+    CefHeadlessView& view = *slot.view;
+
+    if (!view.loadError().empty()) {
+        failJob(slot, view.loadError());
+        return;
+    }
+    if (!view.isLoading() && view.httpStatus() >= 400) {
+        failJob(slot, "HTTP " + std::to_string(view.httpStatus()));
+        return;
+    }
+
+    if (Clock::now() - slot.started >= std::chrono::milliseconds(_options.timeoutMs)) {
+        // Pages with endless animations never go quiet: take what is on screen
+        if (!view.isLoading() && view.paintCount() > 0) {
+            captureJob(slot, false);
+        } else {
+            view.stopLoad();
+            failJob(slot, "timed out after " + std::to_string(_options.timeoutMs) + " ms");
+        }
+        return;
+    }
+
+    switch (slot.state) {
+    case SlotState::kLoading:
+        if (view.isLoadIdle(_options.idleMs)) {
+            if (_options.fullPage && _options.output == Output::kImage) {
+                slot.state = SlotState::kMeasuring;
+                view.executeJavaScript(kMeasureScript);
+            } else {
+                captureJob(slot, true);
+            }
+        }
+        break;
+    case SlotState::kSettling:
+        if (view.isLoadIdle(_options.idleMs) && view.paintCount() > slot.paintsAtResize) {
+            captureJob(slot, true);
+        }
+        break;
+    case SlotState::kMeasuring:
+    case SlotState::kPrinting:
+    case SlotState::kFree:
+        break;
+    }
+}
+
+void CefBatchRenderer::onPageHeight(Slot& slot, const std::string& message) {
+    if (slot.state != SlotState::kMeasuring ||
+        message.compare(0, sizeof(kHeightMessagePrefix) - 1, kHeightMessagePrefix) != 0) {
+        return;
+    }
+    int height = atoi(message.c_str() + sizeof(kHeightMessagePrefix) - 1);
+    const int maxHeight = static_cast<int>(static_cast<float>(_options.maxPageHeight) / slot.view->deviceScaleFactor());
+    if (height > maxHeight) {
+        height = maxHeight;
+    }
+    if (height <= _options.height) {
+        captureJob(slot, true);
+        return;
+    }
+    slot.state = SlotState::kSettling;
+    slot.paintsAtResize = slot.view->paintCount();
+    slot.view->resize(_options.width, height);
+}
+
+void CefBatchRenderer::captureJob(Slot& slot, bool settled) {
+    if (_options.output == Output::kPdf) {
+        printJob(slot, settled);
+        return;
+    }
+
+    EncodeTask task;
+    if (!slot.view->captureFrame(task.frame, task.width, task.height)) {
+        failJob(slot, "no frame to capture");
+        return;
+    }
+    task.result.index = slot.job;
+    task.result.source = _jobs[slot.job].source;
+    task.result.outputPath = _jobs[slot.job].outputPath;
+    task.result.settled = settled;
+    task.result.httpStatus = slot.view->httpStatus();
+    task.result.loadMs = MillisecondsSince(slot.started);
+    slot.state = SlotState::kFree;
+
+    ++_pendingEncodes;
+    {
+        std::lock_guard<std::mutex> lock(_queueMutex);
+        _queue.push_back(std::move(task));
+    }
+    _queueCondition.notify_one();
+}
+
+void CefBatchRenderer::printJob(Slot& slot, bool settled) {
+    CefBatchRenderResult result;
+    result.index = slot.job;
+    result.source = _jobs[slot.job].source;
+    result.outputPath = _jobs[slot.job].outputPath;
+    result.settled = settled;
+    result.httpStatus = slot.view->httpStatus();
+    result.loadMs = MillisecondsSince(slot.started);
+    slot.state = SlotState::kPrinting;
+
+    // Printed next to the target and renamed, as for images
+    const std::string tempPath = result.outputPath + ".part";
+    std::weak_ptr<CefBatchRenderer> weakSelf = weak_from_this();
+    Slot* slotPtr = &slot;
+    const Clock::time_point printStart = Clock::now();
+    slot.view->printToPdf(_options.pdfSettings, tempPath,
+        [weakSelf, slotPtr, result, printStart](bool ok, const std::string&) {
+            if (auto self = weakSelf.lock()) {
+                self->onPrinted(*slotPtr, result, printStart, ok);
+            }
+        });
+}
+
+void CefBatchRenderer::onPrinted(Slot& slot, CefBatchRenderResult result, Clock::time_point printStart, bool ok) {
+    slot.state = SlotState::kFree;
+
+    const std::string tempPath = result.outputPath + ".part";
+    std::error_code error;
+    if (!ok) {
+        result.error = "cannot print to " + tempPath;
+    } else {
+        std::filesystem::rename(std::filesystem::u8path(tempPath), std::filesystem::u8path(result.outputPath), error);
+        if (error) {
+            result.error = "cannot rename " + tempPath + ": " + error.message();
+        }
+    }
+    if (result.error.empty()) {
+        result.success = true;
+        const std::uintmax_t size = std::filesystem::file_size(std::filesystem::u8path(result.outputPath), error);
+        result.bytes = error ? 0 : static_cast<size_t>(size);
+    } else {
+        std::filesystem::remove(std::filesystem::u8path(tempPath), error);
+    }
+    result.encodeMs = MillisecondsSince(printStart);
+    finishJob(result);
+}
+
+void CefBatchRenderer::failJob(Slot& slot, const std::string& error) {
+    CefBatchRenderResult result;
+    result.index = slot.job;
+    result.source = _jobs[slot.job].source;
+    result.outputPath = _jobs[slot.job].outputPath;
+    result.error = error;
+    result.httpStatus = slot.view ? slot.view->httpStatus() : 0;
+    result.loadMs = MillisecondsSince(slot.started);
+    slot.state = SlotState::kFree;
+    finishJob(result);
+}
+
+void CefBatchRenderer::finishJob(const CefBatchRenderResult& result) {
+    ++_finishedJobs;
+    if (result.success) {
+        ++_stats.succeeded;
+    } else {
+        ++_stats.failed;
+        LOGW << "Batch render of " << result.source << " FAILED: " << result.error;
+    }
+    if (_progress) {
+        _progress(result);
+    }
+}
+
+void CefBatchRenderer::onEncoded(const CefBatchRenderResult& result) {
+    --_pendingEncodes;
+    finishJob(result);
+}
+
+void CefBatchRenderer::closeBrowsers() {
+    _closing = true;
+    _openBrowsers = 1;  // Held until every close() below has been issued
+    for (auto& slot : _slots) {
+        if (slot->view && !slot->view->isClosed()) {
+            ++_openBrowsers;
+            slot->view->setClosedCallback([this]() { onBrowserClosed(); });
+            slot->view->close();
+        }
+    }
+    onBrowserClosed();
+}
+
+void CefBatchRenderer::onBrowserClosed() {
+    if (--_openBrowsers > 0) {
+        return;
+    }
+    stopWorkers();
+    _running = false;
+    _stats.seconds = std::chrono::duration<double>(Clock::now() - _startTime).count();
+    _stats.pagesPerMinute = _stats.seconds > 0.0 ? static_cast<double>(_stats.succeeded) * 60.0 / _stats.seconds : 0.0;
+    LOGI << "Batch render done: " << _stats.succeeded << " of " << _stats.jobs << " pages in " << _stats.seconds
+         << " s (" << _stats.pagesPerMinute << " pages/min)";
+
+    CompletionCallback completion = std::move(_completion);
+    _completion = nullptr;
+    _progress = nullptr;
+    if (completion) {
+        completion(_stats);
+    }
+}
+
+bool CefBatchRenderer::startWorkers(int count) {
+    stopWorkers();
+    _stopWorkers = false;
+    try {
+        for (int i = 0; i < count; ++i) {
+            _workers.emplace_back(&CefBatchRenderer::workerMain, this);
+        }
+    } catch (const std::system_error& e) {
+        LOGE << "Failed to start batch encoder thread: " << e.what();
+        stopWorkers();
+        return false;
+    }
+    return true;
+}
+
+void CefBatchRenderer::stopWorkers() {
+    {
+        std::lock_guard<std::mutex> lock(_queueMutex);
+        _stopWorkers = true;
+    }
+    _queueCondition.notify_all();
+    for (auto& worker : _workers) {
+        worker.join();
+    }
+    _workers.clear();
+    _queue.clear();
+}
+
+void CefBatchRenderer::workerMain() {
+    for (;;) {
+        EncodeTask task;
+        {
+            std::unique_lock<std::mutex> lock(_queueMutex);
+            _queueCondition.wait(lock, [this] { return _stopWorkers || !_queue.empty(); });
+            if (_stopWorkers) {
+                return;
+            }
+            task = std::move(_queue.front());
+            _queue.pop_front();
+        }
+
+        encode(task);
+        // Give the capture back to the pool before the result travels to the UI thread
+        task.frame.reset();
+        CefPostTask(TID_UI, base::BindOnce([](std::weak_ptr<CefBatchRenderer> weakSelf,
+                                              const CefBatchRenderResult& result) {
+                if (auto self = weakSelf.lock()) {
+                    self->onEncoded(result);
+                }
+            }, weak_from_this(), std::move(task.result)));
+    }
+}
+
+void CefBatchRenderer::encode(EncodeTask& task) const {
+    const Clock::time_point start = Clock::now();
+    CefBatchRenderResult& result = task.result;
+
+    OsrCaptureResult image;
+    if (!OsrCapture::Encode(task.frame.data(), static_cast<size_t>(task.width) * kBytesPerPixel, task.width,
+                            task.height, _options.scale, _options.format, _options.quality, image)) {
+        result.error = image.error;
+        result.encodeMs = MillisecondsSince(start);
+        return;
+    }
+
+    // Write next to the target and rename, so a crash never leaves a truncated image
+    const std::string tempPath = result.outputPath + ".part";
+    const int size = static_cast<int>(image.data.size());
+    std::error_code error;
+    if (FileUtil::WriteFile(tempPath, reinterpret_cast<const char*>(image.data.data()), size) != size) {
+        result.error = "cannot write " + tempPath;
+    } else {
+        std::filesystem::rename(std::filesystem::u8path(tempPath), std::filesystem::u8path(result.outputPath), error);
+        if (error) {
+            result.error = "cannot rename " + tempPath + ": " + error.message();
+        }
+    }
+    if (result.error.empty()) {
+        result.success = true;
+        result.width = image.width;
+        result.height = image.height;
+        result.bytes = image.data.size();
+    } else {
+        std::filesystem::remove(std::filesystem::u8path(tempPath), error);
+    }
+    result.encodeMs = MillisecondsSince(start);
+}
+
+}  // namespace cefview
@@ -0,0 +1,225 @@
+/**
+ * @file        CefBatchRenderer.h
+ * @brief       Renders lists of pages to image or PDF files with a pool of headless browsers
+ * @version     1.0
+ * @date        2026.10.18
+ * @copyright
+ */
+#ifndef CEFBATCHRENDERER_H
+#define CEFBATCHRENDERER_H
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "include/internal/cef_types_wrappers.h"
+
+#include "utils/ImageEncoder.h"
+#include "utils/PixelBufferPool.h"
+
+namespace cefview {
+
+class CefHeadlessView;
+
+/**
+ * @brief One page to render
+ */
+struct CefBatchRenderJob {
+    std::string source;      ///< URL, or path of a local file
+    std::string outputPath;  ///< Image or PDF file to write
+};
+
+/**
+ * @brief Outcome of one job, delivered as soon as its file is written
+ */
+struct CefBatchRenderResult {
+    size_t index = 0;                ///< Position in the job list
+    std::string source;
+    std::string outputPath;
+    bool success = false;
+    std::string error;               ///< Reason when success is false
+    bool settled = true;             ///< false if captured at the timeout while still painting
+    int httpStatus = 0;
+    int width = 0;                   ///< Image size in pixels; 0 for PDF
+    int height = 0;
+    size_t bytes = 0;                ///< Output file size
+    double loadMs = 0.0;             ///< Navigation to load idle (and full-page resize)
+    double encodeMs = 0.0;           ///< Scaling, encoding and writing on a worker thread, or printing the PDF
+};
+
+/**
+ * @brief Batch statistics, delivered with the completion callback
+ */
+struct CefBatchRenderStats {
+    size_t jobs = 0;
+    size_t succeeded = 0;
+    size_t failed = 0;
+    size_t browsers = 0;
+    size_t encodeThreads = 0;
+    double seconds = 0.0;
+    double pagesPerMinute = 0.0;
+};
+
+/**
+ * @brief Renders pages to PNG/JPEG/BMP or PDF with a bounded pool of headless browsers
+ *
+ * Each browser slot loads its next page as soon as the previous one is
+ * captured, so page loads overlap with each other and with encoding. A page
+ * is captured once it is "load idle": CEF reports that loading stopped and
+ * nothing painted for idleMs. With fullPage the document height is read
+ * through console.log() and the view grows to it before the capture.
+ *
+ * Captures are copied out of the view's frame on the UI thread and are
+ * scaled, encoded and written by a pool of worker threads, as PNG deflate is the dominant
+ * cost for large pages. Browser slots stop picking up pages while twice as
+ * many captures as workers are waiting, which bounds memory.
+ *
+ * With Output::kPdf the page is printed with PrintToPDF instead: layout for
+ * paper and writing the file run in the renderer and browser processes, so
+ * there are no encoder threads and a slot stays busy until its file exists.
+ *
+ * Browsers are reused across pages and all closed before the completion
+ * callback runs. Must be owned by a shared_ptr; call start() on TID_UI.
+ */
+class CefBatchRenderer : public std::enable_shared_from_this<CefBatchRenderer> {
+public:
+    enum class Output {
+        kImage,  ///< Capture the view and encode it in format
+        kPdf,    ///< Print the page with pdfSettings
+    };
+
+    struct Options {
+        Output output = Output::kImage;
+        int concurrency = 0;                ///< Browsers; 0 uses the hardware thread count, capped at 8
+        int encodeThreads = 0;              ///< Encoder threads; 0 uses the hardware thread count (images only)
+        int width = 1280;                   ///< Viewport in view coordinates
+        int height = 800;
+        float deviceScaleFactor = 1.0f;
+        bool fullPage = false;              ///< Grow the view to the document height (images only)
+        int maxPageHeight = 16384;          ///< Full-page limit in pixels (GPU texture limit)
+        int idleMs = 500;                   ///< Quiet period after loading before the capture
+        int timeoutMs = 30000;              ///< Per page; a loaded page is captured anyway
+        float scale = 1.0f;                 ///< Output size relative to the frame, in (0, 1]
+        ImageEncoder::Format format = ImageEncoder::Format::kPng;
+        int quality = 90;                   ///< JPEG quality
+        CefPdfPrintSettings pdfSettings;    ///< Paper, margins and backgrounds for Output::kPdf
+        unsigned int backgroundColor = 0xFFFFFFFF;  ///< ARGB behind transparent pages
+    };
+
+    using ProgressCallback = std::function<void(const CefBatchRenderResult& result)>;
+    using CompletionCallback = std::function<void(const CefBatchRenderStats& stats)>;
+
+    explicit CefBatchRenderer(const Options& options);
+    ~CefBatchRenderer();
+
+    CefBatchRenderer(const CefBatchRenderer&) = delete;
+    CefBatchRenderer& operator=(const CefBatchRenderer&) = delete;
+
+    /**
+     * @brief Render the jobs; returns at once
+     * @param progress Called on TID_UI after each job (may be empty)
+     * @param completion Called on TID_UI once every job is done and the browsers are closed
+     * @return false if a batch is already running or the workers cannot start
+     */
+    bool start(std::vector<CefBatchRenderJob> jobs, ProgressCallback progress, CompletionCallback completion);
+
+    /**
+     * @brief Fail the jobs not started yet and finish as soon as the running ones are done
+     */
+    void cancel();
+
+    bool isRunning() const { return _running; }
+
+    /**
+     * @brief URL for a job source: URLs pass through, local paths become file:// URLs
+     */
+    static std::string SourceToUrl(const std::string& source);
+
+    /**
+     * @brief Output file for a source in a directory, e.g. job 7 "reports/q3.html" -> "<dir>/0007-q3.png"
+     * The job index keeps names unique (URLs often differ only in the query) and in job order.
+     * The extension follows options.output and options.format.
+     */
+    static std::string OutputPathFor(const std::string& source, const std::string& outputDir,
+                                     const Options& options, size_t index);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    enum class SlotState {
+        kFree,
+        kLoading,    ///< Waiting for load idle
+        kMeasuring,  ///< Waiting for the document height
+        kSettling,   ///< Waiting for load idle at the full-page size
+        kPrinting,   ///< Waiting for PrintToPDF to write the file
+    };
+
+    struct Slot {
+        std::shared_ptr<CefHeadlessView> view;
+        SlotState state = SlotState::kFree;
+        size_t job = 0;
+        Clock::time_point started;
+        uint64_t paintsAtResize = 0;
+    };
+
+    struct EncodeTask {
+        PixelBuffer frame;
+        int width = 0;
+        int height = 0;
+        CefBatchRenderResult result;
+    };
+
+    void tick();
+    void scheduleTick();
+    void fillSlots();
+    void updateSlot(Slot& slot);
+    void startJob(Slot& slot, size_t job);
+    void captureJob(Slot& slot, bool settled);
+    void printJob(Slot& slot, bool settled);
+    void onPrinted(Slot& slot, CefBatchRenderResult result, Clock::time_point printStart, bool ok);
+    void failJob(Slot& slot, const std::string& error);
+    void finishJob(const CefBatchRenderResult& result);
+    void onEncoded(const CefBatchRenderResult& result);
+    void onPageHeight(Slot& slot, const std::string& message);
+    void closeBrowsers();
+    void onBrowserClosed();
+
+    bool startWorkers(int count);
+    void stopWorkers();
+    void workerMain();
+    void encode(EncodeTask& task) const;
+
+    Options _options;
+    std::vector<CefBatchRenderJob> _jobs;
+    ProgressCallback _progress;
+    CompletionCallback _completion;
+    std::vector<std::unique_ptr<Slot>> _slots;
+    size_t _nextJob = 0;
+    size_t _finishedJobs = 0;
+    size_t _pendingEncodes = 0;
+    size_t _openBrowsers = 0;
+    bool _running = false;
+    bool _closing = false;
+    CefBatchRenderStats _stats;
+    Clock::time_point _startTime;
+
+    // Encoder workers
+    std::vector<std::thread> _workers;
+    std::mutex _queueMutex;
+    std::condition_variable _queueCondition;
+    std::deque<EncodeTask> _queue;
+    bool _stopWorkers = false;
+};
+
+}  // namespace cefview
+
+#endif  // CEFBATCHRENDERER_H
@@ -0,0 +1,467 @@
+#include "CefHeadlessView.h"
+
+#include <cmath>
+#include <utility>
+
+#include "include/cef_browser.h"
+
+#include "client/CefViewClient.h"
+#include "client/CefViewClientDelegateInterface.h"
+#include "osr/OsrRendererSoftware.h"
+#include "osr/OsrSharedFrameSink.h"
+#include "osr/OsrStreamServer.h"
+#include "utils/LogUtil.h"
+
+namespace cefview {
+
+// Forwards the client callbacks a headless browser cares about; everything
+// interactive (menus, dialogs, drags, popups, permissions) is refused.
+class CefHeadlessView::ClientDelegate : public CefViewClientDelegateInterface {
+public:
+    explicit ClientDelegate(CefHeadlessView* view) : _view(view) {}
+
+#pragma region CefContextMenuHandler
+    void onBeforeContextMenu(CefRefPtr<CefBrowser> browser,
+                             CefRefPtr<CefFrame> frame,
+                             CefRefPtr<CefContextMenuParams> params,
+                             CefRefPtr<CefMenuModel> model) override {
+        model->Clear();
+    }
+
+    bool onContextMenuCommand(CefRefPtr<CefBrowser> browser,
+                              CefRefPtr<CefFrame> frame,
+                              CefRefPtr<CefContextMenuParams> params,
+                              int commandId,
+                              CefContextMenuHandler::EventFlags eventFlags) override {
+        return true;
+    }
+#pragma endregion // CefContextMenuHandler
+
+#pragma region CefDisplayHandler
+    void onAddressChange(CefRefPtr<CefBrowser> browser, CefRefPtr<CefFrame> frame, const CefString& url) override {}
+
+    void onTitleChange(CefRefPtr<CefBrowser> browser, const CefString& title) override {}
+
+    bool onCursorChange(CefRefPtr<CefBrowser> browser,
+                        CefCursorHandle cursor,
+                        cef_cursor_type_t type,
+                        const CefCursorInfo& customCursorInfo) override {
+        return true;
+    }
+
+    bool onConsoleMessage(CefRefPtr<CefBrowser> browser,
+                          cef_log_severity_t level,
+                          const CefString& message,
+                          const CefString& source,
+                          int line) override {
+        _view->onConsoleMessage(message.ToString());
+        return false;
+    }
+#pragma endregion // CefDisplayHandler
+
+#pragma region CefDownloadHandler
+    bool onBeforeDownload(CefRefPtr<CefBrowser> browser,
+                          CefRefPtr<CefDownloadItem> downloadItem,
+                          const CefString& suggestedName,
+                          CefRefPtr<CefBeforeDownloadCallback> callback) override {
+        return false;
+    }
+
+    void onDownloadUpdated(CefRefPtr<CefBrowser> browser,
+                           CefRefPtr<CefDownloadItem> downloadItem,
+                           CefRefPtr<CefDownloadItemCallback> callback) override {
+        callback->Cancel();
+    }
+#pragma endregion // CefDownloadHandler
+
+#pragma region CefDragHandler
+    bool onDragEnter(CefRefPtr<CefBrowser> browser,
+                     CefRefPtr<CefDragData> dragData,
+                     CefRenderHandler::DragOperationsMask mask) override {
+        return true;
+    }
+#pragma endregion // CefDragHandler
+
+#pragma region CefKeyboardHandler
+    bool onPreKeyEvent(CefRefPtr<CefBrowser> browser,
+                       const CefKeyEvent& event,
+                       CefEventHandle osEvent,
+                       bool* isKeyboardShortcut) override {
+        return false;
+    }
+
+    bool onKeyEvent(CefRefPtr<CefBrowser> browser, const CefKeyEvent& event, CefEventHandle osEvent) override {
+        return false;
+    }
+#pragma endregion // CefKeyboardHandler
+
+#pragma region CefLifeSpanHandler
+    bool onBeforePopup(CefRefPtr<CefBrowser> browser,
+                       CefRefPtr<CefFrame> frame,
+                       int popupId,
+                       const CefString& targetUrl,
+                       const CefString& targetFrameName,
+                       CefLifeSpanHandler::WindowOpenDisposition targetDisposition,
+                       bool userGesture,
+                       const CefPopupFeatures& popupFeatures,
+                       CefWindowInfo& windowInfo,
+                       CefRefPtr<CefClient>& client,
+                       CefBrowserSettings& settings,
+                       CefRefPtr<CefDictionaryValue>& extraInfo,
+                       bool* noJavascriptAccess) override {
+        return true;
+    }
+
+    void onAfterCreated(CefRefPtr<CefBrowser> browser) override {
+        _view->onAfterCreated(browser);
+    }
+
+    void onBeforeClose(CefRefPtr<CefBrowser> browser) override {
+        _view->onBeforeClose();
+    }
+#pragma endregion // CefLifeSpanHandler
+
+#pragma region CefLoadHandler
+    void onLoadingStateChange(CefRefPtr<CefBrowser> browser, bool isLoading, bool canGoBack, bool canGoForward) override {
+        _view->onLoadingStateChange(isLoading);
+    }
+
+    void onLoadStart(CefRefPtr<CefBrowser> browser,
+                     CefRefPtr<CefFrame> frame,
+                     CefLoadHandler::TransitionType transitionType) override {}
+
+    void onLoadEnd(CefRefPtr<CefBrowser> browser, CefRefPtr<CefFrame> frame, int httpStatusCode) override {
+        _view->onLoadEnd(httpStatusCode);
+    }
+
+    void onLoadError(CefRefPtr<CefBrowser> browser,
+                     CefRefPtr<CefFrame> frame,
+                     CefLoadHandler::ErrorCode errorCode,
+                     const CefString& errorText,
+                     const CefString& failedUrl) override {
+        if (frame->IsMain()) {
+            _view->onLoadError(errorText.ToString() + " (" + std::to_string(static_cast<int>(errorCode)) + ")");
+        }
+    }
+#pragma endregion // CefLoadHandler
+
+#pragma region CefRenderHandler
+    void onPaint(CefRefPtr<CefBrowser> browser,
+                 CefRenderHandler::PaintElementType type,
+                 const CefRenderHandler::RectList& dirtyRects,
+                 const void* buffer,
+                 int width,
+                 int height) override {
+        // Popups (<select> lists) are not part of a capture
+        if (type == PET_VIEW) {
+            _view->onPaint(dirtyRects, buffer, width, height);
+        }
+    }
+
+    void onAcceleratedPaint(CefRefPtr<CefBrowser> browser,
+                            CefRenderHandler::PaintElementType type,
+                            const CefRenderHandler::RectList& dirtyRects,
+                            const CefAcceleratedPaintInfo& info) override {}
+
+    bool getRootScreenRect(CefRefPtr<CefBrowser> browser, CefRect& rect) override {
+        rect = CefRect(0, 0, _view->_settings.width, _view->_settings.height);
+        return true;
+    }
+
+    void getViewRect(CefRefPtr<CefBrowser> browser, CefRect& rect) override {
+        if (_view->_settings.width > 0 && _view->_settings.height > 0) {
+            rect = CefRect(0, 0, _view->_settings.width, _view->_settings.height);
+        }
+    }
+
+    bool getScreenPoint(CefRefPtr<CefBrowser> browser, int viewX, int viewY, int& screenX, int& screenY) override {
+        screenX = static_cast<int>(std::lround(static_cast<float>(viewX) * _view->_deviceScaleFactor));
+        screenY = static_cast<int>(std::lround(static_cast<float>(viewY) * _view->_deviceScaleFactor));
+        return true;
+    }
+
+    bool getScreenInfo(CefRefPtr<CefBrowser> browser, CefScreenInfo& screenInfo) override {
+        CefRect rect;
+        getViewRect(browser, rect);
+        screenInfo.device_scale_factor = _view->_deviceScaleFactor;
+        screenInfo.rect = rect;
+        screenInfo.available_rect = rect;
+        return true;
+    }
+
+    void onPopupShow(CefRefPtr<CefBrowser> browser, bool show) override {}
+
+    void onPopupSize(CefRefPtr<CefBrowser> browser, const CefRect& rect) override {}
+
+    bool startDragging(CefRefPtr<CefBrowser> browser,
+                       CefRefPtr<CefDragData> dragData,
+                       CefRenderHandler::DragOperationsMask allowedOps,
+                       int x, int y) override {
+        return false;
+    }
+
+    void updateDragCursor(CefRefPtr<CefBrowser> browser, CefRenderHandler::DragOperation operation) override {}
+
+    void onImeCompositionRangeChanged(CefRefPtr<CefBrowser> browser,
+                                      const CefRange& selectionRange,
+                                      const CefRenderHandler::RectList& characterBounds) override {}
+#pragma endregion // CefRenderHandler
+
+#pragma region CefPermissionHandler
+    bool onShowPermissionPrompt(CefRefPtr<CefBrowser> browser,
+                                uint64_t promptId,
+                                const CefString& requestingOrigin,
+                                uint32_t requestedPermissions,
+                                CefRefPtr<CefPermissionPromptCallback> callback) override {
+        callback->Continue(CEF_PERMISSION_RESULT_DENY);
+        return true;
+    }
+#pragma endregion // CefPermissionHandler
+
+#pragma region CefRequestHandler
+    bool onBeforeBrowse(CefRefPtr<CefBrowser> browser,
+                        CefRefPtr<CefFrame> frame,
+                        CefRefPtr<CefRequest> request,
+                        bool userGesture,
+                        bool isRedirect) override {
+        return false;
+    }
+
+    void onRenderProcessTerminated(CefRefPtr<CefBrowser> browser,
+                                   CefRequestHandler::TerminationStatus status,
+                                   int errorCode,
+                                   const CefString& errorString) override {
+        _view->onLoadError("render process terminated (" + std::to_string(errorCode) + ")");
+    }
+#pragma endregion // CefRequestHandler
+
+private:
+    CefHeadlessView* _view;  ///< Owns this delegate
+};
+
+CefHeadlessView::CefHeadlessView(const CefWebViewSetting& settings, float deviceScaleFactor)
+    : _settings(settings)
+    , _deviceScaleFactor(deviceScaleFactor > 0.0f ? deviceScaleFactor : 1.0f)
+    , _clientDelegate()
+    , _client()
+    , _browser()
+    , _pendingUrl()
+    , _loadError()
+    , _loadStartTime()
+    , _loadEndTime()
+    , _renderer()
+    , _lastPaintTime()
+    , _frameSink()
+    , _streamServer()
+    , _consoleMessageCallback()
+    , _closedCallback() {
+}
+
+CefHeadlessView::~CefHeadlessView() {
+    // The client only holds a weak reference to the delegate, so no callback
+    // reaches this view once it is gone
+    if (_browser) {
+        _browser->GetHost()->CloseBrowser(true);
+    }
+}
+
+bool CefHeadlessView::create() {
+    if (_client) {
+        return true;
+    }
+
+    if (_pendingUrl.empty()) {
+        _pendingUrl = _settings.url;
+    }
+    loadUrl(_pendingUrl);
+
+    if (!_settings.frameExportName.empty()) {
+        // Opened at the first paint, sized for it
+        _frameSink = std::make_unique<OsrSharedFrameSink>(_settings.frameExportName);
+    }
+    if (!_settings.streamServerAddress.empty()) {
+        _streamServer = std::make_unique<OsrStreamServer>();
+        std::weak_ptr<CefHeadlessView> weakSelf = weak_from_this();
+        // Runs on the UI thread
+        const bool started = _streamServer->start(_settings.streamServerAddress,
+            [weakSelf](const OsrStreamInput& input) {
+                if (auto self = weakSelf.lock()) {
+                    OsrStreamServer::DispatchToBrowser(self->_browser, input, self->_deviceScaleFactor);
+                }
+            });
+        if (!started) {
+            _streamServer.reset();
+        }
+    }
+
+    _renderer = std::make_unique<OsrRendererSoftware>(_settings.width, _settings.height);
+    _renderer->initialize();
+
+    _clientDelegate = std::make_shared<ClientDelegate>(this);
+    _client = new CefViewClient(_clientDelegate);
+
+    CefWindowInfo windowInfo;
+    windowInfo.SetAsWindowless(kNullWindowHandle);
+    // The frame is read from OnPaint's CPU buffers
+    windowInfo.shared_texture_enabled = false;
+
+    CefBrowserSettings browserSettings;
+    browserSettings.background_color = _settings.backgroundColor;
+    browserSettings.windowless_frame_rate = _settings.windowlessFrameRate;
+
+    if (!CefBrowserHost::CreateBrowser(windowInfo, _client, CefString(_pendingUrl), browserSettings, nullptr, nullptr)) {
+        LOGE << "CreateBrowser FAILED for headless view";
+        _client = nullptr;
+        _clientDelegate.reset();
+        _renderer.reset();
+        _frameSink.reset();
+        _streamServer.reset();
+        return false;
+    }
+    return true;
+}
+
+void CefHeadlessView::close() {
+    if (_closing || _closed) {
+        return;
+    }
+    _closing = true;
+    if (_browser) {
+        _browser->GetHost()->CloseBrowser(true);
+    } else if (!_client) {
+        // Never created: nothing to wait for
+        onBeforeClose();
+    }
+    // Otherwise the browser is still being created; onAfterCreated closes it
+}
+
+void CefHeadlessView::loadUrl(const std::string& url) {
+    _pendingUrl = url;
+    _loading = true;
+    _loadFinished = false;
+    _httpStatus = 0;
+    _loadError.clear();
+    _loadStartTime = Clock::now();
+    _paintCount = 0;
+    if (_browser) {
+        _browser->GetMainFrame()->LoadURL(CefString(url));
+    } else if (_client) {
+        // The browser is being created with the previous URL
+        _navigateOnCreate = true;
+    }
+}
+
+void CefHeadlessView::stopLoad() {
+    if (_browser) {
+        _browser->StopLoad();
+    }
+}
+
+void CefHeadlessView::resize(int width, int height) {
+    if (width == _settings.width && height == _settings.height) {
+        return;
+    }
+    _settings.width = width;
+    _settings.height = height;
+    if (_renderer) {
+        _renderer->setBounds(0, 0, width, height);
+    }
+    if (_browser) {
+        _browser->GetHost()->WasResized();
+    }
+}
+
+void CefHeadlessView::executeJavaScript(const std::string& code) {
+    if (_browser) {
+        CefRefPtr<CefFrame> frame = _browser->GetMainFrame();
+        frame->ExecuteJavaScript(CefString(code), frame->GetURL(), 0);
+    }
+}
+
+bool CefHeadlessView::isLoadIdle(int quietMs) const {
+    if (_loading || !_loadFinished || !_loadError.empty() || _paintCount == 0) {
+        return false;
+    }
+    const Clock::time_point lastActivity = _lastPaintTime > _loadEndTime ? _lastPaintTime : _loadEndTime;
+    return Clock::now() - lastActivity >= std::chrono::milliseconds(quietMs);
+}
+
+bool CefHeadlessView::captureFrame(PixelBuffer& frame, int& width, int& height) const {
+    return _renderer && _renderer->captureFrame(frame, width, height);
+}
+
+void CefHeadlessView::printToPdf(const CefPdfPrintSettings& settings, const std::string& path,
+                                 PdfPrintCallback callback) {
+    CefViewPdfPrinter::PrintToPdf(_closing ? nullptr : _browser, settings, path, std::move(callback));
+}
+
+void CefHeadlessView::onAfterCreated(CefRefPtr<CefBrowser> browser) {
+    _browser = browser;
+    if (_closing) {
+        _browser->GetHost()->CloseBrowser(true);
+        return;
+    }
+    if (_navigateOnCreate) {
+        _navigateOnCreate = false;
+        browser->GetMainFrame()->LoadURL(CefString(_pendingUrl));
+    }
+}
+
+void CefHeadlessView::onBeforeClose() {
+    _browser = nullptr;
+    _closed = true;
+    _renderer.reset();
+    // Readers see the export closed, subscribers are disconnected
+    _frameSink.reset();
+    _streamServer.reset();
+    if (_closedCallback) {
+        // The callback may release this view
+        ClosedCallback callback = std::move(_closedCallback);
+        callback();
+    }
+}
+
+void CefHeadlessView::onLoadingStateChange(bool isLoading) {
+    _loading = isLoading;
+    if (!isLoading) {
+        _loadFinished = true;
+        _loadEndTime = Clock::now();
+    }
+}
+
+void CefHeadlessView::onLoadEnd(int httpStatusCode) {
+    _httpStatus = httpStatusCode;
+}
+
+void CefHeadlessView::onLoadError(const std::string& errorText) {
+    _loadError = errorText;
+    _loading = false;
+    _loadFinished = true;
+    _loadEndTime = Clock::now();
+}
+
+void CefHeadlessView::onPaint(const CefRenderHandler::RectList& dirtyRects, const void* buffer, int width, int height) {
+    if (!_renderer || !buffer || width <= 0 || height <= 0) {
+        return;
+    }
+    _renderer->onPaint(PET_VIEW, dirtyRects, buffer, width, height);
+    // No frame callback: render() only counts the frame and clears its dirty rects
+    _renderer->render();
+    ++_paintCount;
+    _lastPaintTime = Clock::now();
+
+    if (_frameSink) {
+        _frameSink->publish(dirtyRects, buffer, width, height);
+    }
+    if (_streamServer) {
+        _streamServer->publish(dirtyRects, buffer, width, height);
+    }
+}
+
+void CefHeadlessView::onConsoleMessage(const std::string& message) {
+    if (_consoleMessageCallback) {
+        _consoleMessageCallback(message);
+    }
+}
+
+}  // namespace cefview
@@ -0,0 +1,188 @@
+/**
+ * @file        CefHeadlessView.h
+ * @brief       Windowless browser without a native parent, e.g. for batch rendering
+ * @version     1.0
+ * @date        2026.10.18
+ * @copyright
+ */
+#ifndef CEFHEADLESSVIEW_H
+#define CEFHEADLESSVIEW_H
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "include/cef_base.h"
+#include "include/cef_browser.h"
+#include "include/cef_render_handler.h"
+
+#include "client/CefViewPdfPrinter.h"
+#include "utils/PixelBufferPool.h"
+#include "view/CefWebViewSetting.h"
+
+namespace cefview {
+
+class CefViewClient;
+class OsrRendererSoftware;
+class OsrSharedFrameSink;
+class OsrStreamServer;
+
+/**
+ * @brief Off-screen browser that keeps its view frame in memory
+ *
+ * Unlike CefWebView it needs no window or display: CEF paints into
+ * OnPaint's CPU buffer and an OsrRendererSoftware keeps the frame in
+ * memory, updated from the dirty rects. It also tracks the loading state and the time of
+ * the last paint, which is what a caller needs to decide when a page is
+ * done ("load idle") before capturing it. Available on all platforms.
+ *
+ * Uses url, width, height (view coordinates), windowlessFrameRate,
+ * backgroundColor, frameExportName and streamServerAddress from the settings. Must be owned
+ * by a shared_ptr; all methods must be called on TID_UI.
+ */
+class CefHeadlessView : public std::enable_shared_from_this<CefHeadlessView> {
+public:
+    using Clock = std::chrono::steady_clock;
+    using ConsoleMessageCallback = std::function<void(const std::string& message)>;
+    using ClosedCallback = std::function<void()>;
+
+    CefHeadlessView(const CefWebViewSetting& settings, float deviceScaleFactor = 1.0f);
+    ~CefHeadlessView();
+
+    CefHeadlessView(const CefHeadlessView&) = delete;
+    CefHeadlessView& operator=(const CefHeadlessView&) = delete;
+
+    /**
+     * @brief Create the browser and start loading settings.url
+     * @return false if CEF refused to create the browser
+     */
+    bool create();
+
+    /**
+     * @brief Close the browser; the closed callback runs once it is gone
+     */
+    void close();
+
+    /**
+     * @brief Navigate to a URL, resetting the load state and paint count
+     * May be called before the browser exists; the last URL wins.
+     */
+    void loadUrl(const std::string& url);
+
+    /**
+     * @brief Stop the current navigation
+     */
+    void stopLoad();
+
+    /**
+     * @brief Change the view size in view coordinates
+     */
+    void resize(int width, int height);
+
+    /**
+     * @brief Run a script in the main frame
+     */
+    void executeJavaScript(const std::string& code);
+
+    /**
+     * @brief Whether the page finished loading and nothing painted for quietMs
+     * Also requires at least one paint since loadUrl(), so the frame shows the
+     * new page. False while the load failed (see loadError()).
+     */
+    bool isLoadIdle(int quietMs) const;
+
+    /**
+     * @brief Copy the current view frame (BGRA, width * 4 bytes per row)
+     * The copy is independent of later paints, e.g. to encode it on another thread.
+     * @return false before the first paint or when out of memory
+     */
+    bool captureFrame(PixelBuffer& frame, int& width, int& height) const;
+
+    /**
+     * @brief Renderer holding the view frame, e.g. for its render statistics
+     * @return nullptr before create() and after the browser closed
+     */
+    OsrRendererSoftware* renderer() const { return _renderer.get(); }
+
+    /**
+     * @brief Print the current page to a PDF file
+     * @param callback Runs on TID_UI; fails if the browser does not exist yet
+     */
+    void printToPdf(const CefPdfPrintSettings& settings, const std::string& path, PdfPrintCallback callback);
+
+    bool isCreated() const { return _browser != nullptr; }
+    bool isClosed() const { return _closed; }
+    bool isLoading() const { return _loading; }
+    int httpStatus() const { return _httpStatus; }
+    /// Main frame load error or render process crash of the current navigation; empty if none
+    const std::string& loadError() const { return _loadError; }
+    uint64_t paintCount() const { return _paintCount; }
+    Clock::time_point loadStartTime() const { return _loadStartTime; }
+
+    float deviceScaleFactor() const { return _deviceScaleFactor; }
+    CefRefPtr<CefBrowser> browser() const { return _browser; }
+
+    /**
+     * @brief Shared memory frame export for settings.frameExportName
+     * @return nullptr when not configured
+     */
+    OsrSharedFrameSink* frameSink() const { return _frameSink.get(); }
+
+    /**
+     * @brief Remote viewing server started for settings.streamServerAddress
+     * @return nullptr when not configured, not supported or the address cannot be bound
+     */
+    OsrStreamServer* streamServer() const { return _streamServer.get(); }
+
+    /**
+     * @brief Receive console.log() output of the page, e.g. to return values from executeJavaScript()
+     */
+    void setConsoleMessageCallback(ConsoleMessageCallback callback) { _consoleMessageCallback = std::move(callback); }
+    void setClosedCallback(ClosedCallback callback) { _closedCallback = std::move(callback); }
+
+private:
+    class ClientDelegate;
+    friend class ClientDelegate;
+
+    void onAfterCreated(CefRefPtr<CefBrowser> browser);
+    void onBeforeClose();
+    void onLoadingStateChange(bool isLoading);
+    void onLoadEnd(int httpStatusCode);
+    void onLoadError(const std::string& errorText);
+    void onPaint(const CefRenderHandler::RectList& dirtyRects, const void* buffer, int width, int height);
+    void onConsoleMessage(const std::string& message);
+
+    CefWebViewSetting _settings;
+    float _deviceScaleFactor = 1.0f;
+    std::shared_ptr<ClientDelegate> _clientDelegate;
+    CefRefPtr<CefViewClient> _client;
+    CefRefPtr<CefBrowser> _browser;
+    std::string _pendingUrl;
+    bool _navigateOnCreate = false;
+    bool _closing = false;
+    bool _closed = false;
+
+    bool _loading = false;
+    bool _loadFinished = false;
+    int _httpStatus = 0;
+    std::string _loadError;
+    Clock::time_point _loadStartTime;
+    Clock::time_point _loadEndTime;
+
+    std::unique_ptr<OsrRendererSoftware> _renderer;
+    uint64_t _paintCount = 0;
+    Clock::time_point _lastPaintTime;
+
+    std::unique_ptr<OsrSharedFrameSink> _frameSink;
+    std::unique_ptr<OsrStreamServer> _streamServer;
+
+    ConsoleMessageCallback _consoleMessageCallback;
+    ClosedCallback _closedCallback;
+};
+
+}  // namespace cefview
+
+#endif  // CEFHEADLESSVIEW_H
@@ -20,6 +20,10 @@ struct CefWebViewSetting {
 
     bool offScreenRenderingEnabled = false;
     int windowlessFrameRate = 60;
+    // OSR only: lower the frame rate towards minFrameRate while the page is
+    // static and raise it back to windowlessFrameRate on animation or input.
+    bool adaptiveFrameRateEnabled = false;
+    int minFrameRate = 10;
 
     // Position and size. 0 width/height fills the parent window.
     int x = 0;
@@ -28,7 +32,56 @@ struct CefWebViewSetting {
     int height = 0;
 
     bool transparentPaintingEnabled = false;
+
+    // OSR only: hash 64x64 view tiles on each paint and skip uploads/presents
+    // for regions whose pixels did not change. Costs a hash pass per dirty tile.
+    bool tileHashEnabled = false;
+
+    // OSR only: log rendering statistics as JSON every N seconds (0 disables).
+    int renderStatsLogInterval = 0;
+
+    // OSR only: during live resize, draw the last frame 1:1 (cropped) instead
+    // of stretched until CEF paints at the new size.
+    bool resizeCropEnabled = false;
+    // OSR only: minimum milliseconds between WasResized notifications; the
+    // last size of a burst is always sent (0 sends every resize).
+    int resizeThrottleMs = 50;
+    // OSR only: release the view texture this many milliseconds after the
+    // view is hidden, keeping a copy of the last frame for the next show
+    // (negative keeps the texture).
+    int hiddenSuspendDelayMs = 3000;
+    // OSR only: keep the last N seconds of view paints as dirty-rect deltas,
+    // dumped on demand through frameRecorder() (0 disables). Recording needs
+    // the CPU paint buffers, so shared textures are off while it is enabled.
+    int frameRecorderSeconds = 0;
+    // OSR only: memory budget for recorded deltas in MB (plus one frame).
+    int frameRecorderMaxMB = 256;
+    // OSR only: paint through OnPaint's CPU buffers instead of shared
+    // textures, for consumers of the pixels such as setYuvFrameCallback().
+    bool cpuPaintEnabled = false;
+    // OSR only, Windows: draw with OpenGL (OsrRendererGL) instead of D3D11,
+    // so the view can join an OsrCompositorGL through
+    // CefWebView::attachToCompositor(). Implies CPU paint buffers.
+    bool openGLRendererEnabled = false;
+    // OSR only, macOS CefWebView and CefHeadlessView (not Windows): export
+    // view frames to other processes over POSIX shared memory under this
+    // shm_open name, e.g. "/cefview-main" (empty disables). Read them with
+    // the C library in src/frame_reader. Implies CPU paint buffers.
+    std::string frameExportName;
+    // OSR only, macOS CefWebView and CefHeadlessView (not Windows): stream
+    // changed tiles to subscribers and take their input, on
+    // "unix:/path.sock" or "tcp:127.0.0.1:port" (empty disables). No
+    // authentication: bind to loopback. Implies CPU paint buffers.
+    std::string streamServerAddress;
     unsigned int backgroundColor = 0x00000000;  // ARGB format
+
+    // OSR only: whether a consumer of OnPaint's CPU buffers is enabled (the
+    // frame recorder, YUV output, the OpenGL renderer, frame export or
+    // streaming). Views turn shared textures off when this is true.
+    bool cpuPaintRequired() const {
+        return cpuPaintEnabled || frameRecorderSeconds > 0 || openGLRendererEnabled ||
+               !frameExportName.empty() || !streamServerAddress.empty();
+    }
 };
 
 }  // namespace cefview
@@ -5,6 +5,7 @@
 #import <Cocoa/Cocoa.h>
 #include "client/CefViewClient.h"
 #include "client/CefViewClientDelegateInterface.h"
+#include "client/CefViewMessageRegistry.h"
 #include "include/cef_base.h"
 #include <memory>
 
@@ -73,6 +74,12 @@ class CefJsBridgeBrowser;
 
 @optional
 
+/// Popup widget (e.g. <select> dropdown) shown or hidden
+- (void)onPopupShow:(BOOL)show;
+
+/// Popup widget rectangle changed, in view coordinates (DIP)
+- (void)onPopupSize:(const CefRect&)rect;
+
 /// Browser creation complete event
 - (void)onAfterCreatedWithBrowserId:(int)browserId;
 
@@ -124,7 +131,15 @@ public:
     explicit CefViewClientDelegate(id<CefWebViewObserver> observer);
     ~CefViewClientDelegate();
 
+    /**
+     * @brief Registry used to dispatch process messages from the render process.
+     * Register additional handlers here to extend the message set.
+     */
+    CefViewMessageRegistry& messageRegistry() { return _messageRegistry; }
+
 protected:
+    void registerMessageHandlers();
+
 #pragma region CefClient
     virtual bool onProcessMessageReceived(CefRefPtr<CefBrowser> browser,
                                           CefRefPtr<CefFrame> frame,
@@ -301,6 +316,7 @@ protected:
     CefString _url;
     bool _isDevtoolsOpened = false;
     std::shared_ptr<CefJsBridgeBrowser> _jsBridgeBrowser;
+    CefViewMessageRegistry _messageRegistry;
 };
 
 }  // namespace cefview
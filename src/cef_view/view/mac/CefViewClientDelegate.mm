@@ -22,6 +22,7 @@ CefViewClientDelegate::CefViewClientDelegate(id<CefWebViewObserver> observer)
     : _observer(observer)
 {
     _jsBridgeBrowser = std::make_shared<CefJsBridgeBrowser>();
+    registerMessageHandlers();
 }
 
 CefViewClientDelegate::~CefViewClientDelegate()
@@ -29,35 +30,41 @@ CefViewClientDelegate::~CefViewClientDelegate()
     _observer = nil;
 }
 
+void CefViewClientDelegate::registerMessageHandlers()
+{
+    _messageRegistry.registerHandler(kCallCppFunctionMessage,
+        [this](CefRefPtr<CefBrowser> browser, CefRefPtr<CefFrame>, CefProcessId, CefRefPtr<CefProcessMessage> message) {
+            CefRefPtr<CefListValue> args = message->GetArgumentList();
+            CefString funcName = args->GetString(0);
+            CefString param = args->GetString(1);
+            int jsCallbackId = args->GetInt(2);
+
+            if (_jsBridgeBrowser) {
+                _jsBridgeBrowser->executeCppFunc(funcName, param, jsCallbackId, browser);
+            }
+            return true;
+        });
+
+    _messageRegistry.registerHandler(kExecuteCppCallbackMessage,
+        [this](CefRefPtr<CefBrowser>, CefRefPtr<CefFrame>, CefProcessId, CefRefPtr<CefProcessMessage> message) {
+            CefRefPtr<CefListValue> args = message->GetArgumentList();
+            CefString param = args->GetString(0);
+            int callbackId = args->GetInt(1);
+
+            if (_jsBridgeBrowser) {
+                _jsBridgeBrowser->executeCppCallbackFunc(callbackId, param);
+            }
+            return true;
+        });
+}
+
 #pragma region CefClient
 bool CefViewClientDelegate::onProcessMessageReceived(CefRefPtr<CefBrowser> browser,
                                                      CefRefPtr<CefFrame> frame,
                                                      CefProcessId sourceProcess,
                                                      CefRefPtr<CefProcessMessage> message)
 {
-    std::string msgName = message->GetName();
-    if (msgName == kCallCppFunctionMessage) {
-        CefString funcName = message->GetArgumentList()->GetString(0);
-        CefString param = message->GetArgumentList()->GetString(1);
-        int jsCallbackId = message->GetArgumentList()->GetInt(2);
-
-        if (_jsBridgeBrowser) {
-            _jsBridgeBrowser->executeCppFunc(funcName, param, jsCallbackId, browser);
-        }
-
-        return true;
-    } else if (msgName == kExecuteCppCallbackMessage) {
-        CefString param = message->GetArgumentList()->GetString(0);
-        int callbackId = message->GetArgumentList()->GetInt(1);
-
-        if (_jsBridgeBrowser) {
-            _jsBridgeBrowser->executeCppCallbackFunc(callbackId, param);
-        }
-
-        return true;
-    }
-
-    return false;
+    return _messageRegistry.dispatch(browser, frame, sourceProcess, message);
 }
 
 void CefViewClientDelegate::onEditableFocusChanged(CefRefPtr<CefProcessMessage> message)
@@ -355,10 +362,16 @@ bool CefViewClientDelegate::getScreenInfo(CefRefPtr<CefBrowser> browser, CefScre
 
 void CefViewClientDelegate::onPopupShow(CefRefPtr<CefBrowser> browser, bool show)
 {
+    if (_observer && [_observer respondsToSelector:@selector(onPopupShow:)]) {
+        [_observer onPopupShow:show ? YES : NO];
+    }
 }
 
 void CefViewClientDelegate::onPopupSize(CefRefPtr<CefBrowser> browser, const CefRect& rect)
 {
+    if (_observer && [_observer respondsToSelector:@selector(onPopupSize:)]) {
+        [_observer onPopupSize:rect];
+    }
 }
 
 bool CefViewClientDelegate::startDragging(CefRefPtr<CefBrowser> browser,
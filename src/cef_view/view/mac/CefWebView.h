@@ -7,6 +7,15 @@
 #include <string>
 
 #include "include/cef_browser.h"
+#include "client/CefViewPdfPrinter.h"
+#include "osr/OsrCapture.h"
+#include "osr/OsrFrameRecorder.h"
+#include "osr/OsrFrameScheduler.h"
+#include "osr/OsrRenderStats.h"
+#include "osr/OsrSharedFrameSink.h"
+#include "osr/OsrStreamServer.h"
+#include "osr/OsrViewScheduler.h"
+#include "osr/OsrYuvFrame.h"
 #include "view/CefWebViewSetting.h"
 
 @class OsrCefTextInputClient;
@@ -131,6 +140,55 @@ class OsrRenderer;
 /// Check if focus is on editable field
 - (BOOL)isEditableFocused;
 
+/// Frame pacing state for OSR presents (presented/skipped counts)
+- (const cefview::OsrFrameScheduler&)frameScheduler;
+
+/// Flight recorder of recent view paints, e.g. to dump the last seconds for a
+/// bug report. nullptr unless settings.frameRecorderSeconds is set (OSR only).
+- (cefview::OsrFrameRecorder*)frameRecorder;
+
+/// Shared memory export of view frames, e.g. for its counters. nullptr unless
+/// settings.frameExportName is set (OSR only).
+- (cefview::OsrSharedFrameSink*)frameSink;
+
+/// Tile streaming server, e.g. for its address and statistics. nullptr unless
+/// settings.streamServerAddress is set (OSR only).
+- (cefview::OsrStreamServer*)streamServer;
+
+/// OSR rendering statistics since view creation or the last periodic log
+- (cefview::OsrRenderStats)getRenderStats;
+
+/// Host hint that the view is fully covered; a covered OSR view is suspended
+/// like a hidden one. Window occlusion is tracked automatically.
+- (void)setOccluded:(BOOL)occluded;
+
+/// What suspending this view while hidden has saved so far
+- (cefview::OsrSuspendStats)getSuspendStats;
+
+/// Capture the view as PNG, JPEG or BMP without blocking the UI thread (OSR).
+/// rect is in view points (empty captures the whole view) and scale, in (0, 1],
+/// sizes the output relative to its device pixels. Scaling and encoding run on
+/// a CEF worker thread; callback runs on the UI thread, also on failure.
+- (void)captureAsync:(const CefRect&)rect
+               scale:(float)scale
+              format:(cefview::ImageEncoder::Format)format
+             quality:(int)quality
+            callback:(cefview::OsrCaptureCallback)callback;
+
+/// Print the page to a PDF file at path without blocking the UI thread.
+/// callback runs on the UI thread, also when the export fails (e.g. before the
+/// browser is created).
+- (void)printToPdf:(const CefPdfPrintSettings&)settings
+              path:(const std::string&)path
+          callback:(cefview::PdfPrintCallback)callback;
+
+/// Receive each view paint as an I420 or NV12 frame (OSR). Only the dirty rects
+/// are converted, into a frame kept across paints; callback runs on the UI
+/// thread inside OnPaint, nil stops the output. Paints only reach the CPU when
+/// settings.cpuPaintEnabled is set at creation.
+- (void)setYuvFrameFormat:(cefview::OsrYuvFrame::Format)format
+                 callback:(cefview::OsrYuvFrame::FrameCallback)callback;
+
 /// Create the CEF browser instance. Subclasses can override to customize browser creation.
 - (void)createCefBrowser;
 
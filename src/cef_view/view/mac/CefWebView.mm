@@ -6,6 +6,7 @@
 #include "osr/mac/OsrRendererMetal.h"
 #import "OsrCefTextInputClient.h"
 #include "utils/LogUtil.h"
+#include "utils/PixelBufferPool.h"
 #include "utils/ScreenUtil.h"
 #include "include/cef_browser.h"
 #include "include/cef_frame.h"
@@ -54,11 +55,32 @@ static NSString* const kNSURLTitlePboardType = @"public.url-name";
     bool _isLoading;
     std::vector<std::string> _cachedJsCodes;
 
-    // Resize debounce
-    NSTimer* _resizeDebounceTimer;
-
     // Gesture recognizer state
     float _lastMagnification;
+
+    // OSR frame pacing, adaptive windowless frame rate and hidden suspension
+    cefview::OsrViewScheduler _viewScheduler;
+
+    // Throttles WasResized during live resize
+    cefview::OsrFrameScheduler _resizeScheduler;
+
+    // Visibility tracking (OSR)
+    BOOL _viewHidden;
+    BOOL _hostOccluded;
+    BOOL _windowOccluded;
+
+    // Flight recorder of view paints (OSR)
+    std::unique_ptr<cefview::OsrFrameRecorder> _frameRecorder;
+
+    // I420/NV12 output of view paints (OSR)
+    std::unique_ptr<cefview::OsrYuvFrame> _yuvFrame;
+    cefview::OsrYuvFrame::FrameCallback _yuvFrameCallback;
+
+    // Shared memory export of view paints (OSR)
+    std::unique_ptr<cefview::OsrSharedFrameSink> _frameSink;
+
+    // Tile streaming of view paints with input back-channel (OSR)
+    std::unique_ptr<cefview::OsrStreamServer> _streamServer;
 }
 
 #pragma mark - Initialization
@@ -156,6 +178,9 @@ static NSString* const kNSURLTitlePboardType = @"public.url-name";
     _clientDelegate.reset();
     _client = nullptr;
     _osrRenderer.reset();
+    // Readers see the export closed, subscribers are disconnected
+    _frameSink.reset();
+    _streamServer.reset();
 }
 
 - (void)activate {
@@ -188,7 +213,7 @@ static NSString* const kNSURLTitlePboardType = @"public.url-name";
     if (_settings.offScreenRenderingEnabled) {
         // Off-screen rendering mode
         windowInfo.SetAsWindowless((__bridge void*)self);
-        windowInfo.shared_texture_enabled = true;
+        windowInfo.shared_texture_enabled = !_settings.cpuPaintRequired();
     } else {
         // Native window mode
         NSRect bounds = NSMakeRect(0, 0, _settings.width, _settings.height);
@@ -244,6 +269,58 @@ static NSString* const kNSURLTitlePboardType = @"public.url-name";
     }
 
     _osrRenderer->setDeviceScaleFactor(_deviceScaleFactor);
+    _osrRenderer->setTileHashEnabled(_settings.tileHashEnabled);
+    _osrRenderer->setResizeMode(_settings.resizeCropEnabled ? cefview::OsrRenderer::ResizeMode::kCrop
+                                                            : cefview::OsrRenderer::ResizeMode::kStretch);
+    if (_settings.resizeThrottleMs > 0) {
+        _resizeScheduler.setFrameRate(1000.0 / _settings.resizeThrottleMs);
+    }
+    // The scheduler lives in an ivar: capture self weakly so it does not retain the view
+    __weak CefWebView* weakSelf = self;
+    OsrViewScheduler::Host host;
+    host.renderer = [weakSelf]() -> OsrRenderer* {
+        CefWebView* strongSelf = weakSelf;
+        return strongSelf ? strongSelf->_osrRenderer.get() : nullptr;
+    };
+    host.postDelayedTask = [weakSelf](OsrViewScheduler::Task task, OsrViewScheduler::Duration delay) {
+        int64_t delayNs = std::chrono::duration_cast<std::chrono::nanoseconds>(delay).count();
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, delayNs), dispatch_get_main_queue(), ^{
+            CefWebView* strongSelf = weakSelf;
+            if (strongSelf) {
+                task();
+            }
+        });
+        return true;
+    };
+    host.setFrameRate = [weakSelf](int framesPerSecond) {
+        CefWebView* strongSelf = weakSelf;
+        if (strongSelf && strongSelf->_browser) {
+            strongSelf->_browser->GetHost()->SetWindowlessFrameRate(framesPerSecond);
+        }
+    };
+    _viewScheduler.setHost(std::move(host));
+    [self updateFrameInterval];
+    if (_settings.adaptiveFrameRateEnabled) {
+        _viewScheduler.setAdaptiveFrameRate(_settings.minFrameRate, _settings.windowlessFrameRate);
+    }
+    [self scheduleRenderStatsLog];
+    if (_settings.frameRecorderSeconds > 0) {
+        size_t maxBytes = static_cast<size_t>(std::max(_settings.frameRecorderMaxMB, 0)) << 20;
+        _frameRecorder = std::make_unique<OsrFrameRecorder>(_settings.frameRecorderSeconds, maxBytes);
+    }
+    if (!_settings.frameExportName.empty()) {
+        _frameSink = std::make_unique<OsrSharedFrameSink>(_settings.frameExportName);
+    }
+    if (!_settings.streamServerAddress.empty()) {
+        _streamServer = std::make_unique<OsrStreamServer>();
+        __weak CefWebView* weakSelf = self;
+        // Runs on the UI thread
+        _streamServer->start(_settings.streamServerAddress, [weakSelf](const OsrStreamInput& input) {
+            CefWebView* strongSelf = weakSelf;
+            if (!strongSelf) return;
+            OsrStreamServer::DispatchToBrowser(strongSelf->_browser, input, strongSelf->_deviceScaleFactor);
+        });
+    }
 }
 
 - (std::unique_ptr<cefview::OsrRenderer>)createOsrRendererWithWidth:(int)width
@@ -338,7 +415,77 @@ static NSString* const kNSURLTitlePboardType = @"public.url-name";
 - (void)setHidden:(BOOL)hidden
 {
     [super setHidden:hidden];
+    if (!_settings.offScreenRenderingEnabled) {
+        if (_browser) {
+            _browser->GetHost()->WasHidden(hidden);
+        }
+        return;
+    }
+    _viewHidden = hidden;
+    [self updateHiddenState];
+}
+
+- (void)setOccluded:(BOOL)occluded
+{
+    if (_hostOccluded == occluded) return;
+    _hostOccluded = occluded;
+    [self updateHiddenState];
+}
+
+- (cefview::OsrSuspendStats)getSuspendStats
+{
+    return _viewScheduler.suspendStats();
+}
+
+- (void)captureAsync:(const CefRect&)rect
+               scale:(float)scale
+              format:(ImageEncoder::Format)format
+             quality:(int)quality
+            callback:(OsrCaptureCallback)callback
+{
+    // Frames are in device pixels
+    CefRect deviceRect = rect.IsEmpty() ? CefRect() : ScreenUtil::LogicalToDevice(rect, _deviceScaleFactor);
+    OsrCapture::CaptureAsync(_settings.offScreenRenderingEnabled ? _osrRenderer.get() : nullptr,
+                             deviceRect, scale, format, quality, std::move(callback));
+}
+
+- (void)printToPdf:(const CefPdfPrintSettings&)settings
+              path:(const std::string&)path
+          callback:(PdfPrintCallback)callback
+{
+    CefViewPdfPrinter::PrintToPdf(_browser, settings, path, std::move(callback));
+}
+
+- (void)setYuvFrameFormat:(OsrYuvFrame::Format)format
+                 callback:(OsrYuvFrame::FrameCallback)callback
+{
+    _yuvFrameCallback = std::move(callback);
+    if (!_yuvFrameCallback) {
+        _yuvFrame.reset();
+        return;
+    }
+    if (!_settings.cpuPaintEnabled) {
+        LOGW << "YUV frame output needs cpuPaintEnabled, no frames will be delivered";
+    }
+    // A new frame converts the whole view on the next paint
+    if (!_yuvFrame || _yuvFrame->format() != format) {
+        _yuvFrame = std::make_unique<OsrYuvFrame>(format);
+    }
     if (_browser) {
+        _browser->GetHost()->Invalidate(PET_VIEW);
+    }
+}
+
+/// Hide or show the OSR browser from visibility, occlusion and size. Hiding
+/// calls WasHidden(true) and schedules the texture release; showing restores
+/// the cached frame before CEF paints again.
+- (void)updateHiddenState
+{
+    if (!_settings.offScreenRenderingEnabled) return;
+
+    BOOL zeroSize = _settings.width <= 0 || _settings.height <= 0;
+    bool hidden = _viewHidden || _hostOccluded || _windowOccluded || zeroSize;
+    if (_viewScheduler.setHidden(hidden, _settings.hiddenSuspendDelayMs) && _browser) {
         _browser->GetHost()->WasHidden(hidden);
     }
 }
@@ -475,6 +622,7 @@ static NSString* const kNSURLTitlePboardType = @"public.url-name";
 
     if (_osrRenderer) {
         _osrRenderer->setDeviceScaleFactor(deviceScaleFactor);
+        [self updateFrameInterval];
     }
 }
 
@@ -646,8 +794,31 @@ static NSString* const kNSURLTitlePboardType = @"public.url-name";
                  height:(int)height
 {
     if (!_settings.offScreenRenderingEnabled || !_osrRenderer) return;
+    _osrRenderer->renderStats().recordPaint(dirtyRects);
+    _viewScheduler.recordPaint();
+    if (type == PET_VIEW) {
+        _viewScheduler.trackPaint(dirtyRects, width, height);
+        if (_frameRecorder) {
+            _frameRecorder->record(dirtyRects, buffer, width, height);
+        }
+        if (_frameSink) {
+            _frameSink->publish(dirtyRects, buffer, width, height);
+        }
+        if (_streamServer) {
+            _streamServer->publish(dirtyRects, buffer, width, height);
+        }
+        if (_yuvFrame && _yuvFrameCallback) {
+            const CefRenderHandler::RectList& changedRects = _yuvFrame->update(dirtyRects, buffer, width, height);
+            if (!changedRects.empty()) {
+                _yuvFrameCallback(*_yuvFrame, changedRects);
+            }
+        }
+    }
     _osrRenderer->onPaint(type, dirtyRects, buffer, width, height);
-    _osrRenderer->scheduleRender();
+    // Tile hashing may find the paint identical to what is on screen
+    if (_osrRenderer->lastPaintChanged()) {
+        _viewScheduler.requestPresent();
+    }
 }
 
 - (void)onAcceleratedPaintWithType:(CefRenderHandler::PaintElementType)type
@@ -655,8 +826,89 @@ static NSString* const kNSURLTitlePboardType = @"public.url-name";
                               info:(const CefAcceleratedPaintInfo&)info
 {
     if (!_settings.offScreenRenderingEnabled || !_osrRenderer) return;
+    _osrRenderer->renderStats().recordPaint(dirtyRects);
+    _viewScheduler.recordPaint();
+    if (type == PET_VIEW) {
+        _viewScheduler.trackPaint(dirtyRects, static_cast<int>(_settings.width * _deviceScaleFactor),
+                                  static_cast<int>(_settings.height * _deviceScaleFactor));
+    }
     _osrRenderer->onAcceleratedPaint(type, dirtyRects, info);
-    _osrRenderer->scheduleRender();
+    _viewScheduler.requestPresent();
+}
+
+- (void)onPopupShow:(BOOL)show
+{
+    if (!_settings.offScreenRenderingEnabled || !_osrRenderer) return;
+    _osrRenderer->onPopupShow(show == YES);
+    _viewScheduler.requestPresent();
+}
+
+- (void)onPopupSize:(const CefRect&)rect
+{
+    if (!_settings.offScreenRenderingEnabled || !_osrRenderer) return;
+    _osrRenderer->onPopupSize(ScreenUtil::LogicalToDevice(rect, _deviceScaleFactor));
+    _viewScheduler.requestPresent();
+}
+
+#pragma mark - Frame Pacing
+
+- (const cefview::OsrFrameScheduler&)frameScheduler
+{
+    return _viewScheduler.frameScheduler();
+}
+
+- (cefview::OsrFrameRecorder*)frameRecorder
+{
+    return _frameRecorder.get();
+}
+
+- (cefview::OsrSharedFrameSink*)frameSink
+{
+    return _frameSink.get();
+}
+
+- (cefview::OsrStreamServer*)streamServer
+{
+    return _streamServer.get();
+}
+
+- (cefview::OsrRenderStats)getRenderStats
+{
+    return _osrRenderer ? _osrRenderer->renderStats().snapshot() : OsrRenderStats();
+}
+
+/// Log the render statistics as JSON every renderStatsLogInterval seconds.
+- (void)scheduleRenderStatsLog
+{
+    if (_settings.renderStatsLogInterval <= 0) return;
+
+    int64_t delayNs = static_cast<int64_t>(_settings.renderStatsLogInterval) * NSEC_PER_SEC;
+    __weak CefWebView* weakSelf = self;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, delayNs), dispatch_get_main_queue(), ^{
+        [weakSelf logRenderStats];
+    });
+}
+
+- (void)logRenderStats
+{
+    if (!_osrRenderer) return;
+    LOGI << "OSR render stats: " << _osrRenderer->renderStats().snapshot(true).toJson();
+    if (_viewScheduler.suspendStats().hides > 0) {
+        LOGI << "OSR suspend stats: " << [self getSuspendStats].toJson();
+    }
+    [self scheduleRenderStatsLog];
+}
+
+/// Space presents by the screen refresh rate, or windowlessFrameRate when unknown.
+- (void)updateFrameInterval
+{
+    NSInteger refreshRate = 0;
+    if (@available(macOS 12.0, *)) {
+        NSScreen* screen = [[self window] screen];
+        refreshRate = screen ? [screen maximumFramesPerSecond] : 0;
+    }
+    _viewScheduler.frameScheduler().setFrameRate(refreshRate > 0 ? static_cast<double>(refreshRate)
+                                                 : static_cast<double>(_settings.windowlessFrameRate));
 }
 
 #pragma mark - Drag and Drop
@@ -818,12 +1070,14 @@ static NSString* const kNSURLTitlePboardType = @"public.url-name";
         return nil;
 
     size_t dataSize = bitmapData->GetSize();
-    std::vector<unsigned char> buffer(dataSize);
-    bitmapData->GetData(&buffer[0], dataSize, 0);
+    PixelBuffer buffer = PixelBufferPool::Shared().acquire(dataSize);
+    if (!buffer)
+        return nil;
+    bitmapData->GetData(buffer.data(), dataSize, 0);
 
     CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
     CGContextRef context = CGBitmapContextCreate(
-        &buffer[0], pixelWidth, pixelHeight, 8, pixelWidth * 4, colorSpace,
+        buffer.data(), pixelWidth, pixelHeight, 8, pixelWidth * 4, colorSpace,
         kCGImageAlphaPremultipliedLast | kCGBitmapByteOrder32Big);
 
     if (!context) {
@@ -1097,6 +1351,7 @@ static NSString* const kNSURLTitlePboardType = @"public.url-name";
                 button:(CefBrowserHost::MouseButtonType)type
                   isUp:(bool)isUp {
     if (!_browser) return;
+    _viewScheduler.trackInput();
 
     CefMouseEvent mouseEvent = [self createCefMouseEventFromNSEvent:event];
     _browser->GetHost()->SendMouseClickEvent(
@@ -1146,6 +1401,7 @@ static NSString* const kNSURLTitlePboardType = @"public.url-name";
 
 - (void)mouseMoved:(NSEvent*)event {
     if (!_browser) return;
+    _viewScheduler.trackInput();
 
     CefMouseEvent cefEvent = [self createCefMouseEventFromNSEvent:event];
     _browser->GetHost()->SendMouseMoveEvent(cefEvent, false);
@@ -1190,6 +1446,7 @@ static NSString* const kNSURLTitlePboardType = @"public.url-name";
 - (void)sendScrollWheelEvent:(NSEvent*)event
 {
     if (!_browser) return;
+    _viewScheduler.trackInput();
 
     CGEventRef cgEvent = [event CGEvent];
     DCHECK(cgEvent);
@@ -1263,6 +1520,7 @@ static NSString* const kNSURLTitlePboardType = @"public.url-name";
 - (void)keyDown:(NSEvent*)event
 {
     if (!_browser || !_textInputContextOsrMac) return;
+    _viewScheduler.trackInput();
 
     if ([event type] != NSEventTypeFlagsChanged) {
         if (_textInputClient) {
@@ -1277,6 +1535,7 @@ static NSString* const kNSURLTitlePboardType = @"public.url-name";
 - (void)keyUp:(NSEvent*)event
 {
     if (!_browser) return;
+    _viewScheduler.trackInput();
 
     CefKeyEvent cefEvent = [self createCefKeyEventFromNSEvent:event];
     cefEvent.type = KEYEVENT_KEYUP;
@@ -1677,6 +1936,7 @@ static NSString* const kNSURLTitlePboardType = @"public.url-name";
     _settings.height = height;
 
     if (_settings.offScreenRenderingEnabled) {
+        [self updateHiddenState];
         if (_osrRenderer) {
             _osrRenderer->setBounds(0, 0, width, height);
         }
@@ -1690,24 +1950,41 @@ static NSString* const kNSURLTitlePboardType = @"public.url-name";
     }
 }
 
+/// Tell CEF the view was resized, at most once per resizeThrottleMs. The
+/// renderer keeps drawing the last frame until CEF paints at the new size.
 - (void)scheduleBrowserResize
 {
-    if (_resizeDebounceTimer) {
-        [_resizeDebounceTimer invalidate];
-        _resizeDebounceTimer = nil;
+    auto now = OsrFrameScheduler::Clock::now();
+    if (_settings.resizeThrottleMs <= 0) {
+        [self performBrowserResizeAt:now];
+        return;
     }
 
-    __weak CefWebView* weakSelf = self;
-    _resizeDebounceTimer = [NSTimer scheduledTimerWithTimeInterval:0.3
-                                                          repeats:NO
-                                                            block:^(NSTimer* timer) {
-        [weakSelf performBrowserResize];
-    }];
+    OsrFrameScheduler::Duration delay{};
+    switch (_resizeScheduler.onFrameRequested(now, delay)) {
+        case OsrFrameScheduler::Decision::kPresentNow:
+            [self performBrowserResizeAt:now];
+            break;
+        case OsrFrameScheduler::Decision::kSchedule: {
+            // The trailing notification picks up the latest size
+            int64_t delayNs = std::chrono::duration_cast<std::chrono::nanoseconds>(delay).count();
+            __weak CefWebView* weakSelf = self;
+            dispatch_after(dispatch_time(DISPATCH_TIME_NOW, delayNs), dispatch_get_main_queue(), ^{
+                CefWebView* strongSelf = weakSelf;
+                if (strongSelf && strongSelf->_resizeScheduler.isPending()) {
+                    [strongSelf performBrowserResizeAt:OsrFrameScheduler::Clock::now()];
+                }
+            });
+            break;
+        }
+        case OsrFrameScheduler::Decision::kCoalesced:
+            break;
+    }
 }
 
-- (void)performBrowserResize
+- (void)performBrowserResizeAt:(OsrFrameScheduler::TimePoint)now
 {
-    _resizeDebounceTimer = nil;
+    _resizeScheduler.onFramePresented(now);
     if (!_browser) return;
 
     _browser->GetHost()->WasResized();
@@ -1726,12 +2003,30 @@ static NSString* const kNSURLTitlePboardType = @"public.url-name";
     NSWindow* window = [self window];
     if (window) {
         [self setDeviceScaleFactor:static_cast<float>([window backingScaleFactor])];
+        [self updateFrameInterval];
 
         // Observe backing scale factor changes
         [[NSNotificationCenter defaultCenter] addObserver:self
                                                  selector:@selector(windowDidChangeBackingProperties:)
                                                      name:NSWindowDidChangeBackingPropertiesNotification
                                                    object:window];
+
+        // Suspend the OSR view while its window is covered or minimized
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(windowDidChangeOcclusionState:)
+                                                     name:NSWindowDidChangeOcclusionStateNotification
+                                                   object:window];
+        _windowOccluded = ([window occlusionState] & NSWindowOcclusionStateVisible) == 0;
+        [self updateHiddenState];
+    }
+}
+
+- (void)windowDidChangeOcclusionState:(NSNotification*)notification
+{
+    NSWindow* window = [notification object];
+    if (window) {
+        _windowOccluded = ([window occlusionState] & NSWindowOcclusionStateVisible) == 0;
+        [self updateHiddenState];
     }
 }
 
@@ -1743,6 +2038,7 @@ static NSString* const kNSURLTitlePboardType = @"public.url-name";
         if (newScaleFactor != _deviceScaleFactor) {
             [self setDeviceScaleFactor:newScaleFactor];
         }
+        [self updateFrameInterval];
     }
 }
 
@@ -1753,6 +2049,9 @@ static NSString* const kNSURLTitlePboardType = @"public.url-name";
         [[NSNotificationCenter defaultCenter] removeObserver:self
                                                         name:NSWindowDidChangeBackingPropertiesNotification
                                                       object:oldWindow];
+        [[NSNotificationCenter defaultCenter] removeObserver:self
+                                                        name:NSWindowDidChangeOcclusionStateNotification
+                                                      object:oldWindow];
     }
 }
 
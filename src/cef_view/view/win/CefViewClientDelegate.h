@@ -18,6 +18,7 @@
 
 #include "client/CefViewClient.h"
 #include "client/CefViewClientDelegateInterface.h"
+#include "client/CefViewMessageRegistry.h"
 
 namespace cefview {
 class CefWebView;
@@ -28,7 +29,15 @@ public:
     CefViewClientDelegate(CefWebView* view);
     ~CefViewClientDelegate();
 
+    /**
+     * @brief Registry used to dispatch process messages from the render process.
+     * Register additional handlers here to extend the message set.
+     */
+    CefViewMessageRegistry& messageRegistry() { return _messageRegistry; }
+
 protected:
+    void registerMessageHandlers();
+
 #pragma region CefClient
     virtual bool onProcessMessageReceived(CefRefPtr<CefBrowser> browser,
                                           CefRefPtr<CefFrame> frame,
@@ -199,6 +208,7 @@ protected:
     CefString                               _url;
     bool                                    _isDevtoolsOpened{false};
     std::shared_ptr<CefJsBridgeBrowser>     _jsBridgeBrowser{nullptr};
+    CefViewMessageRegistry                  _messageRegistry;
 };
 }
 
@@ -18,7 +18,9 @@
 #include "OsrRendererD3D11.h"
 #include "WinUtil.h"
 #include "client/CefViewClient.h"
+#include "osr/OsrCompositorGL.h"
 #include "osr/OsrRenderer.h"
+#include "osr/OsrRendererGL.h"
 #include "utils/LogUtil.h"
 #include "utils/ScreenUtil.h"
 #include "utils/util.h"
@@ -228,11 +230,12 @@ void CefWebView::destroy() {
         ::RevokeDragDrop(_hwnd);
         _dropTarget = nullptr;
 
-        // Release D3D11 renderer
+        // Release the renderer; a composited one leaves its compositor
         if (_osrRenderer) {
             _osrRenderer->uninitialize();
             _osrRenderer.reset();
         }
+        _glRenderer = nullptr;
 
         _imeHandler.reset();
 
@@ -299,9 +302,45 @@ void CefWebView::initOsrRenderer() {
     _osrRenderer = createOsrRenderer();
     if (_osrRenderer && !_osrRenderer->initialize()) {
         _osrRenderer.reset();
+        _glRenderer = nullptr;
         return;
     }
     _osrRenderer->setDeviceScaleFactor(_deviceScaleFactor);
+    _osrRenderer->setTileHashEnabled(_settings.tileHashEnabled);
+    _osrRenderer->setResizeMode(_settings.resizeCropEnabled ? OsrRenderer::ResizeMode::kCrop
+                                                            : OsrRenderer::ResizeMode::kStretch);
+    if (_settings.resizeThrottleMs > 0) {
+        _resizeScheduler.setFrameRate(1000.0 / _settings.resizeThrottleMs);
+    }
+    OsrViewScheduler::Host host;
+    host.renderer = [this] { return _osrRenderer.get(); };
+    host.postDelayedTask = [this](OsrViewScheduler::Task task, OsrViewScheduler::Duration delay) {
+        // Not owned by a shared_ptr: a deferred task could outlive us
+        std::weak_ptr<CefWebView> weakSelf = weak_from_this();
+        if (weakSelf.expired()) return false;
+        int64_t delayMs = std::chrono::duration_cast<std::chrono::milliseconds>(delay).count();
+        CefPostDelayedTask(TID_UI, base::BindOnce([](std::weak_ptr<CefWebView> weakSelf, OsrViewScheduler::Task task) {
+                if (weakSelf.lock()) {
+                    task();
+                }
+            }, weakSelf, std::move(task)), delayMs > 0 ? delayMs : 1);
+        return true;
+    };
+    host.setFrameRate = [this](int framesPerSecond) {
+        if (_browser) {
+            _browser->GetHost()->SetWindowlessFrameRate(framesPerSecond);
+        }
+    };
+    _viewScheduler.setHost(std::move(host));
+    updateFrameInterval();
+    if (_settings.adaptiveFrameRateEnabled) {
+        _viewScheduler.setAdaptiveFrameRate(_settings.minFrameRate, _settings.windowlessFrameRate);
+    }
+
+    if (_settings.frameRecorderSeconds > 0) {
+        size_t maxBytes = _settings.frameRecorderMaxMB > 0 ? static_cast<size_t>(_settings.frameRecorderMaxMB) << 20 : 0;
+        _frameRecorder = std::make_unique<OsrFrameRecorder>(_settings.frameRecorderSeconds, maxBytes);
+    }
 
     _dragEvents = std::make_shared<OsrDragEventsImpl>(this);
     _dropTarget = OsrDropTargetWin::Create(_dragEvents.get(), _hwnd);
@@ -317,6 +356,12 @@ void CefWebView::initOsrRenderer() {
 }
 
 std::unique_ptr<OsrRenderer> CefWebView::createOsrRenderer() {
+    if (_settings.openGLRendererEnabled) {
+        auto renderer = std::make_unique<OsrRendererGL>(_hwnd, _settings.width, _settings.height,
+                                                        _settings.transparentPaintingEnabled);
+        _glRenderer = renderer.get();
+        return renderer;
+    }
     return std::make_unique<OsrRendererD3D11>(_hwnd, _settings.width, _settings.height, _settings.transparentPaintingEnabled);
 }
 
@@ -336,7 +381,7 @@ void CefWebView::createCefBrowser()
     if (_settings.offScreenRenderingEnabled) {
         // Off-screen rendering mode
         windowInfo.SetAsWindowless(_hwnd);
-        windowInfo.shared_texture_enabled = true;
+        windowInfo.shared_texture_enabled = !_settings.cpuPaintRequired();
     }
     else {
         // Native window mode
@@ -386,11 +431,8 @@ void CefWebView::setBounds(int left, int top, int width, int height)
 
     if (_settings.offScreenRenderingEnabled) {
         // OSR mode: notify CEF about the resize so it can re-render
-        if (_browser) {
-            _browser->GetHost()->WasResized();
-            if (sizeChanged) {
-                _browser->GetHost()->Invalidate(PET_VIEW);
-            }
+        if (sizeChanged) {
+            requestBrowserResize();
         }
     } else {
         // Windowed mode: resize the CEF child window directly
@@ -418,7 +460,8 @@ void CefWebView::setVisible(bool bVisible /*= true*/)
 
     if (_settings.offScreenRenderingEnabled) {
         // WasHidden is only valid for windowless (OSR) browsers.
-        _browser->GetHost()->WasHidden(!bVisible);
+        _visible = bVisible;
+        updateHiddenState();
     } else {
         // For windowed browsers, show/hide the CEF child window directly.
         HWND hwnd = getBrowserWindowHandle();
@@ -749,6 +792,8 @@ void CefWebView::setDeviceScaleFactor(float deviceScaleFactor)
 
     if (_osrRenderer) {
         _osrRenderer->setDeviceScaleFactor(deviceScaleFactor);
+        // A DPI change usually means the window moved to another monitor
+        updateFrameInterval();
     }
 }
 
@@ -857,8 +902,25 @@ void CefWebView::onPaint(CefRenderHandler::PaintElementType type,
                          int height)
 {
     if (!_settings.offScreenRenderingEnabled || !_osrRenderer) return;
+    _osrRenderer->renderStats().recordPaint(dirtyRects);
+    _viewScheduler.recordPaint();
+    if (type == PET_VIEW) {
+        _viewScheduler.trackPaint(dirtyRects, width, height);
+        if (_frameRecorder) {
+            _frameRecorder->record(dirtyRects, buffer, width, height);
+        }
+        if (_yuvFrame && _yuvFrameCallback) {
+            const CefRenderHandler::RectList& changedRects = _yuvFrame->update(dirtyRects, buffer, width, height);
+            if (!changedRects.empty()) {
+                _yuvFrameCallback(*_yuvFrame, changedRects);
+            }
+        }
+    }
     _osrRenderer->onPaint(type, dirtyRects, buffer, width, height);
-    _osrRenderer->scheduleRender();
+    // Tile hashing may find the paint identical to what is on screen
+    if (_osrRenderer->lastPaintChanged()) {
+        _viewScheduler.requestPresent();
+    }
 }
 
 void CefWebView::onAcceleratedPaint(CefRenderHandler::PaintElementType type,
@@ -866,13 +928,148 @@ void CefWebView::onAcceleratedPaint(CefRenderHandler::PaintElementType type,
                                     const CefAcceleratedPaintInfo& info)
 {
     if (!_settings.offScreenRenderingEnabled || !_osrRenderer) return;
+    _osrRenderer->renderStats().recordPaint(dirtyRects);
+    _viewScheduler.recordPaint();
+    if (type == PET_VIEW) {
+        _viewScheduler.trackPaint(dirtyRects, _clientRect.right - _clientRect.left, _clientRect.bottom - _clientRect.top);
+    }
     _osrRenderer->onAcceleratedPaint(type, dirtyRects, info);
-    _osrRenderer->scheduleRender();
+    _viewScheduler.requestPresent();
+}
+
+void CefWebView::onPopupShow(bool show)
+{
+    if (!_settings.offScreenRenderingEnabled || !_osrRenderer) return;
+    _osrRenderer->onPopupShow(show);
+    _viewScheduler.requestPresent();
+}
+
+void CefWebView::onPopupSize(const CefRect& rect)
+{
+    if (!_settings.offScreenRenderingEnabled || !_osrRenderer) return;
+    _osrRenderer->onPopupSize(ScreenUtil::LogicalToDevice(rect, _deviceScaleFactor));
+    _viewScheduler.requestPresent();
+}
+
+OsrRenderStats CefWebView::getRenderStats() const
+{
+    return _osrRenderer ? _osrRenderer->renderStats().snapshot() : OsrRenderStats();
 }
 
-// void onPopupShow(bool show);
+void CefWebView::scheduleRenderStatsLog()
+{
+    if (_settings.renderStatsLogInterval <= 0) return;
+    std::weak_ptr<CefWebView> weakSelf = weak_from_this();
+    if (weakSelf.expired()) {
+        LOGW << "renderStatsLogInterval ignored: the view is not owned by a shared_ptr";
+        return;
+    }
+
+    CefPostDelayedTask(TID_UI, base::BindOnce([](std::weak_ptr<CefWebView> weakSelf) {
+            if (auto self = weakSelf.lock()) {
+                self->logRenderStats();
+            }
+        }, weakSelf), static_cast<int64_t>(_settings.renderStatsLogInterval) * 1000);
+}
+
+void CefWebView::logRenderStats()
+{
+    if (!_osrRenderer) return;
+    LOGI << "OSR render stats: " << _osrRenderer->renderStats().snapshot(true).toJson();
+    if (_viewScheduler.suspendStats().hides > 0) {
+        LOGI << "OSR suspend stats: " << getSuspendStats().toJson();
+    }
+    scheduleRenderStatsLog();
+}
+
+void CefWebView::captureAsync(const CefRect& rect,
+                              float scale,
+                              ImageEncoder::Format format,
+                              OsrCaptureCallback callback,
+                              int quality)
+{
+    // Frames are in device pixels
+    CefRect deviceRect = rect.IsEmpty() ? CefRect() : ScreenUtil::LogicalToDevice(rect, _deviceScaleFactor);
+    OsrCapture::CaptureAsync(_settings.offScreenRenderingEnabled ? _osrRenderer.get() : nullptr,
+                             deviceRect, scale, format, quality, std::move(callback));
+}
 
-// void onPopupSize(const CefRect &rect);
+bool CefWebView::attachToCompositor(const std::shared_ptr<OsrCompositorGL>& compositor, const CefRect& bounds, int zOrder)
+{
+    if (!_glRenderer || !compositor) {
+        LOGE << "attachToCompositor() needs an OSR view with openGLRendererEnabled";
+        return false;
+    }
+    if (!compositor->addLayer(_glRenderer, bounds, zOrder)) {
+        return false;
+    }
+    _compositor = compositor;
+    return true;
+}
+
+void CefWebView::detachFromCompositor()
+{
+    if (auto compositor = _compositor.lock()) {
+        if (_glRenderer) {
+            compositor->removeLayer(_glRenderer);
+        }
+    }
+    _compositor.reset();
+    if (_osrRenderer) {
+        _osrRenderer->render();
+    }
+}
+
+void CefWebView::printToPdf(const CefPdfPrintSettings& settings, const std::string& path, PdfPrintCallback callback)
+{
+    CefViewPdfPrinter::PrintToPdf(_browser, settings, path, std::move(callback));
+}
+
+void CefWebView::setYuvFrameCallback(OsrYuvFrame::Format format, OsrYuvFrame::FrameCallback callback)
+{
+    _yuvFrameCallback = std::move(callback);
+    if (!_yuvFrameCallback) {
+        _yuvFrame.reset();
+        return;
+    }
+    if (!_settings.cpuPaintEnabled) {
+        LOGW << "YUV frame output needs cpuPaintEnabled, no frames will be delivered";
+    }
+    // A new frame converts the whole view on the next paint
+    if (!_yuvFrame || _yuvFrame->format() != format) {
+        _yuvFrame = std::make_unique<OsrYuvFrame>(format);
+    }
+    if (_browser) {
+        _browser->GetHost()->Invalidate(PET_VIEW);
+    }
+}
+
+void CefWebView::setOccluded(bool occluded)
+{
+    if (!_settings.offScreenRenderingEnabled || _occluded == occluded) return;
+    _occluded = occluded;
+    updateHiddenState();
+}
+
+OsrSuspendStats CefWebView::getSuspendStats() const
+{
+    return _viewScheduler.suspendStats();
+}
+
+void CefWebView::updateHiddenState()
+{
+    bool zeroSize = _clientRect.right <= _clientRect.left || _clientRect.bottom <= _clientRect.top;
+    bool hidden = !_visible || _occluded || zeroSize;
+    if (_viewScheduler.setHidden(hidden, _settings.hiddenSuspendDelayMs) && _browser) {
+        _browser->GetHost()->WasHidden(hidden);
+    }
+}
+
+void CefWebView::updateFrameInterval()
+{
+    int refreshRate = WinUtil::GetWindowRefreshRate(_hwnd);
+    _viewScheduler.frameScheduler().setFrameRate(refreshRate > 0 ? refreshRate : _settings.windowlessFrameRate);
+}
 
 bool CefWebView::startDragging(CefRefPtr<CefDragData> dragData, CefRenderHandler::DragOperationsMask allowedOps, int x, int y)
 {
@@ -979,6 +1176,12 @@ void CefWebView::onAfterCreated(int browserId)
         _browser = _client->GetBrowser();
     }
 
+    // Not from initOsrRenderer(): weak_from_this() is still empty in the constructor
+    if (_osrRenderer && !_renderStatsLogStarted) {
+        _renderStatsLogStarted = true;
+        scheduleRenderStatsLog();
+    }
+
     for (auto& task : _taskListAfterCreated) {
         if (task) {
             task();
@@ -1029,6 +1232,7 @@ bool CefWebView::onMouseEvent(UINT message, WPARAM wParam, LPARAM lParam) {
     if (!_settings.offScreenRenderingEnabled || WinUtil::IsMouseEventFromTouch(message)) {
         return false;
     }
+    _viewScheduler.trackInput();
 
     CefRefPtr<CefBrowserHost> browserHost;
     if (_browser) {
@@ -1205,6 +1409,8 @@ void CefWebView::onSize() {
     if (!_settings.offScreenRenderingEnabled) return;
 
     ::GetClientRect(_hwnd, &_clientRect);
+    // A minimized window has an empty client rect
+    updateHiddenState();
 
     int width = _clientRect.right - _clientRect.left;
     int height = _clientRect.bottom - _clientRect.top;
@@ -1214,15 +1420,59 @@ void CefWebView::onSize() {
         _osrRenderer->setBounds(0, 0, width, height);
     }
 
-    // Notify CEF browser about size change
-    if (_browser) {
-        _browser->GetHost()->WasResized();
-        // 离屏模式cef会有一些丢帧行为，导致最后桢可能渲染不完全，加一个延时标脏的行为使其渲染
-        // https://github.com/cefsharp/CefSharp/issues/4953
-        CefPostDelayedTask(TID_UI, base::BindOnce([](CefRefPtr<CefBrowser> browser) {
-                browser->GetHost()->Invalidate(CefBrowserHost::PaintElementType::PET_VIEW);
-            }, _browser), 200);
+    // Notify CEF browser about size change; the renderer keeps drawing the
+    // last frame until CEF paints at the new size
+    requestBrowserResize();
+}
+
+void CefWebView::requestBrowserResize()
+{
+    if (!_browser) return;
+
+    auto now = OsrFrameScheduler::Clock::now();
+    if (_settings.resizeThrottleMs <= 0) {
+        notifyBrowserResized(now);
+        return;
     }
+
+    OsrFrameScheduler::Duration delay{};
+    switch (_resizeScheduler.onFrameRequested(now, delay)) {
+    case OsrFrameScheduler::Decision::kPresentNow:
+        notifyBrowserResized(now);
+        break;
+    case OsrFrameScheduler::Decision::kSchedule: {
+        std::weak_ptr<CefWebView> weakSelf = weak_from_this();
+        if (weakSelf.expired()) {
+            notifyBrowserResized(now);
+            break;
+        }
+        // The trailing notification picks up the latest size
+        int64_t delayMs = std::chrono::duration_cast<std::chrono::milliseconds>(delay).count();
+        CefPostDelayedTask(TID_UI, base::BindOnce([](std::weak_ptr<CefWebView> weakSelf) {
+                if (auto self = weakSelf.lock()) {
+                    if (self->_resizeScheduler.isPending()) {
+                        self->notifyBrowserResized(OsrFrameScheduler::Clock::now());
+                    }
+                }
+            }, weakSelf), delayMs > 0 ? delayMs : 1);
+        break;
+    }
+    case OsrFrameScheduler::Decision::kCoalesced:
+        break;
+    }
+}
+
+void CefWebView::notifyBrowserResized(OsrFrameScheduler::TimePoint now)
+{
+    _resizeScheduler.onFramePresented(now);
+    if (!_browser) return;
+
+    _browser->GetHost()->WasResized();
+    // 离屏模式cef会有一些丢帧行为，导致最后桢可能渲染不完全，加一个延时标脏的行为使其渲染
+    // https://github.com/cefsharp/CefSharp/issues/4953
+    CefPostDelayedTask(TID_UI, base::BindOnce([](CefRefPtr<CefBrowser> browser) {
+            browser->GetHost()->Invalidate(CefBrowserHost::PaintElementType::PET_VIEW);
+        }, _browser), 200);
 }
 
 void CefWebView::onFocus(bool setFocus) {
@@ -1242,6 +1492,7 @@ void CefWebView::onCaptureLost() {
 }
 
 void CefWebView::onKeyEvent(UINT message, WPARAM wParam, LPARAM lParam) {
+    _viewScheduler.trackInput();
     // Handle shortcut keys for key down events
     if (message == WM_KEYDOWN || message == WM_SYSKEYDOWN) {
         uint32_t modifiers = WinUtil::GetCefKeyboardModifiers(wParam, lParam);
@@ -1329,6 +1580,7 @@ void CefWebView::onPaint() {
 
 bool CefWebView::onTouchEvent(UINT message, WPARAM wParam, LPARAM lParam) {
     if (!_settings.offScreenRenderingEnabled) return false;
+    _viewScheduler.trackInput();
 
     // Handle touch events on Windows.
     int numPoints = LOWORD(wParam);
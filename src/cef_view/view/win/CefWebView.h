@@ -22,13 +22,22 @@
 #include "include/cef_browser.h"
 #include "include/cef_client.h"
 
+#include "client/CefViewPdfPrinter.h"
+#include "osr/OsrCapture.h"
+#include "osr/OsrFrameRecorder.h"
+#include "osr/OsrFrameScheduler.h"
+#include "osr/OsrRenderStats.h"
+#include "osr/OsrViewScheduler.h"
+#include "osr/OsrYuvFrame.h"
 #include "view/CefWebViewSetting.h"
 
 namespace cefview {
 
 class CefViewClientDelegate;
 class CefViewClient;
+class OsrCompositorGL;
 class OsrRenderer;
+class OsrRendererGL;
 class OsrDragEvents;
 class OsrDropTargetWin;
 class OsrImeHandlerWin;
@@ -281,6 +290,18 @@ public:
                             const CefRenderHandler::RectList& dirtyRects,
                             const CefAcceleratedPaintInfo& info);
 
+    /**
+     * @brief Handle CEF OnPopupShow callback for popup widgets (e.g. <select> dropdowns)
+     * @param[in] show true to show the popup, false to hide it
+     */
+    void onPopupShow(bool show);
+
+    /**
+     * @brief Handle CEF OnPopupSize callback
+     * @param[in] rect Popup rectangle in view coordinates (logical pixels)
+     */
+    void onPopupSize(const CefRect& rect);
+
     /**
      * @brief Start a drag operation
      * @param[in] dragData Data being dragged
@@ -434,6 +455,94 @@ public:
      * @return true if focus is on an editable field
      */
     bool isEditableFocused() const { return _editableFocused; }
+
+    /**
+     * @brief Frame pacing state for OSR presents (presented/skipped counts)
+     */
+    const OsrFrameScheduler& frameScheduler() const { return _viewScheduler.frameScheduler(); }
+
+    /**
+     * @brief Off-screen renderer: OsrRendererD3D11, or OsrRendererGL with openGLRendererEnabled
+     * @return nullptr in windowed mode or before the browser is created
+     */
+    OsrRenderer* osrRenderer() const { return _osrRenderer.get(); }
+
+    /**
+     * @brief Present this view through a compositor shared with other views (OSR)
+     * Needs CefWebViewSetting::openGLRendererEnabled. The view keeps taking
+     * paints and input; the compositor draws it into its own window.
+     * @param[in] compositor Initialized compositor
+     * @param[in] bounds Layer rect in the compositor window's pixels
+     * @param[in] zOrder Higher values are drawn on top
+     * @return false without an OpenGL renderer or if the compositor refuses the layer
+     */
+    bool attachToCompositor(const std::shared_ptr<OsrCompositorGL>& compositor, const CefRect& bounds, int zOrder = 0);
+
+    /**
+     * @brief Present to the view's own window again
+     */
+    void detachFromCompositor();
+
+    /**
+     * @brief Flight recorder of recent view paints, e.g. to dump the last seconds for a bug report
+     * @return nullptr unless CefWebViewSetting::frameRecorderSeconds is set (OSR only)
+     */
+    OsrFrameRecorder* frameRecorder() const { return _frameRecorder.get(); }
+
+    /**
+     * @brief OSR rendering statistics since view creation or the last periodic log
+     * @return Zeroed statistics when no off-screen renderer exists
+     */
+    OsrRenderStats getRenderStats() const;
+
+    /**
+     * @brief Host hint that the view is fully covered (OSR)
+     * A covered view is suspended like a hidden one.
+     * @param[in] occluded true when no part of the view is visible
+     */
+    void setOccluded(bool occluded);
+
+    /**
+     * @brief What suspending this view while hidden has saved so far
+     */
+    OsrSuspendStats getSuspendStats() const;
+
+    /**
+     * @brief Capture the view as a PNG, JPEG or BMP image without blocking the UI thread (OSR)
+     * Only the frame read-back runs here; scaling and encoding run on a CEF worker
+     * thread. The callback runs on the UI thread, also when the capture fails
+     * (e.g. in windowed mode). Popups are not captured.
+     * @param[in] rect Region in view coordinates (DIP); empty captures the whole view
+     * @param[in] scale Output size relative to the region in device pixels, in (0, 1]
+     * @param[in] format Output image format
+     * @param[in] callback Receives the encoded image
+     * @param[in] quality JPEG quality, 1 to 100
+     */
+    void captureAsync(const CefRect& rect,
+                      float scale,
+                      ImageEncoder::Format format,
+                      OsrCaptureCallback callback,
+                      int quality = 90);
+
+    /**
+     * @brief Print the page to a PDF file without blocking the UI thread
+     * Works in windowed and OSR mode. The callback runs on the UI thread, also
+     * when the export fails (e.g. before the browser is created).
+     * @param[in] settings Paper size, margins, scale, backgrounds, header/footer
+     * @param[in] path File to write
+     * @param[in] callback Receives the outcome and the path
+     */
+    void printToPdf(const CefPdfPrintSettings& settings, const std::string& path, PdfPrintCallback callback);
+
+    /**
+     * @brief Receive each view paint as an I420 or NV12 frame (OSR)
+     * Only the dirty rects are converted, into a frame kept across paints; the
+     * callback runs on the UI thread inside OnPaint. Paints only reach the CPU
+     * when CefWebViewSetting::cpuPaintEnabled is set at creation.
+     * @param[in] format Plane layout of the frame
+     * @param[in] callback Receives the frame and the rects that changed; nullptr stops the output
+     */
+    void setYuvFrameCallback(OsrYuvFrame::Format format, OsrYuvFrame::FrameCallback callback);
 protected:
     static LRESULT CALLBACK windowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
 
@@ -454,6 +563,40 @@ protected:
      */
     virtual std::unique_ptr<OsrRenderer> createOsrRenderer();
 
+    /**
+     * @brief Post logRenderStats() after renderStatsLogInterval seconds (no-op when 0)
+     * Needs the view to be owned by a shared_ptr, so it starts in onAfterCreated().
+     */
+    void scheduleRenderStatsLog();
+
+    /**
+     * @brief Log the render statistics as JSON, start a new window and reschedule
+     */
+    void logRenderStats();
+
+    /**
+     * @brief Tell CEF the view was resized, at most once per resizeThrottleMs
+     */
+    void requestBrowserResize();
+
+    /**
+     * @brief Send WasResized and schedule the follow-up repaint
+     */
+    void notifyBrowserResized(OsrFrameScheduler::TimePoint now);
+
+    /**
+     * @brief Hide or show the OSR browser from visibility, occlusion and size
+     * Hiding calls WasHidden(true) and schedules the texture release; showing
+     * restores the cached frame before CEF paints again.
+     */
+    void updateHiddenState();
+
+    /**
+     * @brief Update the frame interval from the monitor refresh rate
+     * Falls back to windowlessFrameRate when the refresh rate is unknown.
+     */
+    void updateFrameInterval();
+
     void destroy();
 
     CefRefPtr<CefBrowser> getBrowser() const;
@@ -494,6 +637,18 @@ protected:
 
     // OSR renderer
     std::unique_ptr<OsrRenderer> _osrRenderer;
+    OsrRendererGL* _glRenderer = nullptr;  // _osrRenderer when it is an OsrRendererGL
+    std::weak_ptr<OsrCompositorGL> _compositor;
+    std::unique_ptr<OsrFrameRecorder> _frameRecorder;
+    std::unique_ptr<OsrYuvFrame> _yuvFrame;
+    OsrYuvFrame::FrameCallback _yuvFrameCallback;
+    OsrViewScheduler _viewScheduler;  // Present pacing, adaptive frame rate, hidden suspension
+    OsrFrameScheduler _resizeScheduler;  // Throttles WasResized during live resize
+    bool _renderStatsLogStarted = false;
+
+    // Visibility tracking (OSR)
+    bool _visible = true;
+    bool _occluded = false;
 
     // Task queue to execute after browser is created
     using StdClosure = std::function<void(void)>;
@@ -0,0 +1,298 @@
+/**
+ * @file cefview_frame_reader.c
+ * @brief C reader for OSR frames exported over shared memory
+ *
+ * This file is part of CefView project.
+ * Licensed under BSD-style license.
+ */
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include "cefview_frame_reader.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+/* Longest single sleep in cvf_wait(), so a dead writer is noticed */
+#define CVF_WAIT_SLICE_MS 100
+/* Attempts before giving up on a slot the writer keeps overwriting */
+#define CVF_ACQUIRE_ATTEMPTS 64
+
+struct cvf_reader {
+    char* name;
+    const cvf_header* header;
+    size_t bytes;
+};
+
+static uint32_t load32(const uint32_t* value) {
+    return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+}
+
+static uint64_t load64(const uint64_t* value) {
+    return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+}
+
+static int32_t load32_relaxed(const int32_t* value) {
+    return __atomic_load_n(value, __ATOMIC_RELAXED);
+}
+
+static uint32_t loadu32_relaxed(const uint32_t* value) {
+    return __atomic_load_n(value, __ATOMIC_RELAXED);
+}
+
+static int64_t now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static void unmap(cvf_reader* reader) {
+    if (reader->header) {
+        munmap((void*)reader->header, reader->bytes);
+        reader->header = NULL;
+        reader->bytes = 0;
+    }
+}
+
+/* Map the segment currently under the reader's name; 0 on success, errno otherwise */
+static int map_segment(cvf_reader* reader) {
+    int fd = shm_open(reader->name, O_RDONLY, 0);
+    if (fd < 0) {
+        return errno;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        int error = errno;
+        close(fd);
+        return error;
+    }
+    if (st.st_size < (off_t)sizeof(cvf_header)) {
+        close(fd);
+        return EAGAIN;
+    }
+    size_t bytes = (size_t)st.st_size;
+    void* mapping = mmap(NULL, bytes, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        return errno;
+    }
+
+    const cvf_header* header = (const cvf_header*)mapping;
+    /* The writer stores magic last: until then the segment is being set up */
+    int error = 0;
+    if (load32(&header->magic) != CVF_MAGIC) {
+        error = EAGAIN;
+    } else if (header->version != CVF_VERSION || header->header_bytes < sizeof(cvf_header) ||
+               header->format != CVF_FORMAT_BGRA || header->segment_bytes > bytes) {
+        error = EPROTO;
+    } else {
+        for (int i = 0; i < CVF_SLOT_COUNT; ++i) {
+            if (header->slots[i].data_offset > header->segment_bytes ||
+                header->slot_bytes > header->segment_bytes - header->slots[i].data_offset) {
+                error = EPROTO;
+            }
+        }
+    }
+    if (error) {
+        munmap(mapping, bytes);
+        return error;
+    }
+
+    unmap(reader);
+    reader->header = header;
+    reader->bytes = bytes;
+    return 0;
+}
+
+/* Follow the writer to a new segment once the mapped one is closed */
+static int ensure_live(cvf_reader* reader) {
+    if (load32(&reader->header->state) != CVF_STATE_CLOSED) {
+        return CVF_OK;
+    }
+    if (map_segment(reader) != 0 || load32(&reader->header->state) == CVF_STATE_CLOSED) {
+        return CVF_CLOSED;
+    }
+    return CVF_OK;
+}
+
+static int writer_alive(const cvf_header* header) {
+    pid_t pid = (pid_t)header->writer_pid;
+    return pid <= 0 || kill(pid, 0) == 0 || errno != ESRCH;
+}
+
+static void wait_on(const uint32_t* word, uint32_t expected, int timeout_ms) {
+#if defined(__linux__)
+    struct timespec ts;
+    ts.tv_sec = timeout_ms / 1000;
+    ts.tv_nsec = (long)(timeout_ms % 1000) * 1000000L;
+    /* Not FUTEX_PRIVATE_FLAG: the word is shared with the writer process */
+    syscall(SYS_futex, word, FUTEX_WAIT, expected, &ts, NULL, 0);
+#else
+    (void)timeout_ms;
+    struct timespec ts = {0, 1000000L};
+    while (load32(word) == expected && timeout_ms-- > 0) {
+        nanosleep(&ts, NULL);
+    }
+#endif
+}
+
+cvf_reader* cvf_open(const char* name) {
+    if (!name || !*name) {
+        errno = EINVAL;
+        return NULL;
+    }
+    cvf_reader* reader = (cvf_reader*)calloc(1, sizeof(cvf_reader));
+    if (!reader) {
+        return NULL;
+    }
+    reader->name = strdup(name);
+    int error = reader->name ? map_segment(reader) : ENOMEM;
+    if (error) {
+        free(reader->name);
+        free(reader);
+        errno = error;
+        return NULL;
+    }
+    return reader;
+}
+
+void cvf_close(cvf_reader* reader) {
+    if (!reader) {
+        return;
+    }
+    unmap(reader);
+    free(reader->name);
+    free(reader);
+}
+
+int cvf_wait(cvf_reader* reader, uint64_t after_frame, int timeout_ms) {
+    const int64_t deadline = timeout_ms >= 0 ? now_ms() + timeout_ms : 0;
+    for (;;) {
+        if (ensure_live(reader) != CVF_OK) {
+            return CVF_CLOSED;
+        }
+        const cvf_header* header = reader->header;
+        /* Read the word before the frame so a publish in between wakes the wait */
+        const uint32_t notify = load32(&header->notify);
+        if (load64(&header->latest_frame) > after_frame) {
+            return CVF_OK;
+        }
+        if (load32(&header->state) == CVF_STATE_CLOSED) {
+            continue;
+        }
+        if (!writer_alive(header)) {
+            return CVF_CLOSED;
+        }
+
+        int slice = CVF_WAIT_SLICE_MS;
+        if (timeout_ms >= 0) {
+            const int64_t remaining = deadline - now_ms();
+            if (remaining <= 0) {
+                return CVF_NONE;
+            }
+            if (remaining < slice) {
+                slice = (int)remaining;
+            }
+        }
+        wait_on(&header->notify, notify, slice);
+    }
+}
+
+int cvf_acquire(cvf_reader* reader, cvf_frame* frame) {
+    for (int attempt = 0; attempt < CVF_ACQUIRE_ATTEMPTS; ++attempt) {
+        if (ensure_live(reader) != CVF_OK) {
+            return CVF_CLOSED;
+        }
+        const cvf_header* header = reader->header;
+        if (load64(&header->latest_frame) == 0) {
+            return CVF_NONE;
+        }
+        const uint32_t index = load32(&header->latest_slot);
+        if (index >= CVF_SLOT_COUNT) {
+            return CVF_NONE;
+        }
+
+        const cvf_slot* slot = &header->slots[index];
+        const uint32_t seq = load32(&slot->seq);
+        if (seq & 1u) {
+            continue;
+        }
+        const uint32_t width = loadu32_relaxed(&slot->width);
+        const uint32_t height = loadu32_relaxed(&slot->height);
+        const uint32_t stride = loadu32_relaxed(&slot->stride);
+        const uint64_t number = __atomic_load_n(&slot->frame, __ATOMIC_RELAXED);
+        uint32_t dirty_count = loadu32_relaxed(&slot->dirty_count);
+        if (dirty_count > CVF_MAX_DIRTY_RECTS) {
+            dirty_count = CVF_MAX_DIRTY_RECTS;
+        }
+        for (uint32_t i = 0; i < dirty_count; ++i) {
+            frame->dirty[i].x = load32_relaxed(&slot->dirty[i].x);
+            frame->dirty[i].y = load32_relaxed(&slot->dirty[i].y);
+            frame->dirty[i].width = load32_relaxed(&slot->dirty[i].width);
+            frame->dirty[i].height = load32_relaxed(&slot->dirty[i].height);
+        }
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (loadu32_relaxed(&slot->seq) != seq) {
+            continue;
+        }
+
+        if ((uint64_t)stride * height > header->slot_bytes || (uint64_t)width * 4u > stride) {
+            return CVF_NONE;
+        }
+        /* data_offset is fixed when the segment is created */
+        frame->pixels = (const uint8_t*)header + slot->data_offset;
+        frame->width = (int)width;
+        frame->height = (int)height;
+        frame->stride = (int)stride;
+        frame->frame = number;
+        frame->dirty_count = (int)dirty_count;
+        frame->slot = index;
+        frame->seq = seq;
+        return CVF_OK;
+    }
+    return CVF_NONE;
+}
+
+int cvf_validate(const cvf_reader* reader, const cvf_frame* frame) {
+    if (!reader->header || frame->slot >= CVF_SLOT_COUNT) {
+        return 0;
+    }
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return loadu32_relaxed(&reader->header->slots[frame->slot].seq) == frame->seq;
+}
+
+int cvf_copy(cvf_reader* reader, cvf_frame* frame, uint8_t* dst, size_t dst_stride, size_t dst_capacity) {
+    for (int attempt = 0; attempt < CVF_ACQUIRE_ATTEMPTS; ++attempt) {
+        int result = cvf_acquire(reader, frame);
+        if (result != CVF_OK) {
+            return result;
+        }
+        const size_t row_bytes = (size_t)frame->width * 4u;
+        if (frame->height > 0 &&
+            (dst_stride < row_bytes || dst_stride * (size_t)(frame->height - 1) + row_bytes > dst_capacity)) {
+            return CVF_NONE;
+        }
+        for (int y = 0; y < frame->height; ++y) {
+            memcpy(dst + (size_t)y * dst_stride, frame->pixels + (size_t)y * (size_t)frame->stride, row_bytes);
+        }
+        if (cvf_validate(reader, frame)) {
+            frame->pixels = dst;
+            frame->stride = (int)dst_stride;
+            return CVF_OK;
+        }
+    }
+    return CVF_NONE;
+}
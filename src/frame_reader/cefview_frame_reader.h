@@ -0,0 +1,103 @@
+/**
+ * @file cefview_frame_reader.h
+ * @brief C reader for OSR frames exported over shared memory
+ *
+ * Typical loop:
+ *
+ *   cvf_reader* reader = cvf_open("/cefview-main");
+ *   uint64_t last = 0;
+ *   cvf_frame frame;
+ *   while (cvf_wait(reader, last, 1000) >= 0) {
+ *       if (cvf_acquire(reader, &frame) != CVF_OK || frame.frame == last) continue;
+ *       consume(frame.pixels, frame.stride, frame.width, frame.height);
+ *       if (cvf_validate(reader, &frame)) last = frame.frame;  // else it was torn, read again
+ *   }
+ *   cvf_close(reader);
+ *
+ * Pixels are read in place from the shared mapping, without copies. The
+ * writer keeps CVF_SLOT_COUNT frames, so a reader has about two frame
+ * intervals to finish with a frame before it can be overwritten;
+ * cvf_validate() tells whether that happened. cvf_copy() does the
+ * copy-and-retry for readers that need a stable copy.
+ *
+ * POSIX only (Linux, macOS). On Linux cvf_wait() sleeps on a futex; on macOS
+ * it polls every millisecond. A reader is not thread-safe; use one per thread.
+ *
+ * This file is part of CefView project.
+ * Licensed under BSD-style license.
+ */
+#ifndef CEFVIEW_FRAME_READER_H
+#define CEFVIEW_FRAME_READER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "cefview_frame_shm.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CVF_OK 1
+#define CVF_NONE 0      /* no frame yet, or cvf_wait() timed out */
+#define CVF_CLOSED (-1) /* writer gone and no new segment under the name */
+
+typedef struct cvf_reader cvf_reader;
+
+typedef struct cvf_frame {
+    const uint8_t* pixels;  /* BGRA, valid until the frame is overwritten */
+    int width;
+    int height;
+    int stride;
+    uint64_t frame;
+    int dirty_count;        /* rects changed since frame - 1 */
+    cvf_rect dirty[CVF_MAX_DIRTY_RECTS];
+    /* For cvf_validate() */
+    uint32_t slot;
+    uint32_t seq;
+} cvf_frame;
+
+/**
+ * @brief Map an exported frame segment
+ * @param name shm_open name given to the writer, e.g. "/cefview-main"
+ * @return NULL with errno set if the segment does not exist or is not a frame export
+ */
+cvf_reader* cvf_open(const char* name);
+
+void cvf_close(cvf_reader* reader);
+
+/**
+ * @brief Wait until a frame newer than after_frame is available
+ * Follows the writer to a new segment when it was recreated for a larger view.
+ * @param timeout_ms Negative waits forever
+ * @return CVF_OK, CVF_NONE on timeout, CVF_CLOSED when the writer is gone
+ */
+int cvf_wait(cvf_reader* reader, uint64_t after_frame, int timeout_ms);
+
+/**
+ * @brief Describe the newest frame without copying it
+ * @return CVF_OK, CVF_NONE if nothing was written yet, CVF_CLOSED when the writer is gone
+ */
+int cvf_acquire(cvf_reader* reader, cvf_frame* frame);
+
+/**
+ * @brief Check that a frame was not overwritten while it was read
+ * Call after the last read of frame->pixels.
+ * @return Non-zero if every byte read belonged to the frame
+ */
+int cvf_validate(const cvf_reader* reader, const cvf_frame* frame);
+
+/**
+ * @brief Copy the newest frame, retrying while it is overwritten during the copy
+ * frame->pixels points to dst afterwards.
+ * @param dst Receives the rows; must hold dst_stride * height bytes
+ * @param dst_capacity Size of dst
+ * @return CVF_OK, CVF_NONE (nothing yet, or dst too small: frame tells the size), CVF_CLOSED
+ */
+int cvf_copy(cvf_reader* reader, cvf_frame* frame, uint8_t* dst, size_t dst_stride, size_t dst_capacity);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CEFVIEW_FRAME_READER_H */
@@ -0,0 +1,92 @@
+/**
+ * @file cefview_frame_shm.h
+ * @brief Shared memory layout of exported OSR frames
+ *
+ * Shared by the writer (OsrSharedFrameSink in cef_view) and the C reader
+ * library. Plain C so that any process can map it.
+ *
+ * This file is part of CefView project.
+ * Licensed under BSD-style license.
+ */
+#ifndef CEFVIEW_FRAME_SHM_H
+#define CEFVIEW_FRAME_SHM_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Segment layout (POSIX shared memory, shm_open name chosen by the host):
+ *
+ *   cvf_header                  at offset 0
+ *   slot 0 pixels               at slots[0].data_offset (page aligned)
+ *   slot 1 pixels ...
+ *
+ * One writer, any number of readers. The writer fills the slots round-robin,
+ * each guarded by a seqlock: seq is odd while the slot is being written and
+ * even when stable. Readers use the pixels in place and check seq again
+ * afterwards; a change means the frame was overwritten while being read.
+ *
+ * Slots are kept complete: before a slot is reused, the writer copies into it
+ * only what changed since it was last written, straight from the paint.
+ *
+ * When the view grows beyond the slot capacity the writer unlinks the
+ * segment, creates a new one under the same name and sets state to
+ * CVF_STATE_CLOSED in the old one; readers then map the name again.
+ *
+ * All multi-byte fields are native endian. Fields written after creation
+ * are accessed with atomic loads and stores.
+ */
+
+#define CVF_MAGIC 0x46564543u /* "CEVF" */
+#define CVF_VERSION 1u
+#define CVF_SLOT_COUNT 3
+#define CVF_MAX_DIRTY_RECTS 16
+
+#define CVF_STATE_LIVE 0u
+#define CVF_STATE_CLOSED 1u
+
+/* Pixel format of every slot: BGRA, premultiplied alpha, as CEF paints it */
+#define CVF_FORMAT_BGRA 0u
+
+typedef struct cvf_rect {
+    int32_t x;
+    int32_t y;
+    int32_t width;
+    int32_t height;
+} cvf_rect;
+
+typedef struct cvf_slot {
+    uint32_t seq;          /* seqlock, odd while written */
+    uint32_t width;
+    uint32_t height;
+    uint32_t stride;       /* bytes per row */
+    uint64_t frame;        /* frame number from 1, continued in a recreated segment */
+    uint64_t data_offset;  /* pixels, from the start of the segment; fixed at creation */
+    uint32_t dirty_count;  /* rects that changed since frame - 1; one full rect after a resize */
+    uint32_t reserved;
+    cvf_rect dirty[CVF_MAX_DIRTY_RECTS];
+} cvf_slot;
+
+typedef struct cvf_header {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t header_bytes;   /* sizeof(cvf_header) of the writer */
+    uint32_t format;
+    uint64_t slot_bytes;     /* pixel capacity of each slot */
+    uint64_t segment_bytes;
+    uint32_t writer_pid;
+    uint32_t state;          /* CVF_STATE_* */
+    uint64_t latest_frame;   /* newest complete frame, 0 before the first */
+    uint32_t latest_slot;    /* slot holding latest_frame */
+    uint32_t notify;         /* incremented per frame and on close; futex word on Linux */
+    cvf_slot slots[CVF_SLOT_COUNT];
+} cvf_header;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CEFVIEW_FRAME_SHM_H */
@@ -0,0 +1,108 @@
+/**
+ * @file OsrDamageTrackerBench.cpp
+ * @brief Microbenchmark of OsrDamageTracker on typical paint damage
+ *
+ * Each scenario replays a sequence of dirty rect lists shaped like what CEF
+ * reports for a kind of page, and prints the coalescing time per paint, the
+ * upload calls saved and the extra pixels uploaded in exchange.
+ *
+ * This file is part of CefView project.
+ * Licensed under BSD-style license.
+ */
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "osr/OsrDamageTracker.h"
+
+using cefview::OsrDamageTracker;
+
+namespace {
+
+constexpr int kWidth = 1920;
+constexpr int kHeight = 1080;
+constexpr int kPaints = 2000;
+
+struct Scenario {
+    const char* name;
+    std::vector<CefRenderHandler::RectList> paints;
+};
+
+// Caret blink plus the glyphs typed on one line of a text field
+Scenario Typing() {
+    Scenario scenario{"typing", {}};
+    for (int i = 0; i < kPaints; ++i) {
+        const int x = 200 + (i % 400) * 9;
+        scenario.paints.push_back({CefRect(x % 1600, 300, 2, 18), CefRect(x % 1600 - 9, 300, 9, 18)});
+    }
+    return scenario;
+}
+
+// A list scrolling by a few rows: one rect per row, plus the scrollbar thumb
+Scenario ListScroll() {
+    Scenario scenario{"list scroll", {}};
+    for (int i = 0; i < kPaints; ++i) {
+        CefRenderHandler::RectList rects;
+        for (int row = 0; row < 30; ++row) {
+            rects.emplace_back(0, 100 + row * 30, 1900, 29);
+        }
+        rects.emplace_back(1905, 100 + i % 800, 12, 80);
+        scenario.paints.push_back(std::move(rects));
+    }
+    return scenario;
+}
+
+// Small animations scattered over a dashboard
+Scenario Dashboard() {
+    Scenario scenario{"dashboard", {}};
+    std::mt19937 rng(27);
+    for (int i = 0; i < kPaints; ++i) {
+        CefRenderHandler::RectList rects;
+        const int count = 4 + static_cast<int>(rng() % 24);
+        for (int r = 0; r < count; ++r) {
+            rects.emplace_back(static_cast<int>(rng() % (kWidth - 64)), static_cast<int>(rng() % (kHeight - 64)),
+                               4 + static_cast<int>(rng() % 60), 4 + static_cast<int>(rng() % 60));
+        }
+        scenario.paints.push_back(std::move(rects));
+    }
+    return scenario;
+}
+
+int64_t Area(const CefRenderHandler::RectList& rects) {
+    int64_t pixels = 0;
+    for (const auto& rect : rects) {
+        pixels += static_cast<int64_t>(rect.width) * static_cast<int64_t>(rect.height);
+    }
+    return pixels;
+}
+
+void Run(const Scenario& scenario) {
+    OsrDamageTracker tracker;
+    int64_t inputPixels = 0;
+    int64_t outputPixels = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (const auto& paint : scenario.paints) {
+        const auto& rects = tracker.coalesce(paint, kWidth, kHeight);
+        inputPixels += Area(paint);
+        outputPixels += Area(rects);
+    }
+    const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    std::printf("%-12s %8.2f us/paint  rects %6.2f -> %5.2f  pixels x%.2f  full uploads %llu\n", scenario.name,
+                us / static_cast<double>(scenario.paints.size()),
+                static_cast<double>(tracker.totalInputRects()) / static_cast<double>(scenario.paints.size()),
+                static_cast<double>(tracker.totalOutputRects()) / static_cast<double>(scenario.paints.size()),
+                static_cast<double>(outputPixels) / static_cast<double>(inputPixels),
+                static_cast<unsigned long long>(tracker.totalFullUploads()));
+}
+
+}  // namespace
+
+int main() {
+    Run(Typing());
+    Run(ListScroll());
+    Run(Dashboard());
+    return 0;
+}
@@ -0,0 +1,129 @@
+/**
+ * @file OsrDamageTrackerTest.cpp
+ * @brief Unit tests for OsrDamageTracker
+ *
+ * This file is part of CefView project.
+ * Licensed under BSD-style license.
+ */
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "TestCheck.h"
+#include "osr/OsrDamageTracker.h"
+
+using cefview::OsrDamageTracker;
+
+namespace {
+
+// Every pixel of the clipped input must be covered by an output rect
+bool coversInput(const CefRenderHandler::RectList& input, const CefRenderHandler::RectList& output, int width,
+                 int height) {
+    std::vector<bool> covered(static_cast<size_t>(width) * static_cast<size_t>(height), false);
+    for (const auto& rect : output) {
+        for (int y = rect.y; y < rect.y + rect.height; ++y) {
+            for (int x = rect.x; x < rect.x + rect.width; ++x) {
+                covered[static_cast<size_t>(y) * static_cast<size_t>(width) + static_cast<size_t>(x)] = true;
+            }
+        }
+    }
+    for (const auto& rect : input) {
+        for (int y = std::max(rect.y, 0); y < std::min(rect.y + rect.height, height); ++y) {
+            for (int x = std::max(rect.x, 0); x < std::min(rect.x + rect.width, width); ++x) {
+                if (!covered[static_cast<size_t>(y) * static_cast<size_t>(width) + static_cast<size_t>(x)]) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+bool insideBuffer(const CefRenderHandler::RectList& rects, int width, int height) {
+    for (const auto& rect : rects) {
+        if (rect.x < 0 || rect.y < 0 || rect.width <= 0 || rect.height <= 0 || rect.x + rect.width > width ||
+            rect.y + rect.height > height) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void testEmpty() {
+    OsrDamageTracker tracker;
+    CHECK(tracker.coalesce({}, 800, 600).empty());
+    CHECK(tracker.coalesce({CefRect(0, 0, 10, 10)}, 0, 600).empty());
+    CHECK(!tracker.isFullUpload());
+}
+
+void testClipping() {
+    OsrDamageTracker tracker;
+    const auto& rects = tracker.coalesce({CefRect(-10, -10, 30, 30), CefRect(900, 0, 50, 50)}, 800, 600);
+    CHECK(rects.size() == 1);
+    CHECK(rects.size() == 1 && rects[0] == CefRect(0, 0, 20, 20));
+}
+
+void testMergesNearbyRects() {
+    OsrDamageTracker tracker;
+    // A caret and the glyph next to it: one upload beats two
+    const auto& rects = tracker.coalesce({CefRect(100, 100, 2, 16), CefRect(104, 100, 8, 16)}, 800, 600);
+    CHECK(rects.size() == 1);
+    CHECK(rects.size() == 1 && rects[0] == CefRect(100, 100, 12, 16));
+}
+
+void testKeepsDistantRects() {
+    OsrDamageTracker::Config config;
+    config.perRectCost = 64;
+    OsrDamageTracker tracker(config);
+    // Two corners of the view: their union would upload almost everything
+    const auto& rects = tracker.coalesce({CefRect(0, 0, 50, 50), CefRect(700, 500, 50, 50)}, 800, 600);
+    CHECK(rects.size() == 2);
+    CHECK(!tracker.isFullUpload());
+}
+
+void testFullUpload() {
+    OsrDamageTracker tracker;
+    const auto& rects = tracker.coalesce({CefRect(0, 0, 800, 300), CefRect(0, 300, 800, 200)}, 800, 600);
+    CHECK(rects.size() == 1);
+    CHECK(rects.size() == 1 && rects[0] == CefRect(0, 0, 800, 600));
+    CHECK(tracker.isFullUpload());
+    CHECK(tracker.totalFullUploads() == 1);
+}
+
+void testRandomDamage() {
+    const int width = 320;
+    const int height = 240;
+    OsrDamageTracker::Config config;
+    config.maxRects = 4;
+    config.perRectCost = 256;
+    OsrDamageTracker tracker(config);
+    std::mt19937 rng(27);
+    uint64_t inputRects = 0;
+    for (int round = 0; round < 300; ++round) {
+        CefRenderHandler::RectList input;
+        const int count = 1 + static_cast<int>(rng() % 24);
+        for (int i = 0; i < count; ++i) {
+            input.emplace_back(static_cast<int>(rng() % 360) - 20, static_cast<int>(rng() % 280) - 20,
+                               1 + static_cast<int>(rng() % 40), 1 + static_cast<int>(rng() % 40));
+        }
+        inputRects += input.size();
+        const auto& output = tracker.coalesce(input, width, height);
+        CHECK(output.size() <= config.maxRects);
+        CHECK(insideBuffer(output, width, height));
+        CHECK(coversInput(input, output, width, height));
+    }
+    CHECK(tracker.totalInputRects() == inputRects);
+    CHECK(tracker.totalOutputRects() <= inputRects);
+}
+
+}  // namespace
+
+int main() {
+    testEmpty();
+    testClipping();
+    testMergesNearbyRects();
+    testKeepsDistantRects();
+    testFullUpload();
+    testRandomDamage();
+    return TEST_RESULT();
+}
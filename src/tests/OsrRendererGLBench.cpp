@@ -0,0 +1,112 @@
+/**
+ * @file OsrRendererGLBench.cpp
+ * @brief Upload throughput of OsrRendererGL on headless EGL
+ *
+ * Paints and renders frames of a few sizes and damage patterns, and prints
+ * milliseconds per frame, the upload time the renderer reports and the
+ * upload throughput. Numbers from llvmpipe measure the CPU side only.
+ *
+ * This file is part of CefView project.
+ * Licensed under BSD-style license.
+ */
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "osr/OsrRendererGL.h"
+
+using cefview::OsrRendererGL;
+
+namespace {
+
+constexpr int kFrames = 60;
+
+struct Scenario {
+    const char* name;
+    int width;
+    int height;
+    bool tiled;
+    // Dirty rects of frame i; empty means the whole frame
+    CefRenderHandler::RectList (*damage)(int frame, int width, int height);
+};
+
+CefRenderHandler::RectList FullFrame(int, int, int) {
+    return {};
+}
+
+// Caret and the glyph typed next to it
+CefRenderHandler::RectList Typing(int frame, int, int) {
+    const int x = 200 + (frame % 100) * 9;
+    return {CefRect(x, 300, 2, 18), CefRect(x - 9, 300, 9, 18)};
+}
+
+// Scrolling content under a fixed header: most of the view, not all of it
+CefRenderHandler::RectList Scroll(int, int width, int height) {
+    return {CefRect(0, 80, width, height - 80)};
+}
+
+void Run(const Scenario& scenario) {
+    OsrRendererGL renderer(0, scenario.width, scenario.height);
+    renderer.setTiledTexturesEnabled(scenario.tiled);
+    if (!renderer.initialize()) {
+        std::printf("%-24s initialize() FAILED, skipped\n", scenario.name);
+        return;
+    }
+
+    std::vector<uint8_t> frame(static_cast<size_t>(scenario.width) * static_cast<size_t>(scenario.height) * 4);
+    std::mt19937 rng(43);
+    for (auto& byte : frame) {
+        byte = static_cast<uint8_t>(rng());
+    }
+    const CefRenderHandler::RectList full{CefRect(0, 0, scenario.width, scenario.height)};
+    // First paint lays out the textures and uploads everything
+    renderer.onPaint(PET_VIEW, full, frame.data(), scenario.width, scenario.height);
+    renderer.render();
+
+    double uploadMs = 0;
+    int64_t uploadedPixels = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kFrames; ++i) {
+        CefRenderHandler::RectList rects = scenario.damage(i, scenario.width, scenario.height);
+        if (rects.empty()) {
+            rects = full;
+        }
+        for (const auto& rect : rects) {
+            uploadedPixels += static_cast<int64_t>(rect.width) * static_cast<int64_t>(rect.height);
+        }
+        renderer.onPaint(PET_VIEW, rects, frame.data(), scenario.width, scenario.height);
+        renderer.render();
+        uploadMs += renderer.lastUploadTimeMs();
+    }
+    // Wait for the GL work queued by the last frame
+    std::vector<uint8_t> drawn;
+    int width = 0;
+    int height = 0;
+    renderer.readFrame(drawn, width, height);
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("%-24s %8.3f ms/frame  upload %7.3f ms  %7.2f GB/s  tiles %d  pbo %s\n", scenario.name, ms / kFrames,
+                uploadMs / kFrames, static_cast<double>(uploadedPixels * 4) / (uploadMs * 1e6),
+                renderer.viewTileCount(), renderer.isPixelBufferEnabled() ? "on" : "off");
+    renderer.uninitialize();
+}
+
+}  // namespace
+
+int main() {
+    const Scenario scenarios[] = {
+        {"1080p full", 1920, 1080, false, FullFrame},
+        {"1080p typing", 1920, 1080, false, Typing},
+        {"1080p scroll", 1920, 1080, false, Scroll},
+        {"4K full", 3840, 2160, false, FullFrame},
+        {"4K full, tiled", 3840, 2160, true, FullFrame},
+        {"4K scroll, tiled", 3840, 2160, true, Scroll},
+    };
+    std::printf("%d frames per scenario\n", kFrames);
+    for (const auto& scenario : scenarios) {
+        Run(scenario);
+    }
+    return 0;
+}
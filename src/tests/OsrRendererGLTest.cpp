@@ -0,0 +1,173 @@
+/**
+ * @file OsrRendererGLTest.cpp
+ * @brief Tests for OsrRendererGL uploads, read back with readFrame()
+ *
+ * Runs headless on EGL (Mesa surfaceless / llvmpipe in CI). Without an EGL
+ * display the test reports itself skipped.
+ *
+ * This file is part of CefView project.
+ * Licensed under BSD-style license.
+ */
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include "TestCheck.h"
+#include "osr/OsrRendererGL.h"
+
+using cefview::OsrRendererGL;
+
+namespace {
+
+using Bytes = std::vector<uint8_t>;
+
+// ctest SKIP_RETURN_CODE
+constexpr int kSkipped = 77;
+
+// Same lookup as OsrGLDevice: Mesa surfaceless first, then the default display
+bool HasEglDisplay() {
+    const char* extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    auto getPlatformDisplay =
+        reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    EGLDisplay display = EGL_NO_DISPLAY;
+    if (getPlatformDisplay && extensions && std::strstr(extensions, "EGL_MESA_platform_surfaceless")) {
+        display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    }
+    if (display == EGL_NO_DISPLAY) {
+        display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    }
+    EGLint major = 0;
+    EGLint minor = 0;
+    return display != EGL_NO_DISPLAY && eglInitialize(display, &major, &minor);
+}
+
+// Opaque BGRA noise: every texel differs from its neighbours, so an
+// off-by-one in a tile or rect origin shows up
+Bytes RandomFrame(std::mt19937& rng, int width, int height) {
+    Bytes pixels(static_cast<size_t>(width) * static_cast<size_t>(height) * 4);
+    for (size_t i = 0; i < pixels.size(); ++i) {
+        pixels[i] = i % 4 == 3 ? 255 : static_cast<uint8_t>(rng());
+    }
+    return pixels;
+}
+
+void PaintRect(std::mt19937& rng, Bytes& pixels, int width, const CefRect& rect) {
+    for (int y = rect.y; y < rect.y + rect.height; ++y) {
+        for (int x = rect.x; x < rect.x + rect.width; ++x) {
+            uint8_t* pixel = &pixels[(static_cast<size_t>(y) * static_cast<size_t>(width) + static_cast<size_t>(x)) * 4];
+            pixel[0] = static_cast<uint8_t>(rng());
+            pixel[1] = static_cast<uint8_t>(rng());
+            pixel[2] = static_cast<uint8_t>(rng());
+        }
+    }
+}
+
+bool DrawnFrameIs(OsrRendererGL& renderer, const Bytes& expected, int width, int height) {
+    Bytes pixels;
+    int drawnWidth = 0;
+    int drawnHeight = 0;
+    if (!renderer.readFrame(pixels, drawnWidth, drawnHeight)) {
+        std::fprintf(stderr, "readFrame() FAILED\n");
+        return false;
+    }
+    if (drawnWidth != width || drawnHeight != height) {
+        std::fprintf(stderr, "drawn %dx%d, expected %dx%d\n", drawnWidth, drawnHeight, width, height);
+        return false;
+    }
+    return pixels == expected;
+}
+
+void Paint(OsrRendererGL& renderer, const CefRenderHandler::RectList& rects, const Bytes& pixels, int width,
+           int height) {
+    renderer.onPaint(PET_VIEW, rects, pixels.data(), width, height);
+    renderer.render();
+}
+
+void testFullAndPartialUpload() {
+    const int width = 300;
+    const int height = 200;
+    OsrRendererGL renderer(0, width, height);
+    CHECK(renderer.initialize());
+    CHECK(renderer.viewTileCount() <= 1);
+
+    std::mt19937 rng(43);
+    Bytes frame = RandomFrame(rng, width, height);
+    Paint(renderer, {CefRect(0, 0, width, height)}, frame, width, height);
+    CHECK(DrawnFrameIs(renderer, frame, width, height));
+
+    // Only the dirty rects are uploaded; the rest must survive from the previous frame
+    bool partialOk = true;
+    for (int i = 0; i < 5; ++i) {
+        const CefRect caret(10 + i * 40, 30, 2, 18);
+        const CefRect block(5 + i * 7, 120, 60, 33);
+        PaintRect(rng, frame, width, caret);
+        PaintRect(rng, frame, width, block);
+        Paint(renderer, {caret, block}, frame, width, height);
+        partialOk &= DrawnFrameIs(renderer, frame, width, height);
+    }
+    CHECK(partialOk);
+    renderer.uninitialize();
+}
+
+void testResize() {
+    OsrRendererGL renderer(0, 300, 200);
+    CHECK(renderer.initialize());
+    std::mt19937 rng(430);
+    const Bytes frame = RandomFrame(rng, 300, 200);
+    Paint(renderer, {CefRect(0, 0, 300, 200)}, frame, 300, 200);
+
+    for (const auto& size : {CefRect(0, 0, 517, 311), CefRect(0, 0, 64, 48)}) {
+        Bytes resized = RandomFrame(rng, size.width, size.height);
+        renderer.setBounds(0, 0, size.width, size.height);
+        // CEF reports the whole view after a resize; the renderer must not trust a partial list
+        Paint(renderer, {CefRect(0, 0, 10, 10)}, resized, size.width, size.height);
+        CHECK(DrawnFrameIs(renderer, resized, size.width, size.height));
+
+        PaintRect(rng, resized, size.width, CefRect(size.width - 20, size.height - 20, 20, 20));
+        Paint(renderer, {CefRect(size.width - 20, size.height - 20, 20, 20)}, resized, size.width, size.height);
+        CHECK(DrawnFrameIs(renderer, resized, size.width, size.height));
+    }
+    renderer.uninitialize();
+}
+
+void testForcedTiling() {
+    // Three tile columns and two rows, the last ones partial
+    const int width = 2500;
+    const int height = 1100;
+    OsrRendererGL renderer(0, width, height);
+    renderer.setTiledTexturesEnabled(true);
+    CHECK(renderer.initialize());
+
+    std::mt19937 rng(4300);
+    Bytes frame = RandomFrame(rng, width, height);
+    Paint(renderer, {CefRect(0, 0, width, height)}, frame, width, height);
+    CHECK(renderer.viewTileCount() == 6);
+    CHECK(DrawnFrameIs(renderer, frame, width, height));
+
+    // Rects straddling tile edges are split between the tiles they hit
+    const CefRect acrossColumns(1000, 50, 100, 40);
+    const CefRect acrossCorner(2030, 1010, 40, 30);
+    PaintRect(rng, frame, width, acrossColumns);
+    PaintRect(rng, frame, width, acrossCorner);
+    Paint(renderer, {acrossColumns, acrossCorner}, frame, width, height);
+    CHECK(DrawnFrameIs(renderer, frame, width, height));
+    renderer.uninitialize();
+}
+
+}  // namespace
+
+int main() {
+    if (!HasEglDisplay()) {
+        std::printf("No EGL display, skipped\n");
+        return kSkipped;
+    }
+    testFullAndPartialUpload();
+    testResize();
+    testForcedTiling();
+    return TEST_RESULT();
+}
@@ -0,0 +1,202 @@
+/**
+ * @file OsrSharedFrameSinkTest.cpp
+ * @brief Tests for OsrSharedFrameSink against the C frame reader
+ *
+ * This file is part of CefView project.
+ * Licensed under BSD-style license.
+ */
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "TestCheck.h"
+#include "cefview_frame_reader.h"
+#include "osr/OsrSharedFrameSink.h"
+
+using cefview::OsrSharedFrameSink;
+
+namespace {
+
+using Bytes = std::vector<uint8_t>;
+
+constexpr int kWidth = 70;
+constexpr int kHeight = 50;
+constexpr int kTimeoutMs = 1000;
+
+std::string SegmentName(const char* what) {
+    return "/cefview-test-" + std::to_string(getpid()) + "-" + what;
+}
+
+Bytes RandomPixels(std::mt19937& rng, int width, int height) {
+    Bytes pixels(static_cast<size_t>(width) * static_cast<size_t>(height) * 4);
+    for (auto& byte : pixels) {
+        byte = static_cast<uint8_t>(rng());
+    }
+    return pixels;
+}
+
+void Fill(Bytes& pixels, int width, const CefRect& rect, uint8_t value) {
+    for (int y = rect.y; y < rect.y + rect.height; ++y) {
+        const size_t row = static_cast<size_t>(y) * static_cast<size_t>(width);
+        std::memset(&pixels[(row + static_cast<size_t>(rect.x)) * 4], value, static_cast<size_t>(rect.width) * 4);
+    }
+}
+
+bool SameFrame(const cvf_frame& frame, const Bytes& pixels, int width, int height) {
+    if (frame.width != width || frame.height != height) {
+        return false;
+    }
+    const size_t rowBytes = static_cast<size_t>(width) * 4;
+    for (int y = 0; y < height; ++y) {
+        if (std::memcmp(frame.pixels + static_cast<size_t>(y) * static_cast<size_t>(frame.stride),
+                        &pixels[static_cast<size_t>(y) * rowBytes], rowBytes) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void testPublishAndAcquire() {
+    const std::string name = SegmentName("publish");
+    OsrSharedFrameSink sink(name);
+    CHECK(sink.open(kWidth, kHeight));
+    cvf_reader* reader = cvf_open(name.c_str());
+    CHECK(reader != nullptr);
+    if (!reader) {
+        return;
+    }
+
+    cvf_frame frame{};
+    CHECK(cvf_acquire(reader, &frame) == CVF_NONE);
+
+    std::mt19937 rng(47);
+    Bytes pixels = RandomPixels(rng, kWidth, kHeight);
+    CHECK(sink.publish({CefRect(0, 0, kWidth, kHeight)}, pixels.data(), kWidth, kHeight));
+    CHECK(cvf_wait(reader, 0, kTimeoutMs) == CVF_OK);
+    CHECK(cvf_acquire(reader, &frame) == CVF_OK);
+    CHECK(frame.frame == 1 && frame.stride == kWidth * 4);
+    CHECK(SameFrame(frame, pixels, kWidth, kHeight));
+    CHECK(cvf_validate(reader, &frame));
+
+    // Partial paints: every slot must catch up with what it missed while other slots were written
+    bool framesMatch = true;
+    bool dirtyReported = true;
+    for (int i = 0; i < 10; ++i) {
+        const CefRect rect(i * 5, i * 3, 10, 8);
+        Fill(pixels, kWidth, rect, static_cast<uint8_t>(i * 20));
+        CHECK(sink.publish({rect}, pixels.data(), kWidth, kHeight));
+        CHECK(cvf_wait(reader, frame.frame, kTimeoutMs) == CVF_OK);
+        CHECK(cvf_acquire(reader, &frame) == CVF_OK);
+        framesMatch &= frame.frame == static_cast<uint64_t>(i + 2) && SameFrame(frame, pixels, kWidth, kHeight) &&
+                       cvf_validate(reader, &frame);
+        dirtyReported &= frame.dirty_count == 1 && frame.dirty[0].x == rect.x && frame.dirty[0].y == rect.y &&
+                         frame.dirty[0].width == rect.width && frame.dirty[0].height == rect.height;
+    }
+    CHECK(framesMatch);
+    CHECK(dirtyReported);
+
+    // Once the ring wraps around, a frame held that long no longer validates
+    cvf_frame held = frame;
+    for (int i = 0; i < OsrSharedFrameSink::kSlotCount; ++i) {
+        Fill(pixels, kWidth, CefRect(0, 0, 4, 4), static_cast<uint8_t>(i));
+        CHECK(sink.publish({CefRect(0, 0, 4, 4)}, pixels.data(), kWidth, kHeight));
+    }
+    CHECK(!cvf_validate(reader, &held));
+
+    // A copy with row padding (none needed after the last row); too small a
+    // destination tells the size instead
+    const size_t stride = static_cast<size_t>(kWidth) * 4 + 16;
+    Bytes copy(stride * kHeight);
+    CHECK(cvf_copy(reader, &frame, copy.data(), stride, copy.size() - 16) == CVF_OK);
+    CHECK(frame.pixels == copy.data() && static_cast<size_t>(frame.stride) == stride);
+    CHECK(SameFrame(frame, pixels, kWidth, kHeight));
+    CHECK(cvf_copy(reader, &frame, copy.data(), stride, copy.size() - 17) == CVF_NONE);
+    CHECK(frame.width == kWidth && frame.height == kHeight);
+
+    sink.close();
+    CHECK(cvf_wait(reader, frame.frame, kTimeoutMs) == CVF_CLOSED);
+    cvf_close(reader);
+}
+
+void testFollowsGrow() {
+    const std::string name = SegmentName("grow");
+    OsrSharedFrameSink sink(name);
+    std::mt19937 rng(470);
+    const Bytes small = RandomPixels(rng, kWidth, kHeight);
+    CHECK(sink.publish({}, small.data(), kWidth, kHeight));
+    cvf_reader* reader = cvf_open(name.c_str());
+    CHECK(reader != nullptr);
+    if (!reader) {
+        return;
+    }
+    cvf_frame frame{};
+    CHECK(cvf_acquire(reader, &frame) == CVF_OK && frame.frame == 1);
+
+    // Beyond the slot capacity: a new segment under the same name
+    const int width = kWidth * 3;
+    const int height = kHeight * 2;
+    const Bytes large = RandomPixels(rng, width, height);
+    CHECK(sink.publish({}, large.data(), width, height));
+    CHECK(cvf_wait(reader, frame.frame, kTimeoutMs) == CVF_OK);
+    CHECK(cvf_acquire(reader, &frame) == CVF_OK);
+    CHECK(frame.frame == 2);
+    CHECK(frame.dirty_count == 1 && frame.dirty[0].width == width && frame.dirty[0].height == height);
+    CHECK(SameFrame(frame, large, width, height));
+    CHECK(cvf_validate(reader, &frame));
+
+    // Shrinking reuses the segment
+    CHECK(sink.publish({}, small.data(), kWidth, kHeight));
+    CHECK(cvf_wait(reader, frame.frame, kTimeoutMs) == CVF_OK);
+    CHECK(cvf_acquire(reader, &frame) == CVF_OK);
+    CHECK(SameFrame(frame, small, kWidth, kHeight));
+    cvf_close(reader);
+}
+
+void testOneWriterPerName() {
+    const std::string name = SegmentName("owner");
+    OsrSharedFrameSink first(name);
+    CHECK(first.open(kWidth, kHeight));
+
+    // A running writer keeps its segment
+    OsrSharedFrameSink second(name);
+    CHECK(!second.open(kWidth, kHeight));
+    cvf_reader* reader = cvf_open(name.c_str());
+    CHECK(reader != nullptr);
+    const Bytes pixels(static_cast<size_t>(kWidth) * kHeight * 4, 7);
+    CHECK(first.publish({}, pixels.data(), kWidth, kHeight));
+    cvf_frame frame{};
+    CHECK(reader && cvf_acquire(reader, &frame) == CVF_OK && SameFrame(frame, pixels, kWidth, kHeight));
+    if (reader) {
+        cvf_close(reader);
+    }
+
+    // Once it closed, the name is free
+    first.close();
+    CHECK(second.open(kWidth, kHeight));
+    second.close();
+
+    // A writer that died without closing leaves a segment the next one replaces
+    const pid_t child = fork();
+    if (child == 0) {
+        OsrSharedFrameSink crashed(name);
+        _exit(crashed.open(kWidth, kHeight) ? 0 : 1);
+    }
+    int status = 0;
+    CHECK(child > 0 && waitpid(child, &status, 0) == child && WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    OsrSharedFrameSink next(name);
+    CHECK(next.open(kWidth, kHeight));
+}
+
+}  // namespace
+
+int main() {
+    testPublishAndAcquire();
+    testFollowsGrow();
+    testOneWriterPerName();
+    return TEST_RESULT();
+}
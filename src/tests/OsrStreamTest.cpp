@@ -0,0 +1,276 @@
+/**
+ * @file OsrStreamTest.cpp
+ * @brief Tests for the OSR tile streaming server, its wire format and TileCodec
+ *
+ * The server and clients talk over real loopback sockets; nothing here
+ * needs a browser, so CEF is linked but never initialized.
+ *
+ * This file is part of CefView project.
+ * Licensed under BSD-style license.
+ */
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "TestCheck.h"
+#include "osr/OsrStreamClient.h"
+#include "osr/OsrStreamProtocol.h"
+#include "osr/OsrStreamServer.h"
+#include "utils/TileCodec.h"
+
+using cefview::OsrStreamClient;
+using cefview::OsrStreamInput;
+using cefview::OsrStreamProtocol;
+using cefview::OsrStreamServer;
+using cefview::TileCodec;
+
+namespace {
+
+using Bytes = std::vector<uint8_t>;
+
+constexpr int kWidth = 333;  // Not a multiple of the tile size
+constexpr int kHeight = 200;
+constexpr int kTimeoutMs = 2000;
+
+Bytes RandomPixels(std::mt19937& rng, int width, int height) {
+    Bytes pixels(static_cast<size_t>(width) * static_cast<size_t>(height) * 4);
+    for (auto& byte : pixels) {
+        byte = static_cast<uint8_t>(rng());
+    }
+    return pixels;
+}
+
+// Flat background with a box at boxX, the kind of frame QOI shrinks well
+Bytes UiFrame(int width, int height, int boxX) {
+    Bytes pixels(static_cast<size_t>(width) * static_cast<size_t>(height) * 4, 240);
+    for (int y = 20; y < 60; ++y) {
+        for (int x = boxX; x < boxX + 40; ++x) {
+            uint8_t* pixel = &pixels[(static_cast<size_t>(y) * static_cast<size_t>(width) + static_cast<size_t>(x)) * 4];
+            pixel[0] = 200;
+            pixel[1] = 100;
+            pixel[2] = static_cast<uint8_t>(y);
+        }
+    }
+    return pixels;
+}
+
+void testTileCodec() {
+    std::mt19937 rng(48);
+    bool roundTrips = true;
+    bool rejectsTruncated = true;
+    for (int round = 0; round < 150; ++round) {
+        const int width = 1 + static_cast<int>(rng() % 64);
+        const int height = 1 + static_cast<int>(rng() % 64);
+        // Noise (sent raw), flat runs and gradients (QOI)
+        Bytes tile = RandomPixels(rng, width, height);
+        for (size_t i = 0; i < tile.size() && round % 3 != 0; ++i) {
+            tile[i] = round % 3 == 1 ? static_cast<uint8_t>(i / 4 % 5 * 50) : static_cast<uint8_t>(i / 64 + i % 4);
+        }
+        const size_t stride = static_cast<size_t>(width) * 4;
+        Bytes encoded;
+        const TileCodec::Encoding encoding = TileCodec::Encode(tile.data(), stride, width, height, encoded);
+        Bytes decoded(tile.size());
+        roundTrips &= TileCodec::Decode(encoding, encoded.data(), encoded.size(), decoded.data(), stride, width,
+                                        height) &&
+                      decoded == tile;
+        rejectsTruncated &= !TileCodec::Decode(encoding, encoded.data(), encoded.size() - 1, decoded.data(), stride,
+                                               width, height);
+    }
+    CHECK(roundTrips);
+    CHECK(rejectsTruncated);
+}
+
+void testTakeMessages() {
+    Bytes stream;
+    {
+        OsrStreamProtocol::Writer writer(stream, OsrStreamProtocol::kMouseMove);
+        writer.i32(10);
+        writer.i32(-20);
+        writer.u32(0);
+        writer.u8(0);
+    }
+    // Second message cut short: stays in the buffer for the next read
+    {
+        OsrStreamProtocol::Writer writer(stream, OsrStreamProtocol::kMouseWheel);
+        writer.i32(1);
+    }
+    const size_t firstLength = 4 + 1 + 13;
+    stream.pop_back();
+
+    std::vector<Bytes> messages;
+    CHECK(OsrStreamProtocol::TakeMessages(stream, OsrStreamProtocol::kMaxInputMessage, messages));
+    CHECK(messages.size() == 1);
+    CHECK(messages.size() == 1 && messages[0].size() == firstLength - 4);
+    CHECK(stream.size() == 4 + 1 + 3);
+
+    OsrStreamInput input;
+    CHECK(messages.size() == 1 && OsrStreamServer::ParseInput(messages[0], input));
+    CHECK(input.type == OsrStreamInput::Type::kMouseMove && input.mouse.x == 10 && input.mouse.y == -20);
+
+    // A length beyond the limit marks the stream as corrupt
+    Bytes oversized;
+    {
+        OsrStreamProtocol::Writer writer(oversized, OsrStreamProtocol::kKey);
+        writer.bytes(Bytes(OsrStreamProtocol::kMaxInputMessage).data(), OsrStreamProtocol::kMaxInputMessage);
+    }
+    messages.clear();
+    CHECK(!OsrStreamProtocol::TakeMessages(oversized, OsrStreamProtocol::kMaxInputMessage, messages));
+    CHECK(messages.empty());
+
+    // So does an empty message
+    Bytes empty(4, 0);
+    CHECK(!OsrStreamProtocol::TakeMessages(empty, OsrStreamProtocol::kMaxInputMessage, messages));
+}
+
+void testParseInput() {
+    OsrStreamInput input;
+    CHECK(!OsrStreamServer::ParseInput(Bytes{}, input));
+    CHECK(!OsrStreamServer::ParseInput(Bytes{0x7F}, input));
+
+    Bytes stream;
+    {
+        OsrStreamProtocol::Writer writer(stream, OsrStreamProtocol::kMouseButton);
+        writer.i32(5);
+        writer.i32(6);
+        writer.u32(0);
+        writer.u8(2);
+        writer.u8(1);
+        writer.u8(2);
+    }
+    Bytes button(stream.begin() + 4, stream.end());
+    CHECK(OsrStreamServer::ParseInput(button, input));
+    CHECK(input.type == OsrStreamInput::Type::kMouseButton && input.button == 2 && input.mouseUp &&
+          input.clickCount == 2);
+
+    Bytes shortBody(button.begin(), button.end() - 1);
+    CHECK(!OsrStreamServer::ParseInput(shortBody, input));
+    Bytes longBody = button;
+    longBody.push_back(0);
+    CHECK(!OsrStreamServer::ParseInput(longBody, input));
+    Bytes badButton = button;
+    badButton[1 + 12] = 3;
+    CHECK(!OsrStreamServer::ParseInput(badButton, input));
+}
+
+void testFullAndPartialFrames() {
+    OsrStreamServer server;
+    CHECK(server.start("tcp:127.0.0.1:0", nullptr));
+    CHECK(server.address().compare(0, 4, "tcp:") == 0 && server.address() != "tcp:127.0.0.1:0");
+
+    Bytes frame = UiFrame(kWidth, kHeight, 0);
+    server.publish({CefRect(0, 0, kWidth, kHeight)}, frame.data(), kWidth, kHeight);
+
+    OsrStreamClient client;
+    CHECK(client.connect(server.address(), kTimeoutMs));
+    CHECK(client.readFrame(kTimeoutMs));
+    CHECK(client.width() == kWidth && client.height() == kHeight);
+    CHECK(client.canvas() == frame);
+    const size_t allTiles = 6 * 4;
+    CHECK(client.lastTileCount() == allTiles);
+    CHECK(client.lastMessageBytes() < frame.size() / 4);
+
+    // Moving the box only touches the first row of tiles
+    frame = UiFrame(kWidth, kHeight, 70);
+    server.publish({CefRect(0, 20, 110, 40)}, frame.data(), kWidth, kHeight);
+    CHECK(client.readFrame(kTimeoutMs));
+    CHECK(client.frame() == 2);
+    CHECK(client.canvas() == frame);
+    CHECK(client.lastTileCount() == 2);
+
+    // A resize resends everything
+    const Bytes resized = UiFrame(200, 100, 10);
+    server.publish({}, resized.data(), 200, 100);
+    CHECK(client.readFrame(kTimeoutMs));
+    CHECK(client.width() == 200 && client.height() == 100);
+    CHECK(client.canvas() == resized);
+
+    server.stop();
+    CHECK(!client.readFrame(500));
+}
+
+void testSlowSubscriberSkipsFrames() {
+    OsrStreamServer server;
+    CHECK(server.start("tcp:127.0.0.1:0", nullptr));
+
+    // Noise is sent raw: each frame is bigger than the socket buffers
+    const int width = 1024;
+    const int height = 1024;
+    const int frames = 20;
+    std::mt19937 rng(480);
+    Bytes frame = RandomPixels(rng, width, height);
+    server.publish({CefRect(0, 0, width, height)}, frame.data(), width, height);
+
+    OsrStreamClient slow;
+    CHECK(slow.connect(server.address(), kTimeoutMs));
+    for (int i = 1; i < frames; ++i) {
+        frame = RandomPixels(rng, width, height);
+        server.publish({CefRect(0, 0, width, height)}, frame.data(), width, height);
+    }
+
+    // The subscriber reads only now: it gets the latest frame without every one before it
+    int received = 0;
+    while (slow.readFrame(kTimeoutMs)) {
+        ++received;
+        if (slow.frame() == static_cast<uint64_t>(frames)) {
+            break;
+        }
+    }
+    CHECK(slow.frame() == static_cast<uint64_t>(frames));
+    CHECK(slow.canvas() == frame);
+    CHECK(received < frames);
+    const OsrStreamServer::Stats stats = server.stats();
+    CHECK(stats.framesPublished == static_cast<uint64_t>(frames));
+    CHECK(stats.framesSkipped > 0);
+    std::printf("slow subscriber read %d of %d frames\n", received, frames);
+}
+
+void testUnixSocketPath() {
+    const std::string path = "/tmp/cefview_stream_test_" + std::to_string(getpid()) + ".sock";
+    const std::string address = "unix:" + path;
+
+    // Anything but a socket at the path is left alone
+    FILE* file = std::fopen(path.c_str(), "w");
+    CHECK(file != nullptr);
+    if (file) {
+        std::fclose(file);
+    }
+    OsrStreamServer server;
+    CHECK(!server.start(address, nullptr));
+    CHECK(access(path.c_str(), F_OK) == 0);
+    unlink(path.c_str());
+
+    // A socket left by a dead server is replaced
+    const int stale = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un un{};
+    un.sun_family = AF_UNIX;
+    path.copy(un.sun_path, sizeof(un.sun_path) - 1);
+    CHECK(bind(stale, reinterpret_cast<const sockaddr*>(&un), sizeof(un)) == 0);
+    close(stale);
+    CHECK(server.start(address, nullptr));
+
+    // A live one is not
+    OsrStreamServer second;
+    CHECK(!second.start(address, nullptr));
+    OsrStreamClient client;
+    CHECK(client.connect(address, kTimeoutMs));
+    server.stop();
+    unlink(path.c_str());
+}
+
+}  // namespace
+
+int main() {
+    testTileCodec();
+    testTakeMessages();
+    testParseInput();
+    testFullAndPartialFrames();
+    testSlowSubscriberSkipsFrames();
+    testUnixSocketPath();
+    return TEST_RESULT();
+}
@@ -0,0 +1,98 @@
+/**
+ * @file PixelKernelsBench.cpp
+ * @brief Microbenchmark of PixelKernels variants on 4K BGRA frames
+ *
+ * Runs each kernel with the scalar variant and every SIMD variant this CPU
+ * supports, and prints milliseconds per 3840x2160 frame, throughput and the
+ * speed-up over scalar.
+ *
+ * This file is part of CefView project.
+ * Licensed under BSD-style license.
+ */
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "utils/PixelKernels.h"
+
+using cefview::PixelKernels;
+
+namespace {
+
+constexpr int kWidth = 3840;
+constexpr int kHeight = 2160;
+constexpr size_t kPixels = static_cast<size_t>(kWidth) * static_cast<size_t>(kHeight);
+constexpr size_t kStride = static_cast<size_t>(kWidth) * 4;
+constexpr int kIterations = 20;
+
+volatile uint64_t g_sink = 0;
+
+double MsPerFrame(const std::function<void()>& kernel) {
+    kernel();  // Warm up caches and page in the buffers
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kIterations; ++i) {
+        kernel();
+    }
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / kIterations;
+}
+
+}  // namespace
+
+int main() {
+    std::vector<uint8_t> frame(kPixels * 4);
+    std::mt19937 rng(33);
+    for (auto& byte : frame) {
+        byte = static_cast<uint8_t>(rng());
+    }
+    std::vector<uint8_t> work(frame.size());
+    std::vector<uint8_t> half(kPixels);
+    std::vector<uint8_t> yuv(kPixels * 3 / 2);
+    uint8_t* y = yuv.data();
+    uint8_t* u = y + kPixels;
+    uint8_t* v = u + kPixels / 4;
+
+    struct Kernel {
+        const char* name;
+        std::function<void()> run;
+    };
+    const Kernel kernels[] = {
+        {"SwizzleRB", [&] { PixelKernels::SwizzleRB(frame.data(), work.data(), kPixels); }},
+        {"Premultiply", [&] { PixelKernels::Premultiply(work.data(), kPixels); }},
+        {"Unpremultiply", [&] { PixelKernels::Unpremultiply(work.data(), kPixels); }},
+        {"HashRect", [&] { g_sink = g_sink + PixelKernels::HashRect(frame.data(), kStride, kWidth, kHeight); }},
+        {"CopyRect", [&] { PixelKernels::CopyRect(frame.data(), kStride, work.data(), kStride, kWidth, kHeight); }},
+        {"StreamRect", [&] { PixelKernels::StreamRect(frame.data(), kStride, work.data(), kStride, kWidth, kHeight); }},
+        {"Downscale2x",
+         [&] { PixelKernels::Downscale2x(frame.data(), kStride, half.data(), kStride / 2, kWidth / 2, kHeight / 2); }},
+        {"ConvertToI420",
+         [&] {
+             PixelKernels::ConvertToI420(frame.data(), kStride, y, kWidth, u, kWidth / 2, v, kWidth / 2, kWidth, kHeight);
+         }},
+    };
+
+    std::vector<PixelKernels::Isa> variants{PixelKernels::Isa::kScalar};
+    for (PixelKernels::Isa isa : {PixelKernels::Isa::kSSE2, PixelKernels::Isa::kAVX2, PixelKernels::Isa::kNEON}) {
+        PixelKernels::SetIsa(isa);
+        if (PixelKernels::ActiveIsa() == isa) {
+            variants.push_back(isa);
+        }
+    }
+
+    std::printf("%dx%d BGRA, %d iterations\n", kWidth, kHeight, kIterations);
+    for (const auto& kernel : kernels) {
+        double scalarMs = 0;
+        for (PixelKernels::Isa isa : variants) {
+            PixelKernels::SetIsa(isa);
+            const double ms = MsPerFrame(kernel.run);
+            if (isa == PixelKernels::Isa::kScalar) {
+                scalarMs = ms;
+            }
+            std::printf("%-14s %-6s %8.3f ms  %6.2f GB/s  x%.2f\n", kernel.name, PixelKernels::IsaName(isa), ms,
+                        static_cast<double>(kPixels * 4) / (ms * 1e6), scalarMs / ms);
+        }
+    }
+    return 0;
+}
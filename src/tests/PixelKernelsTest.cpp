@@ -0,0 +1,228 @@
+/**
+ * @file PixelKernelsTest.cpp
+ * @brief Unit tests for PixelKernels
+ *
+ * The scalar kernels are checked against reference formulas, then every
+ * SIMD variant supported by this CPU is checked to be bit-identical to
+ * scalar on sizes that exercise the vector loops and their tails.
+ *
+ * This file is part of CefView project.
+ * Licensed under BSD-style license.
+ */
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "TestCheck.h"
+#include "utils/PixelKernels.h"
+
+using cefview::PixelKernels;
+
+namespace {
+
+using Bytes = std::vector<uint8_t>;
+
+Bytes RandomPixels(std::mt19937& rng, size_t pixelCount) {
+    Bytes pixels(pixelCount * 4);
+    for (auto& byte : pixels) {
+        byte = static_cast<uint8_t>(rng());
+    }
+    return pixels;
+}
+
+// Premultiplied input: color channels never exceed alpha
+Bytes RandomPremultiplied(std::mt19937& rng, size_t pixelCount) {
+    Bytes pixels = RandomPixels(rng, pixelCount);
+    for (size_t i = 0; i < pixelCount; ++i) {
+        uint8_t* pixel = &pixels[i * 4];
+        for (int c = 0; c < 3; ++c) {
+            pixel[c] = pixel[3] ? static_cast<uint8_t>(pixel[c] % (pixel[3] + 1)) : 0;
+        }
+    }
+    return pixels;
+}
+
+uint8_t Avg(uint8_t a, uint8_t b) {
+    return static_cast<uint8_t>((a + b + 1) >> 1);
+}
+
+void testScalarReference() {
+    PixelKernels::SetIsa(PixelKernels::Isa::kScalar);
+    CHECK(PixelKernels::ActiveIsa() == PixelKernels::Isa::kScalar);
+
+    const uint8_t bgra[4] = {1, 2, 3, 4};
+    uint8_t rgba[4] = {};
+    PixelKernels::SwizzleRB(bgra, rgba, 1);
+    CHECK(rgba[0] == 3 && rgba[1] == 2 && rgba[2] == 1 && rgba[3] == 4);
+
+    // Every color and alpha value against round(c * a / 255) and its inverse
+    Bytes pixels(256 * 256 * 4);
+    for (uint32_t a = 0; a < 256; ++a) {
+        for (uint32_t c = 0; c < 256; ++c) {
+            uint8_t* pixel = &pixels[(a * 256 + c) * 4];
+            pixel[0] = pixel[1] = pixel[2] = static_cast<uint8_t>(c);
+            pixel[3] = static_cast<uint8_t>(a);
+        }
+    }
+    Bytes premultiplied = pixels;
+    PixelKernels::Premultiply(premultiplied.data(), 256 * 256);
+    bool premultiplyOk = true;
+    for (uint32_t a = 0; a < 256; ++a) {
+        for (uint32_t c = 0; c < 256; ++c) {
+            const uint8_t* pixel = &premultiplied[(a * 256 + c) * 4];
+            premultiplyOk &= pixel[0] == (c * a + 127) / 255 && pixel[3] == a;
+        }
+    }
+    CHECK(premultiplyOk);
+
+    Bytes unpremultiplied = pixels;
+    PixelKernels::Unpremultiply(unpremultiplied.data(), 256 * 256);
+    bool unpremultiplyOk = true;
+    for (uint32_t a = 0; a < 256; ++a) {
+        for (uint32_t c = 0; c < 256; ++c) {
+            const uint32_t expected = a == 0 ? c : std::min<uint32_t>(255, (c * 255 + a / 2) / a);
+            unpremultiplyOk &= unpremultiplied[(a * 256 + c) * 4] == expected;
+        }
+    }
+    CHECK(unpremultiplyOk);
+
+    // 2x2 box filter, rows averaged first
+    const uint8_t block[16] = {10, 20, 30, 40, 11, 21, 31, 41, 200, 100, 0, 255, 201, 101, 1, 254};
+    uint8_t half[4] = {};
+    PixelKernels::Downscale2x(block, 8, half, 4, 1, 1);
+    for (int c = 0; c < 4; ++c) {
+        CHECK(half[c] == Avg(Avg(block[c], block[8 + c]), Avg(block[4 + c], block[12 + c])));
+    }
+
+    // BT.601 limited range: black and white
+    const uint8_t blackWhite[16] = {0, 0, 0, 255, 0, 0, 0, 255, 255, 255, 255, 255, 255, 255, 255, 255};
+    uint8_t y[4] = {};
+    uint8_t u = 0;
+    uint8_t v = 0;
+    PixelKernels::ConvertToI420(blackWhite, 8, y, 2, &u, 1, &v, 1, 2, 2);
+    CHECK(y[0] == 16 && y[1] == 16 && y[2] == 235 && y[3] == 235);
+    CHECK(u == 128 && v == 128);
+}
+
+void testCopyAndHash() {
+    std::mt19937 rng(33);
+    const int width = 37;
+    const int height = 11;
+    const size_t srcStride = static_cast<size_t>(width) * 4 + 12;
+    const size_t dstStride = static_cast<size_t>(width) * 4 + 20;
+    Bytes src = RandomPixels(rng, srcStride / 4 * static_cast<size_t>(height));
+    Bytes copied(dstStride * static_cast<size_t>(height), 0xCD);
+    Bytes streamed(dstStride * static_cast<size_t>(height), 0xCD);
+    PixelKernels::CopyRect(src.data(), srcStride, copied.data(), dstStride, width, height);
+    PixelKernels::StreamRect(src.data(), srcStride, streamed.data(), dstStride, width, height);
+    CHECK(copied == streamed);
+
+    bool rowsOk = true;
+    for (int row = 0; row < height; ++row) {
+        const uint8_t* s = &src[static_cast<size_t>(row) * srcStride];
+        const uint8_t* d = &copied[static_cast<size_t>(row) * dstStride];
+        rowsOk &= std::memcmp(s, d, static_cast<size_t>(width) * 4) == 0;
+        rowsOk &= d[width * 4] == 0xCD;  // Row padding untouched
+    }
+    CHECK(rowsOk);
+
+    // Same pixels, different strides: same hash; one changed byte: different hash
+    const uint64_t hash = PixelKernels::HashRect(src.data(), srcStride, width, height);
+    CHECK(hash == PixelKernels::HashRect(copied.data(), dstStride, width, height));
+    copied[dstStride * 5 + 17] ^= 1;
+    CHECK(hash != PixelKernels::HashRect(copied.data(), dstStride, width, height));
+}
+
+struct Results {
+    Bytes swizzled{};
+    Bytes premultiplied{};
+    Bytes unpremultiplied{};
+    Bytes halved{};
+    Bytes i420{};
+    Bytes nv12{};
+    uint64_t hash = 0;
+};
+
+Results RunAll(const Bytes& pixels, const Bytes& premultiplied, int width, int height) {
+    const size_t count = static_cast<size_t>(width) * static_cast<size_t>(height);
+    const size_t stride = static_cast<size_t>(width) * 4;
+    Results results;
+
+    results.swizzled.resize(pixels.size());
+    PixelKernels::SwizzleRB(pixels.data(), results.swizzled.data(), count);
+    results.premultiplied = pixels;
+    PixelKernels::Premultiply(results.premultiplied.data(), count);
+    results.unpremultiplied = premultiplied;
+    PixelKernels::Unpremultiply(results.unpremultiplied.data(), count);
+    results.hash = PixelKernels::HashRect(pixels.data(), stride, width, height);
+
+    const int halfWidth = width / 2;
+    const int halfHeight = height / 2;
+    results.halved.resize(static_cast<size_t>(halfWidth) * static_cast<size_t>(halfHeight) * 4);
+    PixelKernels::Downscale2x(pixels.data(), stride, results.halved.data(), static_cast<size_t>(halfWidth) * 4,
+                              halfWidth, halfHeight);
+
+    const size_t chromaWidth = static_cast<size_t>((width + 1) / 2);
+    const size_t chromaHeight = static_cast<size_t>((height + 1) / 2);
+    const size_t lumaBytes = count;
+    results.i420.resize(lumaBytes + chromaWidth * chromaHeight * 2);
+    uint8_t* i420 = results.i420.data();
+    PixelKernels::ConvertToI420(pixels.data(), stride, i420, static_cast<size_t>(width), i420 + lumaBytes, chromaWidth,
+                                i420 + lumaBytes + chromaWidth * chromaHeight, chromaWidth, width, height);
+    results.nv12.resize(lumaBytes + chromaWidth * chromaHeight * 2);
+    uint8_t* nv12 = results.nv12.data();
+    PixelKernels::ConvertToNV12(pixels.data(), stride, nv12, static_cast<size_t>(width), nv12 + lumaBytes,
+                                chromaWidth * 2, width, height);
+    return results;
+}
+
+void testVariantsMatchScalar() {
+    const PixelKernels::Isa variants[] = {PixelKernels::Isa::kSSE2, PixelKernels::Isa::kAVX2,
+                                          PixelKernels::Isa::kNEON};
+    std::mt19937 rng(2033);
+    for (PixelKernels::Isa isa : variants) {
+        PixelKernels::SetIsa(isa);
+        if (PixelKernels::ActiveIsa() != isa) {
+            std::printf("%s not supported here, skipped\n", PixelKernels::IsaName(isa));
+            continue;
+        }
+        int mismatches = 0;
+        // Widths around the 4, 8 and 16 pixel vector steps, odd heights for the chroma tail
+        for (int width = 1; width <= 67; width += 3) {
+            for (int height : {1, 2, 7}) {
+                const size_t count = static_cast<size_t>(width) * static_cast<size_t>(height);
+                const Bytes pixels = RandomPixels(rng, count);
+                const Bytes premultiplied = RandomPremultiplied(rng, count);
+
+                PixelKernels::SetIsa(PixelKernels::Isa::kScalar);
+                const Results expected = RunAll(pixels, premultiplied, width, height);
+                PixelKernels::SetIsa(isa);
+                const Results actual = RunAll(pixels, premultiplied, width, height);
+
+                const bool same = actual.swizzled == expected.swizzled &&
+                                  actual.premultiplied == expected.premultiplied &&
+                                  actual.unpremultiplied == expected.unpremultiplied &&
+                                  actual.halved == expected.halved && actual.i420 == expected.i420 &&
+                                  actual.nv12 == expected.nv12 && actual.hash == expected.hash;
+                if (!same && mismatches++ == 0) {
+                    std::fprintf(stderr, "%s differs from scalar at %dx%d\n", PixelKernels::IsaName(isa), width,
+                                 height);
+                }
+            }
+        }
+        CHECK(mismatches == 0);
+        std::printf("%s matches scalar\n", PixelKernels::IsaName(isa));
+    }
+}
+
+}  // namespace
+
+int main() {
+    testScalarReference();
+    testCopyAndHash();
+    testVariantsMatchScalar();
+    return TEST_RESULT();
+}
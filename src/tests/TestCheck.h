@@ -0,0 +1,41 @@
+/**
+ * @file TestCheck.h
+ * @brief Minimal check macros for the cefview unit tests
+ *
+ * Each test is a plain executable: CHECK() reports a failed condition and
+ * keeps going, TEST_RESULT() prints the summary and is main()'s exit code.
+ *
+ * This file is part of CefView project.
+ * Licensed under BSD-style license.
+ */
+#ifndef CEFVIEW_TESTCHECK_H
+#define CEFVIEW_TESTCHECK_H
+#pragma once
+
+#include <cstdio>
+
+namespace cefview {
+namespace test {
+
+inline int& FailureCount() {
+    static int failures = 0;
+    return failures;
+}
+
+}  // namespace test
+}  // namespace cefview
+
+#define CHECK(condition)                                                                   \
+    do {                                                                                   \
+        if (!(condition)) {                                                                \
+            std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #condition); \
+            ++cefview::test::FailureCount();                                               \
+        }                                                                                  \
+    } while (0)
+
+#define TEST_RESULT()                                                                          \
+    (std::printf(cefview::test::FailureCount() ? "%d check(s) FAILED\n" : "All checks passed\n", \
+                 cefview::test::FailureCount()),                                               \
+     cefview::test::FailureCount() ? 1 : 0)
+
+#endif  // CEFVIEW_TESTCHECK_H